@@ -0,0 +1,170 @@
+#include <jni.h>
+#include <android/hardware_buffer.h>
+#include <android/log.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <dlfcn.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#define TAG "HardwareBufferCamera"
+
+// Imports ARCore's camera AHardwareBuffers as EGLImages for Filament external textures. EGLImages
+// only need the display, so no EGL context is made current. The AHardwareBuffer and
+// EGL_ANDROID_get_native_client_buffer entry points are looked up at runtime: they need API 26,
+// the package's minSdk is 24.
+
+namespace {
+
+using FromHardwareBufferFn = AHardwareBuffer* (*)(JNIEnv*, jobject);
+using HardwareBufferRefFn = void (*)(AHardwareBuffer*);
+
+struct HardwareBufferApi {
+    FromHardwareBufferFn fromHardwareBuffer = nullptr;
+    HardwareBufferRefFn acquire = nullptr;
+    HardwareBufferRefFn release = nullptr;
+    PFNEGLGETNATIVECLIENTBUFFERANDROIDPROC getNativeClientBuffer = nullptr;
+    PFNEGLCREATEIMAGEKHRPROC createImage = nullptr;
+    PFNEGLDESTROYIMAGEKHRPROC destroyImage = nullptr;
+    EGLDisplay display = EGL_NO_DISPLAY;
+
+    bool loaded() const {
+        return fromHardwareBuffer && acquire && release && getNativeClientBuffer && createImage && destroyImage &&
+               display != EGL_NO_DISPLAY;
+    }
+};
+
+bool hasExtension(const char* extensions, const char* name) {
+    if (extensions == nullptr) return false;
+    const size_t length = strlen(name);
+    for (const char* match = strstr(extensions, name); match != nullptr; match = strstr(match + length, name)) {
+        const bool startsWord = match == extensions || match[-1] == ' ';
+        const bool endsWord = match[length] == ' ' || match[length] == '\0';
+        if (startsWord && endsWord) return true;
+    }
+    return false;
+}
+
+HardwareBufferApi loadApi() {
+    HardwareBufferApi api;
+    // Both libraries are already loaded by the runtime; dlopen only takes a handle to them
+    void* android = dlopen("libandroid.so", RTLD_NOW);
+    void* nativeWindow = dlopen("libnativewindow.so", RTLD_NOW);
+    if (android == nullptr || nativeWindow == nullptr) return api;
+    api.fromHardwareBuffer = reinterpret_cast<FromHardwareBufferFn>(dlsym(android, "AHardwareBuffer_fromHardwareBuffer"));
+    api.acquire = reinterpret_cast<HardwareBufferRefFn>(dlsym(nativeWindow, "AHardwareBuffer_acquire"));
+    api.release = reinterpret_cast<HardwareBufferRefFn>(dlsym(nativeWindow, "AHardwareBuffer_release"));
+
+    // Filament initializes the same default display; initializing twice is a no-op
+    EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) return api;
+    const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+    if (!hasExtension(extensions, "EGL_KHR_image_base") ||
+        !hasExtension(extensions, "EGL_ANDROID_image_native_buffer") ||
+        !hasExtension(extensions, "EGL_ANDROID_get_native_client_buffer")) {
+        return api;
+    }
+    api.getNativeClientBuffer = reinterpret_cast<PFNEGLGETNATIVECLIENTBUFFERANDROIDPROC>(
+        eglGetProcAddress("eglGetNativeClientBufferANDROID"));
+    api.createImage = reinterpret_cast<PFNEGLCREATEIMAGEKHRPROC>(eglGetProcAddress("eglCreateImageKHR"));
+    api.destroyImage = reinterpret_cast<PFNEGLDESTROYIMAGEKHRPROC>(eglGetProcAddress("eglDestroyImageKHR"));
+    api.display = display;
+    return api;
+}
+
+const HardwareBufferApi& hardwareBufferApi() {
+    static const HardwareBufferApi api = loadApi();
+    return api;
+}
+
+// ARCore cycles through a handful of camera buffers; a few spare slots cover a change of camera config
+constexpr size_t kMaxCachedImages = 8;
+
+struct CachedImage {
+    AHardwareBuffer* buffer = nullptr;
+    EGLImageKHR image = EGL_NO_IMAGE_KHR;
+    uint64_t lastUse = 0;
+};
+
+// One EGLImage per camera buffer, created on first sight and reused while ARCore keeps the buffer.
+// Holds a reference on each buffer, so its address can't be reused by another buffer while cached.
+struct CameraImageCache {
+    std::array<CachedImage, kMaxCachedImages> images;
+    uint64_t useCount = 0;
+
+    ~CameraImageCache() {
+        const HardwareBufferApi& api = hardwareBufferApi();
+        for (CachedImage& cached : images) {
+            if (cached.buffer == nullptr) continue;
+            api.destroyImage(api.display, cached.image);
+            api.release(cached.buffer);
+        }
+    }
+
+    EGLImageKHR imageFor(AHardwareBuffer* buffer) {
+        const HardwareBufferApi& api = hardwareBufferApi();
+        ++useCount;
+
+        CachedImage* slot = &images[0];
+        for (CachedImage& cached : images) {
+            if (cached.buffer == buffer) {
+                cached.lastUse = useCount;
+                return cached.image;
+            }
+            if (cached.lastUse < slot->lastUse) slot = &cached;
+        }
+
+        EGLint attributes[] = {EGL_IMAGE_PRESERVED_KHR, EGL_TRUE, EGL_NONE};
+        EGLImageKHR image = api.createImage(api.display, EGL_NO_CONTEXT, EGL_NATIVE_BUFFER_ANDROID,
+                                            api.getNativeClientBuffer(buffer), attributes);
+        if (image == EGL_NO_IMAGE_KHR) {
+            __android_log_print(ANDROID_LOG_WARN, TAG, "eglCreateImageKHR failed: 0x%x", eglGetError());
+            return EGL_NO_IMAGE_KHR;
+        }
+
+        // The least recently used slot hasn't been handed to Filament for at least kMaxCachedImages
+        // frames, well past the frames the engine keeps in flight
+        if (slot->buffer != nullptr) {
+            api.destroyImage(api.display, slot->image);
+            api.release(slot->buffer);
+        }
+        api.acquire(buffer);
+        slot->buffer = buffer;
+        slot->image = image;
+        slot->lastUse = useCount;
+        return image;
+    }
+};
+
+} // namespace
+
+extern "C" {
+
+JNIEXPORT jboolean JNICALL
+Java_com_margelo_nitro_nitrovto_HardwareBufferCamera_isSupported(JNIEnv*, jclass) {
+    return hardwareBufferApi().loaded() ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_margelo_nitro_nitrovto_HardwareBufferCamera_createImageCache(JNIEnv*, jclass) {
+    if (!hardwareBufferApi().loaded()) return 0;
+    return reinterpret_cast<jlong>(new CameraImageCache());
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_margelo_nitro_nitrovto_HardwareBufferCamera_imageFor(JNIEnv* env, jclass, jlong handle,
+                                                              jobject hardwareBuffer) {
+    if (handle == 0 || hardwareBuffer == nullptr) return 0;
+    AHardwareBuffer* buffer = hardwareBufferApi().fromHardwareBuffer(env, hardwareBuffer);
+    if (buffer == nullptr) return 0;
+    return reinterpret_cast<jlong>(reinterpret_cast<CameraImageCache*>(handle)->imageFor(buffer));
+}
+
+JNIEXPORT void JNICALL
+Java_com_margelo_nitro_nitrovto_HardwareBufferCamera_destroyImageCache(JNIEnv*, jclass, jlong handle) {
+    delete reinterpret_cast<CameraImageCache*>(handle);
+}
+
+} // extern "C"
@@ -0,0 +1,519 @@
+#include <jni.h>
+#include <android/log.h>
+
+#include "FaceMesh.hpp"
+#include "FacePoseStream.hpp"
+#include "FaceRecording.hpp"
+#include "FramePacer.hpp"
+#include "FrameStats.hpp"
+#include "GlassesPose.hpp"
+#include "LightEstimator.hpp"
+#include "ModelLod.hpp"
+#include "ModelMemory.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#define TAG "VtoCore"
+
+using namespace vto;
+
+namespace {
+
+constexpr jint BACK_PLANE_LEFT = 1;
+constexpr jint BACK_PLANE_RIGHT = 2;
+
+// Direct buffer element count, or 0 if the buffer is not direct
+size_t directFloatCount(JNIEnv* env, jobject buffer, float** data) {
+    *data = static_cast<float*>(env->GetDirectBufferAddress(buffer));
+    if (*data == nullptr) return 0;
+    jlong capacity = env->GetDirectBufferCapacity(buffer);
+    return capacity > 0 ? static_cast<size_t>(capacity) : 0;
+}
+
+Mat4 readMatrix(JNIEnv* env, jfloatArray array) {
+    Mat4 matrix;
+    env->GetFloatArrayRegion(array, 0, 16, matrix.m);
+    return matrix;
+}
+
+void writeMatrix(JNIEnv* env, jfloatArray array, const Mat4& matrix) {
+    env->SetFloatArrayRegion(array, 0, 16, matrix.m);
+}
+
+} // namespace
+
+extern "C" {
+
+JNIEXPORT jint JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_packFaceMesh(JNIEnv* env, jclass,
+                                                     jobject vertices, jint vertexCount,
+                                                     jobject dst, jfloatArray faceMatrix,
+                                                     jboolean backPlaneEnabled,
+                                                     jfloatArray outBackPlaneMatrix,
+                                                     jfloatArray outBounds) {
+    float* src = nullptr;
+    float* out = nullptr;
+    size_t srcCount = directFloatCount(env, vertices, &src);
+    size_t dstCount = directFloatCount(env, dst, &out);
+    size_t floatCount = static_cast<size_t>(vertexCount) * 3;
+    if (srcCount < floatCount || dstCount < floatCount) {
+        __android_log_print(ANDROID_LOG_WARN, TAG, "Invalid face mesh buffers: %zu / %zu floats for %d vertices",
+                            srcCount, dstCount, vertexCount);
+        return -1;
+    }
+
+    FaceMeshBounds bounds = packFaceVertices(src, 3, static_cast<size_t>(vertexCount), out);
+
+    // Filament's Java Box takes center + half extent
+    const float box[6] = {
+        (bounds.min.x + bounds.max.x) * 0.5f, (bounds.min.y + bounds.max.y) * 0.5f, (bounds.min.z + bounds.max.z) * 0.5f,
+        (bounds.max.x - bounds.min.x) * 0.5f, (bounds.max.y - bounds.min.y) * 0.5f, (bounds.max.z - bounds.min.z) * 0.5f,
+    };
+    env->SetFloatArrayRegion(outBounds, 0, 6, box);
+
+    BackPlanePlacement placement = placeBackPlanes(readMatrix(env, faceMatrix), bounds.min.z, backPlaneEnabled);
+    writeMatrix(env, outBackPlaneMatrix, placement.transform);
+
+    return (placement.showLeft ? BACK_PLANE_LEFT : 0) | (placement.showRight ? BACK_PLANE_RIGHT : 0);
+}
+
+JNIEXPORT void JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_accumulateWorldBounds(JNIEnv* env, jclass,
+                                                              jfloatArray faceMatrix,
+                                                              jfloatArray localBounds,
+                                                              jfloatArray worldBounds,
+                                                              jboolean first) {
+    // Local bounds come from packFaceMesh as center + half extent; world bounds are min (3) + max (3)
+    float box[6];
+    env->GetFloatArrayRegion(localBounds, 0, 6, box);
+    const FaceMeshBounds local = {
+        {box[0] - box[3], box[1] - box[4], box[2] - box[5]},
+        {box[0] + box[3], box[1] + box[4], box[2] + box[5]},
+    };
+    FaceMeshBounds world = transformBounds(readMatrix(env, faceMatrix), local);
+    if (!first) {
+        float previous[6];
+        env->GetFloatArrayRegion(worldBounds, 0, 6, previous);
+        world = mergeBounds(world, {{previous[0], previous[1], previous[2]}, {previous[3], previous[4], previous[5]}});
+    }
+    const float out[6] = {world.min.x, world.min.y, world.min.z, world.max.x, world.max.y, world.max.z};
+    env->SetFloatArrayRegion(worldBounds, 0, 6, out);
+}
+
+JNIEXPORT jshortArray JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_decimateFaceIndices(JNIEnv* env, jclass, jobject vertices,
+                                                            jint vertexCount, jshortArray indices) {
+    float* src = nullptr;
+    const size_t srcCount = directFloatCount(env, vertices, &src);
+    const size_t count = std::min(static_cast<size_t>(vertexCount), srcCount / 3);
+    const jsize indexCount = env->GetArrayLength(indices);
+    std::vector<uint16_t> source(static_cast<size_t>(indexCount));
+    std::vector<uint16_t> decimated(source.size());
+    env->GetShortArrayRegion(indices, 0, indexCount, reinterpret_cast<jshort*>(source.data()));
+    const size_t decimatedCount = decimateFaceIndices(src, 3, count, source.data(), source.size(),
+                                                      kOccluderCellSize, decimated.data());
+    jshortArray result = env->NewShortArray(static_cast<jsize>(decimatedCount));
+    env->SetShortArrayRegion(result, 0, static_cast<jsize>(decimatedCount),
+                             reinterpret_cast<const jshort*>(decimated.data()));
+    return result;
+}
+
+JNIEXPORT jshortArray JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_buildOccluderIndices(JNIEnv* env, jclass, jshortArray faceIndices,
+                                                             jint vertexCount, jint faceCount) {
+    const jsize faceIndexCount = env->GetArrayLength(faceIndices);
+    const size_t occluderCount = occluderSlotIndexCount(static_cast<size_t>(faceIndexCount)) *
+                                 static_cast<size_t>(faceCount);
+    std::vector<uint16_t> source(static_cast<size_t>(faceIndexCount));
+    std::vector<uint16_t> occluder(occluderCount);
+    env->GetShortArrayRegion(faceIndices, 0, faceIndexCount, reinterpret_cast<jshort*>(source.data()));
+    if (!buildOccluderIndices(source.data(), source.size(), static_cast<size_t>(vertexCount),
+                              static_cast<size_t>(faceCount), occluder.data())) {
+        __android_log_print(ANDROID_LOG_WARN, TAG, "Cannot batch %d faces of %d vertices", faceCount, vertexCount);
+        return nullptr;
+    }
+    jshortArray result = env->NewShortArray(static_cast<jsize>(occluderCount));
+    env->SetShortArrayRegion(result, 0, static_cast<jsize>(occluderCount),
+                             reinterpret_cast<const jshort*>(occluder.data()));
+    return result;
+}
+
+JNIEXPORT jshortArray JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_occluderBoneIndices(JNIEnv* env, jclass, jint vertexCount, jint faceCount) {
+    const size_t count = occluderVertexCount(static_cast<size_t>(vertexCount), static_cast<size_t>(faceCount)) * 4;
+    std::vector<uint16_t> bones(count);
+    occluderBoneIndices(static_cast<size_t>(vertexCount), static_cast<size_t>(faceCount), bones.data());
+    jshortArray result = env->NewShortArray(static_cast<jsize>(count));
+    env->SetShortArrayRegion(result, 0, static_cast<jsize>(count), reinterpret_cast<const jshort*>(bones.data()));
+    return result;
+}
+
+JNIEXPORT jfloatArray JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_occluderBackPlaneVertices(JNIEnv* env, jclass, jint faceCount) {
+    const size_t count = kOccluderBackPlaneVertices * static_cast<size_t>(faceCount) * 3;
+    std::vector<float> vertices(count);
+    occluderBackPlaneVertices(static_cast<size_t>(faceCount), 3, vertices.data());
+    jfloatArray result = env->NewFloatArray(static_cast<jsize>(count));
+    env->SetFloatArrayRegion(result, 0, static_cast<jsize>(count), vertices.data());
+    return result;
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_createGlassesPoseSolver(JNIEnv*, jclass) {
+    return reinterpret_cast<jlong>(new GlassesPoseSolver(kARCoreNoseBridge));
+}
+
+JNIEXPORT void JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_destroyGlassesPoseSolver(JNIEnv*, jclass, jlong handle) {
+    delete reinterpret_cast<GlassesPoseSolver*>(handle);
+}
+
+JNIEXPORT void JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_resetGlassesPoseSolver(JNIEnv*, jclass, jlong handle) {
+    reinterpret_cast<GlassesPoseSolver*>(handle)->reset();
+}
+
+JNIEXPORT void JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_setGlassesForwardOffset(JNIEnv*, jclass, jlong handle, jfloat offset) {
+    reinterpret_cast<GlassesPoseSolver*>(handle)->setForwardOffset(offset);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_updateGlassesPose(JNIEnv* env, jclass, jlong handle,
+                                                          jobject vertices, jfloatArray faceMatrix,
+                                                          jlong timestampNanos, jlong predictionNanos,
+                                                          jfloatArray outMatrix) {
+    float* src = nullptr;
+    size_t floatCount = directFloatCount(env, vertices, &src);
+    if (src == nullptr) {
+        __android_log_print(ANDROID_LOG_WARN, TAG, "Face mesh vertices are not a direct buffer");
+        return JNI_FALSE;
+    }
+
+    auto* solver = reinterpret_cast<GlassesPoseSolver*>(handle);
+    Mat4 transform = solver->update(readMatrix(env, faceMatrix), src, 3, floatCount / 3, timestampNanos * 1e-9,
+                                    predictionNanos * 1e-9);
+    writeMatrix(env, outMatrix, transform);
+    return JNI_TRUE;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_classifyDeviceTier(JNIEnv*, jclass, jlong totalMemoryBytes,
+                                                           jint cpuCores, jboolean lowRamDevice) {
+    return static_cast<jint>(classifyDeviceTier(static_cast<uint64_t>(totalMemoryBytes), cpuCores, lowRamDevice));
+}
+
+JNIEXPORT jint JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_lodLevelFromName(JNIEnv* env, jclass, jstring name) {
+    if (name == nullptr) return -1;
+    const char* chars = env->GetStringUTFChars(name, nullptr);
+    int level = lodLevelFromName(chars);
+    env->ReleaseStringUTFChars(name, chars);
+    return level;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_estimateModelMemory(JNIEnv* env, jclass, jobject glb, jint size,
+                                                            jlongArray out) {
+    const auto* data = static_cast<const uint8_t*>(env->GetDirectBufferAddress(glb));
+    jlong capacity = env->GetDirectBufferCapacity(glb);
+    if (data == nullptr || size < 0 || size > capacity) return JNI_FALSE;
+
+    ModelMemoryEstimate estimate;
+    if (!estimateModelMemory(data, static_cast<size_t>(size), estimate)) return JNI_FALSE;
+    jlong values[2] = {static_cast<jlong>(estimate.geometryBytes), static_cast<jlong>(estimate.textureBytes)};
+    env->SetLongArrayRegion(out, 0, 2, values);
+    return JNI_TRUE;
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_createLodSelector(JNIEnv*, jclass, jint deviceTier) {
+    auto* selector = new LodSelector();
+    selector->setDeviceTier(static_cast<DeviceTier>(deviceTier));
+    return reinterpret_cast<jlong>(selector);
+}
+
+JNIEXPORT void JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_destroyLodSelector(JNIEnv*, jclass, jlong handle) {
+    delete reinterpret_cast<LodSelector*>(handle);
+}
+
+JNIEXPORT void JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_setLodLevelCount(JNIEnv*, jclass, jlong handle, jint count) {
+    reinterpret_cast<LodSelector*>(handle)->setLevelCount(count);
+}
+
+JNIEXPORT void JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_resetLodSelector(JNIEnv*, jclass, jlong handle) {
+    reinterpret_cast<LodSelector*>(handle)->reset();
+}
+
+JNIEXPORT jint JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_lodLevel(JNIEnv*, jclass, jlong handle) {
+    return reinterpret_cast<LodSelector*>(handle)->level();
+}
+
+JNIEXPORT jint JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_updateLodSelector(JNIEnv* env, jclass, jlong handle,
+                                                          jfloatArray faceMatrix, jfloatArray cameraMatrix) {
+    auto* selector = reinterpret_cast<LodSelector*>(handle);
+    return selector->update(readMatrix(env, faceMatrix), readMatrix(env, cameraMatrix));
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_createFramePacer(JNIEnv*, jclass) {
+    return reinterpret_cast<jlong>(new FramePacer());
+}
+
+JNIEXPORT void JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_destroyFramePacer(JNIEnv*, jclass, jlong handle) {
+    delete reinterpret_cast<FramePacer*>(handle);
+}
+
+JNIEXPORT void JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_resetFramePacer(JNIEnv*, jclass, jlong handle) {
+    reinterpret_cast<FramePacer*>(handle)->reset();
+}
+
+JNIEXPORT void JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_setFramePacerThermalLevel(JNIEnv*, jclass, jlong handle, jint level) {
+    reinterpret_cast<FramePacer*>(handle)->setThermalLevel(static_cast<ThermalLevel>(level));
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_addFramePacerFrame(JNIEnv*, jclass, jlong handle,
+                                                          jlong timestampNanos, jlong workNanos,
+                                                          jboolean presented) {
+    auto* pacer = reinterpret_cast<FramePacer*>(handle);
+    return pacer->addFrame(timestampNanos * 1e-9, workNanos * 1e-9, presented == JNI_TRUE) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jfloat JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_framePacerRenderScale(JNIEnv*, jclass, jlong handle) {
+    return reinterpret_cast<FramePacer*>(handle)->renderScale();
+}
+
+JNIEXPORT jint JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_framePacerFramesPerSecond(JNIEnv*, jclass, jlong handle) {
+    return reinterpret_cast<FramePacer*>(handle)->framesPerSecond();
+}
+
+JNIEXPORT jint JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_framePacerReason(JNIEnv*, jclass, jlong handle) {
+    return static_cast<jint>(reinterpret_cast<FramePacer*>(handle)->reason());
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_createFrameStats(JNIEnv*, jclass) {
+    return reinterpret_cast<jlong>(new FrameStats());
+}
+
+JNIEXPORT void JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_destroyFrameStats(JNIEnv*, jclass, jlong handle) {
+    delete reinterpret_cast<FrameStats*>(handle);
+}
+
+JNIEXPORT void JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_addFrameStatsFrame(JNIEnv* env, jclass, jlong handle,
+                                                          jlongArray stageNanos, jboolean dropped) {
+    jlong nanos[kFrameStageCount];
+    env->GetLongArrayRegion(stageNanos, 0, kFrameStageCount, nanos);
+    FrameTimings timings;
+    for (int stage = 0; stage < kFrameStageCount; stage++) {
+        if (nanos[stage] >= 0) timings.seconds[stage] = nanos[stage] * 1e-9;
+    }
+    reinterpret_cast<FrameStats*>(handle)->addFrame(timings, dropped == JNI_TRUE);
+}
+
+JNIEXPORT void JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_frameStatsSnapshot(JNIEnv* env, jclass, jlong handle, jdoubleArray out) {
+    FrameStatsSnapshot snapshot = reinterpret_cast<FrameStats*>(handle)->snapshot();
+    double values[2 + kFrameStageCount * 5];
+    values[0] = static_cast<double>(snapshot.frameCount);
+    values[1] = static_cast<double>(snapshot.droppedFrames);
+    for (int stage = 0; stage < kFrameStageCount; stage++) {
+        const StageSummary& summary = snapshot.stages[stage];
+        double* dst = values + 2 + stage * 5;
+        dst[0] = summary.p50;
+        dst[1] = summary.p95;
+        dst[2] = summary.p99;
+        dst[3] = summary.max;
+        dst[4] = summary.samples;
+    }
+    env->SetDoubleArrayRegion(out, 0, 2 + kFrameStageCount * 5, values);
+}
+
+JNIEXPORT jstring JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_frameStatsSummary(JNIEnv* env, jclass, jlong handle) {
+    std::string summary = formatFrameStats(reinterpret_cast<FrameStats*>(handle)->snapshot());
+    return env->NewStringUTF(summary.c_str());
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_createFaceRecorder(JNIEnv* env, jclass, jstring path) {
+    const char* chars = env->GetStringUTFChars(path, nullptr);
+    auto* writer = new FaceRecordingWriter();
+    bool opened = writer->open(chars, RecordingSource::ARCore);
+    env->ReleaseStringUTFChars(path, chars);
+    if (!opened) {
+        delete writer;
+        return 0;
+    }
+    return reinterpret_cast<jlong>(writer);
+}
+
+JNIEXPORT jint JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_destroyFaceRecorder(JNIEnv*, jclass, jlong handle) {
+    auto* writer = reinterpret_cast<FaceRecordingWriter*>(handle);
+    jint frameCount = static_cast<jint>(writer->frameCount());
+    delete writer;
+    return frameCount;
+}
+
+JNIEXPORT void JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_writeFaceRecordingFrame(JNIEnv* env, jclass, jlong handle,
+                                                               jlong timestampNanos, jfloatArray intrinsics,
+                                                               jint imageWidth, jint imageHeight,
+                                                               jfloatArray projection, jfloatArray cameraMatrix,
+                                                               jfloatArray faceMatrix, jobject vertices) {
+    RecordedCamera camera;
+    camera.timestamp = timestampNanos * 1e-9;
+    float values[4];
+    env->GetFloatArrayRegion(intrinsics, 0, 4, values);
+    camera.focalLengthX = values[0];
+    camera.focalLengthY = values[1];
+    camera.principalPointX = values[2];
+    camera.principalPointY = values[3];
+    camera.imageWidth = static_cast<uint32_t>(imageWidth);
+    camera.imageHeight = static_cast<uint32_t>(imageHeight);
+    camera.projection = readMatrix(env, projection);
+    camera.transform = readMatrix(env, cameraMatrix);
+
+    auto* writer = reinterpret_cast<FaceRecordingWriter*>(handle);
+    float* data = nullptr;
+    size_t count = vertices != nullptr ? directFloatCount(env, vertices, &data) : 0;
+    if (faceMatrix == nullptr || count == 0) {
+        writer->writeFrame(camera, nullptr, nullptr, 3, 0);
+        return;
+    }
+    Mat4 faceTransform = readMatrix(env, faceMatrix);
+    writer->writeFrame(camera, &faceTransform, data, 3, count / 3);
+}
+
+JNIEXPORT void JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_writeFacePoses(JNIEnv* env, jclass, jobject buffer, jint state,
+                                                       jlong timestampNanos, jint faceCount,
+                                                       jobjectArray faceMatrices, jobjectArray faceVertices,
+                                                       jfloatArray viewMatrix, jfloatArray projection) {
+    void* data = env->GetDirectBufferAddress(buffer);
+    if (data == nullptr || env->GetDirectBufferCapacity(buffer) < static_cast<jlong>(kFacePoseBufferBytes)) {
+        __android_log_print(ANDROID_LOG_WARN, TAG, "Face pose buffer is not a direct buffer of %zu bytes",
+                            kFacePoseBufferBytes);
+        return;
+    }
+
+    FacePoseSample samples[kMaxTrackedFaces];
+    int count = 0;
+    if (faceCount > 0) {
+        const Mat4 view = readMatrix(env, viewMatrix);
+        const Mat4 proj = readMatrix(env, projection);
+        const int limit = faceCount < kMaxTrackedFaces ? faceCount : kMaxTrackedFaces;
+        for (int i = 0; i < limit; i++) {
+            auto matrix = static_cast<jfloatArray>(env->GetObjectArrayElement(faceMatrices, i));
+            jobject vertices = env->GetObjectArrayElement(faceVertices, i);
+            float* src = nullptr;
+            size_t floatCount = vertices != nullptr ? directFloatCount(env, vertices, &src) : 0;
+            if (matrix != nullptr) {
+                const Mat4 faceTransform = readMatrix(env, matrix);
+                const Float3 noseBridge =
+                    noseBridgeWorldPosition(faceTransform, src, 3, floatCount / 3, kARCoreNoseBridge);
+                samples[count++] = makeFacePoseSample(faceTransform, noseBridge, view, proj);
+            }
+            env->DeleteLocalRef(matrix);
+            env->DeleteLocalRef(vertices);
+        }
+    }
+    writeFacePoses(data, static_cast<FaceTrackingState>(state), timestampNanos * 1e-9, samples, count);
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_createLightEstimator(JNIEnv*, jclass) {
+    return reinterpret_cast<jlong>(new LightEstimator());
+}
+
+JNIEXPORT void JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_destroyLightEstimator(JNIEnv*, jclass, jlong handle) {
+    delete reinterpret_cast<LightEstimator*>(handle);
+}
+
+JNIEXPORT void JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_resetLightEstimator(JNIEnv*, jclass, jlong handle) {
+    reinterpret_cast<LightEstimator*>(handle)->reset();
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_lightEstimatorWantsEstimate(JNIEnv*, jclass, jlong handle,
+                                                                  jlong timestampNanos) {
+    return reinterpret_cast<LightEstimator*>(handle)->wantsEstimate(timestampNanos * 1e-9) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT void JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_addLightEstimatorRadiance(JNIEnv* env, jclass, jlong handle,
+                                                                jfloatArray radiance, jlong timestampNanos) {
+    if (env->GetArrayLength(radiance) < kSphericalHarmonicsCount * 3) return;
+    float values[kSphericalHarmonicsCount * 3];
+    env->GetFloatArrayRegion(radiance, 0, kSphericalHarmonicsCount * 3, values);
+    const SphericalHarmonics irradiance = irradianceFromInterleavedRadiance(values);
+    reinterpret_cast<LightEstimator*>(handle)->addEstimate(
+        irradiance, brightnessFromIrradiance(irradiance), LightSource::Tracker, timestampNanos * 1e-9);
+}
+
+JNIEXPORT void JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_addLightEstimatorCameraImage(JNIEnv* env, jclass, jlong handle,
+                                                                   jobject image, jint width, jint height,
+                                                                   jfloatArray cameraMatrix,
+                                                                   jfloatArray projection,
+                                                                   jfloat brightness, jlong timestampNanos) {
+    auto* pixels = static_cast<const uint8_t*>(env->GetDirectBufferAddress(image));
+    if (pixels == nullptr || env->GetDirectBufferCapacity(image) < static_cast<jlong>(width) * height * 4) {
+        __android_log_print(ANDROID_LOG_WARN, TAG, "Camera light image is not a direct buffer of %dx%d RGBA",
+                            width, height);
+        return;
+    }
+    const SphericalHarmonics irradiance = irradianceFromCameraImage(
+        pixels, width, height, width * 4, readMatrix(env, cameraMatrix), readMatrix(env, projection));
+    reinterpret_cast<LightEstimator*>(handle)->addEstimate(irradiance, brightness, LightSource::Camera,
+                                                           timestampNanos * 1e-9);
+}
+
+JNIEXPORT void JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_addLightEstimatorBrightness(JNIEnv*, jclass, jlong handle,
+                                                                  jfloat brightness, jlong timestampNanos) {
+    reinterpret_cast<LightEstimator*>(handle)->addBrightness(brightness, timestampNanos * 1e-9);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_updateLightEstimator(JNIEnv* env, jclass, jlong handle,
+                                                           jlong timestampNanos, jfloatArray outIrradiance) {
+    auto* estimator = reinterpret_cast<LightEstimator*>(handle);
+    if (!estimator->update(timestampNanos * 1e-9)) return JNI_FALSE;
+    // Float3 is three packed floats: the coefficients are already IndirectLight.Builder.irradiance's layout
+    static_assert(sizeof(SphericalHarmonics) == sizeof(float) * kSphericalHarmonicsCount * 3,
+                  "SphericalHarmonics must be packed RGB triplets");
+    env->SetFloatArrayRegion(outIrradiance, 0, kSphericalHarmonicsCount * 3,
+                             reinterpret_cast<const float*>(estimator->irradiance().coefficients));
+    return JNI_TRUE;
+}
+
+JNIEXPORT jfloat JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_lightEstimatorIntensity(JNIEnv*, jclass, jlong handle) {
+    return reinterpret_cast<LightEstimator*>(handle)->intensity();
+}
+
+JNIEXPORT jint JNICALL
+Java_com_margelo_nitro_nitrovto_VtoCore_lightEstimatorSource(JNIEnv*, jclass, jlong handle) {
+    return static_cast<jint>(reinterpret_cast<LightEstimator*>(handle)->source());
+}
+
+} // extern "C"
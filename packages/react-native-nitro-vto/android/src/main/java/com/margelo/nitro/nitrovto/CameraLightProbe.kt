@@ -0,0 +1,117 @@
+package com.margelo.nitro.nitrovto
+
+import android.os.Handler
+import android.os.Looper
+import com.google.android.filament.Camera
+import com.google.android.filament.Engine
+import com.google.android.filament.Entity
+import com.google.android.filament.EntityManager
+import com.google.android.filament.RenderTarget
+import com.google.android.filament.Renderer
+import com.google.android.filament.Texture
+import com.google.android.filament.View
+import com.google.android.filament.Viewport
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Downsampled camera image for lighting estimates, when ARCore has no environmental HDR for the
+ * front camera. The camera background is rendered alone into a [SIZE] x [SIZE] offscreen target
+ * (the GPU does the reduction, a bilinear tap per pixel) and read back with Renderer.readPixels,
+ * which Filament fills a few frames later: neither the render loop nor the GPU waits on it.
+ * One readback in flight; the buffers are reused, so a probe frame doesn't allocate.
+ * Render thread only; [onImage] is called on the main thread with the matrices the image was
+ * rendered with.
+ */
+internal class CameraLightProbe(
+    private val engine: Engine,
+    camera: Camera,
+    cameraTextureRenderer: CameraTextureRenderer,
+    private val onImage: (
+        image: ByteBuffer,
+        width: Int,
+        height: Int,
+        cameraMatrix: FloatArray,
+        projection: FloatArray,
+        timestampNanos: Long
+    ) -> Unit
+) {
+
+    companion object {
+        const val SIZE = 32
+    }
+
+    private val mainHandler = Handler(Looper.getMainLooper())
+
+    private val scene = engine.createScene()
+    private val view = engine.createView()
+    private val colorTexture = Texture.Builder()
+        .width(SIZE)
+        .height(SIZE)
+        .levels(1)
+        .format(Texture.InternalFormat.RGBA8)
+        .usage(Texture.Usage.COLOR_ATTACHMENT or Texture.Usage.SAMPLEABLE)
+        .build(engine)
+    private val renderTarget = RenderTarget.Builder()
+        .texture(RenderTarget.AttachmentPoint.COLOR, colorTexture)
+        .build(engine)
+    @Entity private val quadEntity = EntityManager.get().create()
+
+    private val image = ByteBuffer.allocateDirect(SIZE * SIZE * 4).order(ByteOrder.nativeOrder())
+    private val readCameraMatrix = FloatArray(16)
+    private val readProjection = FloatArray(16)
+    private var readTimestampNanos = 0L
+    private var reading = false
+    private var destroyed = false
+
+    // Reused for every readback: readPixels takes the buffer, handler and callback per call
+    private val descriptor = Texture.PixelBufferDescriptor(
+        image, Texture.Format.RGBA, Texture.Type.UBYTE, 1, 0, 0, SIZE, mainHandler
+    ) {
+        reading = false
+        if (!destroyed) onImage(image, SIZE, SIZE, readCameraMatrix, readProjection, readTimestampNanos)
+    }
+
+    init {
+        cameraTextureRenderer.buildBackgroundRenderable(quadEntity)
+        scene.addEntity(quadEntity)
+
+        view.scene = scene
+        view.camera = camera
+        view.renderTarget = renderTarget
+        view.viewport = Viewport(0, 0, SIZE, SIZE)
+        // Raw camera colors: no tone mapping, AA or shadows
+        view.isPostProcessingEnabled = false
+        view.isShadowingEnabled = false
+    }
+
+    /**
+     * Render the probe and queue its readback, unless one is still in flight.
+     * Call between beginFrame and endFrame; [cameraMatrix] and [projection] are the Filament
+     * camera's, handed back with the image.
+     * @return False if the previous readback hasn't arrived yet
+     */
+    fun render(renderer: Renderer, cameraMatrix: FloatArray, projection: FloatArray, timestampNanos: Long): Boolean {
+        if (reading || destroyed) return false
+        reading = true
+        System.arraycopy(cameraMatrix, 0, readCameraMatrix, 0, 16)
+        System.arraycopy(projection, 0, readProjection, 0, 16)
+        readTimestampNanos = timestampNanos
+
+        renderer.render(view)
+        image.clear()
+        renderer.readPixels(renderTarget, 0, 0, SIZE, SIZE, descriptor)
+        return true
+    }
+
+    fun destroy() {
+        destroyed = true
+        scene.removeEntity(quadEntity)
+        engine.destroyEntity(quadEntity)
+        EntityManager.get().destroy(quadEntity)
+        engine.destroyView(view)
+        engine.destroyScene(scene)
+        engine.destroyRenderTarget(renderTarget)
+        engine.destroyTexture(colorTexture)
+    }
+}
@@ -1,11 +1,7 @@
 package com.margelo.nitro.nitrovto
 
+import android.annotation.SuppressLint
 import android.content.Context
-import android.opengl.EGL14
-import android.opengl.EGLConfig
-import android.opengl.EGLContext
-import android.opengl.EGLDisplay
-import android.opengl.EGLSurface
 import android.opengl.GLES11Ext
 import android.opengl.GLES30
 import android.util.Log
@@ -23,10 +19,13 @@ import com.google.android.filament.TextureSampler
 import com.google.android.filament.VertexBuffer
 import com.google.ar.core.Coordinates2d
 import com.google.ar.core.Frame
+import com.google.ar.core.exceptions.NotYetAvailableException
 
 /**
  * Handles camera texture rendering for AR background.
- * Creates and manages the EGL context, external texture, and fullscreen quad.
+ * Creates the external camera texture and the fullscreen quad. Camera frames arrive either as
+ * ARCore hardware buffers imported as EGLImages, or in GL textures of the shared EGL context
+ * (see [FilamentContext.hardwareBufferCamera]).
  */
 class CameraTextureRenderer(private val context: Context) {
 
@@ -34,21 +33,31 @@ class CameraTextureRenderer(private val context: Context) {
         private const val TAG = "CameraTextureRenderer"
     }
 
-    // EGL context for ARCore
-    private var eglDisplay: EGLDisplay = EGL14.EGL_NO_DISPLAY
-    private var eglContext: EGLContext = EGL14.EGL_NO_CONTEXT
-    private var eglSurface: EGLSurface = EGL14.EGL_NO_SURFACE
+    // Shared EGL context, engine and materials
+    private lateinit var filamentContext: FilamentContext
+
+    // Hardware buffer path: one external texture pointed at each frame's EGLImage
+    private var cameraImageCache = 0L
+    private var boundImage = 0L
 
     // Camera textures (multiple to avoid read/write conflicts with ARCore)
     // @see https://github.com/google/filament/issues/5498
     private var cameraTextureIds: IntArray = IntArray(4)
     private var cameraTextures: Array<Texture?> = arrayOfNulls(4)
+    // Texture name bound to the material, so a frame reusing it skips the rebind
+    private var boundTextureId = 0
+    private val cameraSampler = TextureSampler(
+        TextureSampler.MinFilter.LINEAR,
+        TextureSampler.MagFilter.LINEAR,
+        TextureSampler.WrapMode.CLAMP_TO_EDGE
+    )
 
     // Background quad
     private lateinit var cameraMaterial: Material
     private lateinit var cameraMaterialInstance: MaterialInstance
     @Entity private var backgroundQuadEntity: Int = 0
     private var backgroundQuadVertexBuffer: VertexBuffer? = null
+    private var backgroundQuadIndexBuffer: IndexBuffer? = null
     private var uvTransformSet = false
 
     // Reference to engine and scene (set during setup)
@@ -56,9 +65,10 @@ class CameraTextureRenderer(private val context: Context) {
     private lateinit var scene: Scene
 
     /**
-     * Returns the EGL context for sharing with Filament engine
+     * Camera frames come from ARCore's hardware buffers, not from texture names set on the session
      */
-    fun getEglContext(): EGLContext = eglContext
+    val usesHardwareBuffer: Boolean
+        get() = filamentContext.hardwareBufferCamera
 
     /**
      * Returns the camera texture IDs for ARCore (multiple textures to avoid sync issues)
@@ -66,11 +76,15 @@ class CameraTextureRenderer(private val context: Context) {
     fun getCameraTextureIds(): IntArray = cameraTextureIds
 
     /**
-     * Initialize EGL context and create camera texture.
-     * Must be called before creating Filament engine.
+     * Create the camera textures in the shared EGL context, or the EGLImage cache on the hardware
+     * buffer path.
      */
-    fun initializeEglContext() {
-        createEglContext()
+    fun initializeEglContext(filamentContext: FilamentContext) {
+        this.filamentContext = filamentContext
+        if (usesHardwareBuffer) {
+            cameraImageCache = HardwareBufferCamera.createImageCache()
+            return
+        }
         makeEglContextCurrent()
         // Create multiple textures to avoid read/write sync issues with ARCore
         for (i in cameraTextureIds.indices) {
@@ -81,19 +95,29 @@ class CameraTextureRenderer(private val context: Context) {
 
     /**
      * Setup the camera background rendering.
-     * Must be called after Filament engine is created.
+     * Must be called after [initializeEglContext].
      */
-    fun setup(engine: Engine, scene: Scene) {
-        this.engine = engine
+    fun setup(filamentContext: FilamentContext, scene: Scene) {
+        this.engine = filamentContext.engine
         this.scene = scene
 
-        // Load camera background material
-        val materialBuffer = LoaderUtils.loadAsset(context, "materials/camera_background.filamat")
-        cameraMaterial = Material.Builder()
-            .payload(materialBuffer, materialBuffer.remaining())
-            .build(engine)
+        // Camera background material, compiled once and owned by the shared context
+        cameraMaterial = filamentContext.material("materials/camera_background.filamat")
         cameraMaterialInstance = cameraMaterial.createInstance()
 
+        if (usesHardwareBuffer) {
+            // Content set per frame from the camera buffer's EGLImage
+            cameraTextures[0] = Texture.Builder()
+                .sampler(Texture.Sampler.SAMPLER_EXTERNAL)
+                .format(Texture.InternalFormat.RGB8)
+                .external()
+                .build(engine)
+            cameraMaterialInstance.setParameter("cameraTexture", cameraTextures[0]!!, cameraSampler)
+            Log.d(TAG, "Camera texture created for hardware buffers")
+            createBackgroundQuad()
+            return
+        }
+
         // Import all external OES textures that ARCore cycles through
         for (i in cameraTextureIds.indices) {
             cameraTextures[i] = Texture.Builder()
@@ -104,15 +128,8 @@ class CameraTextureRenderer(private val context: Context) {
         }
 
         // Set initial texture on material (will be updated each frame)
-        cameraMaterialInstance.setParameter(
-            "cameraTexture",
-            cameraTextures[0]!!,
-            TextureSampler(
-                TextureSampler.MinFilter.LINEAR,
-                TextureSampler.MagFilter.LINEAR,
-                TextureSampler.WrapMode.CLAMP_TO_EDGE
-            )
-        )
+        cameraMaterialInstance.setParameter("cameraTexture", cameraTextures[0]!!, cameraSampler)
+        boundTextureId = cameraTextureIds[0]
 
         Log.d(TAG, "Camera textures imported, IDs: ${cameraTextureIds.contentToString()}")
 
@@ -124,9 +141,7 @@ class CameraTextureRenderer(private val context: Context) {
      * Make EGL context current for OpenGL operations
      */
     fun makeEglContextCurrent() {
-        if (!EGL14.eglMakeCurrent(eglDisplay, eglSurface, eglSurface, eglContext)) {
-            throw RuntimeException("Unable to make EGL context current")
-        }
+        filamentContext.makeEglContextCurrent()
     }
 
     /**
@@ -134,19 +149,38 @@ class CameraTextureRenderer(private val context: Context) {
      * ARCore cycles through the texture array, so we need to bind the right one.
      */
     fun updateCameraTexture(frame: Frame) {
+        if (usesHardwareBuffer) {
+            updateCameraImage(frame)
+            return
+        }
         val currentTextureId = frame.cameraTextureName
-        val index = cameraTextureIds.indexOf(currentTextureId)
-        if (index >= 0 && cameraTextures[index] != null) {
-            cameraMaterialInstance.setParameter(
-                "cameraTexture",
-                cameraTextures[index]!!,
-                TextureSampler(
-                    TextureSampler.MinFilter.LINEAR,
-                    TextureSampler.MagFilter.LINEAR,
-                    TextureSampler.WrapMode.CLAMP_TO_EDGE
-                )
-            )
+        if (currentTextureId == boundTextureId) return
+        for (i in cameraTextureIds.indices) {
+            if (cameraTextureIds[i] != currentTextureId) continue
+            val texture = cameraTextures[i] ?: return
+            cameraMaterialInstance.setParameter("cameraTexture", texture, cameraSampler)
+            boundTextureId = currentTextureId
+            return
+        }
+    }
+
+    /**
+     * Point the external texture at the EGLImage of this frame's camera buffer. ARCore cycles through
+     * a few buffers, each imported once; nothing is copied and no EGL context is made current.
+     */
+    // Only reached on API 27+, see HardwareBufferCamera.isAvailable
+    @SuppressLint("NewApi")
+    private fun updateCameraImage(frame: Frame) {
+        val texture = cameraTextures[0] ?: return
+        val buffer = try {
+            frame.hardwareBuffer
+        } catch (e: NotYetAvailableException) {
+            return
         }
+        val image = HardwareBufferCamera.imageFor(cameraImageCache, buffer)
+        if (image == 0L || image == boundImage) return
+        texture.setExternalImage(engine, image)
+        boundImage = image
     }
 
     /**
@@ -205,67 +239,28 @@ class CameraTextureRenderer(private val context: Context) {
      */
     fun destroy() {
         scene.removeEntity(backgroundQuadEntity)
+        engine.destroyEntity(backgroundQuadEntity)
         EntityManager.get().destroy(backgroundQuadEntity)
+        backgroundQuadVertexBuffer?.let { engine.destroyVertexBuffer(it) }
+        backgroundQuadIndexBuffer?.let { engine.destroyIndexBuffer(it) }
 
         // Destroy all camera textures
         for (texture in cameraTextures) {
             texture?.let { engine.destroyTexture(it) }
         }
-
-        // Destroy EGL context
-        EGL14.eglDestroySurface(eglDisplay, eglSurface)
-        EGL14.eglDestroyContext(eglDisplay, eglContext)
-        EGL14.eglTerminate(eglDisplay)
-    }
-
-    private fun createEglContext() {
-        eglDisplay = EGL14.eglGetDisplay(EGL14.EGL_DEFAULT_DISPLAY)
-        if (eglDisplay == EGL14.EGL_NO_DISPLAY) {
-            throw RuntimeException("Unable to get EGL display")
-        }
-
-        val version = IntArray(2)
-        if (!EGL14.eglInitialize(eglDisplay, version, 0, version, 1)) {
-            throw RuntimeException("Unable to initialize EGL")
+        engine.destroyMaterialInstance(cameraMaterialInstance)
+
+        if (usesHardwareBuffer) {
+            // The engine may still have the EGLImages queued: let it finish before they go away
+            engine.flushAndWait()
+            HardwareBufferCamera.destroyImageCache(cameraImageCache)
+            cameraImageCache = 0L
+            return
         }
 
-        val configAttribs = intArrayOf(
-            EGL14.EGL_RENDERABLE_TYPE, EGL14.EGL_OPENGL_ES2_BIT,
-            EGL14.EGL_RED_SIZE, 8,
-            EGL14.EGL_GREEN_SIZE, 8,
-            EGL14.EGL_BLUE_SIZE, 8,
-            EGL14.EGL_ALPHA_SIZE, 8,
-            EGL14.EGL_DEPTH_SIZE, 16,
-            EGL14.EGL_NONE
-        )
-
-        val configs = arrayOfNulls<EGLConfig>(1)
-        val numConfigs = IntArray(1)
-        EGL14.eglChooseConfig(eglDisplay, configAttribs, 0, configs, 0, 1, numConfigs, 0)
-
-        if (numConfigs[0] == 0) {
-            throw RuntimeException("Unable to find suitable EGL config")
-        }
-
-        val contextAttribs = intArrayOf(
-            EGL14.EGL_CONTEXT_CLIENT_VERSION, 3,
-            EGL14.EGL_NONE
-        )
-
-        eglContext = EGL14.eglCreateContext(eglDisplay, configs[0], EGL14.EGL_NO_CONTEXT, contextAttribs, 0)
-        if (eglContext == EGL14.EGL_NO_CONTEXT) {
-            throw RuntimeException("Unable to create EGL context")
-        }
-
-        val surfaceAttribs = intArrayOf(
-            EGL14.EGL_WIDTH, 1,
-            EGL14.EGL_HEIGHT, 1,
-            EGL14.EGL_NONE
-        )
-        eglSurface = EGL14.eglCreatePbufferSurface(eglDisplay, configs[0], surfaceAttribs, 0)
-        if (eglSurface == EGL14.EGL_NO_SURFACE) {
-            throw RuntimeException("Unable to create EGL surface")
-        }
+        // The EGL context outlives this view: free the GL textures ARCore wrote into
+        makeEglContextCurrent()
+        GLES30.glDeleteTextures(cameraTextureIds.size, cameraTextureIds, 0)
     }
 
     private fun createExternalTextureId(): Int {
@@ -302,23 +297,31 @@ class CameraTextureRenderer(private val context: Context) {
             .bufferType(IndexBuffer.Builder.IndexType.USHORT)
             .build(engine)
         indexBuffer.setBuffer(engine, MatrixUtils.createShortBuffer(indices))
+        backgroundQuadIndexBuffer = indexBuffer
 
         // Create entity
         backgroundQuadEntity = EntityManager.get().create()
+        buildBackgroundRenderable(backgroundQuadEntity)
+        scene.addEntity(backgroundQuadEntity)
+    }
 
+    /**
+     * Build the fullscreen camera quad into [entity]. Every copy shares the geometry, UV transform
+     * and camera texture of the background, so views rendering the camera alone (the lighting
+     * probe) stay in step with it.
+     */
+    fun buildBackgroundRenderable(@Entity entity: Int) {
         // Bounding box for the fullscreen quad (prevents frustum culling)
         val boundingBox = Box(-1f, -1f, 0f, 1f, 1f, 0f)
 
         RenderableManager.Builder(1)
             .material(0, cameraMaterialInstance)
-            .geometry(0, RenderableManager.PrimitiveType.TRIANGLES, backgroundQuadVertexBuffer!!, indexBuffer)
+            .geometry(0, RenderableManager.PrimitiveType.TRIANGLES, backgroundQuadVertexBuffer!!, backgroundQuadIndexBuffer!!)
             .boundingBox(boundingBox)
             .culling(false)
             .receiveShadows(false)
             .castShadows(false)
-            .priority(7)
-            .build(engine, backgroundQuadEntity)
-
-        scene.addEntity(backgroundQuadEntity)
+            .priority(0)  // Render first (at the back): everything else then draws over it
+            .build(engine, entity)
     }
 }
@@ -1,79 +1,186 @@
 package com.margelo.nitro.nitrovto
 
-import android.content.Context
+import android.util.Log
+import com.google.android.filament.Camera
 import com.google.android.filament.Engine
 import com.google.android.filament.IndirectLight
+import com.google.android.filament.Renderer
 import com.google.android.filament.Scene
-import com.google.android.filament.Skybox
-import com.google.android.filament.utils.KTX1Loader
+import com.google.android.filament.Texture
 import com.google.ar.core.Frame
 import com.google.ar.core.LightEstimate
+import java.nio.ByteBuffer
 
 /**
  * Handles environment-based lighting (IBL) for AR rendering.
- * Loads skybox and indirect light from KTX files and updates
- * intensity based on ARCore light estimation.
+ * No skybox: the camera background covers the whole view. The reflections are those of a bundled
+ * environment, whose cubemap [FilamentContext] loads off the main thread and shares between
+ * views; until it arrives the scene is lit by spherical harmonics alone. The diffuse irradiance (third-order spherical harmonics) and the intensity follow
+ * ARCore: environmental HDR spherical harmonics where the session supports them, else a small
+ * GPU-downsampled render of the camera image ([CameraLightProbe]) with the ambient pixel
+ * intensity. Estimates are rate-limited and smoothed by the native LightEstimator; the indirect
+ * light is rebuilt only when the smoothed irradiance has visibly changed.
  */
-class EnvironmentLightingRenderer(private val context: Context) {
+class EnvironmentLightingRenderer {
 
     companion object {
         private const val TAG = "EnvironmentLighting"
-        // Intensity will range from 30_000 to 90_000 based on pixel intensity
-        // With a minimum of 30_000
-        private const val BASE_INTENSITY = 30_000f
-        private const val INTENSITY_FACTOR = 60_000f
     }
 
     private var indirectLight: IndirectLight? = null
-    private var skybox: Skybox? = null
+    // Owned by the FilamentContext; null until the first environment has loaded
+    private var iblTexture: Texture? = null
+    // Requested environment, and the one iblTexture belongs to: a reference is held on each, so
+    // the displayed cubemap can't be evicted while the requested one loads
+    private var environment: String? = null
+    private var displayedEnvironment: String? = null
+    private lateinit var filamentContext: FilamentContext
     private lateinit var engine: Engine
+    private lateinit var scene: Scene
+    private lateinit var camera: Camera
+    private lateinit var cameraTextureRenderer: CameraTextureRenderer
+
+    private val lightEstimator = LightEstimator()
+    // Created the first time a camera image estimate is due (never with environmental HDR)
+    private var cameraLightProbe: CameraLightProbe? = null
+    private var cameraImageDue = false
+    private var pixelIntensity = 0f
 
     /**
-     * Setup environment lighting with IBL from KTX files.
-     * @param engine Filament engine
+     * Setup environment lighting. Doesn't wait for the environment: the scene is lit by
+     * spherical harmonics until its reflections have loaded.
+     * @param filamentContext Shared context that loads the environments
      * @param scene Filament scene to apply lighting to
-     * @param iblPath Path to IBL KTX file in assets
-     * @param skyboxPath Path to skybox KTX file in assets
+     * @param camera Filament camera of the view, for the camera image estimates
+     * @param cameraTextureRenderer Camera background, rendered alone for the camera image estimates
+     * @param environment Name of the environment whose reflections to load
      */
     fun setup(
-        engine: Engine,
+        filamentContext: FilamentContext,
         scene: Scene,
-        iblPath: String = "envs/studio_small_02_ibl.ktx",
-        skyboxPath: String = "envs/studio_small_02_skybox.ktx"
+        camera: Camera,
+        cameraTextureRenderer: CameraTextureRenderer,
+        environment: String = FilamentContext.DEFAULT_ENVIRONMENT
     ) {
-        this.engine = engine
+        this.filamentContext = filamentContext
+        this.engine = filamentContext.engine
+        this.scene = scene
+        this.camera = camera
+        this.cameraTextureRenderer = cameraTextureRenderer
+
+        rebuildIndirectLight()
+        setEnvironment(environment)
+    }
 
-        // Load IBL (indirect light) from ktx file
-        val iblBuffer = LoaderUtils.loadAsset(context, iblPath)
-        val iblBundle = KTX1Loader.createIndirectLight(engine, iblBuffer)
-        indirectLight = iblBundle.indirectLight
-        indirectLight?.intensity = BASE_INTENSITY
-        scene.indirectLight = indirectLight
+    /**
+     * Switch the reflections to another bundled environment, loading it if no view has it yet.
+     * The current reflections stay until the new ones are ready; an unknown name keeps them.
+     */
+    fun setEnvironment(name: String) {
+        if (name == environment) return
+        if (!FilamentContext.isEnvironmentAvailable(name)) {
+            Log.w(TAG, "Unknown environment: $name")
+            return
+        }
+        val previous = environment
+        if (previous != null && previous != displayedEnvironment) {
+            filamentContext.releaseEnvironment(previous)
+        }
+        environment = name
+        if (name == displayedEnvironment) return
 
-        // Load skybox from ktx file
-        val skyBuffer = LoaderUtils.loadAsset(context, skyboxPath)
-        val skyboxBundle = KTX1Loader.createSkybox(engine, skyBuffer)
-        skybox = skyboxBundle.skybox
-        scene.skybox = skybox
+        filamentContext.acquireEnvironment(name) { cubemap ->
+            // Switched again or destroyed while loading
+            if (environment != name) return@acquireEnvironment
+            iblTexture = cubemap
+            rebuildIndirectLight()
+            displayedEnvironment?.let { filamentContext.releaseEnvironment(it) }
+            displayedEnvironment = name
+        }
     }
 
     /**
-     * Update lighting intensity based on ARCore light estimation.
+     * Update lighting from ARCore light estimation.
      * Should be called each frame with the current ARCore frame.
+     * @param environmentalHdr The session runs ENVIRONMENTAL_HDR rather than AMBIENT_INTENSITY
      */
-    fun updateFromARCore(frame: Frame) {
+    fun updateFromARCore(frame: Frame, environmentalHdr: Boolean) {
+        val timestamp = frame.timestamp
         val lightEstimate = frame.lightEstimate
         if (lightEstimate.state == LightEstimate.State.VALID) {
-            val pixelIntensity = lightEstimate.pixelIntensity
-            indirectLight?.intensity = BASE_INTENSITY + pixelIntensity * INTENSITY_FACTOR
+            if (environmentalHdr) {
+                // Each call copies the coefficients into a new array: only fetch the ones used
+                if (lightEstimator.wantsEstimate(timestamp)) {
+                    lightEstimator.addRadiance(lightEstimate.environmentalHdrAmbientSphericalHarmonics, timestamp)
+                }
+            } else {
+                pixelIntensity = lightEstimate.pixelIntensity
+                lightEstimator.addBrightness(pixelIntensity, timestamp)
+                cameraImageDue = lightEstimator.wantsEstimate(timestamp)
+            }
+        }
+
+        if (lightEstimator.update(timestamp)) {
+            rebuildIndirectLight()
         }
+        indirectLight?.intensity = lightEstimator.intensity
+    }
+
+    /**
+     * Render the camera probe if a camera image estimate is due.
+     * Call between beginFrame and endFrame, before the main view.
+     */
+    fun renderCameraProbe(renderer: Renderer, cameraMatrix: FloatArray, projection: FloatArray, timestampNanos: Long) {
+        if (!cameraImageDue) return
+        cameraImageDue = false
+        val probe = cameraLightProbe
+            ?: CameraLightProbe(engine, camera, cameraTextureRenderer, ::addCameraImage).also { cameraLightProbe = it }
+        probe.render(renderer, cameraMatrix, projection, timestampNanos)
+    }
+
+    private fun addCameraImage(
+        image: ByteBuffer,
+        width: Int,
+        height: Int,
+        cameraMatrix: FloatArray,
+        projection: FloatArray,
+        timestampNanos: Long
+    ) {
+        lightEstimator.addCameraImage(image, width, height, cameraMatrix, projection, pixelIntensity, timestampNanos)
+    }
+
+    /**
+     * IndirectLight irradiance can't be changed after it's built: build a new one around the same
+     * reflections cubemap (none until the environment has loaded)
+     */
+    private fun rebuildIndirectLight() {
+        val builder = IndirectLight.Builder()
+            .irradiance(VtoCore.SPHERICAL_HARMONICS_BANDS, lightEstimator.irradiance)
+            .intensity(lightEstimator.intensity)
+        iblTexture?.let { builder.reflections(it) }
+        val light = builder.build(engine)
+        scene.indirectLight = light
+        indirectLight?.let { engine.destroyIndirectLight(it) }
+        indirectLight = light
     }
 
     /**
      * Destroy all lighting resources.
      */
     fun destroy() {
+        cameraLightProbe?.destroy()
+        cameraLightProbe = null
+        lightEstimator.destroy()
         indirectLight?.let { engine.destroyIndirectLight(it) }
-        skybox?.let { engine.destroySkybox(it) }
+        indirectLight = null
+        // The cubemap is the context's, shared with other views
+        iblTexture = null
+        val requested = environment
+        if (requested != null && requested != displayedEnvironment) {
+            filamentContext.releaseEnvironment(requested)
+        }
+        displayedEnvironment?.let { filamentContext.releaseEnvironment(it) }
+        environment = null
+        displayedEnvironment = null
     }
 }
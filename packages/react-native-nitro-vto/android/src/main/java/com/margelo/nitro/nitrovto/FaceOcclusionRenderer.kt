@@ -11,55 +11,70 @@ import com.google.android.filament.Material
 import com.google.android.filament.MaterialInstance
 import com.google.android.filament.RenderableManager
 import com.google.android.filament.Scene
+import com.google.android.filament.SkinningBuffer
 import com.google.android.filament.VertexBuffer
-import com.google.ar.core.AugmentedFace
 import java.nio.FloatBuffer
-import java.nio.ShortBuffer
 
 /**
  * Renders ARCore face mesh to depth buffer only for face occlusion.
- * Face mesh renders first (priority 0), writes depth, then camera background
- * overwrites color (ignoring depth), then glasses render with depth test.
+ * The camera background draws first, then this depth-only occluder, then the glasses with
+ * depth test.
+ * Every tracked face gets a slot, and all slots are one skinned renderable and vertex buffer:
+ * each slot's low-poly face mesh and pair of back planes follow their own bones, and a hidden
+ * part gets a zero bone, so the whole occluder is a single draw that never leaves the scene
+ * while a face is tracked.
  */
 class FaceOcclusionRenderer(private val context: Context) {
 
     companion object {
         private const val TAG = "FaceOcclusionRenderer"
-        // ARCore face mesh has 468 vertices (fixed)
-        private const val VERTEX_COUNT = 468
-        // ARCore face mesh has 2694 triangle indices (898 triangles)
-        private const val INDEX_COUNT = 2694
+        // After the camera background (0) and before the glasses (default 4)
+        private const val OCCLUDER_PRIORITY = 1
+        // Overlay drawn after everything else
+        private const val OVERLAY_PRIORITY = 7
+        private val ZERO_BONE = FloatArray(16)
     }
 
     private lateinit var engine: Engine
     private lateinit var scene: Scene
     private lateinit var occlusionMaterial: Material
     private lateinit var occlusionMaterialInstance: MaterialInstance
+    // Positions of every face slot back to back, then the back plane quads, plus static bone
+    // indices/weights binding each part to its bone
     private var vertexBuffer: VertexBuffer? = null
+    // Low-poly face triangles and back planes, slot after slot
     private var indexBuffer: IndexBuffer? = null
     @Entity private var faceMeshEntity: Int = 0
     private var entityInScene = false
-    private var indexBufferInitialized = false
-
-    // Back clipping planes (split left/right for better occlusion based on head rotation)
-    private var backPlaneLeftVertexBuffer: VertexBuffer? = null
-    private var backPlaneRightVertexBuffer: VertexBuffer? = null
-    private var backPlaneIndexBuffer: IndexBuffer? = null  // Shared between both planes
-    @Entity private var backPlaneLeftEntity: Int = 0
-    @Entity private var backPlaneRightEntity: Int = 0
-    private var backPlaneLeftInScene = false
-    private var backPlaneRightInScene = false
-
-    /** Whether the left back plane is currently visible (based on head yaw) */
-    val isLeftBackPlaneVisible: Boolean get() = backPlaneLeftInScene
-
-    /** Whether the right back plane is currently visible (based on head yaw) */
-    val isRightBackPlaneVisible: Boolean get() = backPlaneRightInScene
-
-    // Reusable arrays to avoid per-frame allocations
-    private val vertexData = FloatArray(VERTEX_COUNT * 3)
-    private val tempMatrix16 = FloatArray(16)
+    // Face, left and right back plane bones of every slot (disabled parts collapsed)
+    private lateinit var skinningBuffer: SkinningBuffer
+    private var faceSlotCount = 1
+    // Faces covered by the draw range
+    private var drawnFaceCount = 0
+    private var slotIndexCount = 0
+
+    // Shared, immutable face topology (index buffer owned by VTORenderer)
+    private var topology: FaceTopology? = null
+    // Low-poly occluder triangles of the attached topology
+    private var occluderIndices: ShortArray? = null
+
+    // Second draw of the occluder geometry with its own material (debug visualization)
+    @Entity private var overlayEntity: Int = 0
+    private var overlayMaterialInstance: MaterialInstance? = null
+    private var overlayInScene = false
+    // The overlay's own bones: every part, whatever the occlusion settings
+    private lateinit var overlaySkinningBuffer: SkinningBuffer
+
+    // Reusable buffers to avoid per-frame allocations (vertex uploads recycle once Filament consumed them)
+    private var vertexData: FloatBufferPool? = null
     private val backPlaneMatrix16 = FloatArray(16)
+    private val meshBounds6 = FloatArray(6)
+    private val worldBounds6 = FloatArray(6)
+    private val meshBoundingBox = Box()
+    // Face, left and right back plane transform of each slot: the occluder's skinning bones
+    private val occluderBones = MatrixUtils.createFloatBuffer(16 * VtoCore.OCCLUDER_BONES_PER_FACE * VtoCore.MAX_TRACKED_FACES)
+    // The same with every part shown: the overlay's skinning bones
+    private val overlayBones = MatrixUtils.createFloatBuffer(16 * VtoCore.OCCLUDER_BONES_PER_FACE * VtoCore.MAX_TRACKED_FACES)
 
     // Occlusion settings (both enabled by default)
     private var faceMeshEnabled = true
@@ -68,17 +83,13 @@ class FaceOcclusionRenderer(private val context: Context) {
     /**
      * Setup the face occlusion renderer with Filament engine and scene.
      */
-    fun setup(engine: Engine, scene: Scene) {
-        this.engine = engine
+    fun setup(filamentContext: FilamentContext, scene: Scene) {
+        this.engine = filamentContext.engine
         this.scene = scene
 
-        // Load face occlusion material
+        // Face occlusion material, compiled once and owned by the shared context
         try {
-            val materialBuffer = LoaderUtils.loadAsset(context, "materials/face_occlusion.filamat")
-            Log.d(TAG, "Material buffer loaded, size: ${materialBuffer.remaining()}")
-            occlusionMaterial = Material.Builder()
-                .payload(materialBuffer, materialBuffer.remaining())
-                .build(engine)
+            occlusionMaterial = filamentContext.material("materials/face_occlusion.filamat")
             occlusionMaterialInstance = occlusionMaterial.createInstance()
             Log.d(TAG, "Material created successfully")
         } catch (e: Exception) {
@@ -87,30 +98,19 @@ class FaceOcclusionRenderer(private val context: Context) {
             throw e
         }
 
-        // Create dynamic vertex buffer for face mesh positions
-        vertexBuffer = VertexBuffer.Builder()
-            .vertexCount(VERTEX_COUNT)
-            .bufferCount(1)
-            .attribute(
-                VertexBuffer.VertexAttribute.POSITION,
-                0,
-                VertexBuffer.AttributeType.FLOAT3,
-                0,
-                12  // 3 floats * 4 bytes
-            )
-            .build(engine)
-
-        // Create index buffer (fixed topology for ARCore face mesh)
-        indexBuffer = IndexBuffer.Builder()
-            .indexCount(INDEX_COUNT)
-            .bufferType(IndexBuffer.Builder.IndexType.USHORT)
-            .build(engine)
-
-        // Create entity (but don't add to scene yet - wait for valid face data)
+        // Create entities (renderables are built once the face topology is known)
         faceMeshEntity = EntityManager.get().create()
+        overlayEntity = EntityManager.get().create()
 
-        // Create back clipping plane
-        createBackPlane()
+        // Bones for the most slots, set once per frame
+        skinningBuffer = SkinningBuffer.Builder()
+            .boneCount(VtoCore.OCCLUDER_BONES_PER_FACE * VtoCore.MAX_TRACKED_FACES)
+            .initialize(true)
+            .build(engine)
+        overlaySkinningBuffer = SkinningBuffer.Builder()
+            .boneCount(VtoCore.OCCLUDER_BONES_PER_FACE * VtoCore.MAX_TRACKED_FACES)
+            .initialize(true)
+            .build(engine)
 
         Log.d(TAG, "Face occlusion renderer setup complete")
     }
@@ -119,13 +119,9 @@ class FaceOcclusionRenderer(private val context: Context) {
      * Set face mesh occlusion enabled.
      */
     fun setFaceMeshOcclusion(enabled: Boolean) {
-        // If face mesh is being disabled, remove from scene
-        if (faceMeshEnabled && !enabled && entityInScene) {
-            scene.removeEntity(faceMeshEntity)
-            entityInScene = false
-        }
-
+        // The face bones collapse with the next update; with nothing left to occlude, leave the scene now
         faceMeshEnabled = enabled
+        if (!faceMeshEnabled && !backPlaneEnabled) hideOccluder()
         Log.d(TAG, "Face mesh occlusion updated: $enabled")
     }
 
@@ -133,297 +129,320 @@ class FaceOcclusionRenderer(private val context: Context) {
      * Set back plane occlusion enabled.
      */
     fun setBackPlaneOcclusion(enabled: Boolean) {
-        // If back planes are being disabled, remove from scene
-        if (backPlaneEnabled && !enabled) {
-            if (backPlaneLeftInScene) {
-                scene.removeEntity(backPlaneLeftEntity)
-                backPlaneLeftInScene = false
-            }
-            if (backPlaneRightInScene) {
-                scene.removeEntity(backPlaneRightEntity)
-                backPlaneRightInScene = false
-            }
-        }
-
         backPlaneEnabled = enabled
+        if (!faceMeshEnabled && !backPlaneEnabled) hideOccluder()
         Log.d(TAG, "Back plane occlusion updated: $enabled")
     }
 
     /**
-     * Create back clipping planes (split left/right) to occlude glasses behind the head.
+     * Number of face slots, clamped to [1, [VtoCore.MAX_TRACKED_FACES]] (default 1).
      */
-    private fun createBackPlane() {
-        val planeSizeX = 0.12f  // 12cm half-width for each plane
-        val planeSizeY = 0.08f  // 8cm half-height (16cm total)
-        val gap = 0.01f  // Small gap between planes at center
-
-        // Left back plane (user's left side, camera's right side)
-        // X range: -planeSizeX to -gap
-        val leftVertices = floatArrayOf(
-            -planeSizeX, -planeSizeY, 0f,  // bottom-left
-            -gap,        -planeSizeY, 0f,  // bottom-right
-            -planeSizeX,  planeSizeY, 0f,  // top-left
-            -gap,         planeSizeY, 0f   // top-right
-        )
+    fun setMaxFaces(maxFaces: Int) {
+        val slotCount = maxFaces.coerceIn(1, VtoCore.MAX_TRACKED_FACES)
+        if (slotCount == faceSlotCount) return
+        faceSlotCount = slotCount
+        if (!::engine.isInitialized) return
+
+        // Rebuilt for the new slot count
+        topology?.let { attachTopology(it) }
+        Log.d(TAG, "Face slots updated: $slotCount")
+    }
 
-        // Right back plane (user's right side, camera's left side)
-        // X range: gap to planeSizeX
-        val rightVertices = floatArrayOf(
-            gap,        -planeSizeY, 0f,  // bottom-left
-            planeSizeX, -planeSizeY, 0f,  // bottom-right
-            gap,         planeSizeY, 0f,  // top-left
-            planeSizeX,  planeSizeY, 0f   // top-right
-        )
+    /**
+     * Draw the occluder a second time with this material, over the same buffers (one extra draw
+     * call), or stop with null. The overlay has its own bones: it shows the face and back planes
+     * even where their occlusion is disabled. The caller owns the instance.
+     */
+    fun setOverlayMaterialInstance(materialInstance: MaterialInstance?) {
+        if (materialInstance === overlayMaterialInstance) return
+        overlayMaterialInstance = materialInstance
+        if (!::engine.isInitialized) return
+
+        if (overlayInScene) {
+            scene.removeEntity(overlayEntity)
+            overlayInScene = false
+        }
+        engine.renderableManager.destroy(overlayEntity)
+        // Added back with the next tracked face
+        if (materialInstance != null && topology != null) {
+            buildRenderable(overlayEntity, materialInstance, overlaySkinningBuffer, OVERLAY_PRIORITY)
+        }
+    }
+
+    /**
+     * Low-poly occluder triangles of a topology, from the mesh of one tracked face.
+     */
+    private fun decimateTopology(topology: FaceTopology, vertices: FloatBuffer) {
+        val indices = VtoCore.decimateFaceIndices(vertices, topology.vertexCount, topology.indices)
+        occluderIndices = indices
+        Log.d(TAG, "Occluder mesh: ${indices.size / 3} of ${topology.indexCount / 3} triangles")
+    }
 
-        // Create vertex buffers for each plane
-        backPlaneLeftVertexBuffer = VertexBuffer.Builder()
-            .vertexCount(4)
-            .bufferCount(1)
+    /**
+     * Build the occluder vertex buffer, index buffer and renderable for a face topology and the slot count.
+     * Only face positions are streamed per frame.
+     */
+    private fun attachTopology(topology: FaceTopology) {
+        hide()
+        engine.renderableManager.destroy(faceMeshEntity)
+        engine.renderableManager.destroy(overlayEntity)
+        vertexBuffer?.let { engine.destroyVertexBuffer(it) }
+        vertexBuffer = null
+        indexBuffer?.let { engine.destroyIndexBuffer(it) }
+        indexBuffer = null
+        this.topology = null
+
+        val faceIndices = occluderIndices ?: return
+        val slotCount = faceSlotCount
+        val vertexCount = topology.vertexCount
+        val totalVertices = (vertexCount + VtoCore.OCCLUDER_BACK_PLANE_VERTICES) * slotCount
+
+        // One index buffer for every slot: its low-poly face, offset to its vertices, then its back planes
+        val indices = VtoCore.buildOccluderIndices(faceIndices, vertexCount, slotCount) ?: return
+        val indexBuffer = IndexBuffer.Builder()
+            .indexCount(indices.size)
+            .bufferType(IndexBuffer.Builder.IndexType.USHORT)
+            .build(engine)
+        indexBuffer.setBuffer(engine, MatrixUtils.createShortBuffer(indices))
+        this.indexBuffer = indexBuffer
+        slotIndexCount = faceIndices.size + VtoCore.OCCLUDER_BACK_PLANE_INDICES
+
+        // Create dynamic vertex buffer for face mesh positions, and the static bone bindings
+        val vertexBuffer = VertexBuffer.Builder()
+            .vertexCount(totalVertices)
+            .bufferCount(3)
             .attribute(
                 VertexBuffer.VertexAttribute.POSITION,
                 0,
                 VertexBuffer.AttributeType.FLOAT3,
                 0,
-                12
+                12  // 3 floats * 4 bytes
             )
-            .build(engine)
-        backPlaneLeftVertexBuffer!!.setBufferAt(engine, 0, MatrixUtils.createFloatBuffer(leftVertices))
-
-        backPlaneRightVertexBuffer = VertexBuffer.Builder()
-            .vertexCount(4)
-            .bufferCount(1)
             .attribute(
-                VertexBuffer.VertexAttribute.POSITION,
+                VertexBuffer.VertexAttribute.BONE_INDICES,
+                1,
+                VertexBuffer.AttributeType.USHORT4,
                 0,
-                VertexBuffer.AttributeType.FLOAT3,
+                8  // 4 shorts * 2 bytes
+            )
+            .attribute(
+                VertexBuffer.VertexAttribute.BONE_WEIGHTS,
+                2,
+                VertexBuffer.AttributeType.FLOAT4,
                 0,
-                12
+                16  // 4 floats * 4 bytes
             )
             .build(engine)
-        backPlaneRightVertexBuffer!!.setBufferAt(engine, 0, MatrixUtils.createFloatBuffer(rightVertices))
+        this.vertexBuffer = vertexBuffer
+        vertexData = FloatBufferPool(vertexCount * 3, 3 * slotCount)
 
-        // Shared index buffer (same topology for both planes)
-        val indices = shortArrayOf(0, 1, 2, 2, 1, 3)
-        backPlaneIndexBuffer = IndexBuffer.Builder()
-            .indexCount(6)
-            .bufferType(IndexBuffer.Builder.IndexType.USHORT)
-            .build(engine)
-        backPlaneIndexBuffer!!.setBuffer(engine, MatrixUtils.createShortBuffer(indices))
+        // The back plane quads follow the faces once: only the faces stream in every frame
+        val backPlanes = VtoCore.occluderBackPlaneVertices(slotCount)
+        vertexBuffer.setBufferAt(engine, 0, MatrixUtils.createFloatBuffer(backPlanes), vertexCount * slotCount * 12, 0)
 
-        // Create entities
-        backPlaneLeftEntity = EntityManager.get().create()
-        backPlaneRightEntity = EntityManager.get().create()
+        // Each part follows its own bone, fully weighted
+        val boneWeights = FloatArray(totalVertices * 4)
+        for (vertex in 0 until totalVertices) {
+            boneWeights[vertex * 4] = 1f
+        }
+        vertexBuffer.setBufferAt(engine, 1, MatrixUtils.createShortBuffer(VtoCore.occluderBoneIndices(vertexCount, slotCount)))
+        vertexBuffer.setBufferAt(engine, 2, MatrixUtils.createFloatBuffer(boneWeights))
 
-        val boundingBox = Box(0f, 0f, 0f, planeSizeX, planeSizeY, 0.1f)
+        drawnFaceCount = slotCount
+        this.topology = topology
 
-        // Build left back plane renderable
-        RenderableManager.Builder(1)
-            .geometry(
-                0,
-                RenderableManager.PrimitiveType.TRIANGLES,
-                backPlaneLeftVertexBuffer!!,
-                backPlaneIndexBuffer!!,
-                0,
-                6
-            )
-            .material(0, occlusionMaterialInstance)
-            .boundingBox(boundingBox)
-            .culling(false)
-            .receiveShadows(false)
-            .castShadows(false)
-            .priority(0)
-            .build(engine, backPlaneLeftEntity)
+        // Depth only (the material writes no color), after the camera background and before the
+        // glasses, which are depth tested against it
+        buildRenderable(faceMeshEntity, occlusionMaterialInstance, skinningBuffer, OCCLUDER_PRIORITY)
+        overlayMaterialInstance?.let { buildRenderable(overlayEntity, it, overlaySkinningBuffer, OVERLAY_PRIORITY) }
+    }
+
+    /**
+     * A renderable over the occluder buffers, drawing the attached slots with the given bones.
+     */
+    private fun buildRenderable(
+        @Entity entity: Int,
+        materialInstance: MaterialInstance,
+        bones: SkinningBuffer,
+        priority: Int
+    ) {
+        // Create bounding box (approximate head size)
+        val boundingBox = Box(0f, 0f, 0f, 0.15f, 0.15f, 0.15f)
 
-        // Build right back plane renderable
         RenderableManager.Builder(1)
             .geometry(
                 0,
                 RenderableManager.PrimitiveType.TRIANGLES,
-                backPlaneRightVertexBuffer!!,
-                backPlaneIndexBuffer!!,
+                vertexBuffer!!,
+                indexBuffer!!,
                 0,
-                6
+                slotIndexCount * drawnFaceCount
             )
-            .material(0, occlusionMaterialInstance)
+            .material(0, materialInstance)
+            .skinning(bones, VtoCore.OCCLUDER_BONES_PER_FACE * faceSlotCount, 0)
             .boundingBox(boundingBox)
             .culling(false)
             .receiveShadows(false)
             .castShadows(false)
-            .priority(0)
-            .build(engine, backPlaneRightEntity)
+            .priority(priority)
+            .build(engine, entity)
     }
 
     /**
-     * Update face mesh geometry from ARCore face data.
+     * Update face mesh geometry from ARCore face data (at most maxFaces faces are drawn).
+     * @param faceCount Number of tracked faces
+     * @param faceMatrices Face center poses (column-major), one per face
+     * @param meshVertices ARCore face mesh vertices, in face space, one per face
+     * @param topology Cached face topology matching [meshVertices]
      */
-    fun update(face: AugmentedFace) {
-        if (vertexBuffer == null || indexBuffer == null) return
-
-        // Get face mesh vertices (in face-local coordinates)
-        val meshVertices = face.meshVertices
-        val meshIndices = face.meshTriangleIndices
+    fun update(
+        faceCount: Int,
+        faceMatrices: Array<FloatArray>,
+        meshVertices: Array<FloatBuffer?>,
+        topology: FaceTopology
+    ) {
+        if (topology !== this.topology) {
+            val vertices = meshVertices.firstOrNull() ?: return
+            decimateTopology(topology, vertices)
+            attachTopology(topology)
+        }
+        // With nothing to occlude, only the overlay still follows the faces
+        val occluding = faceMeshEnabled || backPlaneEnabled
+        val overlay = overlayMaterialInstance != null
+        if (!occluding && !overlay) return
+        val vertexBuffer = vertexBuffer ?: return
+        val pool = vertexData ?: return
+
+        val count = minOf(faceCount, faceSlotCount)
+        val slotBytes = topology.vertexCount * 12
+        var drawn = 0
+        for (index in 0 until count) {
+            val faceMatrix = faceMatrices[index]
+            val vertices = meshVertices[index] ?: continue
+
+            // Pack vertices (kept in face-local coordinates) and place back planes in native code
+            // (placed even when disabled: the overlay still shows them)
+            val entry = pool.acquire()
+            val backPlaneMask = VtoCore.packFaceMesh(
+                vertices, topology.vertexCount, entry.buffer,
+                faceMatrix, true, backPlaneMatrix16, meshBounds6
+            )
+            if (backPlaneMask < 0) {
+                pool.release(entry)
+                continue
+            }
 
-        // Validate mesh data
-        if (meshVertices.remaining() < VERTEX_COUNT * 3) {
-            Log.w(TAG, "Invalid mesh vertices count: ${meshVertices.remaining()}")
-            return
+            // Update the slot's range of the vertex buffer; its face bone moves it to the face pose
+            pool.upload(engine, vertexBuffer, entry, drawn * slotBytes)
+            occluderBones.position(drawn * VtoCore.OCCLUDER_BONES_PER_FACE * 16)
+            overlayBones.position(drawn * VtoCore.OCCLUDER_BONES_PER_FACE * 16)
+            occluderBones.put(if (faceMeshEnabled) faceMatrix else ZERO_BONE)
+            overlayBones.put(faceMatrix)
+            VtoCore.accumulateWorldBounds(faceMatrix, meshBounds6, worldBounds6, drawn == 0)
+
+            // Back planes sit behind the face; each side is hidden when its temple turns towards
+            // the camera (a zero bone collapses it), and in the occluder when back planes are disabled
+            val leftBackPlane = if ((backPlaneMask and VtoCore.BACK_PLANE_LEFT) != 0) backPlaneMatrix16 else ZERO_BONE
+            val rightBackPlane = if ((backPlaneMask and VtoCore.BACK_PLANE_RIGHT) != 0) backPlaneMatrix16 else ZERO_BONE
+            occluderBones.put(if (backPlaneEnabled) leftBackPlane else ZERO_BONE)
+            occluderBones.put(if (backPlaneEnabled) rightBackPlane else ZERO_BONE)
+            overlayBones.put(leftBackPlane)
+            overlayBones.put(rightBackPlane)
+            drawn++
         }
-        if (meshIndices.remaining() < INDEX_COUNT) {
-            Log.w(TAG, "Invalid mesh indices count: ${meshIndices.remaining()}")
+        if (drawn == 0) {
+            hide()
             return
         }
 
-        // Copy vertices directly (keep in face-local coordinates)
-        for (i in 0 until VERTEX_COUNT) {
-            vertexData[i * 3] = meshVertices.get(i * 3)
-            vertexData[i * 3 + 1] = meshVertices.get(i * 3 + 1)
-            vertexData[i * 3 + 2] = meshVertices.get(i * 3 + 2)
+        val boneCount = VtoCore.OCCLUDER_BONES_PER_FACE * drawn
+        if (occluding) {
+            occluderBones.rewind()
+            skinningBuffer.setBonesAsMatrices(engine, occluderBones, boneCount, 0)
         }
-
-        // Update vertex buffer
-        vertexBuffer!!.setBufferAt(engine, 0, MatrixUtils.createFloatBuffer(vertexData))
-
-        // Initialize index buffer only once (topology doesn't change)
-        if (!indexBufferInitialized) {
-            val indices = ShortArray(INDEX_COUNT)
-            for (i in 0 until INDEX_COUNT) {
-                indices[i] = meshIndices.get(i)
-            }
-            indexBuffer!!.setBuffer(engine, MatrixUtils.createShortBuffer(indices))
-            indexBufferInitialized = true
+        if (overlay) {
+            overlayBones.rewind()
+            overlaySkinningBuffer.setBonesAsMatrices(engine, overlayBones, boneCount, 0)
         }
 
-        // Create renderable if entity not in scene yet (only if face mesh is enabled)
-        if (!entityInScene && faceMeshEnabled) {
-            // Create bounding box (approximate head size)
-            val boundingBox = Box(0f, 0f, 0f, 0.15f, 0.15f, 0.15f)
-
-            RenderableManager.Builder(1)
-                .geometry(
-                    0,
-                    RenderableManager.PrimitiveType.TRIANGLES,
-                    vertexBuffer!!,
-                    indexBuffer!!,
-                    0,
-                    INDEX_COUNT
-                )
-                .material(0, occlusionMaterialInstance)
-                .boundingBox(boundingBox)
-                .culling(false)
-                .receiveShadows(false)
-                .castShadows(false)
-                .priority(0)  // Render FIRST to write depth
-                .build(engine, faceMeshEntity)
+        // Tight world-space bounds around the faces (the renderables themselves keep an identity transform)
+        meshBoundingBox.setCenter(
+            (worldBounds6[0] + worldBounds6[3]) * 0.5f,
+            (worldBounds6[1] + worldBounds6[4]) * 0.5f,
+            (worldBounds6[2] + worldBounds6[5]) * 0.5f
+        )
+        meshBoundingBox.setHalfExtent(
+            (worldBounds6[3] - worldBounds6[0]) * 0.5f,
+            (worldBounds6[4] - worldBounds6[1]) * 0.5f,
+            (worldBounds6[5] - worldBounds6[2]) * 0.5f
+        )
+
+        // Draw only the slots holding a face this frame
+        updateRenderable(faceMeshEntity, drawn)
+        if (overlay) updateRenderable(overlayEntity, drawn)
+        drawnFaceCount = drawn
 
+        // Add the occluder and overlay to the scene if not already there
+        if (occluding && !entityInScene) {
             scene.addEntity(faceMeshEntity)
             entityInScene = true
             Log.d(TAG, "Face mesh entity added to scene")
         }
-
-        // Calculate min Z (furthest from camera in face local space)
-        var minZ = Float.MAX_VALUE
-        for (i in 0 until VERTEX_COUNT) {
-            val z = vertexData[i * 3 + 2]
-            if (z < minZ) minZ = z
-        }
-
-        // Apply face pose transform to entity (transforms local vertices to world space)
-        face.centerPose.toMatrix(tempMatrix16, 0)
-        val faceInstance = engine.transformManager.getInstance(faceMeshEntity)
-        engine.transformManager.setTransform(faceInstance, tempMatrix16)
-
-        // Position back planes behind the face
-        val zOffset = minZ + 0.03f  // 3cm behind the furthest face point
-        // Copy face transform and add offset along local Z axis
-        tempMatrix16.copyInto(backPlaneMatrix16)
-        // Apply local Z offset (multiply by rotation part of matrix)
-        val offsetX = backPlaneMatrix16[8] * zOffset   // column 2, row 0
-        val offsetY = backPlaneMatrix16[9] * zOffset   // column 2, row 1
-        val offsetZ = backPlaneMatrix16[10] * zOffset  // column 2, row 2
-        backPlaneMatrix16[12] += offsetX  // translation X
-        backPlaneMatrix16[13] += offsetY  // translation Y
-        backPlaneMatrix16[14] += offsetZ  // translation Z
-
-        // Position both back planes with the same transform
-        val backPlaneLeftInstance = engine.transformManager.getInstance(backPlaneLeftEntity)
-        val backPlaneRightInstance = engine.transformManager.getInstance(backPlaneRightEntity)
-        engine.transformManager.setTransform(backPlaneLeftInstance, backPlaneMatrix16)
-        engine.transformManager.setTransform(backPlaneRightInstance, backPlaneMatrix16)
-
-        // Extract yaw (Y-axis rotation) from face transform to determine head rotation
-        // For column-major matrix: yaw = atan2(m[8], m[0]) which is atan2(m[2][0], m[0][0])
-        // Positive yaw = head turning left (user's perspective), negative = turning right
-        val yaw = kotlin.math.atan2(tempMatrix16[8], tempMatrix16[0])
-
-        // Threshold for when to hide a back plane (~7 degrees)
-        val yawThreshold = 0.12f  // ~7 degrees in radians
-
-        // Determine which back planes should be visible based on head rotation
-        // When turning right (negative yaw): left temple visible, hide left back plane
-        // When turning left (positive yaw): right temple visible, hide right back plane
-        val showLeftBackPlane = backPlaneEnabled && (yaw < yawThreshold)
-        val showRightBackPlane = backPlaneEnabled && (yaw > -yawThreshold)
-
-        // Update left back plane visibility
-        if (showLeftBackPlane && !backPlaneLeftInScene) {
-            scene.addEntity(backPlaneLeftEntity)
-            backPlaneLeftInScene = true
-        } else if (!showLeftBackPlane && backPlaneLeftInScene) {
-            scene.removeEntity(backPlaneLeftEntity)
-            backPlaneLeftInScene = false
+        if (overlay && !overlayInScene) {
+            scene.addEntity(overlayEntity)
+            overlayInScene = true
         }
+    }
 
-        // Update right back plane visibility
-        if (showRightBackPlane && !backPlaneRightInScene) {
-            scene.addEntity(backPlaneRightEntity)
-            backPlaneRightInScene = true
-        } else if (!showRightBackPlane && backPlaneRightInScene) {
-            scene.removeEntity(backPlaneRightEntity)
-            backPlaneRightInScene = false
+    private fun updateRenderable(@Entity entity: Int, drawn: Int) {
+        val renderableManager = engine.renderableManager
+        val instance = renderableManager.getInstance(entity)
+        if (drawn != drawnFaceCount) {
+            renderableManager.setGeometryAt(
+                instance, 0, RenderableManager.PrimitiveType.TRIANGLES,
+                vertexBuffer!!, indexBuffer!!, 0, slotIndexCount * drawn
+            )
         }
+        renderableManager.setAxisAlignedBoundingBox(instance, meshBoundingBox)
     }
 
     /**
      * Hide face mesh and back planes (remove from scene).
      */
     fun hide() {
+        hideOccluder()
+        if (overlayInScene) {
+            scene.removeEntity(overlayEntity)
+            overlayInScene = false
+        }
+    }
+
+    /**
+     * Remove the occluder alone from the scene (the overlay is independent of the occlusion settings).
+     */
+    private fun hideOccluder() {
         if (entityInScene) {
             scene.removeEntity(faceMeshEntity)
             entityInScene = false
         }
-        if (backPlaneLeftInScene) {
-            scene.removeEntity(backPlaneLeftEntity)
-            backPlaneLeftInScene = false
-        }
-        if (backPlaneRightInScene) {
-            scene.removeEntity(backPlaneRightEntity)
-            backPlaneRightInScene = false
-        }
     }
 
     /**
      * Clean up resources.
      */
     fun destroy() {
-        if (entityInScene) {
-            scene.removeEntity(faceMeshEntity)
-        }
-        if (backPlaneLeftInScene) {
-            scene.removeEntity(backPlaneLeftEntity)
-        }
-        if (backPlaneRightInScene) {
-            scene.removeEntity(backPlaneRightEntity)
-        }
+        hide()
+        // Renderable components live in the shared engine, so destroy them with the entities
+        engine.destroyEntity(faceMeshEntity)
+        engine.destroyEntity(overlayEntity)
         EntityManager.get().destroy(faceMeshEntity)
-        EntityManager.get().destroy(backPlaneLeftEntity)
-        EntityManager.get().destroy(backPlaneRightEntity)
+        EntityManager.get().destroy(overlayEntity)
+        overlayMaterialInstance = null
 
         vertexBuffer?.let { engine.destroyVertexBuffer(it) }
         indexBuffer?.let { engine.destroyIndexBuffer(it) }
-        backPlaneLeftVertexBuffer?.let { engine.destroyVertexBuffer(it) }
-        backPlaneRightVertexBuffer?.let { engine.destroyVertexBuffer(it) }
-        backPlaneIndexBuffer?.let { engine.destroyIndexBuffer(it) }
+        engine.destroySkinningBuffer(skinningBuffer)
+        engine.destroySkinningBuffer(overlaySkinningBuffer)
         engine.destroyMaterialInstance(occlusionMaterialInstance)
-        engine.destroyMaterial(occlusionMaterial)
     }
 }
@@ -0,0 +1,73 @@
+package com.margelo.nitro.nitrovto
+
+import android.util.Log
+import com.google.android.filament.Engine
+import com.google.android.filament.IndexBuffer
+import com.google.ar.core.AugmentedFace
+import java.nio.FloatBuffer
+
+/**
+ * Immutable ARCore face mesh topology (triangle indices, UVs, vertex count).
+ * Built once per session from the first tracked face and shared by FaceOcclusionRenderer
+ * and DebugRenderer, so each frame only streams vertex positions.
+ */
+class FaceTopology private constructor(
+    val vertexCount: Int,
+    val indexCount: Int,
+    /** Shared index buffer, uploaded once */
+    val indexBuffer: IndexBuffer,
+    /** Triangle indices, for renderers that batch several faces */
+    val indices: ShortArray,
+    /** Per-vertex UVs (2 floats per vertex) */
+    val textureCoordinates: FloatBuffer
+) {
+
+    companion object {
+        private const val TAG = "FaceTopology"
+
+        /**
+         * Build the topology from an ARCore face, or null if the mesh data is invalid.
+         */
+        fun create(engine: Engine, face: AugmentedFace): FaceTopology? {
+            val meshVertices = face.meshVertices
+            val meshIndices = face.meshTriangleIndices
+            val meshUvs = face.meshTextureCoordinates
+
+            val vertexCount = meshVertices.limit() / 3
+            val indexCount = meshIndices.limit()
+            if (vertexCount == 0 || indexCount == 0 || indexCount % 3 != 0) {
+                Log.w(TAG, "Invalid face mesh: $vertexCount vertices, $indexCount indices")
+                return null
+            }
+
+            val indices = ShortArray(indexCount)
+            meshIndices.duplicate().apply { rewind() }.get(indices)
+            val indexBuffer = IndexBuffer.Builder()
+                .indexCount(indexCount)
+                .bufferType(IndexBuffer.Builder.IndexType.USHORT)
+                .build(engine)
+            indexBuffer.setBuffer(engine, MatrixUtils.createShortBuffer(indices))
+
+            val uvs = MatrixUtils.createFloatBuffer(vertexCount * 2)
+            val uvSource = meshUvs.duplicate().apply { rewind() }
+            if (uvSource.remaining() >= vertexCount * 2) {
+                uvSource.limit(vertexCount * 2)
+                uvs.put(uvSource)
+            }
+            uvs.flip()
+
+            Log.d(TAG, "Face topology cached: $vertexCount vertices, $indexCount indices")
+            return FaceTopology(vertexCount, indexCount, indexBuffer, indices, uvs)
+        }
+    }
+
+    /**
+     * Whether a face's mesh vertices still fit this topology. ARCore's face mesh has a fixed
+     * triangle list for a given vertex count, so only the (allocation-free) vertex count is compared.
+     */
+    fun matches(meshVertices: FloatBuffer): Boolean = meshVertices.limit() / 3 == vertexCount
+
+    fun destroy(engine: Engine) {
+        engine.destroyIndexBuffer(indexBuffer)
+    }
+}
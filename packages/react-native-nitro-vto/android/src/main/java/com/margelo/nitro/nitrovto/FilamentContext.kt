@@ -0,0 +1,406 @@
+package com.margelo.nitro.nitrovto
+
+import android.content.Context
+import android.opengl.EGL14
+import android.opengl.EGLConfig
+import android.opengl.EGLContext
+import android.opengl.EGLDisplay
+import android.opengl.EGLSurface
+import android.os.Handler
+import android.os.Looper
+import android.os.SystemClock
+import android.util.Log
+import com.google.android.filament.Engine
+import com.google.android.filament.Material
+import com.google.android.filament.Texture
+import com.google.android.filament.gltfio.Gltfio
+import com.google.android.filament.gltfio.UbershaderProvider
+import com.google.android.filament.utils.KTX1Loader
+import com.google.android.filament.utils.Utils
+import java.nio.ByteBuffer
+import java.util.concurrent.Executors
+
+/**
+ * Process-wide Filament state shared by every VTO view: the engine, the glTF ubershader
+ * provider, the package's compiled materials and the environment reflection cubemaps. Camera frames reach Filament either as
+ * hardware buffers ([hardwareBufferCamera]) or through an EGL context ARCore writes camera
+ * textures into, shared with the engine.
+ * Reference counted; when the last view lets go it lingers for a grace period,
+ * so remounting a view skips engine startup and shader compilation.
+ * Main thread only, like the rest of the renderer.
+ */
+class FilamentContext private constructor(context: Context) {
+
+    companion object {
+        private const val TAG = "FilamentContext"
+
+        // How long the context outlives its last view (covers navigating away and back)
+        private const val TEARDOWN_DELAY_MS = 30_000L
+
+        // Scenes are lit by IBL only (no directional or dynamic lights, shadows or fog), so the base
+        // variants are the only ones ever drawn, plus skinning for the face occluder and its overlay
+        private const val WARM_UP_VARIANTS = 0
+        private const val SKINNING_VARIANT = 0x08  // UserVariantFilterBit.SKINNING
+
+        // Materials the renderers use, compiled by warmUpMaterials()
+        private val BUNDLED_MATERIALS = listOf(
+            "materials/camera_background.filamat",
+            "materials/face_occlusion.filamat",
+            "materials/debug_face_material.filamat"
+        )
+        private val SKINNED_MATERIALS = setOf(
+            "materials/face_occlusion.filamat",
+            "materials/debug_face_material.filamat"
+        )
+
+        // Selectable environments and their reflection cubemaps (prefiltered IBL KTX) in assets
+        private val ENVIRONMENTS = mapOf(
+            "studio" to "envs/studio_small_02_ibl.ktx",
+            "brownPhotostudio" to "envs/brown_photostudio_01_ibl.ktx",
+            "neonPhotostudio" to "envs/neon_photostudio_ibl.ktx"
+        )
+        const val DEFAULT_ENVIRONMENT = "studio"
+
+        fun isEnvironmentAvailable(name: String): Boolean = ENVIRONMENTS.containsKey(name)
+
+        init {
+            Utils.init()
+            Gltfio.init()
+        }
+
+        private var shared: FilamentContext? = null
+        private val mainHandler = Handler(Looper.getMainLooper())
+
+        // Set once ARCore rejects the hardware buffer camera config on this device
+        private var hardwareBufferCameraDisabled = false
+
+        /**
+         * Whether a context created now would take camera frames as hardware buffers.
+         * The ARCore session must be configured to match, before the view's renderer acquires the context.
+         */
+        fun hardwareBufferCameraAvailable(): Boolean =
+            !hardwareBufferCameraDisabled && HardwareBufferCamera.isAvailable()
+
+        /**
+         * Fall back to camera textures in a shared EGL context, after ARCore rejected hardware buffers.
+         * A hardware buffer context is no longer handed out; views using it keep it until they release it.
+         */
+        fun disableHardwareBufferCamera() {
+            if (hardwareBufferCameraDisabled) return
+            hardwareBufferCameraDisabled = true
+            Log.w(TAG, "Hardware buffer camera unsupported, using shared EGL context camera textures")
+
+            val filamentContext = shared ?: return
+            if (!filamentContext.hardwareBufferCamera) return
+            shared = null
+            if (filamentContext.refCount == 0) {
+                mainHandler.removeCallbacks(filamentContext.teardown)
+                filamentContext.destroy()
+            }
+        }
+
+        /**
+         * Take a reference to the shared context, creating it if needed.
+         */
+        fun acquire(context: Context): FilamentContext {
+            val filamentContext = shared ?: FilamentContext(context.applicationContext).also { shared = it }
+            filamentContext.refCount++
+            mainHandler.removeCallbacks(filamentContext.teardown)
+            return filamentContext
+        }
+
+        /**
+         * Create the shared context ahead of the first view, e.g. in Application.onCreate,
+         * and compile the bundled materials' shader variants. It lingers for the grace period.
+         */
+        fun warmUp(context: Context) {
+            val filamentContext = acquire(context)
+            filamentContext.warmUpMaterials()
+            filamentContext.release()
+        }
+    }
+
+    private val appContext = context
+
+    /**
+     * Camera frames are imported as hardware buffers: no EGL context of our own, so none to share
+     * with the engine or make current every frame
+     */
+    val hardwareBufferCamera = hardwareBufferCameraAvailable()
+
+    // EGL context for ARCore, shared with Filament (camera texture path only)
+    private var eglDisplay: EGLDisplay = EGL14.EGL_NO_DISPLAY
+    private var eglContext: EGLContext = EGL14.EGL_NO_CONTEXT
+    private var eglSurface: EGLSurface = EGL14.EGL_NO_SURFACE
+
+    val engine: Engine
+    val materialProvider: UbershaderProvider
+    private val materials = HashMap<String, Material>()
+    private val compiledMaterials = HashSet<Material>()
+
+    /**
+     * Reflections cubemap of one environment, loaded once for every view showing it.
+     * Unused ones are kept until another environment loads or the context is torn down.
+     */
+    private class SharedEnvironment {
+        var cubemap: Texture? = null
+        var refCount = 0
+        val onLoaded = ArrayList<(Texture) -> Unit>()
+        // The last load failed; the next acquire loads it again
+        var failed = false
+    }
+    private val environments = HashMap<String, SharedEnvironment>()
+    // Asset reads happen here; textures are created back on the main thread
+    private val environmentLoader = Executors.newSingleThreadExecutor()
+    private var destroyed = false
+
+    private var refCount = 0
+    private val teardown = Runnable { destroy() }
+
+    init {
+        val start = SystemClock.elapsedRealtime()
+        engine = if (hardwareBufferCamera) {
+            Engine.Builder().build()
+        } else {
+            createEglContext()
+            makeEglContextCurrent()
+            Engine.Builder()
+                .sharedContext(eglContext)
+                .build()
+        }
+        materialProvider = UbershaderProvider(engine)
+        Log.d(TAG, "Shared Filament engine created in ${SystemClock.elapsedRealtime() - start} ms " +
+            "(${if (hardwareBufferCamera) "hardware buffer" else "shared EGL context"} camera)")
+    }
+
+    /**
+     * Drop a reference taken with [acquire]; the context is torn down once unused for the grace period.
+     */
+    fun release() {
+        if (refCount <= 0) {
+            Log.w(TAG, "Unbalanced release")
+            return
+        }
+        if (--refCount > 0) return
+        mainHandler.postDelayed(teardown, TEARDOWN_DELAY_MS)
+    }
+
+    /**
+     * Make the shared EGL context current for OpenGL operations (ARCore camera textures).
+     * Camera texture path only.
+     */
+    fun makeEglContextCurrent() {
+        if (!EGL14.eglMakeCurrent(eglDisplay, eglSurface, eglSurface, eglContext)) {
+            throw RuntimeException("Unable to make EGL context current")
+        }
+    }
+
+    /**
+     * Material built once from a bundled .filamat asset and owned by the context.
+     * Callers create their own MaterialInstances and destroy them, never the material.
+     */
+    fun material(assetName: String): Material =
+        materials.getOrPut(assetName) {
+            val materialBuffer = LoaderUtils.loadAsset(appContext, assetName)
+            Material.Builder()
+                .payload(materialBuffer, materialBuffer.remaining())
+                .build(engine)
+        }
+
+    /**
+     * Take a reference to an environment's reflections cubemap, loading it off the main thread
+     * if no view has it yet. [onLoaded] is called on the main thread once it is ready (right away
+     * if it already is); it may run after a matching [releaseEnvironment], so callers check the
+     * environment is still the one they want. Callers never destroy the cubemap. If loading
+     * fails, [onLoaded] never runs and the next acquire of that environment retries.
+     * @return False if there's no such environment
+     */
+    fun acquireEnvironment(name: String, onLoaded: (Texture) -> Unit): Boolean {
+        val assetName = ENVIRONMENTS[name] ?: return false
+        val existing = environments[name]
+        if (existing != null) {
+            existing.refCount++
+            val cubemap = existing.cubemap
+            if (cubemap != null) {
+                onLoaded(cubemap)
+                return true
+            }
+            existing.onLoaded.add(onLoaded)
+            if (existing.failed) {
+                existing.failed = false
+                loadEnvironment(existing, name, assetName)
+            }
+            return true
+        }
+
+        evictUnusedEnvironments()
+        val environment = SharedEnvironment()
+        environment.refCount = 1
+        environment.onLoaded.add(onLoaded)
+        environments[name] = environment
+        loadEnvironment(environment, name, assetName)
+        return true
+    }
+
+    /**
+     * Read an environment's KTX on the loader thread, then create its texture and notify its
+     * listeners on the main thread.
+     */
+    private fun loadEnvironment(environment: SharedEnvironment, name: String, assetName: String) {
+        val start = SystemClock.elapsedRealtime()
+        environmentLoader.execute {
+            val buffer: ByteBuffer? = try {
+                LoaderUtils.loadAsset(appContext, assetName)
+            } catch (e: Exception) {
+                Log.e(TAG, "Failed to read environment $name", e)
+                null
+            }
+            mainHandler.post {
+                // Evicted or torn down while loading
+                if (destroyed || environments[name] !== environment) return@post
+                val cubemap = try {
+                    buffer?.let { KTX1Loader.createTexture(engine, it) }
+                } catch (e: Exception) {
+                    Log.e(TAG, "Failed to create environment texture $name", e)
+                    null
+                }
+                if (cubemap == null) {
+                    failEnvironment(environment, name)
+                    return@post
+                }
+                environment.cubemap = cubemap
+                Log.d(TAG, "Environment $name loaded in ${SystemClock.elapsedRealtime() - start} ms")
+                val listeners = environment.onLoaded.toList()
+                environment.onLoaded.clear()
+                for (listener in listeners) listener(cubemap)
+            }
+        }
+    }
+
+    /**
+     * A load failed (main thread): its listeners never fire, and the next acquire retries. The
+     * entry stays so the references already taken on it still balance.
+     */
+    private fun failEnvironment(environment: SharedEnvironment, name: String) {
+        Log.e(TAG, "Failed to load environment $name")
+        environment.failed = true
+        environment.onLoaded.clear()
+    }
+
+    /**
+     * Drop a reference taken with [acquireEnvironment]
+     */
+    fun releaseEnvironment(name: String) {
+        val environment = environments[name] ?: return
+        if (environment.refCount <= 0) {
+            Log.w(TAG, "Unbalanced environment release: $name")
+            return
+        }
+        if (--environment.refCount > 0) return
+        environment.onLoaded.clear()
+    }
+
+    private fun evictUnusedEnvironments() {
+        val iterator = environments.values.iterator()
+        while (iterator.hasNext()) {
+            val environment = iterator.next()
+            if (environment.refCount > 0) continue
+            environment.cubemap?.let { engine.destroyTexture(it) }
+            iterator.remove()
+        }
+    }
+
+    /**
+     * Compile the shader variants VTO renders with, once per material.
+     * Without this, variants compile lazily on first draw and stall that frame.
+     */
+    fun compileMaterial(material: Material, skinned: Boolean = false) {
+        if (!compiledMaterials.add(material)) return
+        // Queued on the driver's parallel compiler; draws wait only if the variant isn't ready yet
+        val variants = if (skinned) WARM_UP_VARIANTS or SKINNING_VARIANT else WARM_UP_VARIANTS
+        material.compile(Material.CompilerPriorityQueue.HIGH, variants, null, null)
+    }
+
+    /**
+     * Build and compile every bundled material.
+     */
+    fun warmUpMaterials() {
+        for (assetName in BUNDLED_MATERIALS) {
+            compileMaterial(material(assetName), assetName in SKINNED_MATERIALS)
+        }
+    }
+
+    private fun destroy() {
+        if (refCount > 0) return
+        if (shared === this) shared = null
+        destroyed = true
+
+        // Every view has released its environment by now
+        evictUnusedEnvironments()
+        environmentLoader.shutdown()
+        for (material in materials.values) {
+            engine.destroyMaterial(material)
+        }
+        materials.clear()
+        compiledMaterials.clear()
+        materialProvider.destroyMaterials()
+        materialProvider.destroy()
+        engine.destroy()
+        Log.d(TAG, "Shared Filament engine destroyed")
+        if (hardwareBufferCamera) return
+
+        EGL14.eglDestroySurface(eglDisplay, eglSurface)
+        EGL14.eglDestroyContext(eglDisplay, eglContext)
+        EGL14.eglTerminate(eglDisplay)
+    }
+
+    private fun createEglContext() {
+        eglDisplay = EGL14.eglGetDisplay(EGL14.EGL_DEFAULT_DISPLAY)
+        if (eglDisplay == EGL14.EGL_NO_DISPLAY) {
+            throw RuntimeException("Unable to get EGL display")
+        }
+
+        val version = IntArray(2)
+        if (!EGL14.eglInitialize(eglDisplay, version, 0, version, 1)) {
+            throw RuntimeException("Unable to initialize EGL")
+        }
+
+        val configAttribs = intArrayOf(
+            EGL14.EGL_RENDERABLE_TYPE, EGL14.EGL_OPENGL_ES2_BIT,
+            EGL14.EGL_RED_SIZE, 8,
+            EGL14.EGL_GREEN_SIZE, 8,
+            EGL14.EGL_BLUE_SIZE, 8,
+            EGL14.EGL_ALPHA_SIZE, 8,
+            EGL14.EGL_DEPTH_SIZE, 16,
+            EGL14.EGL_NONE
+        )
+
+        val configs = arrayOfNulls<EGLConfig>(1)
+        val numConfigs = IntArray(1)
+        EGL14.eglChooseConfig(eglDisplay, configAttribs, 0, configs, 0, 1, numConfigs, 0)
+
+        if (numConfigs[0] == 0) {
+            throw RuntimeException("Unable to find suitable EGL config")
+        }
+
+        val contextAttribs = intArrayOf(
+            EGL14.EGL_CONTEXT_CLIENT_VERSION, 3,
+            EGL14.EGL_NONE
+        )
+
+        eglContext = EGL14.eglCreateContext(eglDisplay, configs[0], EGL14.EGL_NO_CONTEXT, contextAttribs, 0)
+        if (eglContext == EGL14.EGL_NO_CONTEXT) {
+            throw RuntimeException("Unable to create EGL context")
+        }
+
+        val surfaceAttribs = intArrayOf(
+            EGL14.EGL_WIDTH, 1,
+            EGL14.EGL_HEIGHT, 1,
+            EGL14.EGL_NONE
+        )
+        eglSurface = EGL14.eglCreatePbufferSurface(eglDisplay, configs[0], surfaceAttribs, 0)
+        if (eglSurface == EGL14.EGL_NO_SURFACE) {
+            throw RuntimeException("Unable to create EGL surface")
+        }
+    }
+}
@@ -0,0 +1,66 @@
+package com.margelo.nitro.nitrovto
+
+import android.os.Handler
+import android.os.Looper
+import android.util.Log
+import com.google.android.filament.Engine
+import com.google.android.filament.VertexBuffer
+import java.nio.FloatBuffer
+
+/**
+ * Direct float buffers for per-frame vertex uploads, recycled through Filament's buffer release
+ * callback: a buffer goes back to the pool only once the driver has consumed it, so a slow GPU
+ * never sees a buffer being rewritten and steady-state uploads don't allocate.
+ * Main thread only (the release callbacks are posted to the main looper).
+ */
+internal class FloatBufferPool(private val floatCount: Int, initialSize: Int = INITIAL_SIZE) {
+
+    companion object {
+        private const val TAG = "FloatBufferPool"
+        // One buffer being written, one queued and one being read by the driver
+        private const val INITIAL_SIZE = 3
+    }
+
+    /** A pooled buffer; its [run] is the release callback handed to Filament */
+    inner class Entry : Runnable {
+        val buffer: FloatBuffer = MatrixUtils.createFloatBuffer(floatCount)
+
+        override fun run() {
+            release(this)
+        }
+    }
+
+    private val handler = Handler(Looper.getMainLooper())
+    private var free = Array<Entry?>(initialSize) { Entry() }
+    private var freeCount = initialSize
+    private var size = initialSize
+
+    /**
+     * Take a free buffer to fill. Grows the pool if every buffer is still in flight, which only
+     * happens while the GPU falls behind; the pool then stays at that size.
+     */
+    fun acquire(): Entry {
+        if (freeCount > 0) {
+            val entry = free[--freeCount]!!
+            free[freeCount] = null
+            return entry
+        }
+        size++
+        if (free.size < size) free = free.copyOf(size)
+        Log.d(TAG, "All $floatCount-float buffers in flight, pool grown to $size")
+        return Entry()
+    }
+
+    /**
+     * Upload [entry] to [vertexBuffer], [byteOffset] bytes in (several faces batched into one buffer);
+     * it returns to the pool once Filament is done reading it.
+     */
+    fun upload(engine: Engine, vertexBuffer: VertexBuffer, entry: Entry, byteOffset: Int = 0) {
+        vertexBuffer.setBufferAt(engine, 0, entry.buffer, byteOffset, 0, handler, entry)
+    }
+
+    /** Return a buffer that was acquired but not uploaded */
+    fun release(entry: Entry) {
+        if (freeCount < free.size) free[freeCount++] = entry
+    }
+}
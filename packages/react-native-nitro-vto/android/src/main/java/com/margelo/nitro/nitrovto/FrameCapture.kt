@@ -0,0 +1,362 @@
+package com.margelo.nitro.nitrovto
+
+import android.graphics.Bitmap
+import android.graphics.Matrix
+import android.media.MediaCodec
+import android.media.MediaCodecInfo
+import android.media.MediaFormat
+import android.media.MediaMuxer
+import android.os.Handler
+import android.os.HandlerThread
+import android.os.Looper
+import android.util.Log
+import android.view.Surface
+import com.google.android.filament.Engine
+import com.google.android.filament.Renderer
+import com.google.android.filament.SwapChain
+import com.google.android.filament.Texture
+import com.google.android.filament.Viewport
+import java.io.FileOutputStream
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+import java.util.concurrent.Executors
+import kotlin.math.max
+import kotlin.math.min
+
+/**
+ * Photo and video capture of the rendered view, without stalling the render loop.
+ * Photos are read back with Renderer.readPixels into a small pool of direct buffers, filled by
+ * Filament a few frames later and compressed to JPEG on a background thread. Video frames never
+ * reach the CPU: Renderer.copyFrame blits each one to a MediaCodec input surface, and the H.264
+ * output is muxed to MP4 on a handler thread.
+ * Render thread only; [onComplete] is called on the main thread.
+ */
+internal class FrameCapture(
+    private val engine: Engine,
+    private val onComplete: (filePath: String, durationSeconds: Double) -> Unit
+) {
+
+    companion object {
+        private const val TAG = "FrameCapture"
+
+        // Readbacks in flight at once; a photo request waits for a free buffer
+        private const val MAX_PHOTO_BUFFERS = 2
+        private const val PHOTO_QUALITY = 90
+
+        private const val VIDEO_FRAMES_PER_SECOND = 30
+        // Slack when spacing video frames out (half a 60 Hz refresh)
+        private const val VIDEO_FRAME_INTERVAL_SLACK_NANOS = 8_000_000L
+        // Long side of the video; encoders past 1080p are not a given
+        private const val MAX_VIDEO_SIZE = 1920
+    }
+
+    private val mainHandler = Handler(Looper.getMainLooper())
+    private val photoExecutor = Executors.newSingleThreadExecutor()
+
+    private val pendingPhotoPaths = ArrayList<String>()
+    private val freeBuffers = ArrayList<ByteBuffer>()
+    private var buffersInFlight = 0
+    private var recording: VideoRecording? = null
+
+    /**
+     * Save the next rendered frame to filePath as a JPEG
+     */
+    fun capturePhoto(filePath: String) {
+        pendingPhotoPaths.add(filePath)
+    }
+
+    /**
+     * Record rendered frames to an H.264 MP4 at filePath (replaces a recording in progress)
+     */
+    fun startRecording(filePath: String) {
+        stopRecording()
+        recording = VideoRecording(filePath)
+        Log.d(TAG, "Recording to $filePath")
+    }
+
+    /**
+     * Finish the recording; the file is reported once the encoder has drained
+     */
+    fun stopRecording() {
+        val recording = recording ?: return
+        this.recording = null
+        recording.stop()
+    }
+
+    /**
+     * Read back or encode the frame being rendered, if asked for. Between Renderer.render and
+     * Renderer.endFrame; the renderer's swap chain must be readable (SwapChain.CONFIG_READABLE).
+     */
+    fun captureFrame(renderer: Renderer, viewport: Viewport, timestampNanos: Long) {
+        if (viewport.width <= 0 || viewport.height <= 0) return
+        if (pendingPhotoPaths.isNotEmpty()) {
+            readPhoto(renderer, viewport)
+        }
+        recording?.let { recording ->
+            if (!recording.isFrameDue(timestampNanos)) return
+            if (!recording.encodeFrame(renderer, viewport, timestampNanos)) {
+                // The encoder couldn't start: report it now rather than at stopRecording
+                this.recording = null
+                recording.stop()
+            }
+        }
+    }
+
+    fun destroy() {
+        stopRecording()
+        pendingPhotoPaths.clear()
+        // Queued photos still get written
+        photoExecutor.shutdown()
+    }
+
+    private fun report(filePath: String, durationSeconds: Double) {
+        mainHandler.post { onComplete(filePath, durationSeconds) }
+    }
+
+    // Photos
+
+    private fun readPhoto(renderer: Renderer, viewport: Viewport) {
+        // Every buffer in flight: try again next frame
+        if (buffersInFlight >= MAX_PHOTO_BUFFERS) return
+
+        val width = viewport.width
+        val height = viewport.height
+        val buffer = takeBuffer(width * height * 4)
+        val paths = pendingPhotoPaths.toList()
+        pendingPhotoPaths.clear()
+        buffersInFlight++
+
+        // Bottom row first (Filament's readPixels convention); the callback runs on the main looper
+        val descriptor = Texture.PixelBufferDescriptor(
+            buffer, Texture.Format.RGBA, Texture.Type.UBYTE, 1, 0, 0, width, mainHandler
+        ) {
+            photoExecutor.execute {
+                val written = writePhoto(buffer, width, height, paths)
+                mainHandler.post {
+                    buffersInFlight--
+                    freeBuffers.add(buffer)
+                }
+                for (path in paths) {
+                    report(path, if (path in written) 0.0 else -1.0)
+                }
+            }
+        }
+        renderer.readPixels(viewport.left, viewport.bottom, width, height, descriptor)
+    }
+
+    private fun takeBuffer(size: Int): ByteBuffer {
+        val index = freeBuffers.indexOfFirst { it.capacity() == size }
+        val buffer = if (index >= 0) {
+            freeBuffers.removeAt(index)
+        } else {
+            // A different size (layout change) replaces the pooled buffers
+            freeBuffers.clear()
+            ByteBuffer.allocateDirect(size).order(ByteOrder.nativeOrder())
+        }
+        buffer.clear()
+        return buffer
+    }
+
+    /**
+     * Compress the read back pixels to each path. Background thread.
+     * @return The paths written
+     */
+    private fun writePhoto(buffer: ByteBuffer, width: Int, height: Int, paths: List<String>): Set<String> {
+        val written = HashSet<String>()
+        try {
+            // ARGB_8888 bitmaps are RGBA in memory, like the readback
+            val readback = Bitmap.createBitmap(width, height, Bitmap.Config.ARGB_8888)
+            buffer.rewind()
+            readback.copyPixelsFromBuffer(buffer)
+            val flip = Matrix().apply { preScale(1f, -1f) }
+            val photo = Bitmap.createBitmap(readback, 0, 0, width, height, flip, false)
+            readback.recycle()
+            for (path in paths) {
+                try {
+                    FileOutputStream(path).use { photo.compress(Bitmap.CompressFormat.JPEG, PHOTO_QUALITY, it) }
+                    written.add(path)
+                } catch (e: Exception) {
+                    Log.e(TAG, "Failed to write photo $path: ${e.message}")
+                }
+            }
+            photo.recycle()
+        } catch (e: OutOfMemoryError) {
+            Log.e(TAG, "Not enough memory for a ${width}x$height photo")
+        }
+        return written
+    }
+
+    // Video
+
+    /**
+     * One MP4 recording. The encoder is created with the first frame's size; its output is muxed
+     * on [thread], which also reports the file.
+     */
+    private inner class VideoRecording(private val filePath: String) : MediaCodec.Callback() {
+        private val thread = HandlerThread("VTORecording")
+        private var codec: MediaCodec? = null
+        private var inputSurface: Surface? = null
+        private var swapChain: SwapChain? = null
+        private var dstViewport: Viewport? = null
+        private var lastFrameNanos = -1L
+        private var failed = false
+
+        // Handler thread
+        private var muxer: MediaMuxer? = null
+        private var track = -1
+        private var firstPtsUs = -1L
+        private var lastPtsUs = -1L
+        private var frameCount = 0
+        private var finished = false
+
+        fun isFrameDue(timestampNanos: Long): Boolean =
+            lastFrameNanos < 0 ||
+                timestampNanos - lastFrameNanos >= 1_000_000_000L / VIDEO_FRAMES_PER_SECOND - VIDEO_FRAME_INTERVAL_SLACK_NANOS
+
+        /**
+         * Blit the frame being rendered to the encoder. False if the encoder couldn't be started.
+         */
+        fun encodeFrame(renderer: Renderer, viewport: Viewport, timestampNanos: Long): Boolean {
+            if (failed) return false
+            if (swapChain == null && !start(viewport.width, viewport.height)) {
+                failed = true
+                return false
+            }
+            lastFrameNanos = timestampNanos
+            // The encoder stamps each frame as it is queued, in the render loop's cadence
+            renderer.copyFrame(
+                swapChain!!,
+                dstViewport!!,
+                viewport,
+                Renderer.MIRROR_FRAME_FLAG_COMMIT or Renderer.MIRROR_FRAME_FLAG_CLEAR
+            )
+            return true
+        }
+
+        private fun start(sourceWidth: Int, sourceHeight: Int): Boolean {
+            // H.264 wants even dimensions
+            val scale = min(1f, MAX_VIDEO_SIZE.toFloat() / max(sourceWidth, sourceHeight))
+            val width = (sourceWidth * scale).toInt() and 1.inv()
+            val height = (sourceHeight * scale).toInt() and 1.inv()
+            if (width <= 0 || height <= 0) return false
+
+            try {
+                val format = MediaFormat.createVideoFormat(MediaFormat.MIMETYPE_VIDEO_AVC, width, height).apply {
+                    setInteger(MediaFormat.KEY_COLOR_FORMAT, MediaCodecInfo.CodecCapabilities.COLOR_FormatSurface)
+                    setInteger(MediaFormat.KEY_BIT_RATE, width * height * 4)
+                    setInteger(MediaFormat.KEY_FRAME_RATE, VIDEO_FRAMES_PER_SECOND)
+                    setInteger(MediaFormat.KEY_I_FRAME_INTERVAL, 1)
+                }
+                muxer = MediaMuxer(filePath, MediaMuxer.OutputFormat.MUXER_OUTPUT_MPEG_4)
+                thread.start()
+                val codec = MediaCodec.createEncoderByType(MediaFormat.MIMETYPE_VIDEO_AVC)
+                this.codec = codec
+                codec.setCallback(this, Handler(thread.looper))
+                codec.configure(format, null, null, MediaCodec.CONFIGURE_FLAG_ENCODE)
+                val surface = codec.createInputSurface()
+                inputSurface = surface
+                codec.start()
+                swapChain = engine.createSwapChain(surface)
+                dstViewport = Viewport(0, 0, width, height)
+                return true
+            } catch (e: Exception) {
+                Log.e(TAG, "Failed to start ${width}x$height H.264 encoder: ${e.message}")
+                return false
+            }
+        }
+
+        /**
+         * Render thread. Stop feeding the encoder and let it drain on its thread.
+         */
+        fun stop() {
+            swapChain?.let {
+                engine.destroySwapChain(it)
+                // Filament must be done with the surface before the stream ends
+                engine.flushAndWait()
+            }
+            swapChain = null
+            val codec = codec
+            if (codec == null || failed) {
+                if (thread.isAlive) {
+                    Handler(thread.looper).post { finish(false) }
+                } else {
+                    finish(false)
+                }
+                return
+            }
+            try {
+                codec.signalEndOfInputStream()
+            } catch (e: IllegalStateException) {
+                Handler(thread.looper).post { finish(false) }
+            }
+        }
+
+        override fun onInputBufferAvailable(codec: MediaCodec, index: Int) = Unit
+
+        override fun onOutputFormatChanged(codec: MediaCodec, format: MediaFormat) {
+            val muxer = muxer ?: return
+            track = muxer.addTrack(format)
+            muxer.start()
+        }
+
+        override fun onOutputBufferAvailable(codec: MediaCodec, index: Int, info: MediaCodec.BufferInfo) {
+            if (finished) return
+            val buffer = codec.getOutputBuffer(index)
+            val isConfig = info.flags and MediaCodec.BUFFER_FLAG_CODEC_CONFIG != 0
+            if (buffer != null && info.size > 0 && track >= 0 && !isConfig) {
+                // Start the file at zero, whatever clock the encoder stamped frames with
+                if (firstPtsUs < 0) firstPtsUs = info.presentationTimeUs
+                lastPtsUs = info.presentationTimeUs
+                info.presentationTimeUs -= firstPtsUs
+                muxer?.writeSampleData(track, buffer, info)
+                frameCount++
+            }
+            codec.releaseOutputBuffer(index, false)
+            if (info.flags and MediaCodec.BUFFER_FLAG_END_OF_STREAM != 0) {
+                finish(frameCount > 0)
+            }
+        }
+
+        override fun onError(codec: MediaCodec, e: MediaCodec.CodecException) {
+            Log.e(TAG, "Encoder error: ${e.diagnosticInfo}")
+            finish(false)
+        }
+
+        private fun finish(success: Boolean) {
+            if (finished) return
+            finished = true
+
+            var written = success
+            try {
+                codec?.stop()
+            } catch (e: IllegalStateException) {
+                // Already stopped by an encoder error
+            }
+            codec?.release()
+            codec = null
+            inputSurface?.release()
+            inputSurface = null
+            try {
+                // Throws when no sample was written
+                if (track >= 0) muxer?.stop()
+            } catch (e: IllegalStateException) {
+                written = false
+            }
+            muxer?.release()
+            muxer = null
+            thread.quitSafely()
+
+            val duration = if (written) {
+                (lastPtsUs - firstPtsUs) / 1e6 + 1.0 / VIDEO_FRAMES_PER_SECOND
+            } else {
+                -1.0
+            }
+            if (written) {
+                Log.d(TAG, "Recording finished: $frameCount frames, ${"%.1f".format(duration)} s")
+            } else {
+                Log.e(TAG, "Failed to record $filePath")
+            }
+            report(filePath, duration)
+        }
+    }
+}
@@ -1,7 +1,7 @@
 package com.margelo.nitro.nitrovto
 
+import android.app.ActivityManager
 import android.content.Context
-import android.opengl.Matrix
 import android.os.Handler
 import android.os.Looper
 import android.util.Log
@@ -10,220 +10,656 @@ import com.google.android.filament.EntityManager
 import com.google.android.filament.Scene
 import com.google.android.filament.gltfio.AssetLoader
 import com.google.android.filament.gltfio.FilamentAsset
+import com.google.android.filament.gltfio.FilamentInstance
 import com.google.android.filament.gltfio.ResourceLoader
-import com.google.android.filament.gltfio.UbershaderProvider
 import com.google.ar.core.AugmentedFace
-import com.google.ar.core.Frame
 import java.nio.ByteBuffer
-import java.util.concurrent.Executors
+import java.nio.FloatBuffer
 
 /**
  * Renderer for glasses model with face tracking transform.
  * Handles GLTF loading and NDC-space positioning based on ARCore face mesh.
+ * Each tracked face gets a slot with its own instance of the loaded asset (geometry and textures
+ * are shared) and its own pose filter and level of detail.
  */
 class GlassesRenderer(private val context: Context) {
 
     companion object {
         private const val TAG = "GlassesRenderer"
+        // Budget for warm models kept in the pool, measured in GLB bytes (a proxy for GPU memory)
+        const val DEFAULT_POOL_BYTE_LIMIT = 64L * 1024 * 1024
+
+        /**
+         * Device tier for level of detail selection, from total memory, CPU cores and the low-RAM flag.
+         */
+        fun detectDeviceTier(context: Context): Int {
+            val activityManager = context.getSystemService(Context.ACTIVITY_SERVICE) as ActivityManager
+            val memoryInfo = ActivityManager.MemoryInfo()
+            activityManager.getMemoryInfo(memoryInfo)
+            return VtoCore.classifyDeviceTier(
+                memoryInfo.totalMem,
+                Runtime.getRuntime().availableProcessors(),
+                activityManager.isLowRamDevice
+            )
+        }
+    }
+
+    /**
+     * A created asset kept in the pool, shown or not. One instance per face slot, all sharing the
+     * asset's geometry, textures and materials.
+     */
+    private class PoolEntry(
+        val url: String,
+        val asset: FilamentAsset,
+        val instances: Array<FilamentInstance>,
+        val byteSize: Long,
+        /** Estimated vertex, index and texture bytes on the GPU (shared by every instance) */
+        val gpuBytes: Long,
+        /**
+         * Renderables of each level of detail (0 = full detail) of each instance; empty when the
+         * model has none
+         */
+        val instanceLods: List<List<IntArray>>
+    ) {
+        val levelCount: Int get() = instanceLods.firstOrNull()?.size ?: 0
+
+        /** All resources decoded and source data released */
+        var decoded = false
     }
 
+    private lateinit var filamentContext: FilamentContext
     private lateinit var engine: Engine
     private lateinit var scene: Scene
     private lateinit var assetLoader: AssetLoader
     private lateinit var resourceLoader: ResourceLoader
     private var glassesAsset: FilamentAsset? = null
+    private var shownEntry: PoolEntry? = null
 
-    // Thread management for URL loading
-    private val executor = Executors.newSingleThreadExecutor()
     private val mainHandler = Handler(Looper.getMainLooper())
 
-    // Loading state
-    private var isLoading = false
+    // Warm asset pool keyed by URL, iterated from least to most recently used
+    private val pool = LinkedHashMap<String, PoolEntry>(16, 0.75f, true)
+    private var poolBytes = 0L
+    var poolByteLimit = DEFAULT_POOL_BYTE_LIMIT
+
+    // Loading state: downloads in flight, and assets waiting for the (single) async resource load
+    private val pendingDownloads = HashMap<String, ModelDownloader.Token>()
+    // URLs asked for by prefetchModels, whose downloads survive switching away from them
+    private val prefetchedUrls = HashSet<String>()
+    private val decodeQueue = ArrayDeque<String>()
+    private var decodingEntry: PoolEntry? = null
+    private var lastReportedProgress = -1f
+    // Downloads may land after destroy()
+    private var destroyed = false
 
     // Current model info
     private var currentModelUrl: String = ""
+    // Models kept loaded for setActiveModel: downloaded ahead, decoded ahead, never evicted
+    private var compareUrls: List<String> = emptyList()
+
+    // Pool totals, published on the main thread for memoryStats on any thread
+    @Volatile private var publishedMemoryStats = ModelMemoryStats(0.0, 0.0, 0.0, 0.0, detectDeviceTier(context).toDouble())
+    private val memoryEstimate = LongArray(2)
 
     // Callbacks
     var onModelLoaded: ((modelUrl: String) -> Unit)? = null
+    var onModelLoadProgress: ((modelUrl: String, progress: Double) -> Unit)? = null
 
     // Reusable arrays to avoid per-frame allocations
-    private val tempVec4 = FloatArray(4)
-    private val tempMatrix16 = FloatArray(16)
+    private val glassesMatrix16 = FloatArray(16)
+    private val slotOfFace = IntArray(VtoCore.MAX_TRACKED_FACES)
+    private val slotClaimed = BooleanArray(VtoCore.MAX_TRACKED_FACES)
 
-    // Kalman filters for smoothing (reduce jitter)
-    // Higher processNoise = more responsive, higher measurementNoise = smoother
-    private val positionFilter = KalmanFilter3D(processNoise = 0.1f, measurementNoise = 0.05f)
-    private val rotationFilter = KalmanFilterQuaternion(processNoise = 0.1f, measurementNoise = 0.05f)
+    private val deviceTier = detectDeviceTier(context)
+
+    /**
+     * Glasses of one tracked face: an instance of the shown asset and the face's filter state.
+     */
+    private inner class FaceSlot {
+        // Nose bridge anchoring, pose filtering and prediction, forward offset (shared C++ core)
+        val poseSolver = GlassesPoseSolver()
+        // Level of detail from face distance, biased by the device tier (shared C++ core)
+        val lodSelector = LodSelector(deviceTier)
+        var shownLod = -1
+        // Whether the slot's instance entities are in the scene (only while its face is tracked)
+        var visible = false
+        // ARCore reuses one AugmentedFace per face, so each face keeps its own filter history
+        var face: AugmentedFace? = null
+    }
 
-    // Forward offset for glasses positioning (in meters)
-    private var forwardOffset = 0.005f  // Default: 5mm forward
+    private val faceSlots = Array(VtoCore.MAX_TRACKED_FACES) { FaceSlot() }
+    // Faces fitted with glasses at once; new assets get one instance per slot
+    private var faceSlotCount = 1
 
     /**
-     * Setup the glasses renderer with Filament engine and scene.
-     * @param engine Filament engine instance
+     * Setup the glasses renderer with the shared Filament context and scene.
+     * @param filamentContext Shared engine and ubershader material provider
      * @param scene Scene to add glasses entities to
      * @param modelUrl URL to the glasses model (GLB format)
      */
-    fun setup(engine: Engine, scene: Scene, modelUrl: String) {
-        this.engine = engine
+    fun setup(filamentContext: FilamentContext, scene: Scene, modelUrl: String) {
+        this.filamentContext = filamentContext
+        this.engine = filamentContext.engine
         this.scene = scene
         this.currentModelUrl = modelUrl
 
-        // Setup GLTF loader
-        val materialProvider = UbershaderProvider(engine)
-        assetLoader = AssetLoader(engine, materialProvider, EntityManager.get())
+        // Setup GLTF loader; ubershader materials are shared by every view
+        assetLoader = AssetLoader(engine, filamentContext.materialProvider, EntityManager.get())
+        // The Java ResourceLoader registers PNG/JPEG (stb_image) and KTX2 (KHR_texture_basisu,
+        // transcoded to ASTC or ETC2) texture providers, and decodes EXT_meshopt_compression buffers
         resourceLoader = ResourceLoader(engine)
 
         // Load model
-        loadModel(modelUrl)
+        showModel(modelUrl)
     }
 
-    private fun loadModel(url: String) {
+    /**
+     * Show the model as soon as it is available: instantly when pooled, otherwise once downloaded.
+     */
+    private fun showModel(url: String) {
         if (url.isEmpty()) {
             Log.d(TAG, "Empty URL, skipping model load")
             return
         }
 
-        if (isLoading) {
-            Log.d(TAG, "Already loading a model, skipping request for: $url")
+        val entry = pool[url]
+        if (entry != null) {
+            activate(entry, keepPose = false)
             return
         }
 
-        isLoading = true
+        // Not pooled yet: download it (no-op if a prefetch is already in flight), shown when it lands
+        download(url)
+    }
+
+    /**
+     * Download and decode models into the warm asset pool without showing them.
+     */
+    fun prefetchModels(urls: List<String>) {
+        for (url in urls) {
+            if (url.isEmpty() || pool.containsKey(url)) continue
+            prefetchedUrls.add(url)
+            download(url)
+        }
+    }
+
+    private fun download(url: String) {
+        if (pendingDownloads.containsKey(url)) return
         Log.d(TAG, "Starting download from URL: $url")
 
-        executor.execute {
-            try {
-                val modelBuffer = LoaderUtils.loadFromUrl(context, url)
-
-                mainHandler.post {
-                    try {
-                        loadModelBuffer(modelBuffer)
-                        onModelLoaded?.invoke(url)
-                    } catch (e: Exception) {
-                        Log.e(TAG, "Failed to load model buffer on main thread: ${e.message}")
-                        e.printStackTrace()
-                    } finally {
-                        isLoading = false
-                    }
-                }
+        // Runs on a download thread
+        pendingDownloads[url] = ModelDownloader.download(context, url) { file, error ->
+            val modelBuffer = try {
+                // createAsset copies what it needs, so the mapping is dropped with the buffer
+                file?.let { LoaderUtils.mapFile(it) }
             } catch (e: Exception) {
-                Log.e(TAG, "Failed to download GLB from URL: ${e.message}")
-                e.printStackTrace()
-                mainHandler.post {
-                    isLoading = false
+                Log.e(TAG, "Failed to read cached GLB: ${e.message}")
+                null
+            }
+
+            mainHandler.post {
+                pendingDownloads.remove(url)
+                prefetchedUrls.remove(url)
+                if (modelBuffer == null) {
+                    Log.e(TAG, "Failed to download GLB from URL: ${error?.message}")
+                    return@post
+                }
+                try {
+                    addModelBuffer(url, modelBuffer)
+                } catch (e: Exception) {
+                    Log.e(TAG, "Failed to load model buffer on main thread: ${e.message}")
+                    e.printStackTrace()
                 }
             }
         }
     }
 
-    private fun loadModelBuffer(modelBuffer: ByteBuffer) {
-        glassesAsset = assetLoader.createAsset(modelBuffer)
+    /**
+     * Stop downloading a model nobody is waiting for any more; its partial file is kept for resuming.
+     */
+    private fun cancelDownload(url: String) {
+        if (prefetchedUrls.contains(url) || compareUrls.contains(url)) return
+        pendingDownloads.remove(url)?.cancel()
+    }
 
-        glassesAsset?.let { asset ->
-            resourceLoader.loadResources(asset)
-            asset.releaseSourceData()
+    /**
+     * Create the asset for a downloaded GLB, pool it, and show it if it is the current model.
+     */
+    private fun addModelBuffer(url: String, modelBuffer: ByteBuffer) {
+        if (destroyed || pool.containsKey(url)) return
 
-            scene.addEntities(asset.entities)
-            Log.d(TAG, "Glasses model loaded: ${asset.entities.size} entities")
-            hide()
-        } ?: run {
+        // One instance per face slot: geometry and textures are loaded once and shared
+        val asset = assetLoader.createInstancedAsset(modelBuffer, arrayOfNulls(faceSlotCount)) ?: run {
             Log.e(TAG, "Failed to create glasses asset")
+            return
+        }
+        val instances = asset.assetInstances
+
+        // Filament doesn't report buffer or texture sizes: estimate them from the GLB (shared C++ core)
+        memoryEstimate.fill(0L)
+        if (!VtoCore.estimateModelMemory(modelBuffer, modelBuffer.limit(), memoryEstimate)) {
+            Log.w(TAG, "Couldn't estimate the memory of $url")
+        }
+
+        val entry = PoolEntry(
+            url, asset, instances, modelBuffer.limit().toLong(), memoryEstimate[0] + memoryEstimate[1],
+            instances.map { collectLodLevels(asset, it) }
+        )
+        pool[url] = entry
+        poolBytes += entry.byteSize
+        decodeQueue.addLast(url)
+        Log.d(TAG, "Glasses model created: ${instances.size} instances of ${instances[0].entities.size} entities, " +
+            "${entry.levelCount} LODs, ~${entry.gpuBytes / 1024} KB on the GPU, decoding resources")
+
+        // Compile the model's uber shader variants now, while the camera preview runs without a face
+        // (instances share their materials)
+        for (materialInstance in asset.instance.materialInstances) {
+            filamentContext.compileMaterial(materialInstance.material)
+        }
+
+        if (url == currentModelUrl) {
+            activate(entry, keepPose = false)
+        }
+        evictToBudget()
+        publishMemoryStats()
+        updateLoading()
+    }
+
+    /**
+     * Put a pooled model in the scene, replacing whatever was shown. With [keepPose] the face slots
+     * keep their faces and filters, so the new model appears exactly where the old one was.
+     */
+    private fun activate(entry: PoolEntry, keepPose: Boolean) {
+        removeShownAssetFromScene()
+
+        // Enters the scene with the next tracked face; geometry renders with default material
+        // params until textures land
+        glassesAsset = entry.asset
+        shownEntry = entry
+        for (slot in faceSlots) {
+            slot.lodSelector.setLevelCount(entry.levelCount)
+            slot.shownLod = slot.lodSelector.level
+        }
+        if (!keepPose) hide()
+
+        if (entry.decoded) {
+            onModelLoaded?.invoke(entry.url)
+            return
+        }
+
+        // Decode the visible model before any prefetched ones
+        decodeQueue.remove(entry.url)
+        decodeQueue.addFirst(entry.url)
+        lastReportedProgress = -1f
+    }
+
+    private fun removeShownAssetFromScene() {
+        if (glassesAsset == null) return
+        // Entities only: the slots keep their faces and filters for whatever is shown next
+        for (slotIndex in faceSlots.indices) {
+            removeSlotFromScene(slotIndex)
+        }
+        glassesAsset = null
+        shownEntry = null
+        for (slot in faceSlots) {
+            slot.shownLod = -1
+        }
+    }
+
+    /**
+     * Group an instance's renderables by the _LOD<n> suffix on their node or its closest tagged ancestor.
+     * Levels are renumbered in order (LOD0, LOD2 -> 0, 1); untagged renderables show at every level.
+     */
+    private fun collectLodLevels(asset: FilamentAsset, instance: FilamentInstance): List<IntArray> {
+        val transformManager = engine.transformManager
+        val renderableManager = engine.renderableManager
+        val byLevel = sortedMapOf<Int, MutableList<Int>>()
+        for (entity in instance.entities) {
+            if (!renderableManager.hasComponent(entity)) continue
+            var node = entity
+            var level = -1
+            while (node != 0 && level < 0) {
+                level = VtoCore.lodLevelFromName(asset.getName(node))
+                if (node == instance.root) break
+                val transform = transformManager.getInstance(node)
+                node = if (transform != 0) transformManager.getParent(transform) else 0
+            }
+            if (level >= 0) byLevel.getOrPut(level) { ArrayList() }.add(entity)
+        }
+        // A single tagged level is no choice at all
+        if (byLevel.size < 2) return emptyList()
+        return byLevel.values.map { it.toIntArray() }
+    }
+
+    /**
+     * Keep only [level]'s renderables of [slotIndex]'s instance of the shown model in the scene.
+     */
+    private fun showLod(slotIndex: Int, level: Int) {
+        val slot = faceSlots[slotIndex]
+        slot.shownLod = level
+        val entry = shownEntry ?: return
+        if (slotIndex >= entry.instances.size || !slot.visible) return
+        val lodLevels = entry.instanceLods[slotIndex]
+        for (index in lodLevels.indices) {
+            if (index == level) {
+                scene.addEntities(lodLevels[index])
+            } else {
+                scene.removeEntities(lodLevels[index])
+            }
         }
     }
 
     /**
-     * Update glasses transform based on detected face.
+     * Advance the in-flight model load by one step; call once per frame.
+     * Geometry is shown as soon as the asset is created, textures stream in over later frames.
+     * @return Whether a load is in flight (so the frame has new texture data to show)
      */
-    fun updateTransform(face: AugmentedFace, frame: Frame) {
-        glassesAsset?.let { asset ->
-            val instance = engine.transformManager.getInstance(asset.root)
+    fun updateLoading(): Boolean {
+        if (destroyed) return false
+
+        // ResourceLoader decodes one asset at a time: start the next queued one
+        while (decodingEntry == null) {
+            val url = decodeQueue.removeFirstOrNull() ?: return false
+            val entry = pool[url] ?: continue
+
+            // Upload geometry now and decode textures across frames, so the main thread never stalls
+            if (resourceLoader.asyncBeginLoad(entry.asset)) {
+                decodingEntry = entry
+            } else {
+                Log.e(TAG, "Failed to begin loading glasses resources: $url")
+                destroyEntry(entry)
+            }
+        }
+        val entry = decodingEntry ?: return false
+
+        resourceLoader.asyncUpdateLoad()
+        val progress = resourceLoader.asyncGetLoadProgress()
 
-            // Get nose bridge position in world space
-            val noseBridgeWorld = getNoseBridgeWorldPos(face)
+        val isCurrent = entry.asset == glassesAsset
+        if (isCurrent && progress != lastReportedProgress) {
+            lastReportedProgress = progress
+            onModelLoadProgress?.invoke(entry.url, progress.toDouble())
+        }
+
+        if (progress < 1f) return true
 
-            // Get face rotation from pose (world space)
-            val faceQuaternion = face.centerPose.rotationQuaternion
+        decodingEntry = null
+        entry.decoded = true
+        entry.asset.releaseSourceData()
+        Log.d(TAG, "Glasses model loaded: ${entry.url}")
+        publishMemoryStats()
+
+        if (isCurrent) {
+            onModelLoaded?.invoke(entry.url)
+        }
+        return true
+    }
 
-            // Apply Kalman filter smoothing
-            val smoothedPosition = positionFilter.update(noseBridgeWorld)
-            val smoothedRotation = rotationFilter.update(faceQuaternion)
+    /**
+     * Drop least recently used models until the pool fits its budget; the shown model and the compare
+     * models are never evicted.
+     */
+    private fun evictToBudget() {
+        val iterator = pool.values.iterator()
+        while (poolBytes > poolByteLimit && iterator.hasNext()) {
+            val entry = iterator.next()
+            if (entry.asset == glassesAsset || compareUrls.contains(entry.url)) continue
+            Log.d(TAG, "Evicting pooled model: ${entry.url}")
+            iterator.remove()
+            releaseEntry(entry)
+        }
+    }
 
-            // Build world-space transform matrix (no scaling - models are in real-world meters)
-            val rotationMatrix = MatrixUtils.quaternionToMatrix(smoothedRotation)
-            System.arraycopy(rotationMatrix, 0, tempMatrix16, 0, 16)
+    private fun destroyEntry(entry: PoolEntry) {
+        pool.remove(entry.url)
+        releaseEntry(entry)
+    }
 
-            // Offset glasses along face's Z axis (forward/backward)
-            val forwardX = rotationMatrix[8]   // Z axis X component (column 2, row 0)
-            val forwardY = rotationMatrix[9]   // Z axis Y component (column 2, row 1)
-            val forwardZ = rotationMatrix[10]  // Z axis Z component (column 2, row 2)
+    /**
+     * Destroy an entry's asset once it is out of [pool].
+     */
+    private fun releaseEntry(entry: PoolEntry) {
+        // Stop decoding before the asset's textures and buffers go away
+        if (entry == decodingEntry) {
+            resourceLoader.asyncCancelLoad()
+            decodingEntry = null
+        }
+        if (entry.asset == glassesAsset) {
+            removeShownAssetFromScene()
+        }
 
-            // Set world-space position with forward offset
-            tempMatrix16[12] = smoothedPosition[0] + forwardX * forwardOffset
-            tempMatrix16[13] = smoothedPosition[1] + forwardY * forwardOffset
-            tempMatrix16[14] = smoothedPosition[2] + forwardZ * forwardOffset
+        decodeQueue.remove(entry.url)
+        poolBytes -= entry.byteSize
+        assetLoader.destroyAsset(entry.asset)
+        publishMemoryStats()
+    }
 
-            engine.transformManager.setTransform(instance, tempMatrix16)
+    /**
+     * Refresh the totals [memoryStats] reports (main thread, whenever the pool changes).
+     */
+    private fun publishMemoryStats() {
+        var compareModelCount = 0
+        var gpuBytes = 0L
+        var cpuBytes = 0L
+        for (entry in pool.values) {
+            gpuBytes += entry.gpuBytes
+            // The asset holds on to its GLB until releaseSourceData, once its textures are decoded
+            if (!entry.decoded) cpuBytes += entry.byteSize
+            if (compareUrls.contains(entry.url)) compareModelCount++
         }
+        publishedMemoryStats = ModelMemoryStats(
+            pool.size.toDouble(),
+            compareModelCount.toDouble(),
+            gpuBytes.toDouble(),
+            cpuBytes.toDouble(),
+            deviceTier.toDouble()
+        )
     }
 
     /**
-     * Get nose bridge center position in world coordinates.
-     * Uses vertices 351 (left) and 122 (right) from ARCore face mesh.
+     * Estimated memory of the pooled models. Any thread.
+     */
+    fun memoryStats(): ModelMemoryStats = publishedMemoryStats
+
+    /**
+     * Update glasses transforms based on the detected faces (at most maxFaces are fitted).
+     * @param faces Tracked faces
+     * @param faceMatrices Face center poses (column-major), one per face
+     * @param meshVertices ARCore face mesh vertices, in face space, one per face
+     * @param cameraMatrix Camera world transform (column-major)
+     * @param timestampNanos Camera frame timestamp
+     * @param predictionNanos Time from the camera frame to it reaching the display
      */
-    private fun getNoseBridgeWorldPos(face: AugmentedFace): FloatArray {
-        val left = MatrixUtils.getPositionForVertice(351, face)
-        val right = MatrixUtils.getPositionForVertice(122, face)
+    fun updateTransform(
+        faces: List<AugmentedFace>,
+        faceMatrices: Array<FloatArray>,
+        meshVertices: Array<FloatBuffer?>,
+        cameraMatrix: FloatArray,
+        timestampNanos: Long,
+        predictionNanos: Long
+    ) {
+        val entry = shownEntry ?: return
+        val slotCount = minOf(faceSlotCount, entry.instances.size)
+        val faceCount = minOf(faces.size, slotCount)
+
+        // Faces keep the slot that followed them last frame; new faces take a free slot with fresh filters
+        slotClaimed.fill(false)
+        for (f in 0 until faceCount) {
+            slotOfFace[f] = -1
+            for (s in 0 until slotCount) {
+                if (!slotClaimed[s] && faceSlots[s].face === faces[f]) {
+                    slotOfFace[f] = s
+                    slotClaimed[s] = true
+                    break
+                }
+            }
+        }
+        for (f in 0 until faceCount) {
+            if (slotOfFace[f] >= 0) continue
+            for (s in 0 until slotCount) {
+                if (slotClaimed[s]) continue
+                hideSlot(s)
+                faceSlots[s].face = faces[f]
+                slotOfFace[f] = s
+                slotClaimed[s] = true
+                break
+            }
+        }
+        for (s in faceSlots.indices) {
+            if (!slotClaimed[s]) hideSlot(s)
+        }
+
+        for (f in 0 until faceCount) {
+            val vertices = meshVertices[f] ?: continue
+            val faceMatrix = faceMatrices[f]
+            val slotIndex = slotOfFace[f]
+            val slot = faceSlots[slotIndex]
+            val instance = entry.instances[slotIndex]
+
+            // Nose bridge position (vertices 351 and 122) and face rotation, smoothed in world space
+            // and extrapolated to when this frame is displayed
+            if (!slot.poseSolver.update(vertices, faceMatrix, timestampNanos, predictionNanos, glassesMatrix16)) continue
+
+            engine.transformManager.setTransform(engine.transformManager.getInstance(instance.root), glassesMatrix16)
+
+            // Coarser levels as the face moves away from the camera
+            if (entry.instanceLods[slotIndex].isNotEmpty()) {
+                val level = slot.lodSelector.update(faceMatrix, cameraMatrix)
+                if (level != slot.shownLod) showLod(slotIndex, level)
+            }
+
+            if (!slot.visible) {
+                scene.addEntities(instance.entities)
+                slot.visible = true
+                // Drop the levels of detail that aren't selected again
+                showLod(slotIndex, slot.shownLod)
+            }
+        }
+    }
 
-        val centerX = (left[0] + right[0]) / 2f
-        val centerY = (left[1] + right[1]) / 2f
-        val centerZ = (left[2] + right[2]) / 2f
+    /**
+     * Take a slot's instance of the shown model out of the scene.
+     */
+    private fun removeSlotFromScene(slotIndex: Int) {
+        val slot = faceSlots[slotIndex]
+        // Out of the scene, so Filament neither culls nor transforms the glasses while no face is tracked
+        if (slot.visible) {
+            shownEntry?.let { scene.removeEntities(it.instances[slotIndex].entities) }
+            slot.visible = false
+        }
+    }
 
-        face.centerPose.toMatrix(tempMatrix16, 0)
-        return MatrixUtils.transformToWorld(centerX, centerY, centerZ, tempMatrix16, tempVec4)
+    /**
+     * Take a slot's glasses out of the scene and forget the face it followed.
+     */
+    private fun hideSlot(slotIndex: Int) {
+        val slot = faceSlots[slotIndex]
+        removeSlotFromScene(slotIndex)
+        slot.face = null
+        slot.poseSolver.reset()
+        slot.lodSelector.reset()
     }
 
     /**
-     * Hide glasses by moving off-screen.
+     * Remove the glasses from the scene until the next tracked face.
      */
     fun hide() {
-        glassesAsset?.let { asset ->
-            val instance = engine.transformManager.getInstance(asset.root)
-            engine.transformManager.setTransform(instance, MatrixUtils.createHideMatrix())
+        for (slotIndex in faceSlots.indices) {
+            hideSlot(slotIndex)
+        }
+    }
+
+    /**
+     * Number of face slots, clamped to [1, [VtoCore.MAX_TRACKED_FACES]] (default 1). Raising it
+     * reloads pooled models that were created with fewer instances.
+     */
+    fun setMaxFaces(maxFaces: Int) {
+        val slotCount = maxFaces.coerceIn(1, VtoCore.MAX_TRACKED_FACES)
+        if (slotCount == faceSlotCount) return
+        faceSlotCount = slotCount
+        Log.d(TAG, "Face slots updated: $slotCount")
+        if (!::assetLoader.isInitialized || destroyed) return
+
+        // Instances can't be added once an asset's source data is released: pooled models with too few
+        // are dropped, and the shown one is loaded again (from the download cache)
+        val reloadShown = (shownEntry?.instances?.size ?: slotCount) < slotCount
+        val iterator = pool.values.iterator()
+        while (iterator.hasNext()) {
+            val entry = iterator.next()
+            if (entry.instances.size >= slotCount) continue
+            iterator.remove()
+            releaseEntry(entry)
+        }
+        if (reloadShown) showModel(currentModelUrl)
+        prefetchModels(compareUrls)
+    }
+
+    /**
+     * Keep these models loaded side by side (downloaded and decoded ahead, never evicted) for
+     * [setActiveModel]. An empty list returns them to the pool's budget.
+     */
+    fun setCompareModels(urls: List<String>) {
+        val previousUrls = compareUrls
+        compareUrls = urls.toList()
+        Log.d(TAG, "Compare models updated: ${urls.size}")
+
+        // Models dropped from the set go back to the pool's budget; a download nobody waits for stops
+        for (url in previousUrls) {
+            if (!compareUrls.contains(url) && url != currentModelUrl) cancelDownload(url)
         }
-        resetFilters()
+        prefetchModels(compareUrls)
+        evictToBudget()
+        publishMemoryStats()
     }
 
-    private fun resetFilters() {
-        positionFilter.reset()
-        rotationFilter.reset()
+    /**
+     * Show the compare model at [index]. Once it is loaded this only changes which instances are in
+     * the scene, and the glasses keep their pose.
+     */
+    fun setActiveModel(index: Int) {
+        val url = compareUrls.getOrNull(index) ?: run {
+            Log.w(TAG, "No compare model at index $index (${compareUrls.size} set)")
+            return
+        }
+        val entry = pool[url] ?: run {
+            // Still downloading: shown once it lands, like any other switch
+            switchModel(url)
+            return
+        }
+        if (entry === shownEntry) return
+
+        // Already resident: swap which instances are in the scene, keeping the glasses' pose
+        currentModelUrl = url
+        activate(entry, keepPose = true)
+        Log.d(TAG, "Active compare model $index: $url")
     }
 
     /**
      * Set forward offset for glasses positioning (in meters).
      */
     fun setForwardOffset(offset: Float) {
-        forwardOffset = offset
+        for (slot in faceSlots) {
+            slot.poseSolver.setForwardOffset(offset)
+        }
     }
 
     /**
-     * Switch to a different glasses model.
+     * Switch to a different glasses model (instant when it is already in the pool).
      * @param modelUrl URL to the new model (GLB format)
      */
     fun switchModel(modelUrl: String) {
-        // Remove current model from scene
-        glassesAsset?.let { asset ->
-            scene.removeEntities(asset.entities)
-            assetLoader.destroyAsset(asset)
-        }
-        glassesAsset = null
-        resetFilters()
+        // Take the current model out of the scene; it stays warm in the pool
+        removeShownAssetFromScene()
+        hide()
 
-        // Update current model info
+        // Latest request wins: a download of the previous model no longer holds up bandwidth
+        if (currentModelUrl != modelUrl) {
+            cancelDownload(currentModelUrl)
+        }
         currentModelUrl = modelUrl
 
-        // Load new model
-        loadModel(modelUrl)
+        // Load new model (instant when prefetched)
+        showModel(modelUrl)
         Log.d(TAG, "Switched to model: $modelUrl")
     }
 
@@ -231,12 +667,20 @@ class GlassesRenderer(private val context: Context) {
      * Clean up resources.
      */
     fun destroy() {
-        executor.shutdown()
-        glassesAsset?.let {
-            scene.removeEntities(it.entities)
-            assetLoader.destroyAsset(it)
+        destroyed = true
+        for (token in pendingDownloads.values) {
+            token.cancel()
         }
+        pendingDownloads.clear()
+        for (entry in pool.values) {
+            releaseEntry(entry)
+        }
+        pool.clear()
         resourceLoader.destroy()
         assetLoader.destroy()
+        for (slot in faceSlots) {
+            slot.poseSolver.destroy()
+            slot.lodSelector.destroy()
+        }
     }
 }
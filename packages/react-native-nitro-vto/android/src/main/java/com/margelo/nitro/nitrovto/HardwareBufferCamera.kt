@@ -0,0 +1,38 @@
+package com.margelo.nitro.nitrovto
+
+import android.hardware.HardwareBuffer
+import android.os.Build
+
+/**
+ * JNI bindings importing ARCore's camera [HardwareBuffer]s as EGLImages, for Filament external
+ * textures without a shared EGL context (see HardwareBufferCameraJni.cpp).
+ * The native library is loaded by NitroVtoOnLoad.
+ */
+internal object HardwareBufferCamera {
+
+    /**
+     * True if camera frames can be imported as hardware buffers: ARCore exposes them from API 27,
+     * and EGL must be able to wrap them in an EGLImage.
+     */
+    fun isAvailable(): Boolean =
+        Build.VERSION.SDK_INT >= Build.VERSION_CODES.O_MR1 && isSupported()
+
+    @JvmStatic
+    private external fun isSupported(): Boolean
+
+    /** Create a cache of one EGLImage per camera buffer; 0 if unsupported */
+    @JvmStatic
+    external fun createImageCache(): Long
+
+    /**
+     * EGLImage for [buffer], created the first time the buffer is seen. Stays valid until the cache
+     * is destroyed or the buffer hasn't been seen for several frames.
+     * @return EGLImageKHR handle, or 0 if the buffer can't be imported
+     */
+    @JvmStatic
+    external fun imageFor(cache: Long, buffer: HardwareBuffer): Long
+
+    /** Destroy every EGLImage of the cache; Filament must be done with them (flushAndWait) */
+    @JvmStatic
+    external fun destroyImageCache(cache: Long)
+}
@@ -2,6 +2,7 @@ package com.margelo.nitro.nitrovto
 
 import android.view.View
 import com.facebook.react.uimanager.ThemedReactContext
+import com.margelo.nitro.core.ArrayBuffer
 
 /**
  * HybridNitroVtoView - NitroModules HybridView implementation for NitroVto.
@@ -39,6 +40,12 @@ class HybridNitroVtoView(private val reactContext: ThemedReactContext) : HybridN
             nitroVtoView.onModelLoaded = value
         }
 
+    override var onModelLoadProgress: ((modelUrl: String, progress: Double) -> Unit)? = null
+        set(value) {
+            field = value
+            nitroVtoView.onModelLoadProgress = value
+        }
+
     override var faceMeshOcclusion: Boolean? = null
         set(value) {
             field = value
@@ -57,12 +64,36 @@ class HybridNitroVtoView(private val reactContext: ThemedReactContext) : HybridN
             nitroVtoView.setForwardOffset(value)
         }
 
+    override var maxFaces: Double? = null
+        set(value) {
+            field = value
+            nitroVtoView.setMaxFaces(value)
+        }
+
     override var debug: Boolean? = null
         set(value) {
             field = value
             nitroVtoView.setDebug(value)
         }
 
+    override var adaptivePerformance: Boolean? = null
+        set(value) {
+            field = value
+            nitroVtoView.setAdaptivePerformance(value)
+        }
+
+    override var onPerformanceChange: ((renderScale: Double, frameRate: Double, reason: String) -> Unit)? = null
+        set(value) {
+            field = value
+            nitroVtoView.onPerformanceChange = value
+        }
+
+    override var onCaptureComplete: ((filePath: String, durationSeconds: Double) -> Unit)? = null
+        set(value) {
+            field = value
+            nitroVtoView.onCaptureComplete = value
+        }
+
     // Methods implementation
     override fun switchModel(modelUrl: String) {
         nitroVtoView.switchModel(modelUrl)
@@ -72,6 +103,77 @@ class HybridNitroVtoView(private val reactContext: ThemedReactContext) : HybridN
         nitroVtoView.resetSession()
     }
 
+    override fun prefetchModels(modelUrls: Array<String>) {
+        nitroVtoView.prefetchModels(modelUrls.toList())
+    }
+
+    override fun setCompareModels(modelUrls: Array<String>) {
+        nitroVtoView.setCompareModels(modelUrls.toList())
+    }
+
+    override fun setActiveModel(index: Double) {
+        nitroVtoView.setActiveModel(maxOf(index.toInt(), 0))
+    }
+
+    override fun setEnvironment(name: String) {
+        nitroVtoView.setEnvironment(name)
+    }
+
+    override fun getModelMemoryStats(): ModelMemoryStats {
+        return nitroVtoView.getModelMemoryStats()
+    }
+
+    override fun getFacePoseBuffer(): ArrayBuffer {
+        return nitroVtoView.getFacePoseBuffer()
+    }
+
+    override fun warmUp() {
+        nitroVtoView.warmUp()
+    }
+
+    override fun getModelCacheStats(): ModelCacheStats {
+        val stats = ModelDownloader.stats(reactContext)
+        return ModelCacheStats(
+            stats.fileCount.toDouble(),
+            stats.totalBytes.toDouble(),
+            stats.byteLimit.toDouble(),
+            stats.hitCount.toDouble(),
+            stats.missCount.toDouble()
+        )
+    }
+
+    override fun getPerformanceStats(): PerformanceStats {
+        return nitroVtoView.getPerformanceStats()
+    }
+
+    override fun startFaceRecording(filePath: String) {
+        nitroVtoView.startFaceRecording(filePath)
+    }
+
+    override fun stopFaceRecording() {
+        nitroVtoView.stopFaceRecording()
+    }
+
+    override fun capture(filePath: String) {
+        nitroVtoView.capture(filePath)
+    }
+
+    override fun startRecording(filePath: String) {
+        nitroVtoView.startRecording(filePath)
+    }
+
+    override fun stopRecording() {
+        nitroVtoView.stopRecording()
+    }
+
+    override fun clearModelCache() {
+        ModelDownloader.clearCache(reactContext)
+    }
+
+    override fun setModelCacheLimit(maxBytes: Double) {
+        ModelDownloader.cacheByteLimit = maxBytes.toLong().coerceAtLeast(0L)
+    }
+
     // Lifecycle callbacks from HybridView base class
     override fun beforeUpdate() {
         // Called before props are updated
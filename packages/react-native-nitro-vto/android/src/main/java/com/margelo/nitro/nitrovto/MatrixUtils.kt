@@ -1,7 +1,5 @@
 package com.margelo.nitro.nitrovto
 
-import android.opengl.Matrix
-import com.google.ar.core.AugmentedFace
 import java.nio.ByteBuffer
 import java.nio.ByteOrder
 import java.nio.FloatBuffer
@@ -12,49 +10,6 @@ import java.nio.ShortBuffer
  */
 object MatrixUtils {
 
-    /**
-     * Convert quaternion to 4x4 rotation matrix (column-major).
-     */
-    fun quaternionToMatrix(q: FloatArray): FloatArray {
-        val qx = q[0]
-        val qy = q[1]
-        val qz = q[2]
-        val qw = q[3]
-        return floatArrayOf(
-            1 - 2*qy*qy - 2*qz*qz,  2*qx*qy + 2*qz*qw,      2*qx*qz - 2*qy*qw,      0f,
-            2*qx*qy - 2*qz*qw,      1 - 2*qx*qx - 2*qz*qz,  2*qy*qz + 2*qx*qw,      0f,
-            2*qx*qz + 2*qy*qw,      2*qy*qz - 2*qx*qw,      1 - 2*qx*qx - 2*qy*qy,  0f,
-            0f,                     0f,                     0f,                     1f
-        )
-    }
-
-    /**
-     * Transform a local position to world coordinates using a pose matrix.
-     */
-    fun transformToWorld(
-        localX: Float, localY: Float, localZ: Float,
-        poseMatrix: FloatArray,
-        tempVec4: FloatArray
-    ): FloatArray {
-        tempVec4[0] = localX
-        tempVec4[1] = localY
-        tempVec4[2] = localZ
-        tempVec4[3] = 1f
-        val worldPos = FloatArray(4)
-        Matrix.multiplyMV(worldPos, 0, poseMatrix, 0, tempVec4, 0)
-        return worldPos
-    }
-
-    /**
-     * Create a hide matrix (translates far on Z axis).
-     */
-    fun createHideMatrix(): FloatArray {
-        val hideMatrix = FloatArray(16)
-        Matrix.setIdentityM(hideMatrix, 0)
-        Matrix.translateM(hideMatrix, 0, 0f, 0f, -1000f)
-        return hideMatrix
-    }
-
     /**
      * Create a direct FloatBuffer from a float array.
      */
@@ -65,6 +20,14 @@ object MatrixUtils {
             .put(data)
             .apply { flip() }
 
+    /**
+     * Create an empty direct FloatBuffer holding [size] floats.
+     */
+    fun createFloatBuffer(size: Int): FloatBuffer =
+        ByteBuffer.allocateDirect(size * 4)
+            .order(ByteOrder.nativeOrder())
+            .asFloatBuffer()
+
     /**
      * Create a direct ShortBuffer from a short array.
      */
@@ -74,19 +37,4 @@ object MatrixUtils {
             .asShortBuffer()
             .put(data)
             .apply { flip() }
-
-    /**
-     * Form the ARCore canonical_face_mesh get x,y,z position of a given vertice.
-     * See https://github.com/google-ar/arcore-android-sdk/blob/main/assets/canonical_face_mesh.fbx
-     */
-    fun getPositionForVertice(index: Int, face: AugmentedFace): FloatArray {
-        val meshBuffer = face.meshVertices
-
-        val x = meshBuffer.get(index * 3)
-        val y = meshBuffer.get(index * 3 + 1)
-        val z = meshBuffer.get(index * 3 + 2)
-
-        return floatArrayOf(x, y, z)
-    }
-
 }
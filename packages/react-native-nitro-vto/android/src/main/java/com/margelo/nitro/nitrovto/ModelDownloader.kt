@@ -0,0 +1,577 @@
+package com.margelo.nitro.nitrovto
+
+import android.content.Context
+import android.util.Log
+import org.json.JSONObject
+import java.io.File
+import java.io.FileOutputStream
+import java.io.IOException
+import java.net.HttpURLConnection
+import java.net.URL
+import java.security.MessageDigest
+import java.util.Properties
+import java.util.concurrent.Executors
+
+/**
+ * Streams remote GLB models straight into the glb_cache directory.
+ * - Requests for the same URL share one transfer; different URLs download concurrently.
+ * - Cancelled or interrupted transfers keep their partial file and resume with a Range request.
+ * - Cached files are revalidated with If-None-Match / If-Modified-Since once older than the
+ *   revalidation interval. The cached copy is still served when the network is unavailable.
+ * - An index (size, last access, SHA-256, validators) tracks every cached file. Files are only
+ *   trusted when they match it, and least recently used ones are evicted beyond [cacheByteLimit].
+ */
+internal object ModelDownloader {
+
+    private const val TAG = "ModelDownloader"
+    private const val CACHE_DIR = "glb_cache"
+    private const val DEFAULT_BUFFER_SIZE = 64 * 1024
+    private const val MAX_CONCURRENT_DOWNLOADS = 4
+    private const val CONNECT_TIMEOUT_MS = 15000
+    private const val READ_TIMEOUT_MS = 30000
+    // Cached models are trusted this long before the next conditional request
+    private const val REVALIDATE_INTERVAL_MS = 60 * 60 * 1000L
+    private const val DEFAULT_CACHE_BYTE_LIMIT = 200L * 1024 * 1024
+    // Partial files nobody resumed within this long are deleted at startup
+    private const val PART_FILE_MAX_AGE_MS = 24 * 60 * 60 * 1000L
+
+    // Cache index (index.json): URL hash -> entry
+    private const val INDEX_FILE = "index.json"
+    private const val INDEX_VERSION = 1
+    private const val INDEX_KEY_VERSION = "version"
+    private const val INDEX_KEY_ENTRIES = "entries"
+    private const val ENTRY_URL = "url"
+    private const val ENTRY_SIZE = "size"
+    private const val ENTRY_SHA256 = "sha256"
+    private const val ENTRY_LAST_ACCESS = "lastAccess"
+    private const val ENTRY_VALIDATED_AT = "validatedAt"
+
+    // Validator keys, in index entries and in <hash>.part.properties next to a partial file
+    private const val META_ETAG = "etag"
+    private const val META_LAST_MODIFIED = "lastModified"
+
+    /** Snapshot of the on-disk model cache. Hits / misses count loads since app start. */
+    data class CacheStats(
+        val fileCount: Int,
+        val totalBytes: Long,
+        val byteLimit: Long,
+        val hitCount: Int,
+        val missCount: Int
+    )
+
+    /** Index entry for one cached file. Guarded by [lock]. */
+    private class Entry(
+        val url: String,
+        val size: Long,
+        val sha256: String,
+        var lastAccess: Long,
+        var validatedAt: Long,
+        val etag: String?,
+        val lastModified: String?
+    ) {
+        fun toJson(): JSONObject = JSONObject().apply {
+            put(ENTRY_URL, url)
+            put(ENTRY_SIZE, size)
+            put(ENTRY_SHA256, sha256)
+            put(ENTRY_LAST_ACCESS, lastAccess)
+            put(ENTRY_VALIDATED_AT, validatedAt)
+            etag?.let { put(META_ETAG, it) }
+            lastModified?.let { put(META_LAST_MODIFIED, it) }
+        }
+
+        companion object {
+            fun fromJson(json: JSONObject) = Entry(
+                json.getString(ENTRY_URL),
+                json.getLong(ENTRY_SIZE),
+                json.getString(ENTRY_SHA256),
+                json.optLong(ENTRY_LAST_ACCESS),
+                json.optLong(ENTRY_VALIDATED_AT),
+                json.optString(META_ETAG).ifEmpty { null },
+                json.optString(META_LAST_MODIFIED).ifEmpty { null }
+            )
+        }
+    }
+
+    /**
+     * One caller's interest in a download. Cancelling drops its callback, and stops the
+     * transfer once no other caller is waiting on the same URL.
+     */
+    class Token internal constructor(
+        internal val url: String,
+        internal var callback: ((file: File?, error: Exception?) -> Unit)?
+    ) {
+        fun cancel() = cancelToken(this)
+    }
+
+    /** One transfer, shared by every token waiting on its URL. Guarded by [lock]. */
+    private class Download(val url: String, val hash: String, val cacheFile: File, val partFile: File) {
+        val tokens = ArrayList<Token>()
+        @Volatile var cancelled = false
+        @Volatile var connection: HttpURLConnection? = null
+    }
+
+    private class CancelledException : IOException("Download cancelled")
+
+    private val lock = Any()
+    private val downloads = HashMap<String, Download>()
+    private val executor = Executors.newFixedThreadPool(MAX_CONCURRENT_DOWNLOADS)
+
+    // Loaded with the cache directory on first use
+    private var cacheDir: File? = null
+    private val index = HashMap<String, Entry>()
+    // Files whose SHA-256 was checked against the index since launch
+    private val verifiedHashes = HashSet<String>()
+    private var hitCount = 0
+    private var missCount = 0
+
+    /** Byte budget for cached models (default 200 MB). Lowering it evicts on the next cache write. */
+    @Volatile var cacheByteLimit = DEFAULT_CACHE_BYTE_LIMIT
+        set(value) {
+            field = value
+            synchronized(lock) {
+                if (cacheDir != null && evictToBudget(null)) saveIndex()
+            }
+        }
+
+    /**
+     * Make the model at [urlString] available in the cache, downloading or revalidating as needed.
+     * [callback] runs on a download thread with the cached file, or an error.
+     */
+    fun download(context: Context, urlString: String, callback: (file: File?, error: Exception?) -> Unit): Token {
+        val token = Token(urlString, callback)
+        synchronized(lock) {
+            val existing = downloads[urlString]
+            if (existing != null) {
+                // Joining a transfer that is being cancelled restarts it once the cancel lands
+                existing.tokens.add(token)
+                return token
+            }
+
+            val cacheDir = cacheDirectory(context)
+            val hash = hashUrl(urlString)
+            val download = Download(urlString, hash, File(cacheDir, "$hash.glb"), File(cacheDir, "$hash.part"))
+            download.tokens.add(token)
+            downloads[urlString] = download
+            executor.execute { run(download) }
+        }
+        return token
+    }
+
+    private fun cancelToken(token: Token) {
+        synchronized(lock) {
+            if (token.callback == null) return
+            token.callback = null
+
+            val download = downloads[token.url] ?: return
+            download.tokens.remove(token)
+            if (download.tokens.isEmpty() && !download.cancelled) {
+                // The partial file stays on disk, so a later request resumes where this one stopped
+                Log.d(TAG, "Cancelling download: ${token.url}")
+                download.cancelled = true
+                download.connection?.disconnect()
+            }
+        }
+    }
+
+    private fun run(download: Download) {
+        var file: File? = null
+        var error: Exception? = null
+        try {
+            file = fetch(download)
+        } catch (e: Exception) {
+            error = e
+        }
+
+        val tokens: List<Token>
+        synchronized(lock) {
+            if (download.cancelled) {
+                if (download.tokens.isEmpty()) {
+                    // Nobody wants it any more; keep the partial file for the next request
+                    downloads.remove(download.url)
+                    return
+                }
+                // Cancelled, then requested again before the cancel landed: start over (resuming)
+                val restarted = Download(download.url, download.hash, download.cacheFile, download.partFile)
+                restarted.tokens.addAll(download.tokens)
+                downloads[download.url] = restarted
+                executor.execute { run(restarted) }
+                return
+            }
+            downloads.remove(download.url)
+            tokens = download.tokens.toList()
+        }
+
+        if (error != null) {
+            Log.e(TAG, "Failed to download GLB from URL: ${error.message}")
+        }
+        for (token in tokens) {
+            val callback = synchronized(lock) { token.callback.also { token.callback = null } }
+            callback?.invoke(file, error)
+        }
+    }
+
+    private fun fetch(download: Download): File {
+        val cacheFile = download.cacheFile
+        val partFile = download.partFile
+        val entry = trustedEntry(download.hash)
+        val revalidating = entry != null
+
+        if (entry != null && System.currentTimeMillis() - entry.validatedAt < REVALIDATE_INTERVAL_MS) {
+            Log.d(TAG, "Cache hit: ${cacheFile.absolutePath}")
+            recordHit(download.hash)
+            return cacheFile
+        }
+
+        val connection = URL(download.url).openConnection() as HttpURLConnection
+        download.connection = connection
+        try {
+            connection.connectTimeout = CONNECT_TIMEOUT_MS
+            connection.readTimeout = READ_TIMEOUT_MS
+            connection.useCaches = false
+
+            var partSize = 0L
+            if (revalidating) {
+                // Conditional GET: 304 keeps the cached file, 200 replaces it
+                entry?.etag?.let { connection.setRequestProperty("If-None-Match", it) }
+                entry?.lastModified?.let { connection.setRequestProperty("If-Modified-Since", it) }
+                Log.d(TAG, "Revalidating cached model: ${download.url}")
+            } else {
+                // Resume a partial file when its validator lets the server confirm it is the same version
+                val partMeta = readMeta(metaFileFor(partFile))
+                val validator = partMeta.getProperty(META_ETAG) ?: partMeta.getProperty(META_LAST_MODIFIED)
+                if (validator != null && partFile.length() > 0) {
+                    partSize = partFile.length()
+                    connection.setRequestProperty("Range", "bytes=$partSize-")
+                    connection.setRequestProperty("If-Range", validator)
+                    Log.d(TAG, "Resuming download at $partSize bytes: ${download.url}")
+                } else {
+                    Log.d(TAG, "Starting download: ${download.url}")
+                }
+            }
+
+            if (download.cancelled) throw CancelledException()
+            val responseCode = connection.responseCode
+
+            if (responseCode == HttpURLConnection.HTTP_NOT_MODIFIED && revalidating) {
+                synchronized(lock) { index[download.hash]?.validatedAt = System.currentTimeMillis() }
+                recordHit(download.hash)
+                Log.d(TAG, "Cached model still current: ${download.url}")
+                return cacheFile
+            }
+
+            // 206 continues the partial file; a 200 (new version, or no range support) starts it over
+            val resuming = when (responseCode) {
+                HttpURLConnection.HTTP_OK -> false
+                HttpURLConnection.HTTP_PARTIAL -> {
+                    val contentRange = connection.getHeaderField("Content-Range") ?: ""
+                    if (!contentRange.startsWith("bytes $partSize-")) {
+                        partFile.delete()
+                        throw IOException("Unexpected Content-Range: $contentRange")
+                    }
+                    true
+                }
+                416 -> {
+                    // The partial file no longer matches anything the server has
+                    partFile.delete()
+                    throw IOException("HTTP error code: $responseCode")
+                }
+                else -> throw IOException("HTTP error code: $responseCode")
+            }
+
+            val responseMeta = if (resuming) {
+                readMeta(metaFileFor(partFile))
+            } else {
+                Properties().apply {
+                    connection.getHeaderField("ETag")?.let { setProperty(META_ETAG, it) }
+                    connection.getHeaderField("Last-Modified")?.let { setProperty(META_LAST_MODIFIED, it) }
+                    // Written up front, so an interrupted transfer can be resumed with If-Range
+                    writeMeta(metaFileFor(partFile), this)
+                }
+            }
+
+            // Streamed straight to disk: the model is never held in memory as a whole
+            var bytesWritten = if (resuming) partSize else 0L
+            connection.inputStream.use { input ->
+                FileOutputStream(partFile, resuming).use { output ->
+                    val buffer = ByteArray(DEFAULT_BUFFER_SIZE)
+                    while (true) {
+                        if (download.cancelled) throw CancelledException()
+                        val bytesRead = input.read(buffer)
+                        if (bytesRead == -1) break
+                        output.write(buffer, 0, bytesRead)
+                        bytesWritten += bytesRead
+                    }
+                }
+            }
+            Log.d(TAG, "Downloaded $bytesWritten bytes: ${download.url}")
+
+            commit(download, responseMeta)
+            return cacheFile
+        } catch (e: Exception) {
+            if (download.cancelled) throw CancelledException()
+            if (revalidating && synchronized(lock) { index.containsKey(download.hash) }) {
+                // Offline or server trouble: the cached copy beats no model
+                Log.w(TAG, "Revalidation failed (${e.message}), using cached model")
+                recordHit(download.hash)
+                return cacheFile
+            }
+            throw e
+        } finally {
+            download.connection = null
+            connection.disconnect()
+        }
+    }
+
+    /** Current cache usage */
+    fun stats(context: Context): CacheStats = synchronized(lock) {
+        cacheDirectory(context)
+        CacheStats(index.size, indexedBytes(), cacheByteLimit, hitCount, missCount)
+    }
+
+    /** Delete every cached model; downloads in flight still complete into the cache */
+    fun clearCache(context: Context) {
+        synchronized(lock) {
+            val cacheDir = cacheDirectory(context)
+            val activeHashes = downloads.values.map { it.hash }.toSet()
+            cacheDir.listFiles()?.forEach { file ->
+                if (file.name != INDEX_FILE && file.name.substringBefore('.') !in activeHashes) {
+                    file.delete()
+                }
+            }
+            index.keys.retainAll(activeHashes)
+            saveIndex()
+        }
+        Log.d(TAG, "Cache cleared")
+    }
+
+    /**
+     * Atomically move a complete partial file over the cached one, then index it.
+     */
+    private fun commit(download: Download, responseMeta: Properties) {
+        val sha256 = sha256Of(download.partFile) ?: throw IOException("Failed to read downloaded file")
+
+        synchronized(lock) {
+            // The old file leaves the index first: a crash past this point leaves an unindexed file,
+            // which is deleted at startup rather than trusted
+            index.remove(download.hash)
+            verifiedHashes.remove(download.hash)
+            saveIndex()
+
+            // rename() replaces the cached file atomically
+            if (!download.partFile.renameTo(download.cacheFile)) {
+                throw IOException("Failed to save to cache: ${download.cacheFile.absolutePath}")
+            }
+            metaFileFor(download.partFile).delete()
+
+            val now = System.currentTimeMillis()
+            index[download.hash] = Entry(
+                download.url,
+                download.cacheFile.length(),
+                sha256,
+                now,
+                now,
+                responseMeta.getProperty(META_ETAG),
+                responseMeta.getProperty(META_LAST_MODIFIED)
+            )
+            verifiedHashes.add(download.hash)
+            missCount++
+
+            evictToBudget(download.hash)
+            saveIndex()
+        }
+        Log.d(TAG, "Saved ${download.cacheFile.length()} bytes to cache: ${download.cacheFile.absolutePath}")
+    }
+
+    /**
+     * The index entry for [hash], if its file is present and matches it (content checked once per launch).
+     */
+    private fun trustedEntry(hash: String): Entry? {
+        val cacheDir: File
+        val entry: Entry
+        val verified: Boolean
+        synchronized(lock) {
+            cacheDir = this.cacheDir ?: return null
+            entry = index[hash] ?: return null
+            verified = hash in verifiedHashes
+        }
+
+        val cacheFile = File(cacheDir, "$hash.glb")
+        var intact = cacheFile.length() == entry.size
+        if (intact && !verified) {
+            // Hashed outside the lock, so other downloads aren't held up by a large file
+            intact = sha256Of(cacheFile) == entry.sha256
+        }
+
+        synchronized(lock) {
+            if (index[hash] !== entry) return index[hash]
+            if (intact) {
+                verifiedHashes.add(hash)
+                return entry
+            }
+            Log.w(TAG, "Cached model does not match the index, discarding: ${entry.url}")
+            cacheFile.delete()
+            index.remove(hash)
+            saveIndex()
+        }
+        return null
+    }
+
+    private fun recordHit(hash: String) {
+        synchronized(lock) {
+            index[hash]?.lastAccess = System.currentTimeMillis()
+            hitCount++
+            saveIndex()
+        }
+    }
+
+    /** Called with [lock] held */
+    private fun indexedBytes(): Long = index.values.sumOf { it.size }
+
+    /**
+     * Delete least recently used models until the index fits the budget. Returns true if any went.
+     * Files being downloaded are kept; a model already loaded stays valid after its file is deleted.
+     * Called with [lock] held.
+     */
+    private fun evictToBudget(keepHash: String?): Boolean {
+        val cacheDir = cacheDir ?: return false
+        val limit = cacheByteLimit
+        var total = indexedBytes()
+        if (total <= limit) return false
+
+        val activeHashes = downloads.values.map { it.hash }.toSet()
+        var evicted = false
+        for ((hash, entry) in index.entries.sortedBy { it.value.lastAccess }) {
+            if (total <= limit) break
+            if (hash == keepHash || hash in activeHashes) continue
+
+            File(cacheDir, "$hash.glb").delete()
+            index.remove(hash)
+            total -= entry.size
+            evicted = true
+            Log.d(TAG, "Evicted ${entry.url} (${entry.size} bytes)")
+        }
+        return evicted
+    }
+
+    /**
+     * The cache directory; loads the index and makes the directory match it on first use
+     * (unindexed models and old partial files go). Called with [lock] held.
+     */
+    private fun cacheDirectory(context: Context): File {
+        this.cacheDir?.let { return it }
+
+        val cacheDir = File(context.cacheDir, CACHE_DIR)
+        if (!cacheDir.exists()) {
+            cacheDir.mkdirs()
+        }
+        this.cacheDir = cacheDir
+        loadIndex(cacheDir)
+        return cacheDir
+    }
+
+    private fun loadIndex(cacheDir: File) {
+        val indexFile = File(cacheDir, INDEX_FILE)
+        if (indexFile.exists()) {
+            try {
+                val json = JSONObject(indexFile.readText())
+                if (json.optInt(INDEX_KEY_VERSION) == INDEX_VERSION) {
+                    val entries = json.getJSONObject(INDEX_KEY_ENTRIES)
+                    for (hash in entries.keys()) {
+                        index[hash] = Entry.fromJson(entries.getJSONObject(hash))
+                    }
+                }
+            } catch (e: Exception) {
+                // Unreadable or corrupt: start over with an empty cache
+                Log.w(TAG, "Failed to read cache index: ${e.message}")
+                index.clear()
+            }
+        }
+
+        val now = System.currentTimeMillis()
+        val presentHashes = HashSet<String>()
+        cacheDir.listFiles()?.forEach { file ->
+            val hash = file.name.substringBefore('.')
+            val keep = when {
+                file.name == INDEX_FILE -> true
+                file.name.endsWith(".glb") -> (hash in index).also { if (it) presentHashes.add(hash) }
+                file.name.endsWith(".part") || file.name.endsWith(".part.properties") ->
+                    now - file.lastModified() < PART_FILE_MAX_AGE_MS
+                else -> false
+            }
+            if (!keep) file.delete()
+        }
+
+        index.keys.retainAll(presentHashes)
+        evictToBudget(null)
+        saveIndex()
+        Log.d(TAG, "Cache index loaded: ${index.size} models, ${indexedBytes()} bytes")
+    }
+
+    /** Written to a temporary file and renamed, so a crash never leaves a torn index. Called with [lock] held. */
+    private fun saveIndex() {
+        val cacheDir = cacheDir ?: return
+        try {
+            val entries = JSONObject()
+            for ((hash, entry) in index) {
+                entries.put(hash, entry.toJson())
+            }
+            val json = JSONObject().put(INDEX_KEY_VERSION, INDEX_VERSION).put(INDEX_KEY_ENTRIES, entries)
+
+            val tmpFile = File(cacheDir, "$INDEX_FILE.tmp")
+            tmpFile.writeText(json.toString())
+            if (!tmpFile.renameTo(File(cacheDir, INDEX_FILE))) {
+                throw IOException("rename failed")
+            }
+        } catch (e: Exception) {
+            // IOException, or JSONException for a non-finite number
+            Log.w(TAG, "Failed to write cache index: ${e.message}")
+        }
+    }
+
+    private fun hashUrl(urlString: String): String {
+        val digest = MessageDigest.getInstance("SHA-256")
+        val hashBytes = digest.digest(urlString.toByteArray())
+        return hashBytes.joinToString("") { "%02x".format(it) }
+    }
+
+    /** SHA-256 of a file's content, streamed; null if it can't be read */
+    private fun sha256Of(file: File): String? {
+        return try {
+            val digest = MessageDigest.getInstance("SHA-256")
+            file.inputStream().use { input ->
+                val buffer = ByteArray(DEFAULT_BUFFER_SIZE)
+                while (true) {
+                    val bytesRead = input.read(buffer)
+                    if (bytesRead == -1) break
+                    digest.update(buffer, 0, bytesRead)
+                }
+            }
+            digest.digest().joinToString("") { "%02x".format(it) }
+        } catch (e: IOException) {
+            Log.w(TAG, "Failed to hash ${file.name}: ${e.message}")
+            null
+        }
+    }
+
+    private fun metaFileFor(partFile: File): File = File(partFile.parentFile, "${partFile.name}.properties")
+
+    private fun readMeta(file: File): Properties {
+        val meta = Properties()
+        if (file.exists()) {
+            try {
+                file.inputStream().use { meta.load(it) }
+            } catch (e: IOException) {
+                Log.w(TAG, "Failed to read cache metadata: ${e.message}")
+            }
+        }
+        return meta
+    }
+
+    private fun writeMeta(file: File, meta: Properties) {
+        try {
+            file.outputStream().use { meta.store(it, null) }
+        } catch (e: IOException) {
+            Log.w(TAG, "Failed to write cache metadata: ${e.message}")
+        }
+    }
+}
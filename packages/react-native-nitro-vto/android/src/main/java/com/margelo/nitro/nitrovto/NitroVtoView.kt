@@ -1,9 +1,15 @@
 package com.margelo.nitro.nitrovto
 
 import android.content.Context
+import android.graphics.Color
+import android.graphics.Typeface
+import android.os.Handler
+import android.os.Looper
 import android.util.Log
+import android.view.Gravity
 import android.view.SurfaceView
 import android.widget.FrameLayout
+import android.widget.TextView
 import com.google.ar.core.ArCoreApk
 import com.google.ar.core.Config
 import com.google.ar.core.Session
@@ -12,6 +18,10 @@ import com.google.ar.core.exceptions.UnavailableApkTooOldException
 import com.google.ar.core.exceptions.UnavailableArcoreNotInstalledException
 import com.google.ar.core.exceptions.UnavailableDeviceNotCompatibleException
 import com.google.ar.core.exceptions.UnavailableSdkTooOldException
+import com.google.ar.core.exceptions.UnsupportedConfigurationException
+import com.margelo.nitro.core.ArrayBuffer
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
 import java.util.EnumSet
 
 /**
@@ -33,6 +43,8 @@ class NitroVtoView(context: Context) : FrameLayout(context) {
 
     // ARCore session
     private var arSession: Session? = null
+    // The session runs ENVIRONMENTAL_HDR light estimation rather than AMBIENT_INTENSITY
+    private var environmentalHdrLighting = false
 
     // SurfaceView for rendering
     private val surfaceView: SurfaceView = SurfaceView(context)
@@ -40,12 +52,52 @@ class NitroVtoView(context: Context) : FrameLayout(context) {
     // Filament renderer
     private var vtoRenderer: VTORenderer? = null
 
+    // Per-stage frame times over the view while debug is on, refreshed twice a second
+    private var debugHud: TextView? = null
+    private val debugHudHandler = Handler(Looper.getMainLooper())
+    private val refreshDebugHud = object : Runnable {
+        override fun run() {
+            val hud = debugHud ?: return
+            hud.text = vtoRenderer?.performanceSummary() ?: ""
+            debugHudHandler.postDelayed(this, 500)
+        }
+    }
+
     // Configuration
     private var modelUrl: String = ""
     private var isActive: Boolean = true
+    private var adaptivePerformance: Boolean = false
+    private var maxFaces: Int = 1
+    private var debug: Boolean = false
+    // Prefetch requests made before the renderer exists
+    private val pendingPrefetchUrls = mutableListOf<String>()
+    // Compare set and active model, kept for a renderer created later
+    private var compareModelUrls: List<String> = emptyList()
+    private var pendingActiveModel: Int = -1
+    // Kept across renderer recreation, like the compare models
+    private var environment: String? = null
+
+    // Hybrid methods arrive on the JS thread: they're run here, where the view's state lives and
+    // the renderer's command ring has its single producer
+    private val mainHandler = Handler(Looper.getMainLooper())
+
+    // Face pose buffer shared with JS; the renderer rewrites it every frame
+    private val facePoseBuffer = ByteBuffer.allocateDirect(VtoCore.FACE_POSE_BUFFER_BYTES).order(ByteOrder.nativeOrder())
+    private val facePoseArrayBuffer = ArrayBuffer.wrap(facePoseBuffer)
 
     // Callbacks
     var onModelLoaded: ((modelUrl: String) -> Unit)? = null
+    var onModelLoadProgress: ((modelUrl: String, progress: Double) -> Unit)? = null
+    var onPerformanceChange: ((renderScale: Double, frameRate: Double, reason: String) -> Unit)? = null
+        set(value) {
+            field = value
+            vtoRenderer?.onPerformanceChange = value
+        }
+    var onCaptureComplete: ((filePath: String, durationSeconds: Double) -> Unit)? = null
+        set(value) {
+            field = value
+            vtoRenderer?.onCaptureComplete = value
+        }
 
     // State
     private var isInitialized = false
@@ -106,37 +158,169 @@ class NitroVtoView(context: Context) : FrameLayout(context) {
         vtoRenderer?.setForwardOffset((offset ?: 0.005).toFloat())
     }
 
+    /**
+     * Set how many tracked faces are fitted with glasses. ARCore Augmented Faces has no face-count
+     * setting, so this only caps how many of the faces it tracks are rendered.
+     */
+    fun setMaxFaces(maxFaces: Double?) {
+        this.maxFaces = (maxFaces ?: 1.0).toInt()
+        vtoRenderer?.setMaxFaces(this.maxFaces)
+    }
+
     /**
      * Set debug mode enabled
      */
     fun setDebug(enabled: Boolean?) {
-        vtoRenderer?.setDebug(enabled ?: false)
+        debug = enabled ?: false
+        vtoRenderer?.setDebug(debug)
+        updateDebugHud()
+    }
+
+    /**
+     * Set whether render scale and frame rate adapt to thermal state and frame times
+     */
+    fun setAdaptivePerformance(enabled: Boolean?) {
+        adaptivePerformance = enabled ?: false
+        vtoRenderer?.setAdaptivePerformance(adaptivePerformance)
     }
 
     /**
      * Switch to a different glasses model
      */
     fun switchModel(modelUrl: String) {
-        this.modelUrl = modelUrl
-        vtoRenderer?.switchModel(modelUrl)
+        runOnMainThread {
+            this.modelUrl = modelUrl
+            vtoRenderer?.switchModel(modelUrl)
+        }
+    }
+
+    /**
+     * Download and decode models ahead of time, so a later switchModel to them is instant
+     */
+    fun prefetchModels(modelUrls: List<String>) {
+        runOnMainThread {
+            val renderer = vtoRenderer
+            if (renderer == null) {
+                pendingPrefetchUrls.addAll(modelUrls)
+            } else {
+                renderer.prefetchModels(modelUrls)
+            }
+        }
+    }
+
+    /**
+     * Keep these models loaded side by side, so setActiveModel switches between them instantly
+     */
+    fun setCompareModels(modelUrls: List<String>) {
+        runOnMainThread {
+            compareModelUrls = modelUrls
+            vtoRenderer?.setCompareModels(modelUrls)
+        }
+    }
+
+    /**
+     * Show the compare model at index, keeping the glasses' pose
+     */
+    fun setActiveModel(index: Int) {
+        runOnMainThread {
+            val renderer = vtoRenderer
+            if (renderer == null) {
+                pendingActiveModel = index
+            } else {
+                renderer.setActiveModel(index)
+            }
+        }
+    }
+
+    /**
+     * Switch the reflections to another bundled environment, shared with the other views
+     */
+    fun setEnvironment(name: String) {
+        runOnMainThread {
+            environment = name
+            vtoRenderer?.setEnvironment(name)
+        }
+    }
+
+    /**
+     * Estimated memory of the loaded models, with the device tier for capping the compare set
+     */
+    fun getModelMemoryStats(): ModelMemoryStats {
+        return vtoRenderer?.modelMemoryStats()
+            ?: ModelMemoryStats(0.0, 0.0, 0.0, 0.0, GlassesRenderer.detectDeviceTier(context).toDouble())
+    }
+
+    /**
+     * Start the shared Filament engine and compile its materials ahead of the first frame.
+     * The engine is shared, so this also covers a view that isn't initialized yet.
+     */
+    fun warmUp() {
+        // Called from the JS thread; Filament state lives on the main thread.
+        // Not View.post, which waits until the view is attached.
+        mainHandler.post { FilamentContext.warmUp(context) }
+    }
+
+    /**
+     * Per-stage frame time percentiles of this view (empty before the renderer starts)
+     */
+    fun getPerformanceStats(): PerformanceStats {
+        return vtoRenderer?.performanceStats() ?: FrameStats.EMPTY
     }
 
     /**
-     * Take a snapshot of the current view
-     * @return Base64-encoded image data
+     * Record camera and face tracking data to filePath until stopFaceRecording
      */
-    fun takeSnapshot(): String {
-        // TODO: Implement snapshot functionality
-        return ""
+    fun startFaceRecording(filePath: String) {
+        runOnMainThread { vtoRenderer?.startFaceRecording(filePath) }
+    }
+
+    fun stopFaceRecording() {
+        runOnMainThread { vtoRenderer?.stopFaceRecording() }
+    }
+
+    /**
+     * The face pose buffer, shared with JS without copies (layout in cpp/FacePoseStream.hpp)
+     */
+    fun getFacePoseBuffer(): ArrayBuffer = facePoseArrayBuffer
+
+    /**
+     * Save the next rendered frame to filePath; reported through onCaptureComplete
+     */
+    fun capture(filePath: String) {
+        runOnMainThread { vtoRenderer?.capture(filePath) }
+    }
+
+    /**
+     * Record the rendered view to filePath until stopRecording
+     */
+    fun startRecording(filePath: String) {
+        runOnMainThread { vtoRenderer?.startRecording(filePath) }
+    }
+
+    fun stopRecording() {
+        runOnMainThread { vtoRenderer?.stopRecording() }
     }
 
     /**
      * Reset the AR session
      */
     fun resetSession() {
-        vtoRenderer?.resetSession()
-        arSession?.pause()
-        arSession?.resume()
+        runOnMainThread {
+            vtoRenderer?.resetSession()
+            arSession?.pause()
+            arSession?.resume()
+        }
+    }
+
+    /**
+     * Run on the main thread: right away when already there, else posted in call order
+     */
+    private fun runOnMainThread(block: () -> Unit) {
+        if (Looper.myLooper() == Looper.getMainLooper()) {
+            block()
+        } else {
+            mainHandler.post(block)
+        }
     }
 
     /**
@@ -148,12 +332,57 @@ class NitroVtoView(context: Context) : FrameLayout(context) {
         // Create and initialize renderer
         vtoRenderer = VTORenderer(context)
         vtoRenderer?.onModelLoaded = onModelLoaded
+        vtoRenderer?.onModelLoadProgress = onModelLoadProgress
+        vtoRenderer?.onPerformanceChange = onPerformanceChange
+        vtoRenderer?.onCaptureComplete = onCaptureComplete
+        vtoRenderer?.facePoseBuffer = facePoseBuffer
+        environment?.let { vtoRenderer?.initialEnvironment = it }
         vtoRenderer?.initialize(surfaceView, modelUrl)
+        vtoRenderer?.session = arSession
+        vtoRenderer?.setAdaptivePerformance(adaptivePerformance)
+        vtoRenderer?.setMaxFaces(maxFaces)
+        vtoRenderer?.setDebug(debug)
+        if (pendingPrefetchUrls.isNotEmpty()) {
+            vtoRenderer?.prefetchModels(pendingPrefetchUrls.toList())
+            pendingPrefetchUrls.clear()
+        }
+        if (compareModelUrls.isNotEmpty()) {
+            vtoRenderer?.setCompareModels(compareModelUrls)
+        }
+        if (pendingActiveModel >= 0) {
+            vtoRenderer?.setActiveModel(pendingActiveModel)
+            pendingActiveModel = -1
+        }
 
         isInitialized = true
+        updateDebugHud()
         Log.d(TAG, "NitroVtoView initialized")
     }
 
+    /**
+     * Show the debug HUD while debug is on and a renderer exists
+     */
+    private fun updateDebugHud() {
+        if (!debug || vtoRenderer == null) {
+            debugHudHandler.removeCallbacks(refreshDebugHud)
+            debugHud?.let { removeView(it) }
+            debugHud = null
+            return
+        }
+        if (debugHud != null) return
+
+        val hud = TextView(context).apply {
+            typeface = Typeface.MONOSPACE
+            textSize = 11f
+            setTextColor(Color.WHITE)
+            setBackgroundColor(Color.argb(128, 0, 0, 0))
+            setPadding(8, 8, 8, 8)
+        }
+        addView(hud, LayoutParams(LayoutParams.WRAP_CONTENT, LayoutParams.WRAP_CONTENT, Gravity.TOP or Gravity.START))
+        debugHud = hud
+        refreshDebugHud.run()
+    }
+
     /**
      * Resume the AR session and rendering
      */
@@ -162,14 +391,15 @@ class NitroVtoView(context: Context) : FrameLayout(context) {
 
         if (!isActive) return
 
+        // Setup AR session if needed. First: its camera config decides which Filament context
+        // (hardware buffer or shared EGL context) the renderer gets
+        setupArSession()
+
         // Initialize if not already done
         if (!isInitialized) {
             initialize()
         }
 
-        // Setup AR session if needed
-        setupArSession()
-
         // Resume renderer
         vtoRenderer?.resume()
     }
@@ -192,6 +422,7 @@ class NitroVtoView(context: Context) : FrameLayout(context) {
         vtoRenderer?.destroy()
         vtoRenderer = null
         isInitialized = false
+        updateDebugHud()
     }
 
     /**
@@ -201,6 +432,7 @@ class NitroVtoView(context: Context) : FrameLayout(context) {
     private fun setupArSession() {
         if (arSession != null) {
             arSession?.resume()
+            vtoRenderer?.environmentalHdrLighting = environmentalHdrLighting
             vtoRenderer?.session = arSession
             return
         }
@@ -219,7 +451,6 @@ class NitroVtoView(context: Context) : FrameLayout(context) {
             val config = Config(arSession).apply {
                 augmentedFaceMode = Config.AugmentedFaceMode.MESH3D
                 planeFindingMode = Config.PlaneFindingMode.DISABLED
-                lightEstimationMode = Config.LightEstimationMode.AMBIENT_INTENSITY
                 // Enable depth if supported by device
                 depthMode = if (arSession!!.isDepthModeSupported(Config.DepthMode.AUTOMATIC)) {
                     Config.DepthMode.AUTOMATIC
@@ -227,12 +458,13 @@ class NitroVtoView(context: Context) : FrameLayout(context) {
                     Config.DepthMode.DISABLED
                 }
             }
-            arSession?.configure(config)
+            configureCameraTexture(arSession!!, config)
 
             // Resume session
             arSession?.resume()
 
             // Connect session to renderer
+            vtoRenderer?.environmentalHdrLighting = environmentalHdrLighting
             vtoRenderer?.session = arSession
 
             Log.d(TAG, "ARCore session created successfully")
@@ -252,6 +484,43 @@ class NitroVtoView(context: Context) : FrameLayout(context) {
         }
     }
 
+    /**
+     * Apply [config], taking camera frames as hardware buffers when the device can import them.
+     * If ARCore rejects that, the session and every later Filament context use camera textures in
+     * the shared EGL context instead.
+     */
+    private fun configureCameraTexture(session: Session, config: Config) {
+        if (FilamentContext.hardwareBufferCameraAvailable()) {
+            config.textureUpdateMode = Config.TextureUpdateMode.EXPOSE_HARDWARE_BUFFER
+            if (configureLighting(session, config)) return
+            FilamentContext.disableHardwareBufferCamera()
+        }
+        config.textureUpdateMode = Config.TextureUpdateMode.BIND_TO_TEXTURE_EXTERNAL_OES
+        // Unsupported even with ambient intensity: let the error through
+        if (!configureLighting(session, config)) session.configure(config)
+    }
+
+    /**
+     * Configure with environmental HDR light estimation where the device supports it with this
+     * camera (spherical harmonics straight from ARCore), else with ambient intensity (the renderer
+     * then estimates them from the camera image).
+     * @return False if the configuration is unsupported either way; config is left on ambient intensity
+     */
+    private fun configureLighting(session: Session, config: Config): Boolean {
+        for (mode in arrayOf(Config.LightEstimationMode.ENVIRONMENTAL_HDR, Config.LightEstimationMode.AMBIENT_INTENSITY)) {
+            config.lightEstimationMode = mode
+            try {
+                session.configure(config)
+                environmentalHdrLighting = mode == Config.LightEstimationMode.ENVIRONMENTAL_HDR
+                Log.d(TAG, "Light estimation mode: $mode")
+                return true
+            } catch (e: UnsupportedConfigurationException) {
+                // Try the next mode
+            }
+        }
+        return false
+    }
+
     /**
      * Helper to get the activity from context
      */
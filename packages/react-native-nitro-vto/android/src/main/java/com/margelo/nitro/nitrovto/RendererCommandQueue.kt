@@ -0,0 +1,130 @@
+package com.margelo.nitro.nitrovto
+
+import android.util.Log
+import java.util.concurrent.atomic.AtomicInteger
+
+/**
+ * Typed renderer state change, queued by prop setters and applied by the render loop.
+ */
+sealed class RendererCommand {
+    data class SetFaceMeshOcclusion(val enabled: Boolean) : RendererCommand()
+    data class SetBackPlaneOcclusion(val enabled: Boolean) : RendererCommand()
+    data class SetForwardOffset(val offset: Float) : RendererCommand()
+    data class SetMaxFaces(val maxFaces: Int) : RendererCommand()
+    data class SetDebug(val enabled: Boolean) : RendererCommand()
+    data class SetAdaptivePerformance(val enabled: Boolean) : RendererCommand()
+    data class SwitchModel(val modelUrl: String) : RendererCommand()
+    data class PrefetchModels(val modelUrls: List<String>) : RendererCommand()
+    data class SetCompareModels(val modelUrls: List<String>) : RendererCommand()
+    data class SetActiveModel(val index: Int) : RendererCommand()
+    data class SetEnvironment(val name: String) : RendererCommand()
+    object ResetSession : RendererCommand()
+    data class StartFaceRecording(val filePath: String) : RendererCommand()
+    object StopFaceRecording : RendererCommand()
+    data class Capture(val filePath: String) : RendererCommand()
+    data class StartRecording(val filePath: String) : RendererCommand()
+    object StopRecording : RendererCommand()
+
+    /**
+     * Setters carry only the latest state: a newer one makes an older one still waiting redundant.
+     */
+    val supersedesEarlier: Boolean
+        get() = when (this) {
+            is SetFaceMeshOcclusion, is SetBackPlaneOcclusion, is SetForwardOffset, is SetMaxFaces,
+            is SetDebug, is SetAdaptivePerformance, is SwitchModel, is SetCompareModels,
+            is SetActiveModel, is SetEnvironment -> true
+            else -> false
+        }
+}
+
+/**
+ * Bounded single-producer / single-consumer lock-free ring of [RendererCommand]s.
+ * Prop setters push (never blocking on the renderer); the render loop drains it once at the
+ * start of each frame, so scene mutations happen at one well-defined point per frame.
+ * When the ring is full (e.g. props set before the renderers exist, which don't drain it),
+ * commands wait in a producer-side backlog where a newer setter replaces an older one of the same
+ * type, so nothing is dropped and the latest value always arrives, still in order with the other
+ * commands.
+ * Capacity must be a power of two; one slot is kept free to tell full from empty.
+ */
+class RendererCommandQueue(capacity: Int = DEFAULT_CAPACITY) {
+
+    companion object {
+        private const val TAG = "RendererCommandQueue"
+        // Prop changes come in bursts of a handful; 64 leaves ample headroom while paused
+        const val DEFAULT_CAPACITY = 64
+    }
+
+    init {
+        require(capacity >= 2 && (capacity and (capacity - 1)) == 0) { "Capacity must be a power of two" }
+    }
+
+    private val mask = capacity - 1
+    private val slots = arrayOfNulls<RendererCommand>(capacity)
+    // AtomicInteger get/set are volatile reads/writes, which publish the slot contents
+    private val head = AtomicInteger(0)
+    private val tail = AtomicInteger(0)
+    // Producer only
+    private val backlog = ArrayDeque<RendererCommand>()
+
+    /**
+     * Producer only (the main thread). Queue a command behind any backlogged ones.
+     */
+    fun push(command: RendererCommand) {
+        flushBacklog()
+        if (backlog.isEmpty() && offer(command)) return
+
+        if (backlog.isEmpty()) Log.w(TAG, "Command queue full, holding $command until it drains")
+        if (command.supersedesEarlier) backlog.removeAll { it::class == command::class }
+        backlog.addLast(command)
+    }
+
+    /**
+     * Producer only. Move backlogged commands into the ring while they fit and return how many moved.
+     */
+    fun flushBacklog(): Int {
+        var moved = 0
+        while (backlog.isNotEmpty() && offer(backlog.first())) {
+            backlog.removeFirst()
+            moved++
+        }
+        return moved
+    }
+
+    /**
+     * Producer only. False (leaving the ring untouched) when full.
+     */
+    private fun offer(command: RendererCommand): Boolean {
+        val currentTail = tail.get()
+        val next = (currentTail + 1) and mask
+        if (next == head.get()) return false
+        slots[currentTail] = command
+        tail.set(next)
+        return true
+    }
+
+    /**
+     * Consumer only. Apply every queued command in push order and return how many were applied.
+     */
+    inline fun drain(handler: (RendererCommand) -> Unit): Int {
+        var count = 0
+        while (true) {
+            val command = poll() ?: break
+            handler(command)
+            count++
+        }
+        return count
+    }
+
+    /**
+     * Consumer only. Next queued command, or null when empty.
+     */
+    fun poll(): RendererCommand? {
+        val currentHead = head.get()
+        if (currentHead == tail.get()) return null
+        val command = slots[currentHead]
+        slots[currentHead] = null
+        head.set((currentHead + 1) and mask)
+        return command
+    }
+}
@@ -1,6 +1,12 @@
 package com.margelo.nitro.nitrovto
 
 import android.content.Context
+import android.os.Build
+import android.os.Handler
+import android.os.Looper
+import android.os.PowerManager
+import android.os.SystemClock
+import android.os.Trace
 import android.util.Log
 import android.view.Choreographer
 import android.view.Surface
@@ -18,11 +24,11 @@ import com.google.android.filament.Viewport
 import com.google.ar.core.Frame
 import com.google.android.filament.android.DisplayHelper
 import com.google.android.filament.android.UiHelper
-import com.google.android.filament.gltfio.Gltfio
-import com.google.android.filament.utils.Utils
 import com.google.ar.core.AugmentedFace
 import com.google.ar.core.Session
 import com.google.ar.core.TrackingState
+import java.nio.ByteBuffer
+import java.nio.FloatBuffer
 
 /**
  * Filament-based renderer for glasses VTO.
@@ -33,13 +39,24 @@ class VTORenderer(private val context: Context) {
     companion object {
         private const val TAG = "VTORenderer"
 
-        init {
-            Utils.init()
-            Gltfio.init()
+        // Camera-only pass-through rate once no face has been tracked for IDLE_DELAY_NANOS
+        private const val IDLE_FRAMES_PER_SECOND = 30
+        private const val IDLE_DELAY_NANOS = 1_000_000_000L
+
+        // Camera frames older than this are taken to be on another clock than elapsedRealtimeNanos
+        private const val MAX_CAMERA_AGE_NANOS = 100_000_000L
+
+        /** Fold PowerManager thermal statuses into the shared core's four levels */
+        private fun thermalLevelFor(status: Int): Int = when {
+            status >= PowerManager.THERMAL_STATUS_CRITICAL -> VtoCore.THERMAL_CRITICAL
+            status >= PowerManager.THERMAL_STATUS_SEVERE -> VtoCore.THERMAL_SERIOUS
+            status >= PowerManager.THERMAL_STATUS_LIGHT -> VtoCore.THERMAL_FAIR
+            else -> VtoCore.THERMAL_NOMINAL
         }
     }
 
-    // Filament core components
+    // Filament core components (engine and materials are shared with other views)
+    private var filamentContext: FilamentContext? = null
     private lateinit var engine: Engine
     private lateinit var renderer: Renderer
     private lateinit var scene: Scene
@@ -67,18 +84,69 @@ class VTORenderer(private val context: Context) {
     // Debug renderer
     private lateinit var debugRenderer: DebugRenderer
 
+    // Face mesh topology, cached from the first tracked face and shared by the face renderers
+    private var faceTopology: FaceTopology? = null
+
     // ARCore
     var session: Session? = null
+    // The session runs ENVIRONMENTAL_HDR light estimation (set before the session)
+    var environmentalHdrLighting = false
+    // Environment the lighting starts with (set before initialize; setEnvironment afterwards)
+    var initialEnvironment = FilamentContext.DEFAULT_ENVIRONMENT
+
+    // Prop changes, applied at the start of each frame
+    private val commandQueue = RendererCommandQueue()
+    private var renderLoopRunning = false
+    private val mainHandler = Handler(Looper.getMainLooper())
 
     // Frame callback
     private val choreographer = Choreographer.getInstance()
     private val frameCallback = object : Choreographer.FrameCallback {
         override fun doFrame(frameTimeNanos: Long) {
             choreographer.postFrameCallback(this)
-            doFrame()
+            if (!isFrameDue(frameTimeNanos)) return
+            val workStart = System.nanoTime()
+            allocationCounter.beginFrame()
+            frameStats.beginFrame()
+            val outcome = traceStage(VtoCore.STAGE_FRAME, "VTO frame") { doFrame() }
+            if (outcome != FrameOutcome.IDLE) {
+                frameStats.endFrame(outcome == FrameOutcome.DROPPED)
+                recordFrame(frameTimeNanos, System.nanoTime() - workStart, outcome == FrameOutcome.PRESENTED)
+                allocationCounter.endFrame()
+            }
         }
     }
 
+    private enum class FrameOutcome {
+        // Nothing new to draw (no surface or session yet, or the same camera frame with no scene changes)
+        IDLE,
+        PRESENTED,
+        // Filament skipped the frame because the GPU was behind
+        DROPPED,
+    }
+
+    // Idle tracking: faces and camera frames seen by the last rendered frame
+    private var faceTracked = false
+    private var faceLostNanos = 0L
+    private var lastCameraTimestamp = 0L
+
+    // Adaptive performance: render scale and frame rate chosen by the shared FramePacer
+    private var framePacer: FramePacer? = null
+    private var lastRenderedFrameNanos = 0L
+    private var thermalListener: Any? = null
+
+    // Per-stage frame times for getPerformanceStats (GPU time isn't available through Filament's Java API)
+    private val frameStats = FrameStats()
+    private val allocationCounter = FrameAllocationCounter()
+
+    // Face session recording for scripts/replay-bench.ts, with its per-frame scratch arrays
+    private var faceRecorder: FaceRecorder? = null
+    private val recordingIntrinsics = FloatArray(4)
+    private val recordingImageSize = IntArray(2)
+
+    // Photo and video capture of the rendered view
+    private var frameCapture: FrameCapture? = null
+
     // Track initialization
     private var initialized = false
     private var width = 0
@@ -88,6 +156,7 @@ class VTORenderer(private val context: Context) {
     private var lastDisplayRotation = -1
     private var lastDisplayWidth = 0
     private var lastDisplayHeight = 0
+    private var vsyncPeriodNanos = 16_666_667L
 
     // Model configuration
     private var modelUrl: String = ""
@@ -95,10 +164,24 @@ class VTORenderer(private val context: Context) {
     // Reusable matrices for camera update (avoid per-frame allocations)
     private val viewMatrix = FloatArray(16)
     private val projMatrix = FloatArray(16)
+    private val projMatrixDouble = DoubleArray(16)
     private val cameraModelMatrix = FloatArray(16)
 
+    // Tracked faces, kept across frames so finding them doesn't allocate while they stay tracked
+    private val trackedFaces = ArrayList<AugmentedFace>(VtoCore.MAX_TRACKED_FACES)
+    private var maxFaces = 1
+    // The tracked faces' poses and mesh vertices, read from ARCore once per frame and shared by the face renderers
+    private val faceMatrices = Array(VtoCore.MAX_TRACKED_FACES) { FloatArray(16) }
+    private val faceVertices = arrayOfNulls<FloatBuffer>(VtoCore.MAX_TRACKED_FACES)
+
     // Callbacks
     var onModelLoaded: ((modelUrl: String) -> Unit)? = null
+    var onModelLoadProgress: ((modelUrl: String, progress: Double) -> Unit)? = null
+    var onPerformanceChange: ((renderScale: Double, frameRate: Double, reason: String) -> Unit)? = null
+    var onCaptureComplete: ((filePath: String, durationSeconds: Double) -> Unit)? = null
+
+    // Face pose buffer shared with JS (direct, VtoCore.FACE_POSE_BUFFER_BYTES), rewritten every frame
+    var facePoseBuffer: ByteBuffer? = null
 
     /**
      * Initialize Filament and attach to surface view
@@ -107,14 +190,15 @@ class VTORenderer(private val context: Context) {
         this.modelUrl = modelUrl
         surfaceViewRef = surfaceView
 
-        // Initialize camera texture renderer (creates EGL context)
+        // Acquire the shared Filament engine (created on first use, or still warm)
+        val filamentContext = FilamentContext.acquire(context)
+        this.filamentContext = filamentContext
+
+        // Initialize camera texture renderer on the shared EGL context (or for hardware buffers)
         cameraTextureRenderer = CameraTextureRenderer(context)
-        cameraTextureRenderer.initializeEglContext()
+        cameraTextureRenderer.initializeEglContext(filamentContext)
 
-        // Initialize Filament engine with shared EGL context
-        engine = Engine.Builder()
-            .sharedContext(cameraTextureRenderer.getEglContext())
-            .build()
+        engine = filamentContext.engine
         renderer = engine.createRenderer()
         scene = engine.createScene()
         view = engine.createView()
@@ -133,7 +217,8 @@ class VTORenderer(private val context: Context) {
             renderCallback = object : UiHelper.RendererCallback {
                 override fun onNativeWindowChanged(surface: Surface) {
                     swapChain?.let { engine.destroySwapChain(it) }
-                    swapChain = engine.createSwapChain(surface)
+                    // Readable for photo capture
+                    swapChain = engine.createSwapChain(surface, SwapChain.CONFIG_READABLE)
                     displayHelper.attach(renderer, surfaceView.display)
                 }
 
@@ -158,41 +243,56 @@ class VTORenderer(private val context: Context) {
         displayHelper = DisplayHelper(context)
 
         // Setup environment lighting
-        environmentLightingRenderer = EnvironmentLightingRenderer(context)
-        environmentLightingRenderer.setup(engine, scene)
+        environmentLightingRenderer = EnvironmentLightingRenderer()
+        environmentLightingRenderer.setup(filamentContext, scene, filamentCamera, cameraTextureRenderer, initialEnvironment)
 
         // Setup camera background
-        cameraTextureRenderer.setup(engine, scene)
+        cameraTextureRenderer.setup(filamentContext, scene)
 
         // Setup face occlusion renderer
         faceOcclusionRenderer = FaceOcclusionRenderer(context)
-        faceOcclusionRenderer.setup(engine, scene)
+        faceOcclusionRenderer.setup(filamentContext, scene)
 
         // Setup glasses renderer
         glassesRenderer = GlassesRenderer(context)
         glassesRenderer.onModelLoaded = onModelLoaded
-        glassesRenderer.setup(engine, scene, modelUrl)
+        glassesRenderer.onModelLoadProgress = onModelLoadProgress
+        glassesRenderer.setup(filamentContext, scene, modelUrl)
 
         // Setup debug renderer
-        debugRenderer = DebugRenderer(context)
-        debugRenderer.setup(engine, scene)
+        debugRenderer = DebugRenderer()
+        debugRenderer.setup(filamentContext, faceOcclusionRenderer)
+
+        // Setup photo and video capture (reports on the main thread)
+        frameCapture = FrameCapture(engine) { filePath, durationSeconds ->
+            onCaptureComplete?.invoke(filePath, durationSeconds)
+        }
+
+        // Compile shader variants behind the camera preview, before a face is found
+        filamentContext.warmUpMaterials()
 
         initialized = true
+
+        // Apply props set before the renderers existed
+        drainCommands()
     }
 
     private fun updateCameraProjection(frame: Frame) {
         if (width == 0 || height == 0) return
 
-        // Get ARCore camera matrices
-        frame.camera.getViewMatrix(viewMatrix, 0)
-        frame.camera.getProjectionMatrix(projMatrix, 0, 0.01f, 100f)
+        // Get ARCore camera matrices (each Frame.getCamera() call creates a wrapper object)
+        val camera = frame.camera
+        camera.getViewMatrix(viewMatrix, 0)
+        camera.getProjectionMatrix(projMatrix, 0, 0.01f, 100f)
 
         // ARCore viewMatrix transforms world -> camera space
         // Filament camera needs model matrix (camera -> world), which is inverse(viewMatrix)
         Matrix.invertM(cameraModelMatrix, 0, viewMatrix, 0)
 
         // Convert to double arrays for Filament
-        val projMatrixDouble = DoubleArray(16) { projMatrix[it].toDouble() }
+        for (i in 0 until 16) {
+            projMatrixDouble[i] = projMatrix[i].toDouble()
+        }
 
         // Set custom projection and camera model matrix
         filamentCamera.setCustomProjection(projMatrixDouble, 0.01, 100.0)
@@ -200,84 +300,269 @@ class VTORenderer(private val context: Context) {
     }
 
     fun resume() {
+        renderLoopRunning = true
         choreographer.postFrameCallback(frameCallback)
     }
 
     fun pause() {
+        renderLoopRunning = false
         choreographer.removeFrameCallback(frameCallback)
+        publishFacePoses(VtoCore.FACE_TRACKING_NOT_RUNNING, lastCameraTimestamp, 0)
     }
 
     /**
      * Switch to a different glasses model
      */
     fun switchModel(modelUrl: String) {
-        this.modelUrl = modelUrl
-        glassesRenderer.switchModel(modelUrl)
+        enqueue(RendererCommand.SwitchModel(modelUrl))
+    }
+
+    /**
+     * Download and decode models into the warm asset pool, so switching to them is instant
+     */
+    fun prefetchModels(modelUrls: List<String>) {
+        enqueue(RendererCommand.PrefetchModels(modelUrls))
+    }
+
+    /**
+     * Keep these models loaded side by side for [setActiveModel] (never evicted from the pool)
+     */
+    fun setCompareModels(modelUrls: List<String>) {
+        enqueue(RendererCommand.SetCompareModels(modelUrls))
+    }
+
+    /**
+     * Show one of the compare models, keeping the glasses' pose
+     */
+    fun setActiveModel(index: Int) {
+        enqueue(RendererCommand.SetActiveModel(index))
+    }
+
+    /**
+     * Switch the reflections to another bundled environment
+     */
+    fun setEnvironment(name: String) {
+        enqueue(RendererCommand.SetEnvironment(name))
     }
 
     /**
      * Reset the session (clears UV transform)
      */
     fun resetSession() {
-        cameraTextureNameSet = false
-        cameraTextureRenderer.resetUvTransform()
-        faceOcclusionRenderer.hide()
-        glassesRenderer.hide()
+        enqueue(RendererCommand.ResetSession)
+    }
+
+    /**
+     * Record camera and face tracking data of every rendered frame to a file
+     */
+    fun startFaceRecording(filePath: String) {
+        enqueue(RendererCommand.StartFaceRecording(filePath))
+    }
+
+    /**
+     * Finish the face recording started by startFaceRecording
+     */
+    fun stopFaceRecording() {
+        enqueue(RendererCommand.StopFaceRecording)
+    }
+
+    /**
+     * Save the next rendered frame to a JPEG file
+     */
+    fun capture(filePath: String) {
+        enqueue(RendererCommand.Capture(filePath))
+    }
+
+    /**
+     * Record the rendered view to an H.264 MP4 file
+     */
+    fun startRecording(filePath: String) {
+        enqueue(RendererCommand.StartRecording(filePath))
+    }
+
+    /**
+     * Finish the recording started by startRecording
+     */
+    fun stopRecording() {
+        enqueue(RendererCommand.StopRecording)
     }
 
     /**
      * Set face mesh occlusion enabled
      */
     fun setFaceMeshOcclusion(enabled: Boolean) {
-        if (initialized) {
-            faceOcclusionRenderer.setFaceMeshOcclusion(enabled)
-        }
+        enqueue(RendererCommand.SetFaceMeshOcclusion(enabled))
     }
 
     /**
      * Set back plane occlusion enabled
      */
     fun setBackPlaneOcclusion(enabled: Boolean) {
-        if (initialized) {
-            faceOcclusionRenderer.setBackPlaneOcclusion(enabled)
-        }
+        enqueue(RendererCommand.SetBackPlaneOcclusion(enabled))
     }
 
     /**
      * Set forward offset for glasses positioning (in meters)
      */
     fun setForwardOffset(offset: Float) {
-        if (initialized) {
-            glassesRenderer.setForwardOffset(offset)
-        }
+        enqueue(RendererCommand.SetForwardOffset(offset))
+    }
+
+    /**
+     * Set how many tracked faces are fitted with glasses (clamped to [1, 3])
+     */
+    fun setMaxFaces(maxFaces: Int) {
+        enqueue(RendererCommand.SetMaxFaces(maxFaces))
     }
 
     /**
      * Set debug mode enabled
      */
     fun setDebug(enabled: Boolean) {
-        if (initialized) {
-            debugRenderer.setEnabled(enabled)
+        enqueue(RendererCommand.SetDebug(enabled))
+    }
+
+    /**
+     * Adapt render scale and frame rate to the thermal state and frame times
+     */
+    fun setAdaptivePerformance(enabled: Boolean) {
+        enqueue(RendererCommand.SetAdaptivePerformance(enabled))
+    }
+
+    /**
+     * Main thread only: the command ring has a single producer.
+     */
+    private fun enqueue(command: RendererCommand) {
+        commandQueue.push(command)
+        // No frame will drain the queue while paused: apply it on the render (main) thread's next
+        // turn, never inline in the caller
+        if (!renderLoopRunning) {
+            mainHandler.post {
+                if (!renderLoopRunning) drainCommands()
+            }
         }
     }
 
-    private fun doFrame() {
-        if (!initialized) return
+    /**
+     * Apply queued commands. Commands stay queued until the renderers exist.
+     */
+    private fun drainCommands(): Int {
+        if (!initialized) return 0
+        // Producer and consumer are both the main thread: move any backlog in as room frees up
+        var count = 0
+        do {
+            count += commandQueue.drain { applyCommand(it) }
+        } while (commandQueue.flushBacklog() > 0)
+        return count
+    }
 
-        val session = session ?: return
-        val swap = swapChain ?: return
+    private fun applyCommand(command: RendererCommand) {
+        when (command) {
+            is RendererCommand.SetFaceMeshOcclusion -> faceOcclusionRenderer.setFaceMeshOcclusion(command.enabled)
+            is RendererCommand.SetBackPlaneOcclusion -> faceOcclusionRenderer.setBackPlaneOcclusion(command.enabled)
+            is RendererCommand.SetForwardOffset -> glassesRenderer.setForwardOffset(command.offset)
+            is RendererCommand.SetMaxFaces -> {
+                maxFaces = command.maxFaces.coerceIn(1, VtoCore.MAX_TRACKED_FACES)
+                faceOcclusionRenderer.setMaxFaces(maxFaces)
+                glassesRenderer.setMaxFaces(maxFaces)
+            }
+            is RendererCommand.SetDebug -> debugRenderer.setEnabled(command.enabled)
+            is RendererCommand.SetAdaptivePerformance -> applyAdaptivePerformance(command.enabled)
+            is RendererCommand.SwitchModel -> {
+                modelUrl = command.modelUrl
+                glassesRenderer.switchModel(command.modelUrl)
+            }
+            is RendererCommand.PrefetchModels -> glassesRenderer.prefetchModels(command.modelUrls)
+            is RendererCommand.SetCompareModels -> glassesRenderer.setCompareModels(command.modelUrls)
+            is RendererCommand.SetActiveModel -> glassesRenderer.setActiveModel(command.index)
+            is RendererCommand.SetEnvironment -> environmentLightingRenderer.setEnvironment(command.name)
+            RendererCommand.ResetSession -> {
+                cameraTextureNameSet = false
+                trackedFaces.clear()
+                cameraTextureRenderer.resetUvTransform()
+                faceOcclusionRenderer.hide()
+                glassesRenderer.hide()
+            }
+            is RendererCommand.StartFaceRecording -> {
+                stopFaceRecordingNow()
+                faceRecorder = FaceRecorder.open(command.filePath)
+                if (faceRecorder == null) {
+                    Log.e(TAG, "Failed to open face recording: ${command.filePath}")
+                }
+            }
+            RendererCommand.StopFaceRecording -> stopFaceRecordingNow()
+            is RendererCommand.Capture -> frameCapture?.capturePhoto(command.filePath)
+            is RendererCommand.StartRecording -> frameCapture?.startRecording(command.filePath)
+            RendererCommand.StopRecording -> frameCapture?.stopRecording()
+        }
+    }
 
-        if (!uiHelper.isReadyToRender) return
+    private fun stopFaceRecordingNow() {
+        val recorder = faceRecorder ?: return
+        faceRecorder = null
+        Log.d(TAG, "Face recording finished: ${recorder.close()} frames")
+    }
+
+    /**
+     * Append this frame's camera and face tracking data to the recording, if one is running
+     */
+    private fun recordFaceFrame(frame: Frame, meshVertices: FloatBuffer?) {
+        val recorder = faceRecorder ?: return
+        val intrinsics = frame.camera.imageIntrinsics
+        intrinsics.getFocalLength(recordingIntrinsics, 0)
+        intrinsics.getPrincipalPoint(recordingIntrinsics, 2)
+        intrinsics.getImageDimensions(recordingImageSize, 0)
+        recorder.writeFrame(
+            frame.timestamp,
+            recordingIntrinsics,
+            recordingImageSize[0],
+            recordingImageSize[1],
+            projMatrix,
+            cameraModelMatrix,
+            if (meshVertices != null) faceMatrices[0] else null,
+            meshVertices
+        )
+    }
+
+    /**
+     * Overwrite the shared face pose buffer with this frame's faces (the first [faceCount] of
+     * faceMatrices / faceVertices) and the camera matrices of updateCameraProjection
+     */
+    private fun publishFacePoses(state: Int, timestampNanos: Long, faceCount: Int) {
+        val buffer = facePoseBuffer ?: return
+        VtoCore.writeFacePoses(
+            buffer, state, timestampNanos, faceCount, faceMatrices, faceVertices, viewMatrix, projMatrix
+        )
+    }
+
+    private fun doFrame(): FrameOutcome {
+        if (!initialized) return FrameOutcome.IDLE
+
+        // Apply prop changes once, before any scene work for this frame
+        var sceneChanged = drainCommands() > 0
+
+        // Stream in glasses textures a slice at a time, even before a face is tracked
+        sceneChanged = traceStage(VtoCore.STAGE_RESOURCES, "VTO resources") {
+            glassesRenderer.updateLoading()
+        } || sceneChanged
+
+        val session = session ?: return FrameOutcome.IDLE
+        val swap = swapChain ?: return FrameOutcome.IDLE
+
+        if (!uiHelper.isReadyToRender) return FrameOutcome.IDLE
 
         try {
-            // Make EGL context current for ARCore texture operations
-            cameraTextureRenderer.makeEglContextCurrent()
-
-            // Set camera texture names on ARCore session (only once)
-            // Using multiple textures avoids read/write sync issues (green flashes)
-            if (!cameraTextureNameSet) {
-                session.setCameraTextureNames(cameraTextureRenderer.getCameraTextureIds())
-                cameraTextureNameSet = true
+            // Hardware buffer frames need neither a current EGL context nor texture names
+            if (!cameraTextureRenderer.usesHardwareBuffer) {
+                // Make EGL context current for ARCore texture operations
+                cameraTextureRenderer.makeEglContextCurrent()
+
+                // Set camera texture names on ARCore session (only once)
+                // Using multiple textures avoids read/write sync issues (green flashes)
+                if (!cameraTextureNameSet) {
+                    session.setCameraTextureNames(cameraTextureRenderer.getCameraTextureIds())
+                    cameraTextureNameSet = true
+                }
             }
 
             // Set display geometry for ARCore (only when changed)
@@ -286,6 +571,7 @@ class VTORenderer(private val context: Context) {
                 val rotation = display?.rotation ?: 0
                 if (rotation != lastDisplayRotation || width != lastDisplayWidth || height != lastDisplayHeight) {
                     session.setDisplayGeometry(rotation, width, height)
+                    display?.refreshRate?.takeIf { it > 0f }?.let { vsyncPeriodNanos = (1e9f / it).toLong() }
                     lastDisplayRotation = rotation
                     lastDisplayWidth = width
                     lastDisplayHeight = height
@@ -293,63 +579,277 @@ class VTORenderer(private val context: Context) {
             }
 
             // Update ARCore and get frame
-            val frame = session.update()
+            val frame = traceStage(VtoCore.STAGE_SESSION, "VTO session") { session.update() }
 
-            // Update Filament camera with ARCore camera matrices
-            updateCameraProjection(frame)
+            // Vsync can outpace the camera: don't redraw a frame that's already on screen
+            if (frame.timestamp == lastCameraTimestamp && !sceneChanged) return FrameOutcome.IDLE
+            lastCameraTimestamp = frame.timestamp
 
-            // Update material to use the correct texture for this frame
-            cameraTextureRenderer.updateCameraTexture(frame)
+            traceStage(VtoCore.STAGE_CAMERA, "VTO camera") {
+                // Update Filament camera with ARCore camera matrices
+                updateCameraProjection(frame)
 
-            // Update lighting from ARCore light estimation
-            environmentLightingRenderer.updateFromARCore(frame)
+                // Update material to use the correct texture for this frame
+                cameraTextureRenderer.updateCameraTexture(frame)
 
-            // Update UV transform for proper aspect ratio
-            if (width > 0 && height > 0) {
-                cameraTextureRenderer.updateUvTransform(frame)
-            }
+                // Update lighting from ARCore light estimation
+                environmentLightingRenderer.updateFromARCore(frame, environmentalHdrLighting)
 
-            // Get tracked faces
-            val faces = session.getAllTrackables(AugmentedFace::class.java)
-                .filter { it.trackingState == TrackingState.TRACKING }
+                // Update UV transform for proper aspect ratio
+                if (width > 0 && height > 0) {
+                    cameraTextureRenderer.updateUvTransform(frame)
+                }
+            }
 
-            // Update face occlusion and glasses transform if face detected
+            // Update face occlusion and glasses transforms if faces detected
+            val faces = trackingFaces(session)
             if (faces.isNotEmpty()) {
-                val face = faces.first()
-                faceOcclusionRenderer.update(face)
-                glassesRenderer.updateTransform(face, frame)
-                debugRenderer.update(
-                    face,
-                    faceOcclusionRenderer.isLeftBackPlaneVisible,
-                    faceOcclusionRenderer.isRightBackPlaneVisible
-                )
+                faceTracked = true
+                // Read ARCore's face data once; every getter creates a Pose or buffer view
+                for (index in faces.indices) {
+                    faces[index].centerPose.toMatrix(faceMatrices[index], 0)
+                    faceVertices[index] = faces[index].meshVertices
+                }
+                val meshVertices = faceVertices[0]!!
+                val previousTopology = faceTopology
+                traceStage(VtoCore.STAGE_FACE_MESH, "VTO face mesh") {
+                    // Every face shares ARCore's canonical mesh layout
+                    val topology = faceTopologyFor(faces[0], meshVertices)
+                    if (topology != null) {
+                        // Also moves the debug overlay, which draws the occluder's own buffers
+                        faceOcclusionRenderer.update(faces.size, faceMatrices, faceVertices, topology)
+                    }
+                }
+                traceStage(VtoCore.STAGE_GLASSES_POSE, "VTO glasses pose") {
+                    glassesRenderer.updateTransform(
+                        faces, faceMatrices, faceVertices, cameraModelMatrix, frame.timestamp, predictionNanos(frame)
+                    )
+                }
+                recordFaceFrame(frame, meshVertices)
+                publishFacePoses(VtoCore.FACE_TRACKING_TRACKING, frame.timestamp, faces.size)
+                // Release a replaced topology once the renderers have moved off its index buffer
+                if (previousTopology != null && previousTopology !== faceTopology) {
+                    previousTopology.destroy(engine)
+                }
             } else {
-                faceOcclusionRenderer.hide()
-                glassesRenderer.hide()
-                debugRenderer.hide()
+                if (faceTracked) {
+                    // Face lost: take the face entities out of the scene once, then render the camera alone
+                    faceTracked = false
+                    faceLostNanos = System.nanoTime()
+                    faceOcclusionRenderer.hide()
+                    glassesRenderer.hide()
+                }
+                recordFaceFrame(frame, null)
+                publishFacePoses(VtoCore.FACE_TRACKING_SEARCHING, frame.timestamp, 0)
             }
 
             // Render frame with Filament
-            if (renderer.beginFrame(swap, frame.timestamp)) {
-                renderer.render(view)
-                renderer.endFrame()
+            val presented = traceStage(VtoCore.STAGE_RENDER, "VTO render") {
+                if (renderer.beginFrame(swap, frame.timestamp)) {
+                    environmentLightingRenderer.renderCameraProbe(renderer, cameraModelMatrix, projMatrix, frame.timestamp)
+                    renderer.render(view)
+                    frameCapture?.captureFrame(renderer, view.viewport, frame.timestamp)
+                    renderer.endFrame()
+                    true
+                } else {
+                    false
+                }
             }
+            return if (presented) FrameOutcome.PRESENTED else FrameOutcome.DROPPED
 
         } catch (e: Exception) {
             Log.e(TAG, "Render error: ${e.message}")
         }
+        return FrameOutcome.IDLE
+    }
+
+    /**
+     * Time [block] as one stage of the current frame, and mark it as a trace section so the
+     * stage shows up in Perfetto / systrace captures.
+     */
+    private inline fun <T> traceStage(stage: Int, sectionName: String, block: () -> T): T {
+        Trace.beginSection(sectionName)
+        val start = System.nanoTime()
+        try {
+            return block()
+        } finally {
+            frameStats.setStage(stage, System.nanoTime() - start)
+            Trace.endSection()
+        }
+    }
+
+    /**
+     * Per-stage frame time percentiles over the last few seconds (any thread)
+     */
+    fun performanceStats(): PerformanceStats = frameStats.snapshot()
+
+    /**
+     * The same percentiles as debug HUD text, one stage per line (any thread)
+     */
+    fun performanceSummary(): String = frameStats.summary()
+
+    /**
+     * Estimated memory of the pooled models (any thread), null before initialize
+     */
+    fun modelMemoryStats(): ModelMemoryStats? =
+        if (::glassesRenderer.isInitialized) glassesRenderer.memoryStats() else null
+
+    private fun applyAdaptivePerformance(enabled: Boolean) {
+        if (enabled == (framePacer != null)) return
+
+        if (enabled) {
+            framePacer = FramePacer()
+            startThermalMonitoring()
+        } else {
+            stopThermalMonitoring()
+            framePacer?.destroy()
+            framePacer = null
+            applyPacing(1f, FramePacer.MAX_FRAMES_PER_SECOND)
+        }
+    }
+
+    /**
+     * Skip vsyncs to hold a lowered frame rate (adaptive performance, or camera-only pass-through
+     * while no face is tracked). Choreographer keeps firing every vsync, so a frame is due once
+     * the target interval has (nearly) elapsed since the last one.
+     */
+    private fun isFrameDue(frameTimeNanos: Long): Boolean {
+        var framesPerSecond = framePacer?.framesPerSecond ?: FramePacer.MAX_FRAMES_PER_SECOND
+        if (!faceTracked && frameTimeNanos - faceLostNanos >= IDLE_DELAY_NANOS) {
+            framesPerSecond = minOf(framesPerSecond, IDLE_FRAMES_PER_SECOND)
+        }
+        val intervalNanos = 1_000_000_000L / framesPerSecond
+        // Half a 60 Hz vsync of slack, so vsync jitter doesn't drop every other due frame
+        if (framesPerSecond < FramePacer.MAX_FRAMES_PER_SECOND &&
+            frameTimeNanos - lastRenderedFrameNanos < intervalNanos - 8_000_000L
+        ) {
+            return false
+        }
+        lastRenderedFrameNanos = frameTimeNanos
+        return true
+    }
+
+    /**
+     * Time from the camera frame's capture to this render reaching the display, for the glasses
+     * pose prediction: the camera frame's age, the wait for the next vsync, and one more vsync for
+     * composition (Filament's Java API doesn't report present times).
+     */
+    private fun predictionNanos(frame: Frame): Long {
+        // ARCore timestamps are on CLOCK_BOOTTIME on current devices, though the time base isn't specified
+        val cameraAge = SystemClock.elapsedRealtimeNanos() - frame.timestamp
+        val knownCameraAge = if (cameraAge in 0..MAX_CAMERA_AGE_NANOS) cameraAge else 0L
+        val untilVsync = (lastRenderedFrameNanos + vsyncPeriodNanos - System.nanoTime()).coerceAtLeast(0L)
+        return knownCameraAge + untilVsync + vsyncPeriodNanos
+    }
+
+    private fun recordFrame(frameTimeNanos: Long, workNanos: Long, presented: Boolean) {
+        val pacer = framePacer ?: return
+        if (!pacer.addFrame(frameTimeNanos, workNanos, presented)) return
+
+        val renderScale = pacer.renderScale
+        val framesPerSecond = pacer.framesPerSecond
+        Log.i(TAG, "Adaptive performance: scale $renderScale, $framesPerSecond fps (${pacer.reason})")
+        applyPacing(renderScale, framesPerSecond)
+        onPerformanceChange?.invoke(renderScale.toDouble(), framesPerSecond.toDouble(), pacer.reason)
+    }
+
+    /**
+     * Apply a render scale and frame rate. Filament's dynamic resolution needs post-processing,
+     * which stays off to keep the camera feed's colors untouched, so the surface buffer is
+     * shrunk instead and the compositor scales it up to the view.
+     */
+    private fun applyPacing(renderScale: Float, framesPerSecond: Int) {
+        val surfaceView = surfaceViewRef ?: return
+        if (renderScale < 1f && surfaceView.width > 0 && surfaceView.height > 0) {
+            surfaceView.holder.setFixedSize(
+                (surfaceView.width * renderScale).toInt(),
+                (surfaceView.height * renderScale).toInt()
+            )
+        } else {
+            surfaceView.holder.setSizeFromLayout()
+        }
+
+        // Let Filament's frame pacing know how many vsyncs each frame spans
+        val refreshRate = surfaceView.display?.let { DisplayHelper.getDisplayRefreshRate(it) } ?: 60f
+        renderer.frameRateOptions = renderer.frameRateOptions.apply {
+            interval = maxOf(1f, refreshRate / framesPerSecond)
+        }
+    }
+
+    private fun startThermalMonitoring() {
+        if (Build.VERSION.SDK_INT < Build.VERSION_CODES.Q) return
+        val powerManager = context.getSystemService(Context.POWER_SERVICE) as? PowerManager ?: return
+
+        framePacer?.setThermalLevel(thermalLevelFor(powerManager.currentThermalStatus))
+        // Registered on the main thread's executor, like the frame callback that reads the pacer
+        val listener = PowerManager.OnThermalStatusChangedListener { status ->
+            framePacer?.setThermalLevel(thermalLevelFor(status))
+        }
+        powerManager.addThermalStatusListener(context.mainExecutor, listener)
+        thermalListener = listener
+    }
+
+    private fun stopThermalMonitoring() {
+        if (Build.VERSION.SDK_INT < Build.VERSION_CODES.Q) return
+        val listener = thermalListener as? PowerManager.OnThermalStatusChangedListener ?: return
+        val powerManager = context.getSystemService(Context.POWER_SERVICE) as? PowerManager ?: return
+        powerManager.removeThermalStatusListener(listener)
+        thermalListener = null
+    }
+
+    /**
+     * Get the cached face topology, building it on the first face (or if ARCore changes the mesh layout).
+     */
+    private fun faceTopologyFor(face: AugmentedFace, meshVertices: FloatBuffer): FaceTopology? {
+        faceTopology?.let { if (it.matches(meshVertices)) return it }
+        FaceTopology.create(engine, face)?.let { faceTopology = it }
+        return faceTopology?.takeIf { it.matches(meshVertices) }
+    }
+
+    /**
+     * Up to maxFaces tracked faces. ARCore hands out the same AugmentedFace for a face across frames,
+     * so the trackables collection is only queried again once a face stops tracking or while fewer
+     * than maxFaces are tracked.
+     */
+    private fun trackingFaces(session: Session): List<AugmentedFace> {
+        for (index in trackedFaces.indices.reversed()) {
+            if (index >= maxFaces || trackedFaces[index].trackingState != TrackingState.TRACKING) {
+                trackedFaces.removeAt(index)
+            }
+        }
+        if (trackedFaces.size >= maxFaces) return trackedFaces
+        for (face in session.getAllTrackables(AugmentedFace::class.java)) {
+            if (trackedFaces.size >= maxFaces) break
+            if (face.trackingState == TrackingState.TRACKING && !trackedFaces.contains(face)) {
+                trackedFaces.add(face)
+            }
+        }
+        return trackedFaces
     }
 
     fun destroy() {
         choreographer.removeFrameCallback(frameCallback)
+        frameStats.destroy()
+        allocationCounter.destroy()
+        stopFaceRecordingNow()
 
         if (!initialized) return
+        initialized = false
+
+        stopThermalMonitoring()
+        framePacer?.destroy()
+        framePacer = null
 
+        frameCapture?.destroy()
+        frameCapture = null
         debugRenderer.destroy()
         glassesRenderer.destroy()
         faceOcclusionRenderer.destroy()
-        cameraTextureRenderer.destroy()
+        faceTopology?.destroy(engine)
+        faceTopology = null
+        // The camera light probe shares the background quad's geometry and material
         environmentLightingRenderer.destroy()
+        cameraTextureRenderer.destroy()
 
         engine.destroyCameraComponent(cameraEntity)
         EntityManager.get().destroy(cameraEntity)
@@ -360,6 +860,9 @@ class VTORenderer(private val context: Context) {
         engine.destroyView(view)
         engine.destroyScene(scene)
         engine.destroyRenderer(renderer)
-        engine.destroy()
+
+        // The engine outlives this view while others use it (or until the warm period ends)
+        filamentContext?.release()
+        filamentContext = null
     }
 }
@@ -0,0 +1,617 @@
+package com.margelo.nitro.nitrovto
+
+import java.nio.ByteBuffer
+import java.nio.FloatBuffer
+
+/**
+ * JNI bindings to the shared C++ VTO core (see cpp/ at the package root).
+ * Per-frame face math runs natively on direct buffers, so the frame loop doesn't
+ * allocate JVM arrays. The native library is loaded by NitroVtoOnLoad.
+ */
+internal object VtoCore {
+    const val BACK_PLANE_LEFT = 1
+    const val BACK_PLANE_RIGHT = 2
+
+    // Most faces rendered at once, matching the native kMaxTrackedFaces
+    const val MAX_TRACKED_FACES = 3
+
+    // Occluder layout, matching the native kOccluderBonesPerFace / kOccluderBackPlaneIndices
+    const val OCCLUDER_BONES_PER_FACE = 3
+    const val OCCLUDER_BACK_PLANE_VERTICES = 8
+    const val OCCLUDER_BACK_PLANE_INDICES = 12
+
+    const val DEVICE_TIER_LOW = 0
+    const val DEVICE_TIER_MID = 1
+    const val DEVICE_TIER_HIGH = 2
+
+    const val THERMAL_NOMINAL = 0
+    const val THERMAL_FAIR = 1
+    const val THERMAL_SERIOUS = 2
+    const val THERMAL_CRITICAL = 3
+
+    // Frame stages, matching the native FrameStage
+    const val STAGE_SESSION = 0
+    const val STAGE_CAMERA = 1
+    const val STAGE_FACE_MESH = 2
+    const val STAGE_GLASSES_POSE = 3
+    const val STAGE_RESOURCES = 4
+    const val STAGE_RENDER = 5
+    const val STAGE_FRAME = 6
+    const val STAGE_GPU = 7
+    const val STAGE_COUNT = 8
+
+    // Face pose buffer shared with JS, matching the native FacePoseStream layout
+    const val FACE_POSE_BUFFER_BYTES = 32 + MAX_TRACKED_FACES * 96
+    const val FACE_TRACKING_NOT_RUNNING = 0
+    const val FACE_TRACKING_SEARCHING = 1
+    const val FACE_TRACKING_TRACKING = 2
+
+    // Third-order spherical harmonics as RGB triplets, matching the native SphericalHarmonics
+    const val SPHERICAL_HARMONICS_BANDS = 3
+    const val SPHERICAL_HARMONICS_FLOATS = 27
+
+    // Lighting estimate sources, matching the native LightSource
+    const val LIGHT_SOURCE_DEFAULT = 0
+    const val LIGHT_SOURCE_TRACKER = 1
+    const val LIGHT_SOURCE_CAMERA = 2
+
+    /**
+     * Pack [vertexCount] face mesh positions from [vertices] into [dst] (both direct buffers),
+     * compute the back plane transform for [faceMatrix], and write the local mesh bounds
+     * into [outBounds] as center (3 floats) + half extent (3 floats).
+     * @return Bitmask of visible back planes ([BACK_PLANE_LEFT], [BACK_PLANE_RIGHT]), or -1 on invalid buffers
+     */
+    @JvmStatic
+    external fun packFaceMesh(
+        vertices: FloatBuffer,
+        vertexCount: Int,
+        dst: FloatBuffer,
+        faceMatrix: FloatArray,
+        backPlaneEnabled: Boolean,
+        outBackPlaneMatrix: FloatArray,
+        outBounds: FloatArray
+    ): Int
+
+    /**
+     * Grow [worldBounds] (min (3 floats) + max (3 floats)) to the world-space box of [localBounds]
+     * (center + half extent, as written by [packFaceMesh]) under [faceMatrix]; [first] starts it over.
+     */
+    @JvmStatic
+    external fun accumulateWorldBounds(
+        faceMatrix: FloatArray,
+        localBounds: FloatArray,
+        worldBounds: FloatArray,
+        first: Boolean
+    )
+
+    /**
+     * Low-poly occluder triangles over the face mesh's own vertices (vertex clustering), from the
+     * face-space [vertices] (direct, 3 floats each) of one tracked face.
+     */
+    @JvmStatic
+    external fun decimateFaceIndices(vertices: FloatBuffer, vertexCount: Int, indices: ShortArray): ShortArray
+
+    /**
+     * Occluder indices for [faceCount] slots, slot after slot: the [faceIndices] offset to the slot's
+     * vertices, then its back planes, so the first n slots draw as one range.
+     * @return The indices, or null when they overflow 16 bits
+     */
+    @JvmStatic
+    external fun buildOccluderIndices(faceIndices: ShortArray, vertexCount: Int, faceCount: Int): ShortArray?
+
+    /**
+     * Bone of every occluder vertex, 4 shorts each: the slot's face meshes, then its back planes.
+     */
+    @JvmStatic
+    external fun occluderBoneIndices(vertexCount: Int, faceCount: Int): ShortArray
+
+    /**
+     * Back plane corners of [faceCount] slots (3 floats each), placed by their bones.
+     */
+    @JvmStatic
+    external fun occluderBackPlaneVertices(faceCount: Int): FloatArray
+
+    @JvmStatic
+    external fun createGlassesPoseSolver(): Long
+
+    @JvmStatic
+    external fun destroyGlassesPoseSolver(handle: Long)
+
+    @JvmStatic
+    external fun resetGlassesPoseSolver(handle: Long)
+
+    @JvmStatic
+    external fun setGlassesForwardOffset(handle: Long, offset: Float)
+
+    @JvmStatic
+    external fun updateGlassesPose(
+        handle: Long,
+        vertices: FloatBuffer,
+        faceMatrix: FloatArray,
+        timestampNanos: Long,
+        predictionNanos: Long,
+        outMatrix: FloatArray
+    ): Boolean
+
+    /**
+     * Device tier ([DEVICE_TIER_LOW], [DEVICE_TIER_MID] or [DEVICE_TIER_HIGH]) from memory and CPU cores.
+     */
+    @JvmStatic
+    external fun classifyDeviceTier(totalMemoryBytes: Long, cpuCores: Int, lowRamDevice: Boolean): Int
+
+    /**
+     * Level of detail a glTF node name asks for ("Frame_LOD1" -> 1), or -1 without a _LOD<n> suffix.
+     */
+    @JvmStatic
+    external fun lodLevelFromName(name: String?): Int
+
+    /**
+     * Estimate the GPU memory of the GLB in the first [size] bytes of [glb] (a direct buffer) and write
+     * geometry and texture bytes into [out]. @return false if it isn't a valid GLB
+     */
+    @JvmStatic
+    external fun estimateModelMemory(glb: ByteBuffer, size: Int, out: LongArray): Boolean
+
+    @JvmStatic
+    external fun createLodSelector(deviceTier: Int): Long
+
+    @JvmStatic
+    external fun destroyLodSelector(handle: Long)
+
+    @JvmStatic
+    external fun setLodLevelCount(handle: Long, count: Int)
+
+    @JvmStatic
+    external fun resetLodSelector(handle: Long)
+
+    @JvmStatic
+    external fun lodLevel(handle: Long): Int
+
+    @JvmStatic
+    external fun updateLodSelector(handle: Long, faceMatrix: FloatArray, cameraMatrix: FloatArray): Int
+
+    @JvmStatic
+    external fun createFramePacer(): Long
+
+    @JvmStatic
+    external fun destroyFramePacer(handle: Long)
+
+    @JvmStatic
+    external fun resetFramePacer(handle: Long)
+
+    /**
+     * Thermal pressure, [THERMAL_NOMINAL] to [THERMAL_CRITICAL].
+     */
+    @JvmStatic
+    external fun setFramePacerThermalLevel(handle: Long, level: Int)
+
+    @JvmStatic
+    external fun addFramePacerFrame(handle: Long, timestampNanos: Long, workNanos: Long, presented: Boolean): Boolean
+
+    @JvmStatic
+    external fun framePacerRenderScale(handle: Long): Float
+
+    @JvmStatic
+    external fun framePacerFramesPerSecond(handle: Long): Int
+
+    @JvmStatic
+    external fun framePacerReason(handle: Long): Int
+
+    @JvmStatic
+    external fun createFrameStats(): Long
+
+    @JvmStatic
+    external fun destroyFrameStats(handle: Long)
+
+    /**
+     * Record one rendered frame: [stageNanos] holds [STAGE_COUNT] durations, -1 for stages that didn't run.
+     */
+    @JvmStatic
+    external fun addFrameStatsFrame(handle: Long, stageNanos: LongArray, dropped: Boolean)
+
+    /**
+     * Write frame count, dropped frames, then p50 / p95 / p99 / max / samples per stage (in seconds)
+     * into [out], which holds 2 + 5 * [STAGE_COUNT] values.
+     */
+    @JvmStatic
+    external fun frameStatsSnapshot(handle: Long, out: DoubleArray)
+
+    /** Debug HUD text of the percentiles: frame counts, then p50 / p95 ms of each stage with samples */
+    @JvmStatic
+    external fun frameStatsSummary(handle: Long): String
+
+    /** Open a face recording at [path], or return 0 if the file can't be created */
+    @JvmStatic
+    external fun createFaceRecorder(path: String): Long
+
+    /** Close the recording and return the number of frames written */
+    @JvmStatic
+    external fun destroyFaceRecorder(handle: Long): Int
+
+    /**
+     * Append one frame. [intrinsics] holds fx, fy, cx, cy in pixels; [faceMatrix] and [vertices]
+     * (a direct buffer of packed float3) are null when no face is tracked.
+     */
+    @JvmStatic
+    external fun writeFaceRecordingFrame(
+        handle: Long,
+        timestampNanos: Long,
+        intrinsics: FloatArray,
+        imageWidth: Int,
+        imageHeight: Int,
+        projection: FloatArray,
+        cameraMatrix: FloatArray,
+        faceMatrix: FloatArray?,
+        vertices: FloatBuffer?
+    )
+
+    /**
+     * Publish one frame to the face pose buffer shared with JS ([buffer], a direct buffer of
+     * [FACE_POSE_BUFFER_BYTES]) under its seqlock. The first [faceCount] entries of [faceMatrices]
+     * and [faceVertices] are the tracked faces; [state] is one of the FACE_TRACKING_ constants.
+     */
+    @JvmStatic
+    external fun writeFacePoses(
+        buffer: ByteBuffer,
+        state: Int,
+        timestampNanos: Long,
+        faceCount: Int,
+        faceMatrices: Array<FloatArray>,
+        faceVertices: Array<FloatBuffer?>,
+        viewMatrix: FloatArray,
+        projection: FloatArray
+    )
+
+    @JvmStatic
+    external fun createLightEstimator(): Long
+
+    @JvmStatic
+    external fun destroyLightEstimator(handle: Long)
+
+    @JvmStatic
+    external fun resetLightEstimator(handle: Long)
+
+    @JvmStatic
+    external fun lightEstimatorWantsEstimate(handle: Long, timestampNanos: Long): Boolean
+
+    /**
+     * ARCore environmental HDR ambient spherical harmonics ([SPHERICAL_HARMONICS_FLOATS] floats, RGB
+     * per coefficient); the brightness is taken from their L00 term.
+     */
+    @JvmStatic
+    external fun addLightEstimatorRadiance(handle: Long, radiance: FloatArray, timestampNanos: Long)
+
+    /**
+     * Small RGBA8 render of the camera background in [image] (a direct buffer, rows bottom first),
+     * rendered with [cameraMatrix] (camera -> world) and [projection].
+     */
+    @JvmStatic
+    external fun addLightEstimatorCameraImage(
+        handle: Long,
+        image: ByteBuffer,
+        width: Int,
+        height: Int,
+        cameraMatrix: FloatArray,
+        projection: FloatArray,
+        brightness: Float,
+        timestampNanos: Long
+    )
+
+    @JvmStatic
+    external fun addLightEstimatorBrightness(handle: Long, brightness: Float, timestampNanos: Long)
+
+    /**
+     * Advance the smoothing to [timestampNanos].
+     * @return True if the indirect light should be rebuilt; [outIrradiance] then holds its
+     * [SPHERICAL_HARMONICS_FLOATS] irradiance coefficients
+     */
+    @JvmStatic
+    external fun updateLightEstimator(handle: Long, timestampNanos: Long, outIrradiance: FloatArray): Boolean
+
+    @JvmStatic
+    external fun lightEstimatorIntensity(handle: Long): Float
+
+    @JvmStatic
+    external fun lightEstimatorSource(handle: Long): Int
+}
+
+/**
+ * Smoothed and latency-compensated glasses pose from ARCore face data, backed by the native
+ * GlassesPoseSolver.
+ */
+internal class GlassesPoseSolver {
+    private var handle: Long = VtoCore.createGlassesPoseSolver()
+
+    /**
+     * Filter a new face observation from the camera frame at [timestampNanos] and write the glasses
+     * world transform, extrapolated [predictionNanos] ahead to the display time, into [outMatrix].
+     */
+    fun update(
+        vertices: FloatBuffer,
+        faceMatrix: FloatArray,
+        timestampNanos: Long,
+        predictionNanos: Long,
+        outMatrix: FloatArray
+    ): Boolean {
+        if (handle == 0L) return false
+        return VtoCore.updateGlassesPose(handle, vertices, faceMatrix, timestampNanos, predictionNanos, outMatrix)
+    }
+
+    fun setForwardOffset(offset: Float) {
+        if (handle != 0L) VtoCore.setGlassesForwardOffset(handle, offset)
+    }
+
+    fun reset() {
+        if (handle != 0L) VtoCore.resetGlassesPoseSolver(handle)
+    }
+
+    fun destroy() {
+        if (handle != 0L) {
+            VtoCore.destroyGlassesPoseSolver(handle)
+            handle = 0L
+        }
+    }
+}
+
+/**
+ * Level of detail selection from face distance and device tier, backed by the native LodSelector.
+ * Level 0 is full detail; switches are damped by hysteresis.
+ */
+internal class LodSelector(deviceTier: Int) {
+    private var handle: Long = VtoCore.createLodSelector(deviceTier)
+
+    /** Level chosen by the last [update] */
+    val level: Int
+        get() = if (handle != 0L) VtoCore.lodLevel(handle) else 0
+
+    fun setLevelCount(count: Int) {
+        if (handle != 0L) VtoCore.setLodLevelCount(handle, count)
+    }
+
+    /**
+     * Update with the face and camera world transforms and return the level to render.
+     */
+    fun update(faceMatrix: FloatArray, cameraMatrix: FloatArray): Int {
+        if (handle == 0L) return 0
+        return VtoCore.updateLodSelector(handle, faceMatrix, cameraMatrix)
+    }
+
+    fun reset() {
+        if (handle != 0L) VtoCore.resetLodSelector(handle)
+    }
+
+    fun destroy() {
+        if (handle != 0L) {
+            VtoCore.destroyLodSelector(handle)
+            handle = 0L
+        }
+    }
+}
+
+/**
+ * Render scale and frame rate choice for thermally constrained devices, backed by the native
+ * FramePacer. Resolution is lowered before frame rate; both recover once there is headroom.
+ */
+internal class FramePacer {
+    private var handle: Long = VtoCore.createFramePacer()
+
+    /** Fraction of full resolution to render at, in (0, 1] */
+    val renderScale: Float
+        get() = if (handle != 0L) VtoCore.framePacerRenderScale(handle) else 1f
+
+    val framesPerSecond: Int
+        get() = if (handle != 0L) VtoCore.framePacerFramesPerSecond(handle) else MAX_FRAMES_PER_SECOND
+
+    /** Why the last change was made, as reported to JS */
+    val reason: String
+        get() = REASONS.getOrElse(if (handle != 0L) VtoCore.framePacerReason(handle) else -1) { "recovered" }
+
+    fun setThermalLevel(level: Int) {
+        if (handle != 0L) VtoCore.setFramePacerThermalLevel(handle, level)
+    }
+
+    /**
+     * Record one vsync callback and return true if the render scale or frame rate changed.
+     * [presented] is false when Filament skipped the frame because the GPU was behind.
+     */
+    fun addFrame(timestampNanos: Long, workNanos: Long, presented: Boolean): Boolean {
+        if (handle == 0L) return false
+        return VtoCore.addFramePacerFrame(handle, timestampNanos, workNanos, presented)
+    }
+
+    fun reset() {
+        if (handle != 0L) VtoCore.resetFramePacer(handle)
+    }
+
+    fun destroy() {
+        if (handle != 0L) {
+            VtoCore.destroyFramePacer(handle)
+            handle = 0L
+        }
+    }
+
+    companion object {
+        const val MAX_FRAMES_PER_SECOND = 60
+
+        // Indexed by the native PacingReason
+        private val REASONS = arrayOf("thermal", "frameTime", "recovered")
+    }
+}
+
+/**
+ * Rolling per-stage frame time percentiles, backed by the native FrameStats. Frames are recorded
+ * on the main thread; [snapshot] may be called from any thread.
+ */
+internal class FrameStats {
+    private var handle: Long = VtoCore.createFrameStats()
+
+    // Filled by the frame loop and handed to addFrame, so recording doesn't allocate
+    private val stageNanos = LongArray(VtoCore.STAGE_COUNT) { -1L }
+
+    /** Clear the current frame's stage durations */
+    fun beginFrame() {
+        stageNanos.fill(-1L)
+    }
+
+    fun setStage(stage: Int, nanos: Long) {
+        stageNanos[stage] = nanos
+    }
+
+    /** Record the current frame. [dropped] is true if Filament skipped presenting it. */
+    fun endFrame(dropped: Boolean) {
+        if (handle != 0L) VtoCore.addFrameStatsFrame(handle, stageNanos, dropped)
+    }
+
+    @Synchronized
+    fun snapshot(): PerformanceStats {
+        val values = DoubleArray(2 + 5 * VtoCore.STAGE_COUNT)
+        if (handle != 0L) VtoCore.frameStatsSnapshot(handle, values)
+
+        fun stage(stage: Int): StageTiming {
+            val offset = 2 + 5 * stage
+            return StageTiming(
+                values[offset] * 1000.0,
+                values[offset + 1] * 1000.0,
+                values[offset + 2] * 1000.0,
+                values[offset + 3] * 1000.0,
+                values[offset + 4]
+            )
+        }
+        return PerformanceStats(
+            values[0],
+            values[1],
+            stage(VtoCore.STAGE_SESSION),
+            stage(VtoCore.STAGE_CAMERA),
+            stage(VtoCore.STAGE_FACE_MESH),
+            stage(VtoCore.STAGE_GLASSES_POSE),
+            stage(VtoCore.STAGE_RESOURCES),
+            stage(VtoCore.STAGE_RENDER),
+            stage(VtoCore.STAGE_FRAME),
+            stage(VtoCore.STAGE_GPU)
+        )
+    }
+
+    @Synchronized
+    fun summary(): String = if (handle != 0L) VtoCore.frameStatsSummary(handle) else ""
+
+    @Synchronized
+    fun destroy() {
+        if (handle != 0L) {
+            VtoCore.destroyFrameStats(handle)
+            handle = 0L
+        }
+    }
+
+    companion object {
+        private val NO_SAMPLES = StageTiming(0.0, 0.0, 0.0, 0.0, 0.0)
+
+        /** Stats of a view that hasn't rendered */
+        val EMPTY = PerformanceStats(
+            0.0, 0.0, NO_SAMPLES, NO_SAMPLES, NO_SAMPLES, NO_SAMPLES,
+            NO_SAMPLES, NO_SAMPLES, NO_SAMPLES, NO_SAMPLES
+        )
+    }
+}
+
+/**
+ * Streams the tracked face session to a file for scripts/replay-bench.ts, backed by the native
+ * FaceRecordingWriter. Used on the main thread only.
+ */
+internal class FaceRecorder private constructor(private var handle: Long) {
+    /**
+     * Append one frame; [faceMatrix] and [vertices] are null when no face is tracked.
+     */
+    fun writeFrame(
+        timestampNanos: Long,
+        intrinsics: FloatArray,
+        imageWidth: Int,
+        imageHeight: Int,
+        projection: FloatArray,
+        cameraMatrix: FloatArray,
+        faceMatrix: FloatArray?,
+        vertices: FloatBuffer?
+    ) {
+        if (handle == 0L) return
+        VtoCore.writeFaceRecordingFrame(
+            handle, timestampNanos, intrinsics, imageWidth, imageHeight,
+            projection, cameraMatrix, faceMatrix, vertices
+        )
+    }
+
+    /** Close the file and return the number of frames written */
+    fun close(): Int {
+        if (handle == 0L) return 0
+        val frameCount = VtoCore.destroyFaceRecorder(handle)
+        handle = 0L
+        return frameCount
+    }
+
+    companion object {
+        /** Start recording to [path], or return null if the file can't be created */
+        fun open(path: String): FaceRecorder? {
+            val handle = VtoCore.createFaceRecorder(path)
+            return if (handle != 0L) FaceRecorder(handle) else null
+        }
+    }
+}
+
+/**
+ * Smoothed, rate-limited lighting estimates for the indirect light, backed by the native
+ * LightEstimator. Render thread only.
+ */
+internal class LightEstimator {
+    private var handle: Long = VtoCore.createLightEstimator()
+
+    /** Irradiance to rebuild the indirect light with after [update] returned true */
+    val irradiance = FloatArray(VtoCore.SPHERICAL_HARMONICS_FLOATS)
+
+    /** Smoothed IndirectLight intensity */
+    val intensity: Float
+        get() = if (handle != 0L) VtoCore.lightEstimatorIntensity(handle) else 30_000f
+
+    /** One of the LIGHT_SOURCE_ constants */
+    val source: Int
+        get() = if (handle != 0L) VtoCore.lightEstimatorSource(handle) else VtoCore.LIGHT_SOURCE_DEFAULT
+
+    /** False while a new estimate would be dropped: skip fetching or computing one */
+    fun wantsEstimate(timestampNanos: Long): Boolean =
+        handle != 0L && VtoCore.lightEstimatorWantsEstimate(handle, timestampNanos)
+
+    fun addRadiance(radiance: FloatArray, timestampNanos: Long) {
+        if (handle != 0L) VtoCore.addLightEstimatorRadiance(handle, radiance, timestampNanos)
+    }
+
+    fun addCameraImage(
+        image: ByteBuffer,
+        width: Int,
+        height: Int,
+        cameraMatrix: FloatArray,
+        projection: FloatArray,
+        brightness: Float,
+        timestampNanos: Long
+    ) {
+        if (handle == 0L) return
+        VtoCore.addLightEstimatorCameraImage(
+            handle, image, width, height, cameraMatrix, projection, brightness, timestampNanos
+        )
+    }
+
+    fun addBrightness(brightness: Float, timestampNanos: Long) {
+        if (handle != 0L) VtoCore.addLightEstimatorBrightness(handle, brightness, timestampNanos)
+    }
+
+    /** Advance the smoothing; true if [irradiance] changed and the indirect light needs a rebuild */
+    fun update(timestampNanos: Long): Boolean =
+        handle != 0L && VtoCore.updateLightEstimator(handle, timestampNanos, irradiance)
+
+    fun reset() {
+        if (handle != 0L) VtoCore.resetLightEstimator(handle)
+    }
+
+    fun destroy() {
+        if (handle != 0L) {
+            VtoCore.destroyLightEstimator(handle)
+            handle = 0L
+        }
+    }
+}
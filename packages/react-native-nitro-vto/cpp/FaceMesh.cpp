@@ -0,0 +1,314 @@
+#include "FaceMesh.hpp"
+
+#include <cfloat>
+#include <cmath>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace vto {
+
+void backPlaneQuad(BackPlaneSide side, float* out) {
+    const float minX = side == BackPlaneSide::Left ? -kBackPlaneHalfWidth : kBackPlaneGap;
+    const float maxX = side == BackPlaneSide::Left ? -kBackPlaneGap : kBackPlaneHalfWidth;
+    const float corners[12] = {
+        minX, -kBackPlaneHalfHeight, 0.0f,  // bottom-left
+        maxX, -kBackPlaneHalfHeight, 0.0f,  // bottom-right
+        minX,  kBackPlaneHalfHeight, 0.0f,  // top-left
+        maxX,  kBackPlaneHalfHeight, 0.0f,  // top-right
+    };
+    for (int i = 0; i < 12; i++) {
+        out[i] = corners[i];
+    }
+}
+
+namespace {
+
+// Scalar tail (and fallback for strides without a NEON path)
+void packFaceVerticesScalar(const float* src, size_t srcStride, size_t begin, size_t end, float* dst,
+                            FaceMeshBounds& bounds) {
+    for (size_t i = begin; i < end; i++) {
+        const float* v = src + i * srcStride;
+        if (dst) {
+            dst[i * 3] = v[0];
+            dst[i * 3 + 1] = v[1];
+            dst[i * 3 + 2] = v[2];
+        }
+        bounds.min = {std::fmin(bounds.min.x, v[0]), std::fmin(bounds.min.y, v[1]), std::fmin(bounds.min.z, v[2])};
+        bounds.max = {std::fmax(bounds.max.x, v[0]), std::fmax(bounds.max.y, v[1]), std::fmax(bounds.max.z, v[2])};
+    }
+}
+
+#if defined(__ARM_NEON)
+// Process 4 vertices per iteration: de-interleave into x/y/z lanes, accumulate
+// per-lane min/max, and re-interleave into the packed destination.
+size_t packFaceVerticesNeon(const float* src, size_t srcStride, size_t count, float* dst,
+                            FaceMeshBounds& bounds) {
+    if (srcStride != 3 && srcStride != 4) return 0;
+
+    float32x4_t minX = vdupq_n_f32(FLT_MAX), minY = minX, minZ = minX;
+    float32x4_t maxX = vdupq_n_f32(-FLT_MAX), maxY = maxX, maxZ = maxX;
+
+    const size_t blocks = count / 4;
+    for (size_t b = 0; b < blocks; b++) {
+        float32x4x3_t xyz;
+        if (srcStride == 4) {
+            // simd_float3 is padded to 16 bytes: drop the 4th lane
+            float32x4x4_t xyzw = vld4q_f32(src + b * 16);
+            xyz.val[0] = xyzw.val[0];
+            xyz.val[1] = xyzw.val[1];
+            xyz.val[2] = xyzw.val[2];
+        } else {
+            xyz = vld3q_f32(src + b * 12);
+        }
+        if (dst) {
+            vst3q_f32(dst + b * 12, xyz);
+        }
+        minX = vminq_f32(minX, xyz.val[0]);
+        minY = vminq_f32(minY, xyz.val[1]);
+        minZ = vminq_f32(minZ, xyz.val[2]);
+        maxX = vmaxq_f32(maxX, xyz.val[0]);
+        maxY = vmaxq_f32(maxY, xyz.val[1]);
+        maxZ = vmaxq_f32(maxZ, xyz.val[2]);
+    }
+
+    bounds.min = {std::fmin(bounds.min.x, vminvq_f32(minX)),
+                  std::fmin(bounds.min.y, vminvq_f32(minY)),
+                  std::fmin(bounds.min.z, vminvq_f32(minZ))};
+    bounds.max = {std::fmax(bounds.max.x, vmaxvq_f32(maxX)),
+                  std::fmax(bounds.max.y, vmaxvq_f32(maxY)),
+                  std::fmax(bounds.max.z, vmaxvq_f32(maxZ))};
+    return blocks * 4;
+}
+#endif
+
+} // namespace
+
+FaceMeshBounds packFaceVertices(const float* src, size_t srcStride, size_t count, float* dst) {
+    if (count == 0) {
+        return {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    }
+
+    FaceMeshBounds bounds = {{FLT_MAX, FLT_MAX, FLT_MAX}, {-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+    size_t done = 0;
+#if defined(__ARM_NEON)
+    done = packFaceVerticesNeon(src, srcStride, count, dst, bounds);
+#endif
+    packFaceVerticesScalar(src, srcStride, done, count, dst, bounds);
+    return bounds;
+}
+
+float faceYaw(const Mat4& faceTransform) {
+    // Yaw = atan2(m[2][0], m[0][0]) for a rotation matrix
+    return std::atan2(faceTransform(2, 0), faceTransform(0, 0));
+}
+
+BackPlanePlacement placeBackPlanes(const Mat4& faceTransform, float minZ, bool enabled) {
+    BackPlanePlacement placement;
+
+    // Offset along local Z axis (minZ is behind the face in face local space)
+    // translation += forward axis (column 2, w = 0) * zOffset
+    const float zOffset = minZ + kBackPlaneDepthOffset;
+    placement.transform = faceTransform;
+#if defined(__ARM_NEON)
+    float* translation = placement.transform.m + 12;
+    vst1q_f32(translation, vmlaq_n_f32(vld1q_f32(translation), vld1q_f32(faceTransform.m + 8), zOffset));
+#else
+    const Float3 forward = forwardAxis(faceTransform);
+    placement.transform(3, 0) += forward.x * zOffset;
+    placement.transform(3, 1) += forward.y * zOffset;
+    placement.transform(3, 2) += forward.z * zOffset;
+#endif
+
+    // When turning right (negative yaw): left temple visible, hide left back plane
+    // When turning left (positive yaw): right temple visible, hide right back plane
+    const float yaw = faceYaw(faceTransform);
+    placement.showLeft = enabled && (yaw < kBackPlaneYawThreshold);
+    placement.showRight = enabled && (yaw > -kBackPlaneYawThreshold);
+
+    return placement;
+}
+
+FaceMeshBounds transformBounds(const Mat4& faceTransform, const FaceMeshBounds& bounds) {
+    FaceMeshBounds result = {{FLT_MAX, FLT_MAX, FLT_MAX}, {-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+    for (int corner = 0; corner < 8; corner++) {
+        const Float3 local = {
+            (corner & 1) ? bounds.max.x : bounds.min.x,
+            (corner & 2) ? bounds.max.y : bounds.min.y,
+            (corner & 4) ? bounds.max.z : bounds.min.z,
+        };
+        const Float3 p = transformPoint(faceTransform, local);
+        result.min = {std::fmin(result.min.x, p.x), std::fmin(result.min.y, p.y), std::fmin(result.min.z, p.z)};
+        result.max = {std::fmax(result.max.x, p.x), std::fmax(result.max.y, p.y), std::fmax(result.max.z, p.z)};
+    }
+    return result;
+}
+
+FaceMeshBounds mergeBounds(const FaceMeshBounds& a, const FaceMeshBounds& b) {
+    return {
+        {std::fmin(a.min.x, b.min.x), std::fmin(a.min.y, b.min.y), std::fmin(a.min.z, b.min.z)},
+        {std::fmax(a.max.x, b.max.x), std::fmax(a.max.y, b.max.y), std::fmax(a.max.z, b.max.z)},
+    };
+}
+
+size_t decimateFaceIndices(const float* vertices, size_t stride, size_t vertexCount,
+                           const uint16_t* indices, size_t indexCount, float cellSize, uint16_t* out) {
+    if (vertexCount == 0 || cellSize <= 0.0f) return 0;
+
+    const FaceMeshBounds bounds = packFaceVertices(vertices, stride, vertexCount, nullptr);
+    auto position = [&](size_t v) {
+        const float* p = vertices + v * stride;
+        return Float3{p[0], p[1], p[2]};
+    };
+
+    // Group the vertices by grid cell
+    std::unordered_map<uint64_t, uint32_t> cellClusters;
+    std::vector<uint32_t> vertexCluster(vertexCount);
+    std::vector<Float3> clusterSum;
+    std::vector<uint32_t> clusterSize;
+    for (size_t v = 0; v < vertexCount; v++) {
+        const Float3 p = position(v);
+        const auto cx = static_cast<uint64_t>((p.x - bounds.min.x) / cellSize);
+        const auto cy = static_cast<uint64_t>((p.y - bounds.min.y) / cellSize);
+        const auto cz = static_cast<uint64_t>((p.z - bounds.min.z) / cellSize);
+        const uint64_t key = (cx << 42) | (cy << 21) | cz;
+        auto [it, inserted] = cellClusters.try_emplace(key, static_cast<uint32_t>(clusterSum.size()));
+        if (inserted) {
+            clusterSum.push_back({0.0f, 0.0f, 0.0f});
+            clusterSize.push_back(0);
+        }
+        const uint32_t cluster = it->second;
+        vertexCluster[v] = cluster;
+        clusterSum[cluster] = {clusterSum[cluster].x + p.x, clusterSum[cluster].y + p.y, clusterSum[cluster].z + p.z};
+        clusterSize[cluster]++;
+    }
+
+    // Each cluster is stood for by its vertex nearest to the cluster's mean, so the occluder stays
+    // on the tracked surface
+    std::vector<uint32_t> representative(clusterSum.size(), UINT32_MAX);
+    std::vector<float> representativeDistance(clusterSum.size(), FLT_MAX);
+    for (size_t v = 0; v < vertexCount; v++) {
+        const uint32_t cluster = vertexCluster[v];
+        const float scale = 1.0f / static_cast<float>(clusterSize[cluster]);
+        const Float3 p = position(v);
+        const float dx = p.x - clusterSum[cluster].x * scale;
+        const float dy = p.y - clusterSum[cluster].y * scale;
+        const float dz = p.z - clusterSum[cluster].z * scale;
+        const float distance = dx * dx + dy * dy + dz * dz;
+        if (distance < representativeDistance[cluster]) {
+            representativeDistance[cluster] = distance;
+            representative[cluster] = static_cast<uint32_t>(v);
+        }
+    }
+
+    // Keep the triangles spanning three clusters, once each (rotated to a canonical order that
+    // keeps the winding)
+    std::unordered_set<uint64_t> triangles;
+    size_t written = 0;
+    for (size_t i = 0; i + 2 < indexCount; i += 3) {
+        if (indices[i] >= vertexCount || indices[i + 1] >= vertexCount || indices[i + 2] >= vertexCount) continue;
+        uint32_t a = representative[vertexCluster[indices[i]]];
+        uint32_t b = representative[vertexCluster[indices[i + 1]]];
+        uint32_t c = representative[vertexCluster[indices[i + 2]]];
+        if (a == b || b == c || a == c) continue;
+        while (a > b || a > c) {
+            const uint32_t first = a;
+            a = b;
+            b = c;
+            c = first;
+        }
+        if (!triangles.insert((uint64_t(a) << 32) | (uint64_t(b) << 16) | c).second) continue;
+        out[written++] = static_cast<uint16_t>(a);
+        out[written++] = static_cast<uint16_t>(b);
+        out[written++] = static_cast<uint16_t>(c);
+    }
+    return written;
+}
+
+bool buildOccluderIndices(const uint16_t* faceIndices, size_t faceIndexCount, size_t vertexCount,
+                          size_t faceCount, uint16_t* out) {
+    if (occluderVertexCount(vertexCount, faceCount) > UINT16_MAX + 1u) return false;
+
+    const size_t backPlaneBase = vertexCount * faceCount;
+    for (size_t face = 0; face < faceCount; face++) {
+        uint16_t* dst = out + face * occluderSlotIndexCount(faceIndexCount);
+        const size_t faceOffset = face * vertexCount;
+        for (size_t i = 0; i < faceIndexCount; i++) {
+            dst[i] = static_cast<uint16_t>(faceIndices[i] + faceOffset);
+        }
+        // Left quad, then the right one 4 vertices on
+        const size_t planeOffset = backPlaneBase + face * kOccluderBackPlaneVertices;
+        for (size_t i = 0; i < 6; i++) {
+            dst[faceIndexCount + i] = static_cast<uint16_t>(kBackPlaneIndices[i] + planeOffset);
+            dst[faceIndexCount + 6 + i] = static_cast<uint16_t>(kBackPlaneIndices[i] + planeOffset + 4);
+        }
+    }
+    return true;
+}
+
+void occluderBoneIndices(size_t vertexCount, size_t faceCount, uint16_t* out) {
+    const size_t faceVertices = vertexCount * faceCount;
+    const size_t total = occluderVertexCount(vertexCount, faceCount);
+    for (size_t v = 0; v < total; v++) {
+        size_t bone;
+        if (v < faceVertices) {
+            bone = (v / vertexCount) * kOccluderBonesPerFace;
+        } else {
+            const size_t planeVertex = v - faceVertices;
+            const size_t face = planeVertex / kOccluderBackPlaneVertices;
+            const size_t side = (planeVertex % kOccluderBackPlaneVertices) / 4;
+            bone = face * kOccluderBonesPerFace + 1 + side;
+        }
+        uint16_t* dst = out + v * 4;
+        dst[0] = static_cast<uint16_t>(bone);
+        dst[1] = 0;
+        dst[2] = 0;
+        dst[3] = 0;
+    }
+}
+
+void occluderBackPlaneVertices(size_t faceCount, size_t stride, float* out) {
+    float corners[2][12];
+    backPlaneQuad(BackPlaneSide::Left, corners[0]);
+    backPlaneQuad(BackPlaneSide::Right, corners[1]);
+    for (size_t face = 0; face < faceCount; face++) {
+        for (size_t corner = 0; corner < kOccluderBackPlaneVertices; corner++) {
+            const float* src = &corners[corner / 4][(corner % 4) * 3];
+            float* dst = out + (face * kOccluderBackPlaneVertices + corner) * stride;
+            dst[0] = src[0];
+            dst[1] = src[1];
+            dst[2] = src[2];
+            for (size_t i = 3; i < stride; i++) {
+                dst[i] = 0.0f;
+            }
+        }
+    }
+}
+
+Float3 noseBridgeWorldPosition(const Mat4& faceTransform,
+                               const float* vertices,
+                               size_t stride,
+                               size_t count,
+                               NoseBridgeLandmarks landmarks) {
+    if (landmarks.left >= count || landmarks.right >= count) {
+        // Fallback to face center
+        return {faceTransform(3, 0), faceTransform(3, 1), faceTransform(3, 2)};
+    }
+
+    const float* left = vertices + landmarks.left * stride;
+    const float* right = vertices + landmarks.right * stride;
+
+    // Center in local face coordinates, then transform to world coordinates
+    const Float3 center = {
+        (left[0] + right[0]) * 0.5f,
+        (left[1] + right[1]) * 0.5f,
+        (left[2] + right[2]) * 0.5f,
+    };
+    return transformPoint(faceTransform, center);
+}
+
+} // namespace vto
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "VtoMath.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace vto {
+
+/**
+ * Pair of face mesh vertex indices on each side of the nose bridge.
+ * The glasses are anchored at their midpoint.
+ */
+struct NoseBridgeLandmarks {
+    uint32_t left;
+    uint32_t right;
+};
+
+// ARKit face mesh vertex indices for nose bridge
+// Reference: https://www.oxfordechoes.com/ios-arkit-face-tracking-vertices/
+constexpr NoseBridgeLandmarks kARKitNoseBridge = {818, 366};
+
+// ARCore canonical face mesh vertex indices for nose bridge
+// Reference: https://github.com/google-ar/arcore-android-sdk/blob/main/assets/canonical_face_mesh.fbx
+constexpr NoseBridgeLandmarks kARCoreNoseBridge = {351, 122};
+
+// Back clipping planes (split left/right so each can be hidden based on head rotation)
+constexpr float kBackPlaneHalfWidth = 0.12f;   // 12cm half-width for each plane
+constexpr float kBackPlaneHalfHeight = 0.08f;  // 8cm half-height (16cm total)
+constexpr float kBackPlaneGap = 0.01f;         // Small gap between planes at center
+constexpr float kBackPlaneDepthOffset = 0.03f; // 3cm behind the furthest face point
+constexpr float kBackPlaneYawThreshold = 0.12f; // ~7 degrees in radians
+constexpr uint16_t kBackPlaneIndices[6] = {0, 1, 2, 2, 1, 3};
+
+// Most faces rendered at once (ARKit tracks up to 3 on A12 and later, ARCore a single one)
+constexpr int kMaxTrackedFaces = 3;
+
+// Occluder: every face slot's mesh and back planes drawn as one skinned renderable. Each slot has
+// three bones (face, left back plane, right back plane); a hidden part gets a zero bone, which
+// collapses its triangles to a point, so showing or hiding one never touches the scene.
+constexpr size_t kOccluderBonesPerFace = 3;
+constexpr size_t kOccluderBackPlaneVertices = 8;  // Left then right quad
+constexpr size_t kOccluderBackPlaneIndices = 12;
+// Grid cell of the low-poly occluder mesh: about the tracked mesh's accuracy at the cheeks and
+// temples, where the glasses' temples pass behind the face
+constexpr float kOccluderCellSize = 0.008f;
+
+enum class BackPlaneSide {
+    Left,  // User's left side, camera's right side
+    Right, // User's right side, camera's left side
+};
+
+/**
+ * Back plane transform and per-side visibility for the current face pose.
+ */
+struct BackPlanePlacement {
+    Mat4 transform;
+    bool showLeft;
+    bool showRight;
+};
+
+/**
+ * Axis-aligned bounds of the face mesh in face local space.
+ */
+struct FaceMeshBounds {
+    Float3 min;
+    Float3 max;
+};
+
+/// Write the 4 corners (bottom-left, bottom-right, top-left, top-right) of a back plane quad as 12 floats
+void backPlaneQuad(BackPlaneSide side, float* out);
+
+/// Copy `count` vertex positions from a strided source (in floats, e.g. 4 for simd_float3, 3 for ARCore)
+/// into a tightly packed float3 array and return their bounds in the same pass (NEON when available).
+/// `dst` may be null to only compute the bounds. An empty mesh yields zero bounds.
+FaceMeshBounds packFaceVertices(const float* src, size_t srcStride, size_t count, float* dst);
+
+/// World-space bounds of face-local bounds under a face transform (the box around its 8 transformed corners)
+FaceMeshBounds transformBounds(const Mat4& faceTransform, const FaceMeshBounds& bounds);
+
+/// Union of two bounds
+FaceMeshBounds mergeBounds(const FaceMeshBounds& a, const FaceMeshBounds& b);
+
+/**
+ * Low-poly occluder triangles over the face mesh's own vertices, by vertex clustering: vertices are
+ * grouped on a `cellSize` grid, each group is replaced by its vertex nearest to the group's mean,
+ * and triangles that collapse or repeat are dropped. Only the indices change, so the tracked
+ * vertices stream in unchanged and the dense eye and lip regions stop costing triangles.
+ * Computed once per topology from one tracked face.
+ * @param vertices Face-local positions, `stride` floats apart (4 for simd_float3, 3 for ARCore)
+ * @param out At least indexCount entries
+ * @return Number of indices written
+ */
+size_t decimateFaceIndices(const float* vertices, size_t stride, size_t vertexCount,
+                           const uint16_t* indices, size_t indexCount, float cellSize, uint16_t* out);
+
+/// Vertices of an occluder for faceCount slots: the face meshes back to back, then the back planes
+constexpr size_t occluderVertexCount(size_t vertexCount, size_t faceCount) {
+    return (vertexCount + kOccluderBackPlaneVertices) * faceCount;
+}
+
+/// Indices per occluder slot: its face triangles, then its back planes
+constexpr size_t occluderSlotIndexCount(size_t faceIndexCount) {
+    return faceIndexCount + kOccluderBackPlaneIndices;
+}
+
+/**
+ * Occluder index buffer for faceCount slots, slot after slot, so drawing the first n slots is the
+ * range [0, n * occluderSlotIndexCount(faceIndexCount)).
+ * @param out occluderSlotIndexCount(faceIndexCount) * faceCount entries
+ * @return False (writing nothing) when the vertices overflow 16-bit indices
+ */
+bool buildOccluderIndices(const uint16_t* faceIndices, size_t faceIndexCount, size_t vertexCount,
+                          size_t faceCount, uint16_t* out);
+
+/// Bone of every occluder vertex (occluderVertexCount entries of 4, unused ones zero)
+void occluderBoneIndices(size_t vertexCount, size_t faceCount, uint16_t* out);
+
+/// Back plane corners of every slot (kOccluderBackPlaneVertices * faceCount positions, `stride`
+/// floats apart), in each plane's local space: its bone places it behind the face
+void occluderBackPlaneVertices(size_t faceCount, size_t stride, float* out);
+
+/// Head yaw (rotation around Y) of a face transform
+/// Positive yaw = head turning left (user's perspective), negative = turning right
+float faceYaw(const Mat4& faceTransform);
+
+/// Place the back planes behind the face and decide which side is visible based on head yaw
+BackPlanePlacement placeBackPlanes(const Mat4& faceTransform, float minZ, bool enabled);
+
+/// Nose bridge midpoint in world space, falling back to the face origin when the mesh is too small
+Float3 noseBridgeWorldPosition(const Mat4& faceTransform,
+                               const float* vertices,
+                               size_t stride,
+                               size_t count,
+                               NoseBridgeLandmarks landmarks);
+
+} // namespace vto
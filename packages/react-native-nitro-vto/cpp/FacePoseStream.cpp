@@ -0,0 +1,107 @@
+#include "FacePoseStream.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace vto {
+
+namespace {
+
+// The sequence word is shared with JS as a plain uint32 in the buffer
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "Sequence must be a plain 32-bit word");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Sequence must be lock-free");
+
+constexpr size_t kSequenceOffset = 0;
+constexpr size_t kVersionOffset = 4;
+constexpr size_t kStateOffset = 8;
+constexpr size_t kFaceCountOffset = 12;
+constexpr size_t kTimestampOffset = 16;
+
+struct PackedFace {
+    float faceTransform[16];
+    float noseBridge[3];
+    float yaw;
+    float viewX;
+    float viewY;
+    float depth;
+    float reserved;
+};
+static_assert(sizeof(PackedFace) == kFacePoseFaceBytes, "Face slot layout changed");
+
+void put(uint8_t* bytes, size_t offset, const void* value, size_t size) {
+    std::memcpy(bytes + offset, value, size);
+}
+
+} // namespace
+
+FacePoseSample makeFacePoseSample(const Mat4& faceTransform,
+                                  Float3 noseBridge,
+                                  const Mat4& viewMatrix,
+                                  const Mat4& projectionMatrix) {
+    FacePoseSample sample;
+    sample.faceTransform = faceTransform;
+    sample.noseBridge = noseBridge;
+    sample.yaw = faceYaw(faceTransform);
+
+    // Camera space looks down -Z
+    const Float3 eye = transformPoint(viewMatrix, noseBridge);
+    sample.depth = -eye.z;
+    const float clipX = projectionMatrix(0, 0) * eye.x + projectionMatrix(1, 0) * eye.y +
+                        projectionMatrix(2, 0) * eye.z + projectionMatrix(3, 0);
+    const float clipY = projectionMatrix(0, 1) * eye.x + projectionMatrix(1, 1) * eye.y +
+                        projectionMatrix(2, 1) * eye.z + projectionMatrix(3, 1);
+    const float clipW = projectionMatrix(0, 3) * eye.x + projectionMatrix(1, 3) * eye.y +
+                        projectionMatrix(2, 3) * eye.z + projectionMatrix(3, 3);
+    if (clipW > 1e-6f) {
+        sample.viewX = (clipX / clipW + 1.0f) * 0.5f;
+        sample.viewY = (1.0f - clipY / clipW) * 0.5f;
+    } else {
+        // Behind the camera: no meaningful view position
+        sample.viewX = 0.5f;
+        sample.viewY = 0.5f;
+    }
+    return sample;
+}
+
+void writeFacePoses(void* buffer,
+                    FaceTrackingState state,
+                    double timestamp,
+                    const FacePoseSample* faces,
+                    int faceCount) {
+    auto* bytes = static_cast<uint8_t*>(buffer);
+    auto* sequence = reinterpret_cast<std::atomic<uint32_t>*>(bytes + kSequenceOffset);
+    const uint32_t count = static_cast<uint32_t>(std::clamp(faceCount, 0, kMaxTrackedFaces));
+
+    // Odd while writing; the fence keeps the field stores after it
+    const uint32_t start = sequence->load(std::memory_order_relaxed) + 1;
+    sequence->store(start, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const uint32_t version = kFacePoseLayoutVersion;
+    const uint32_t stateValue = static_cast<uint32_t>(state);
+    put(bytes, kVersionOffset, &version, sizeof(version));
+    put(bytes, kStateOffset, &stateValue, sizeof(stateValue));
+    put(bytes, kFaceCountOffset, &count, sizeof(count));
+    put(bytes, kTimestampOffset, &timestamp, sizeof(timestamp));
+
+    for (uint32_t i = 0; i < count; i++) {
+        const FacePoseSample& face = faces[i];
+        PackedFace packed;
+        std::memcpy(packed.faceTransform, face.faceTransform.m, sizeof(packed.faceTransform));
+        packed.noseBridge[0] = face.noseBridge.x;
+        packed.noseBridge[1] = face.noseBridge.y;
+        packed.noseBridge[2] = face.noseBridge.z;
+        packed.yaw = face.yaw;
+        packed.viewX = face.viewX;
+        packed.viewY = face.viewY;
+        packed.depth = face.depth;
+        packed.reserved = 0.0f;
+        put(bytes, kFacePoseHeaderBytes + i * kFacePoseFaceBytes, &packed, sizeof(packed));
+    }
+
+    // Even again: publishes the frame
+    sequence->store(start + 1, std::memory_order_release);
+}
+
+} // namespace vto
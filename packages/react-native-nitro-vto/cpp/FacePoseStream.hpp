@@ -0,0 +1,73 @@
+#pragma once
+
+#include "FaceMesh.hpp"
+#include "VtoMath.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace vto {
+
+/**
+ * Fixed binary layout of the face pose buffer a view shares with JS (getFacePoseBuffer).
+ * The renderer overwrites it every frame under a seqlock: the sequence word is odd while a frame
+ * is being written, so a reader that sees the same even sequence before and after copying the
+ * fields has a consistent frame. Native byte order (little-endian on every supported device).
+ * Mirrored by src/FacePoseReader.ts: bump kFacePoseLayoutVersion when an offset changes.
+ *
+ * Header (32 bytes):
+ *   0  uint32  sequence
+ *   4  uint32  layout version
+ *   8  uint32  tracking state (FaceTrackingState)
+ *   12 uint32  face count
+ *   16 float64 camera frame timestamp (seconds)
+ *   24         reserved
+ * Then kMaxTrackedFaces face slots of 96 bytes, the first faceCount of them valid:
+ *   0  float32[16] face transform, world space, column-major
+ *   64 float32[3]  nose bridge, world space (meters)
+ *   76 float32     head yaw (radians, positive turning to the user's left)
+ *   80 float32[2]  nose bridge in view coordinates, [0, 1] from the top left corner
+ *   88 float32     nose bridge distance in front of the camera (meters)
+ *   92             reserved
+ */
+constexpr uint32_t kFacePoseLayoutVersion = 1;
+constexpr size_t kFacePoseHeaderBytes = 32;
+constexpr size_t kFacePoseFaceBytes = 96;
+constexpr size_t kFacePoseBufferBytes = kFacePoseHeaderBytes + kMaxTrackedFaces * kFacePoseFaceBytes;
+
+enum class FaceTrackingState : uint32_t {
+    /// Rendering is paused (or hasn't started); the buffer is zero-filled before the first frame
+    NotRunning = 0,
+    /// Running, no face tracked
+    Searching = 1,
+    Tracking = 2,
+};
+
+/**
+ * One tracked face as published to JS.
+ */
+struct FacePoseSample {
+    Mat4 faceTransform;
+    Float3 noseBridge;
+    float yaw;
+    float viewX;
+    float viewY;
+    float depth;
+};
+
+/// Face sample for a face transform and its nose bridge, projected with the camera's view
+/// (world -> camera) and projection matrices
+FacePoseSample makeFacePoseSample(const Mat4& faceTransform,
+                                  Float3 noseBridge,
+                                  const Mat4& viewMatrix,
+                                  const Mat4& projectionMatrix);
+
+/// Publish one frame into buffer (kFacePoseBufferBytes, 8-byte aligned) under its seqlock.
+/// Single writer: call from the render thread only. faceCount is clamped to kMaxTrackedFaces.
+void writeFacePoses(void* buffer,
+                    FaceTrackingState state,
+                    double timestamp,
+                    const FacePoseSample* faces,
+                    int faceCount);
+
+} // namespace vto
@@ -0,0 +1,171 @@
+#include "FaceRecording.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace vto {
+
+namespace {
+
+constexpr char kMagic[4] = {'V', 'T', 'O', 'R'};
+constexpr uint32_t kVersion = 1;
+
+// Meters per quantized vertex unit: +-0.33 m around the face origin in int16
+constexpr float kVertexQuantum = 1e-5f;
+
+// Face meshes are at most a few thousand vertices (ARKit 1220, ARCore 468)
+constexpr uint32_t kMaxVertexCount = 1u << 16;
+
+// Bytes of a frame before its face data
+constexpr size_t kCameraBytes = sizeof(double) + 4 * sizeof(float) + 2 * sizeof(uint32_t) + 32 * sizeof(float) +
+                                sizeof(uint32_t);
+
+void append(std::vector<uint8_t>& buffer, const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+}
+
+bool read(FILE* file, void* data, size_t size) {
+    return std::fread(data, 1, size, file) == size;
+}
+
+} // namespace
+
+NoseBridgeLandmarks noseBridgeLandmarks(RecordingSource source) {
+    return source == RecordingSource::ARCore ? kARCoreNoseBridge : kARKitNoseBridge;
+}
+
+FaceRecordingWriter::~FaceRecordingWriter() {
+    close();
+}
+
+bool FaceRecordingWriter::open(const std::string& path, RecordingSource source) {
+    close();
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) return false;
+
+    // Buffered, so the render loop only hits the file system every few frames
+    std::setvbuf(file_, nullptr, _IOFBF, 256 * 1024);
+    buffer_.clear();
+    buffer_.reserve(kCameraBytes + 16 * sizeof(float) + 3 * sizeof(int16_t) * 2048);
+    frameCount_ = 0;
+
+    uint32_t sourceValue = static_cast<uint32_t>(source);
+    append(buffer_, kMagic, sizeof(kMagic));
+    append(buffer_, &kVersion, sizeof(kVersion));
+    append(buffer_, &sourceValue, sizeof(sourceValue));
+    append(buffer_, &kVertexQuantum, sizeof(kVertexQuantum));
+    std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+    return true;
+}
+
+void FaceRecordingWriter::writeFrame(const RecordedCamera& camera,
+                                     const Mat4* faceTransform,
+                                     const float* vertices,
+                                     size_t stride,
+                                     size_t count) {
+    if (!file_) return;
+
+    bool hasFace = faceTransform != nullptr && vertices != nullptr && count > 0;
+    uint32_t vertexCount = hasFace ? static_cast<uint32_t>(std::min<size_t>(count, kMaxVertexCount)) : 0;
+
+    buffer_.clear();
+    float intrinsics[4] = {camera.focalLengthX, camera.focalLengthY, camera.principalPointX, camera.principalPointY};
+    uint32_t imageSize[2] = {camera.imageWidth, camera.imageHeight};
+    append(buffer_, &camera.timestamp, sizeof(camera.timestamp));
+    append(buffer_, intrinsics, sizeof(intrinsics));
+    append(buffer_, imageSize, sizeof(imageSize));
+    append(buffer_, camera.projection.m, sizeof(camera.projection.m));
+    append(buffer_, camera.transform.m, sizeof(camera.transform.m));
+    append(buffer_, &vertexCount, sizeof(vertexCount));
+
+    if (hasFace) {
+        append(buffer_, faceTransform->m, sizeof(faceTransform->m));
+        size_t offset = buffer_.size();
+        buffer_.resize(offset + vertexCount * 3 * sizeof(int16_t));
+        auto* out = reinterpret_cast<int16_t*>(buffer_.data() + offset);
+        for (uint32_t i = 0; i < vertexCount; i++) {
+            for (int axis = 0; axis < 3; axis++) {
+                float units = std::round(vertices[i * stride + axis] / kVertexQuantum);
+                out[i * 3 + axis] = static_cast<int16_t>(std::clamp(units, -32768.0f, 32767.0f));
+            }
+        }
+    }
+
+    std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+    frameCount_++;
+}
+
+void FaceRecordingWriter::close() {
+    if (!file_) return;
+    std::fclose(file_);
+    file_ = nullptr;
+}
+
+FaceRecordingReader::~FaceRecordingReader() {
+    if (file_) std::fclose(file_);
+}
+
+bool FaceRecordingReader::open(const std::string& path) {
+    if (file_) std::fclose(file_);
+    file_ = std::fopen(path.c_str(), "rb");
+    if (!file_) return false;
+
+    char magic[4];
+    uint32_t version = 0;
+    uint32_t source = 0;
+    if (!read(file_, magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+        !read(file_, &version, sizeof(version)) || version != kVersion ||
+        !read(file_, &source, sizeof(source)) || !read(file_, &vertexScale_, sizeof(vertexScale_))) {
+        std::fclose(file_);
+        file_ = nullptr;
+        return false;
+    }
+    source_ = source == static_cast<uint32_t>(RecordingSource::ARCore) ? RecordingSource::ARCore
+                                                                       : RecordingSource::ARKit;
+    firstFrameOffset_ = std::ftell(file_);
+    return true;
+}
+
+bool FaceRecordingReader::next(RecordedFrame& frame) {
+    if (!file_) return false;
+
+    RecordedCamera& camera = frame.camera;
+    float intrinsics[4];
+    uint32_t imageSize[2];
+    uint32_t vertexCount = 0;
+    if (!read(file_, &camera.timestamp, sizeof(camera.timestamp)) || !read(file_, intrinsics, sizeof(intrinsics)) ||
+        !read(file_, imageSize, sizeof(imageSize)) ||
+        !read(file_, camera.projection.m, sizeof(camera.projection.m)) ||
+        !read(file_, camera.transform.m, sizeof(camera.transform.m)) ||
+        !read(file_, &vertexCount, sizeof(vertexCount)) || vertexCount > kMaxVertexCount) {
+        return false;
+    }
+    camera.focalLengthX = intrinsics[0];
+    camera.focalLengthY = intrinsics[1];
+    camera.principalPointX = intrinsics[2];
+    camera.principalPointY = intrinsics[3];
+    camera.imageWidth = imageSize[0];
+    camera.imageHeight = imageSize[1];
+
+    frame.hasFace = vertexCount > 0;
+    frame.vertices.resize(static_cast<size_t>(vertexCount) * 3);
+    if (!frame.hasFace) return true;
+
+    quantized_.resize(static_cast<size_t>(vertexCount) * 3);
+    if (!read(file_, frame.faceTransform.m, sizeof(frame.faceTransform.m)) ||
+        !read(file_, quantized_.data(), quantized_.size() * sizeof(int16_t))) {
+        return false;
+    }
+    for (size_t i = 0; i < quantized_.size(); i++) {
+        frame.vertices[i] = quantized_[i] * vertexScale_;
+    }
+    return true;
+}
+
+void FaceRecordingReader::rewind() {
+    if (file_) std::fseek(file_, firstFrameOffset_, SEEK_SET);
+}
+
+} // namespace vto
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "FaceMesh.hpp"
+#include "VtoMath.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace vto {
+
+/// Face tracker a recording was made with; decides the mesh layout and nose bridge landmarks
+enum class RecordingSource : uint32_t {
+    ARKit = 0,
+    ARCore = 1,
+};
+
+NoseBridgeLandmarks noseBridgeLandmarks(RecordingSource source);
+
+/// Camera state of one recorded frame
+struct RecordedCamera {
+    /// Camera frame timestamp in seconds (ARFrame.timestamp, ARCore Frame.timestamp)
+    double timestamp = 0.0;
+    /// Image intrinsics in pixels
+    float focalLengthX = 0.0f;
+    float focalLengthY = 0.0f;
+    float principalPointX = 0.0f;
+    float principalPointY = 0.0f;
+    uint32_t imageWidth = 0;
+    uint32_t imageHeight = 0;
+    /// Projection the frame was rendered with, and the camera's world transform
+    Mat4 projection = Mat4::identity();
+    Mat4 transform = Mat4::identity();
+};
+
+struct RecordedFrame {
+    RecordedCamera camera;
+    bool hasFace = false;
+    Mat4 faceTransform = Mat4::identity();
+    /// Face mesh positions in face space, packed float3
+    std::vector<float> vertices;
+
+    size_t vertexCount() const { return vertices.size() / 3; }
+};
+
+/**
+ * Streams tracked face sessions to a compact binary file, for replaying the VTO pipeline
+ * offline (see scripts/replay-bench.ts). Little-endian layout:
+ *   header: "VTOR", uint32 version, uint32 RecordingSource, float meters per vertex unit
+ *   frame:  float64 timestamp, float32 fx fy cx cy, uint32 image width height,
+ *           float32[16] projection, float32[16] camera transform, uint32 vertex count,
+ *           then with a face: float32[16] face transform, int16[3 * count] vertices
+ * Vertices are quantized to 10 µm, which halves the file size and is far below ARKit and
+ * ARCore's own mesh noise. A file cut short by a crash replays up to its last whole frame.
+ */
+class FaceRecordingWriter {
+public:
+    FaceRecordingWriter() = default;
+    ~FaceRecordingWriter();
+
+    FaceRecordingWriter(const FaceRecordingWriter&) = delete;
+    FaceRecordingWriter& operator=(const FaceRecordingWriter&) = delete;
+
+    /// Create (or truncate) the file at path and write the header. Returns false if it can't be opened.
+    bool open(const std::string& path, RecordingSource source);
+    bool isOpen() const { return file_ != nullptr; }
+
+    /**
+     * Append one frame. faceTransform is null when no face is tracked; vertices are strided
+     * in floats (4 for simd_float3, 3 for ARCore).
+     */
+    void writeFrame(const RecordedCamera& camera,
+                    const Mat4* faceTransform,
+                    const float* vertices,
+                    size_t stride,
+                    size_t count);
+
+    uint32_t frameCount() const { return frameCount_; }
+
+    /// Flush and close the file (also done on destruction)
+    void close();
+
+private:
+    FILE* file_ = nullptr;
+    std::vector<uint8_t> buffer_;
+    uint32_t frameCount_ = 0;
+};
+
+/**
+ * Reads a file written by FaceRecordingWriter one frame at a time.
+ */
+class FaceRecordingReader {
+public:
+    FaceRecordingReader() = default;
+    ~FaceRecordingReader();
+
+    FaceRecordingReader(const FaceRecordingReader&) = delete;
+    FaceRecordingReader& operator=(const FaceRecordingReader&) = delete;
+
+    /// Open a recording and read its header. Returns false if the file is missing or not a recording.
+    bool open(const std::string& path);
+    RecordingSource source() const { return source_; }
+
+    /// Read the next frame into frame (reusing its vertex storage). Returns false at the end.
+    bool next(RecordedFrame& frame);
+
+    /// Back to the first frame
+    void rewind();
+
+private:
+    FILE* file_ = nullptr;
+    RecordingSource source_ = RecordingSource::ARKit;
+    float vertexScale_ = 0.0f;
+    long firstFrameOffset_ = 0;
+    std::vector<int16_t> quantized_;
+};
+
+} // namespace vto
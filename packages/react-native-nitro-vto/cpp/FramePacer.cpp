@@ -0,0 +1,136 @@
+#include "FramePacer.hpp"
+
+#include <algorithm>
+
+namespace vto {
+
+namespace {
+
+struct PacingStep {
+    float renderScale;
+    int framesPerSecond;
+};
+
+// Resolution goes first: a softer image is less noticeable than glasses lagging the face
+constexpr PacingStep kSteps[] = {
+    {1.0f, 60},
+    {0.85f, 60},
+    {0.7f, 60},
+    {0.7f, 30},
+    {0.5f, 30},
+};
+constexpr int kStepCount = sizeof(kSteps) / sizeof(kSteps[0]);
+
+// Lowest step each thermal level allows
+constexpr int kThermalMinStep[] = {0, 0, 2, 4};
+
+// Seconds of frames behind a frame time decision, and since the last change before undoing one
+constexpr double kDecisionInterval = 2.0;
+constexpr double kRecoveryInterval = 6.0;
+
+// Over budget: smoothed work above this fraction of the frame time, or too many skipped frames
+constexpr double kOverloadFraction = 0.85;
+constexpr double kMaxSkippedFraction = 0.05;
+
+// Headroom: smoothed work below this fraction of the next better step's frame time
+constexpr double kHeadroomFraction = 0.6;
+
+constexpr double kWorkSmoothing = 0.1;
+
+} // namespace
+
+const char* pacingReasonName(PacingReason reason) {
+    switch (reason) {
+        case PacingReason::Thermal:
+            return "thermal";
+        case PacingReason::FrameTime:
+            return "frameTime";
+        case PacingReason::Recovered:
+            return "recovered";
+    }
+    return "recovered";
+}
+
+FramePacer::FramePacer() {
+    reset();
+}
+
+void FramePacer::reset() {
+    thermal_ = ThermalLevel::Nominal;
+    reason_ = PacingReason::Recovered;
+    step_ = 0;
+    lastChange_ = -1.0;
+    windowStart_ = -1.0;
+    workEma_ = 0.0;
+    frames_ = 0;
+    skippedFrames_ = 0;
+}
+
+void FramePacer::setThermalLevel(ThermalLevel level) {
+    thermal_ = std::clamp(level, ThermalLevel::Nominal, ThermalLevel::Critical);
+}
+
+float FramePacer::renderScale() const {
+    return kSteps[step_].renderScale;
+}
+
+int FramePacer::framesPerSecond() const {
+    return kSteps[step_].framesPerSecond;
+}
+
+bool FramePacer::addFrame(double timestampSeconds, double workSeconds, bool presented) {
+    if (windowStart_ < 0.0) {
+        startWindow(timestampSeconds);
+        lastChange_ = timestampSeconds;
+        workEma_ = workSeconds;
+    }
+
+    frames_++;
+    if (!presented) skippedFrames_++;
+    workEma_ += (workSeconds - workEma_) * kWorkSmoothing;
+
+    // Thermal pressure doesn't wait for frame statistics
+    const int minStep = kThermalMinStep[static_cast<int>(thermal_)];
+    if (step_ < minStep) {
+        return setStep(minStep, PacingReason::Thermal, timestampSeconds);
+    }
+
+    if (timestampSeconds - windowStart_ < kDecisionInterval) return false;
+
+    const double budget = 1.0 / kSteps[step_].framesPerSecond;
+    const bool overloaded = workEma_ > budget * kOverloadFraction ||
+                            skippedFrames_ > frames_ * kMaxSkippedFraction;
+
+    bool changed = false;
+    if (overloaded && step_ + 1 < kStepCount) {
+        changed = setStep(step_ + 1, PacingReason::FrameTime, timestampSeconds);
+    } else if (!overloaded && step_ > minStep && skippedFrames_ == 0 &&
+               timestampSeconds - lastChange_ >= kRecoveryInterval) {
+        const double betterBudget = 1.0 / kSteps[step_ - 1].framesPerSecond;
+        if (workEma_ < betterBudget * kHeadroomFraction) {
+            changed = setStep(step_ - 1, PacingReason::Recovered, timestampSeconds);
+        }
+    }
+
+    startWindow(timestampSeconds);
+    return changed;
+}
+
+bool FramePacer::setStep(int step, PacingReason reason, double now) {
+    step = std::clamp(step, 0, kStepCount - 1);
+    if (step == step_) return false;
+
+    step_ = step;
+    reason_ = reason;
+    lastChange_ = now;
+    startWindow(now);
+    return true;
+}
+
+void FramePacer::startWindow(double now) {
+    windowStart_ = now;
+    frames_ = 0;
+    skippedFrames_ = 0;
+}
+
+} // namespace vto
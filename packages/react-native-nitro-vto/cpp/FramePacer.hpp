@@ -0,0 +1,71 @@
+#pragma once
+
+namespace vto {
+
+/**
+ * Device thermal pressure, matching ProcessInfo.ThermalState on iOS. Android's PowerManager
+ * thermal statuses are folded into these four levels.
+ */
+enum class ThermalLevel : int {
+    Nominal = 0,
+    Fair = 1,
+    Serious = 2,
+    Critical = 3,
+};
+
+/// Why the pacer changed the render scale or frame rate
+enum class PacingReason : int {
+    Thermal = 0,
+    FrameTime = 1,
+    Recovered = 2,
+};
+
+/// Name reported to JS for a pacing reason ("thermal", "frameTime", "recovered")
+const char* pacingReasonName(PacingReason reason);
+
+/**
+ * Chooses render scale and frame rate to hold the frame time budget on hot or slow devices.
+ * Steps walk a fixed ladder that lowers resolution first and frame rate second. Frame time
+ * steps are taken at most once per decision interval. Thermal pressure jumps straight to the
+ * step it requires. Steps are only undone after a longer stretch of headroom.
+ */
+class FramePacer {
+public:
+    FramePacer();
+
+    /// Back to full scale and frame rate, with no frame history
+    void reset();
+
+    void setThermalLevel(ThermalLevel level);
+    ThermalLevel thermalLevel() const { return thermal_; }
+
+    /**
+     * Record one display link / vsync callback.
+     * @param timestampSeconds Monotonic frame timestamp
+     * @param workSeconds CPU time spent preparing and submitting the frame
+     * @param presented False if the renderer skipped the frame because the GPU was behind
+     * @return True if the render scale or frame rate changed
+     */
+    bool addFrame(double timestampSeconds, double workSeconds, bool presented);
+
+    /// Fraction of full resolution to render at, in (0, 1]
+    float renderScale() const;
+    int framesPerSecond() const;
+    /// Reason for the last change (Recovered before any)
+    PacingReason reason() const { return reason_; }
+
+private:
+    bool setStep(int step, PacingReason reason, double now);
+    void startWindow(double now);
+
+    ThermalLevel thermal_ = ThermalLevel::Nominal;
+    PacingReason reason_ = PacingReason::Recovered;
+    int step_ = 0;
+    double lastChange_ = -1.0;
+    double windowStart_ = -1.0;
+    double workEma_ = 0.0;
+    int frames_ = 0;
+    int skippedFrames_ = 0;
+};
+
+} // namespace vto
@@ -0,0 +1,97 @@
+#include "FrameStats.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace vto {
+
+namespace {
+
+/// Nearest-rank percentile of the first count values. Reorders them.
+float percentile(float* values, int count, double fraction) {
+    int rank = std::clamp(static_cast<int>(fraction * count + 0.5) - 1, 0, count - 1);
+    std::nth_element(values, values + rank, values + count);
+    return values[rank];
+}
+
+} // namespace
+
+const char* frameStageName(FrameStage stage) {
+    switch (stage) {
+        case FrameStage::Session: return "session";
+        case FrameStage::Camera: return "camera";
+        case FrameStage::FaceMesh: return "faceMesh";
+        case FrameStage::GlassesPose: return "glassesPose";
+        case FrameStage::Resources: return "resources";
+        case FrameStage::Render: return "render";
+        case FrameStage::Frame: return "frame";
+        case FrameStage::Gpu: return "gpu";
+    }
+    return "";
+}
+
+std::string formatFrameStats(const FrameStatsSnapshot& snapshot) {
+    char line[64];
+    std::snprintf(line, sizeof(line), "frames %llu  dropped %llu\n",
+                  static_cast<unsigned long long>(snapshot.frameCount),
+                  static_cast<unsigned long long>(snapshot.droppedFrames));
+    std::string text = line;
+    text += "stage        p50    p95 ms";
+    for (int stage = 0; stage < kFrameStageCount; stage++) {
+        const StageSummary& summary = snapshot.stages[stage];
+        if (summary.samples == 0) continue;
+        std::snprintf(line, sizeof(line), "\n%-11s %5.2f  %5.2f", frameStageName(static_cast<FrameStage>(stage)),
+                      summary.p50 * 1000.0, summary.p95 * 1000.0);
+        text += line;
+    }
+    return text;
+}
+
+void FrameStats::addFrame(const FrameTimings& timings, bool dropped) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    frameCount_++;
+    if (dropped) droppedFrames_++;
+
+    for (int stage = 0; stage < kFrameStageCount; stage++) {
+        double seconds = timings.seconds[stage];
+        if (seconds < 0.0) continue;
+        Ring& ring = rings_[stage];
+        ring.values[ring.next] = static_cast<float>(seconds);
+        ring.next = (ring.next + 1) % kWindowSize;
+        ring.count = std::min(ring.count + 1, kWindowSize);
+    }
+}
+
+FrameStatsSnapshot FrameStats::snapshot() const {
+    FrameStatsSnapshot snapshot;
+    std::array<Ring, kFrameStageCount> rings;
+    {
+        // Copy out so the render loop isn't held up while the percentiles are computed
+        std::lock_guard<std::mutex> lock(mutex_);
+        rings = rings_;
+        snapshot.frameCount = frameCount_;
+        snapshot.droppedFrames = droppedFrames_;
+    }
+
+    for (int stage = 0; stage < kFrameStageCount; stage++) {
+        Ring& ring = rings[stage];
+        if (ring.count == 0) continue;
+        float* values = ring.values.data();
+        StageSummary& summary = snapshot.stages[stage];
+        summary.samples = ring.count;
+        summary.max = *std::max_element(values, values + ring.count);
+        summary.p50 = percentile(values, ring.count, 0.50);
+        summary.p95 = percentile(values, ring.count, 0.95);
+        summary.p99 = percentile(values, ring.count, 0.99);
+    }
+    return snapshot;
+}
+
+void FrameStats::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rings_ = {};
+    frameCount_ = 0;
+    droppedFrames_ = 0;
+}
+
+} // namespace vto
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace vto {
+
+/**
+ * Timed parts of a rendered frame, in the order they run. Frame is the whole callback and Gpu
+ * is Filament's measured GPU time for a recent frame.
+ */
+enum class FrameStage : int {
+    /// ARKit currentFrame / ARCore Session.update()
+    Session = 0,
+    /// Camera projection, camera texture, background transform and light estimation
+    Camera = 1,
+    /// Face occlusion mesh uploads
+    FaceMesh = 2,
+    /// Glasses pose solve, filtering and level of detail
+    GlassesPose = 3,
+    /// Streaming glasses resources (updateLoading)
+    Resources = 4,
+    /// Filament beginFrame / render / endFrame
+    Render = 5,
+    Frame = 6,
+    Gpu = 7,
+};
+
+constexpr int kFrameStageCount = 8;
+
+/// Name of a stage, as in getPerformanceStats ("session", "camera", ...)
+const char* frameStageName(FrameStage stage);
+
+/// Seconds spent in each stage of one frame; negative for stages that didn't run
+struct FrameTimings {
+    FrameTimings() { clear(); }
+
+    void clear() { seconds.fill(-1.0); }
+    void set(FrameStage stage, double value) { seconds[static_cast<int>(stage)] = value; }
+
+    std::array<double, kFrameStageCount> seconds;
+};
+
+/// Distribution of one stage over the rolling window, in seconds
+struct StageSummary {
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+    int samples = 0;
+};
+
+struct FrameStatsSnapshot {
+    /// Frames rendered and frames Filament skipped because the GPU was behind, since reset
+    uint64_t frameCount = 0;
+    uint64_t droppedFrames = 0;
+    std::array<StageSummary, kFrameStageCount> stages;
+};
+
+/// Debug HUD text: frame and dropped counts, then the p50 / p95 milliseconds of every stage with
+/// samples, one line each
+std::string formatFrameStats(const FrameStatsSnapshot& snapshot);
+
+/**
+ * Rolling per-stage frame time percentiles for field telemetry. The render loop records one
+ * frame at a time and any thread may take a snapshot: recording is a short locked copy into
+ * fixed ring buffers, and the percentiles are only computed when a snapshot is taken.
+ */
+class FrameStats {
+public:
+    /// Frames each stage's percentiles are computed over (about 5 seconds at 60 fps)
+    static constexpr int kWindowSize = 300;
+
+    /// Record one rendered frame. dropped is true if Filament skipped presenting it.
+    void addFrame(const FrameTimings& timings, bool dropped);
+
+    FrameStatsSnapshot snapshot() const;
+
+    void reset();
+
+private:
+    struct Ring {
+        std::array<float, kWindowSize> values{};
+        int count = 0;
+        int next = 0;
+    };
+
+    mutable std::mutex mutex_;
+    std::array<Ring, kFrameStageCount> rings_;
+    uint64_t frameCount_ = 0;
+    uint64_t droppedFrames_ = 0;
+};
+
+} // namespace vto
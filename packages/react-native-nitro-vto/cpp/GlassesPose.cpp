@@ -0,0 +1,35 @@
+#include "GlassesPose.hpp"
+
+namespace vto {
+
+GlassesPoseSolver::GlassesPoseSolver(NoseBridgeLandmarks landmarks)
+    : landmarks_(landmarks) {}
+
+Mat4 GlassesPoseSolver::update(const Mat4& faceTransform,
+                               const float* vertices,
+                               size_t stride,
+                               size_t count,
+                               double timestamp,
+                               double predictionSeconds) {
+    const Float3 noseBridge = noseBridgeWorldPosition(faceTransform, vertices, stride, count, landmarks_);
+    const Quat faceRotation = quatFromMatrix(faceTransform);
+
+    updatePoseFilter(filter_, filterParams_, {noseBridge, faceRotation}, timestamp);
+    const Pose pose = predictPose(filter_, filterParams_, predictionSeconds);
+
+    Mat4 result = matrixFromQuat(pose.rotation);
+
+    // Offset glasses along face's Z axis (forward/backward)
+    const Float3 forward = forwardAxis(result);
+    result(3, 0) = pose.position.x + forward.x * forwardOffset_;
+    result(3, 1) = pose.position.y + forward.y * forwardOffset_;
+    result(3, 2) = pose.position.z + forward.z * forwardOffset_;
+
+    return result;
+}
+
+void GlassesPoseSolver::reset() {
+    filter_ = PoseFilterState{};
+}
+
+} // namespace vto
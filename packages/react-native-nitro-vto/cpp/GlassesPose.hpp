@@ -0,0 +1,45 @@
+#pragma once
+
+#include "FaceMesh.hpp"
+#include "PoseFilter.hpp"
+
+namespace vto {
+
+/**
+ * Computes the smoothed world-space glasses transform from a tracked face.
+ * Position is anchored at the nose bridge, rotation follows the face transform,
+ * both filtered and extrapolated to the display time by a PoseFilterState, then
+ * offset along the face's forward axis.
+ */
+class GlassesPoseSolver {
+public:
+    GlassesPoseSolver() = default;
+    explicit GlassesPoseSolver(NoseBridgeLandmarks landmarks);
+
+    /// Set forward offset for glasses positioning (in meters)
+    void setForwardOffset(float offset) { forwardOffset_ = offset; }
+    float forwardOffset() const { return forwardOffset_; }
+
+    /**
+     * Filter a new face observation from the camera frame at timestamp (seconds) and return the
+     * glasses world transform predicted predictionSeconds later, when the frame reaches the
+     * display (no scaling - models are in real-world meters).
+     */
+    Mat4 update(const Mat4& faceTransform,
+                const float* vertices,
+                size_t stride,
+                size_t count,
+                double timestamp,
+                double predictionSeconds);
+
+    /// Reset filters (e.g. when the face is lost or the model changes)
+    void reset();
+
+private:
+    NoseBridgeLandmarks landmarks_ = {0, 0};
+    PoseFilterParams filterParams_;
+    PoseFilterState filter_;
+    float forwardOffset_ = 0.005f; // Default: 5mm forward
+};
+
+} // namespace vto
@@ -0,0 +1,277 @@
+#include "LightEstimator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace vto {
+
+namespace {
+
+/// Camera frames further apart than this (a pause) snap to the latest estimate instead of fading
+constexpr double kMaxSmoothingGap = 1.0;
+
+/// Darker L00 luminance than this carries no usable shape or color: the previous one is kept
+constexpr float kMinLuminance = 1e-4f;
+
+/**
+ * Radiance to Filament irradiance, per coefficient: the band's clamped cosine convolution
+ * (pi, 2pi/3, pi/4, divided by pi) times the basis normalization, signed for the
+ * Condon-Shortley phase Filament's shader polynomial folds in.
+ */
+constexpr float kRadianceToIrradiance[kSphericalHarmonicsCount] = {
+    0.282095f,
+    -0.325735f, 0.325735f, -0.325735f,
+    0.273137f, -0.273137f, 0.078848f, -0.273137f, 0.136569f,
+};
+
+// envs/sh.txt
+constexpr Float3 kDefaultIrradiance[kSphericalHarmonicsCount] = {
+    {0.943607568740845f, 0.898088872432709f, 0.855028331279755f},
+    {0.006618741434067f, 0.043489247560501f, 0.054495576769114f},
+    {0.458678007125854f, 0.456036537885666f, 0.497849345207214f},
+    {-0.615800380706787f, -0.603614926338196f, -0.564750075340271f},
+    {-0.140873685479164f, -0.154375776648521f, -0.156153202056885f},
+    {-0.182523220777512f, -0.185679689049721f, -0.169991940259933f},
+    {0.003131012432277f, -0.000400724558858f, 0.016711814329028f},
+    {0.119264446198940f, 0.104864254593849f, 0.095173336565495f},
+    {0.238071888685226f, 0.256286025047302f, 0.247138708829880f},
+};
+
+float luminance(Float3 c) {
+    return 0.2126f * c.x + 0.7152f * c.y + 0.0722f * c.z;
+}
+
+/// Scale to unit L00 luminance; false (and untouched) if there is no light to take a shape from
+bool normalizeIrradiance(SphericalHarmonics& sh) {
+    const float l00 = luminance(sh.coefficients[0]);
+    if (!(l00 > kMinLuminance)) return false;
+    const float scale = 1.0f / l00;
+    for (Float3& c : sh.coefficients) {
+        c = {c.x * scale, c.y * scale, c.z * scale};
+    }
+    return true;
+}
+
+void lerpIrradiance(SphericalHarmonics& sh, const SphericalHarmonics& target, float t) {
+    for (int i = 0; i < kSphericalHarmonicsCount; i++) {
+        Float3& c = sh.coefficients[i];
+        const Float3 to = target.coefficients[i];
+        c = {c.x + (to.x - c.x) * t, c.y + (to.y - c.y) * t, c.z + (to.z - c.z) * t};
+    }
+}
+
+float maxDifference(const SphericalHarmonics& a, const SphericalHarmonics& b) {
+    float difference = 0.0f;
+    for (int i = 0; i < kSphericalHarmonicsCount; i++) {
+        const Float3 x = a.coefficients[i];
+        const Float3 y = b.coefficients[i];
+        difference = std::max({difference, std::fabs(x.x - y.x), std::fabs(x.y - y.y), std::fabs(x.z - y.z)});
+    }
+    return difference;
+}
+
+/// sRGB byte to linear
+const std::array<float, 256>& srgbToLinear() {
+    static const std::array<float, 256> table = [] {
+        std::array<float, 256> values{};
+        for (int i = 0; i < 256; i++) {
+            const float c = i / 255.0f;
+            values[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        return values;
+    }();
+    return table;
+}
+
+/// Add radiance from direction n (unit, world space) over a solid angle, projected on the real SH
+/// basis without the Condon-Shortley phase and scaled straight to Filament's irradiance
+/// coefficients. basisSums collects the projection of a unit radiance over the same solid angles.
+void accumulate(Float3* sums, float* basisSums, Float3 n, Float3 radiance, float solidAngle) {
+    const float basis[kSphericalHarmonicsCount] = {
+        1.0f,
+        n.y, n.z, n.x,
+        n.y * n.x, n.y * n.z, 3.0f * n.z * n.z - 1.0f, n.z * n.x, n.x * n.x - n.y * n.y,
+    };
+    // Basis normalization times the unsigned convolution factor
+    constexpr float kScale[kSphericalHarmonicsCount] = {
+        0.282095f * 0.282095f,
+        0.488603f * 0.325735f, 0.488603f * 0.325735f, 0.488603f * 0.325735f,
+        1.092548f * 0.273137f, 1.092548f * 0.273137f, 0.315392f * 0.078848f, 1.092548f * 0.273137f,
+        0.546274f * 0.136569f,
+    };
+    for (int i = 0; i < kSphericalHarmonicsCount; i++) {
+        const float w = solidAngle * basis[i] * kScale[i];
+        sums[i] = {sums[i].x + radiance.x * w, sums[i].y + radiance.y * w, sums[i].z + radiance.z * w};
+        basisSums[i] += w;
+    }
+}
+
+} // namespace
+
+SphericalHarmonics defaultIrradiance() {
+    SphericalHarmonics sh;
+    std::copy(std::begin(kDefaultIrradiance), std::end(kDefaultIrradiance), sh.coefficients);
+    return sh;
+}
+
+SphericalHarmonics irradianceFromInterleavedRadiance(const float* interleaved) {
+    SphericalHarmonics sh;
+    for (int i = 0; i < kSphericalHarmonicsCount; i++) {
+        const float k = kRadianceToIrradiance[i];
+        sh.coefficients[i] = {interleaved[i * 3] * k, interleaved[i * 3 + 1] * k, interleaved[i * 3 + 2] * k};
+    }
+    return sh;
+}
+
+SphericalHarmonics irradianceFromPlanarRadiance(const float* planar) {
+    SphericalHarmonics sh;
+    const int n = kSphericalHarmonicsCount;
+    for (int i = 0; i < n; i++) {
+        const float k = kRadianceToIrradiance[i];
+        sh.coefficients[i] = {planar[i] * k, planar[n + i] * k, planar[2 * n + i] * k};
+    }
+    return sh;
+}
+
+SphericalHarmonics irradianceFromCameraImage(const uint8_t* rgba,
+                                             int width,
+                                             int height,
+                                             int rowBytes,
+                                             const Mat4& cameraToWorld,
+                                             const Mat4& projection) {
+    SphericalHarmonics sh = {};
+    if (width <= 0 || height <= 0) return sh;
+
+    const std::array<float, 256>& linear = srgbToLinear();
+    const Float3 forward = {-cameraToWorld(2, 0), -cameraToWorld(2, 1), -cameraToWorld(2, 2)};
+    // Area of one pixel on the z = -1 plane
+    const float pixelArea = std::fabs(4.0f / (width * projection(0, 0) * height * projection(1, 1)));
+    float basisSums[kSphericalHarmonicsCount] = {};
+    Float3 total = {0.0f, 0.0f, 0.0f};
+    float totalSolidAngle = 0.0f;
+
+    for (int row = 0; row < height; row++) {
+        const uint8_t* pixel = rgba + static_cast<ptrdiff_t>(row) * rowBytes;
+        const float ndcY = (row + 0.5f) / height * 2.0f - 1.0f;
+        // Camera space ray through the pixel at z = -1, off-center projections included
+        const float y = (ndcY + projection(2, 1)) / projection(1, 1);
+        for (int column = 0; column < width; column++, pixel += 4) {
+            const float ndcX = (column + 0.5f) / width * 2.0f - 1.0f;
+            const float x = (ndcX + projection(2, 0)) / projection(0, 0);
+
+            // Solid angle of the pixel falls off with the cube of the ray length
+            const float lengthSquared = x * x + y * y + 1.0f;
+            const float inverseLength = 1.0f / std::sqrt(lengthSquared);
+            const float solidAngle = pixelArea * inverseLength / lengthSquared;
+
+            const Float3 view = {x * inverseLength, y * inverseLength, -inverseLength};
+            const Float3 ray = {
+                cameraToWorld(0, 0) * view.x + cameraToWorld(1, 0) * view.y + cameraToWorld(2, 0) * view.z,
+                cameraToWorld(0, 1) * view.x + cameraToWorld(1, 1) * view.y + cameraToWorld(2, 1) * view.z,
+                cameraToWorld(0, 2) * view.x + cameraToWorld(1, 2) * view.y + cameraToWorld(2, 2) * view.z,
+            };
+            // Same direction with the forward component flipped: towards the camera side of the user
+            const float along = 2.0f * (ray.x * forward.x + ray.y * forward.y + ray.z * forward.z);
+            const Float3 mirrored = {ray.x - along * forward.x, ray.y - along * forward.y, ray.z - along * forward.z};
+
+            const Float3 radiance = {linear[pixel[0]], linear[pixel[1]], linear[pixel[2]]};
+            accumulate(sh.coefficients, basisSums, ray, radiance, solidAngle);
+            accumulate(sh.coefficients, basisSums, mirrored, radiance, solidAngle);
+            total = {total.x + radiance.x * solidAngle, total.y + radiance.y * solidAngle,
+                     total.z + radiance.z * solidAngle};
+            totalSolidAngle += solidAngle;
+        }
+    }
+
+    // Directions neither seen nor mirrored get the mean radiance: a uniform sphere of it (L00
+    // alone) minus its projection over the covered solid angle
+    const float inverseTotal = 1.0f / totalSolidAngle;
+    const Float3 mean = {total.x * inverseTotal, total.y * inverseTotal, total.z * inverseTotal};
+    for (int i = 0; i < kSphericalHarmonicsCount; i++) {
+        Float3& c = sh.coefficients[i];
+        c = {c.x - mean.x * basisSums[i], c.y - mean.y * basisSums[i], c.z - mean.z * basisSums[i]};
+    }
+    sh.coefficients[0] = {sh.coefficients[0].x + mean.x, sh.coefficients[0].y + mean.y,
+                          sh.coefficients[0].z + mean.z};
+    return sh;
+}
+
+float brightnessFromIrradiance(const SphericalHarmonics& irradiance) {
+    const float l00 = std::max(luminance(irradiance.coefficients[0]), 0.0f);
+    return std::min(std::pow(l00, 1.0f / 2.2f), 1.0f);
+}
+
+LightEstimator::LightEstimator(const LightEstimatorParams& params) : params_(params) {
+    reset();
+}
+
+void LightEstimator::reset() {
+    target_ = defaultIrradiance();
+    normalizeIrradiance(target_);
+    smoothed_ = target_;
+    applied_ = target_;
+    targetBrightness_ = 0.0f;
+    brightness_ = 0.0f;
+    hasEstimate_ = false;
+    hasBrightness_ = false;
+    source_ = LightSource::Default;
+    lastEstimate_ = -1.0;
+    lastUpdate_ = -1.0;
+    lastApply_ = -1.0;
+}
+
+bool LightEstimator::wantsEstimate(double timestampSeconds) const {
+    // A timestamp going backwards is a new session clock
+    return lastEstimate_ < 0.0 || timestampSeconds < lastEstimate_ ||
+           timestampSeconds - lastEstimate_ >= params_.estimateInterval;
+}
+
+void LightEstimator::addEstimate(const SphericalHarmonics& irradiance, float brightness, LightSource source,
+                                 double timestampSeconds) {
+    lastEstimate_ = timestampSeconds;
+    SphericalHarmonics target = irradiance;
+    if (normalizeIrradiance(target)) {
+        target_ = target;
+        // The first estimate replaces the default outright
+        if (!hasEstimate_) smoothed_ = target_;
+        hasEstimate_ = true;
+        source_ = source;
+    }
+    addBrightness(brightness, timestampSeconds);
+}
+
+void LightEstimator::addBrightness(float brightness, double) {
+    targetBrightness_ = std::clamp(brightness, 0.0f, 1.0f);
+    if (!hasBrightness_) brightness_ = targetBrightness_;
+    hasBrightness_ = true;
+}
+
+bool LightEstimator::update(double timestampSeconds) {
+    const double dt = timestampSeconds - lastUpdate_;
+    if (lastUpdate_ < 0.0 || dt < 0.0 || dt > kMaxSmoothingGap) {
+        smoothed_ = target_;
+        brightness_ = targetBrightness_;
+    } else {
+        const float t = 1.0f - std::exp(-static_cast<float>(dt) / params_.smoothingTime);
+        lerpIrradiance(smoothed_, target_, t);
+        brightness_ += (targetBrightness_ - brightness_) * t;
+    }
+    lastUpdate_ = timestampSeconds;
+
+    if (lastApply_ >= 0.0 && timestampSeconds >= lastApply_ &&
+        timestampSeconds - lastApply_ < params_.applyInterval) {
+        return false;
+    }
+    if (maxDifference(smoothed_, applied_) < params_.applyThreshold) return false;
+    applied_ = smoothed_;
+    lastApply_ = timestampSeconds;
+    return true;
+}
+
+float LightEstimator::intensity() const {
+    return params_.baseIntensity + brightness_ * params_.intensityRange;
+}
+
+} // namespace vto
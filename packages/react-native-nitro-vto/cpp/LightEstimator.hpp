@@ -0,0 +1,134 @@
+#pragma once
+
+#include "VtoMath.hpp"
+
+#include <cstdint>
+
+namespace vto {
+
+/// Third-order spherical harmonics: bands 0 to 2, 9 coefficients
+constexpr int kSphericalHarmonicsBands = 3;
+constexpr int kSphericalHarmonicsCount = kSphericalHarmonicsBands * kSphericalHarmonicsBands;
+
+/**
+ * Irradiance as Filament's IndirectLight::Builder::irradiance() takes it: one RGB coefficient per
+ * basis function in (l, m) order, pre-convolved with the clamped cosine lobe and pre-multiplied by
+ * the basis normalization (cmgen's "irradiance, pre-scaled base"). A uniform environment of
+ * radiance 1 is {1, 1, 1} in L00 and zero elsewhere. World space, y up.
+ */
+struct SphericalHarmonics {
+    Float3 coefficients[kSphericalHarmonicsCount];
+};
+
+/// Irradiance of the bundled studio_small_02 environment (envs/sh.txt), used until a first estimate
+SphericalHarmonics defaultIrradiance();
+
+/**
+ * Irradiance from radiance SH as the trackers report them (real SH basis with the Condon-Shortley
+ * phase, world space).
+ * @param interleaved 27 floats, RGB per coefficient (ARCore getEnvironmentalHdrAmbientSphericalHarmonics)
+ */
+SphericalHarmonics irradianceFromInterleavedRadiance(const float* interleaved);
+
+/// @param planar 27 floats, 9 red then 9 green then 9 blue coefficients
+/// (ARDirectionalLightEstimate.sphericalHarmonicsCoefficients)
+SphericalHarmonics irradianceFromPlanarRadiance(const float* planar);
+
+/**
+ * Irradiance from a small RGBA8 render of the camera background (sRGB-encoded, as displayed).
+ * Each pixel is the radiance along its view ray. The front camera only sees the half of the
+ * environment behind the user, so every ray is also mirrored across the image plane to stand in
+ * for the unseen half that lights the front of the face; the directions left over take the mean
+ * radiance. Coarse, but it tracks the color and the left/right and up/down balance of the room.
+ * @param rgba Rows bottom first (Filament's readPixels order), rowBytes apart
+ * @param cameraToWorld Camera model matrix the image was rendered with
+ * @param projection Projection the image was rendered with
+ */
+SphericalHarmonics irradianceFromCameraImage(const uint8_t* rgba,
+                                             int width,
+                                             int height,
+                                             int rowBytes,
+                                             const Mat4& cameraToWorld,
+                                             const Mat4& projection);
+
+/// Brightness in [0, 1] of an irradiance, gamma encoded like ARCore's pixelIntensity
+float brightnessFromIrradiance(const SphericalHarmonics& irradiance);
+
+/// Where the current estimate comes from
+enum class LightSource : int {
+    /// No estimate yet: the bundled environment's irradiance
+    Default = 0,
+    /// ARCore environmental HDR or ARKit directional light estimate
+    Tracker = 1,
+    /// Reduction of the camera image
+    Camera = 2,
+};
+
+struct LightEstimatorParams {
+    /// Shortest time between accepted estimates, in seconds. Callers ask wantsEstimate() first
+    /// so skipped estimates are never fetched or computed.
+    double estimateInterval = 0.1;
+    /// Time constant of the exponential smoothing towards the latest estimate, in seconds
+    float smoothingTime = 0.5f;
+    /// Shortest time between irradiance changes handed to the renderer, in seconds: every change
+    /// rebuilds the IndirectLight
+    double applyInterval = 0.1;
+    /// Smallest change of any coefficient (relative to a unit L00) worth a rebuild
+    float applyThreshold = 0.01f;
+    /// IndirectLight intensity at brightness 0 and its increase at brightness 1 (lux)
+    float baseIntensity = 30000.0f;
+    float intensityRange = 60000.0f;
+};
+
+/**
+ * Smooths lighting estimates from frame to frame and decides when the renderer updates its
+ * indirect light. The irradiance is kept normalized to unit L00 luminance: its shape and color
+ * come from the estimate, its brightness from a separate [0, 1] value mapped to the
+ * IndirectLight intensity, so SH and ambient-only estimates share one calibration.
+ * Render thread only.
+ */
+class LightEstimator {
+public:
+    explicit LightEstimator(const LightEstimatorParams& params = {});
+
+    /// Back to the default irradiance and brightness
+    void reset();
+
+    /// True if an estimate taken at timestamp would be used
+    bool wantsEstimate(double timestampSeconds) const;
+
+    /// New target irradiance and brightness in [0, 1]
+    void addEstimate(const SphericalHarmonics& irradiance, float brightness, LightSource source,
+                     double timestampSeconds);
+
+    /// New target brightness alone (ambient intensity estimates); the irradiance target is kept
+    void addBrightness(float brightness, double timestampSeconds);
+
+    /**
+     * Advance the smoothing to timestamp (once per rendered frame).
+     * @return True if irradiance() changed enough since it was last applied: rebuild the indirect light
+     */
+    bool update(double timestampSeconds);
+
+    /// Smoothed irradiance to build the indirect light with, normalized to unit L00 luminance
+    const SphericalHarmonics& irradiance() const { return applied_; }
+    /// Smoothed IndirectLight intensity, cheap to set every frame
+    float intensity() const;
+    LightSource source() const { return source_; }
+
+private:
+    LightEstimatorParams params_;
+    SphericalHarmonics target_;
+    SphericalHarmonics smoothed_;
+    SphericalHarmonics applied_;
+    float targetBrightness_ = 0.0f;
+    float brightness_ = 0.0f;
+    bool hasEstimate_ = false;
+    bool hasBrightness_ = false;
+    LightSource source_ = LightSource::Default;
+    double lastEstimate_ = -1.0;
+    double lastUpdate_ = -1.0;
+    double lastApply_ = -1.0;
+};
+
+} // namespace vto
@@ -0,0 +1,95 @@
+#include "ModelLod.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace vto {
+
+namespace {
+
+constexpr uint64_t kGiB = 1024ull * 1024 * 1024;
+
+// Camera-to-face distance (meters) where level n switches to n + 1 on a high tier device:
+// a face at arm's length (~35 cm) keeps full detail, a face further back drops a level per 20 cm
+constexpr float kFirstSwitchDistance = 0.45f;
+constexpr float kSwitchDistanceStep = 0.2f;
+
+// Lower tiers switch to coarser levels closer to the camera
+constexpr float kTierDistanceScale[] = {0.6f, 0.8f, 1.0f};
+
+// Fraction of the switch distance the face must move past it before the level changes
+constexpr float kHysteresis = 0.1f;
+
+} // namespace
+
+DeviceTier classifyDeviceTier(uint64_t totalMemoryBytes, int cpuCores, bool lowRamDevice) {
+    if (lowRamDevice || totalMemoryBytes < 3 * kGiB || cpuCores < 6) return DeviceTier::Low;
+    if (totalMemoryBytes < 6 * kGiB) return DeviceTier::Mid;
+    return DeviceTier::High;
+}
+
+int lodLevelFromName(const char* name) {
+    if (name == nullptr) return -1;
+
+    const char* suffix = nullptr;
+    for (const char* p = std::strstr(name, "_LOD"); p != nullptr; p = std::strstr(p + 1, "_LOD")) {
+        suffix = p + 4;
+    }
+    if (suffix == nullptr || *suffix < '0' || *suffix > '9') return -1;
+
+    char* end = nullptr;
+    const long level = std::strtol(suffix, &end, 10);
+    // Exporters may append ".001" style duplicates; anything else after the digits isn't an LOD tag
+    if (*end != '\0' && *end != '.') return -1;
+    return level <= 16 ? static_cast<int>(level) : -1;
+}
+
+void LodSelector::setLevelCount(int count) {
+    levelCount_ = std::max(count, 1);
+    reset();
+}
+
+void LodSelector::setDeviceTier(DeviceTier tier) {
+    tier_ = tier;
+    reset();
+}
+
+int LodSelector::finestLevel() const {
+    // Low tier devices never render the full detail level when a coarser one exists
+    return tier_ == DeviceTier::Low ? std::min(1, levelCount_ - 1) : 0;
+}
+
+float LodSelector::switchDistance(int level) const {
+    return (kFirstSwitchDistance + kSwitchDistanceStep * static_cast<float>(level)) *
+           kTierDistanceScale[static_cast<int>(tier_)];
+}
+
+int LodSelector::update(const Mat4& faceTransform, const Mat4& cameraTransform) {
+    if (levelCount_ <= 1) return level_;
+
+    const float dx = faceTransform(3, 0) - cameraTransform(3, 0);
+    const float dy = faceTransform(3, 1) - cameraTransform(3, 1);
+    const float dz = faceTransform(3, 2) - cameraTransform(3, 2);
+    const float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+    const int finest = finestLevel();
+    if (!hasLevel_) {
+        // First observation: jump straight to the matching level, no hysteresis
+        level_ = finest;
+        while (level_ < levelCount_ - 1 && distance > switchDistance(level_)) level_++;
+        hasLevel_ = true;
+        return level_;
+    }
+
+    while (level_ < levelCount_ - 1 && distance > switchDistance(level_) * (1.0f + kHysteresis)) level_++;
+    while (level_ > finest && distance < switchDistance(level_ - 1) * (1.0f - kHysteresis)) level_--;
+    return level_;
+}
+
+void LodSelector::reset() {
+    level_ = finestLevel();
+    hasLevel_ = false;
+}
+
+} // namespace vto
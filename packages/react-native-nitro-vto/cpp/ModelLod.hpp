@@ -0,0 +1,57 @@
+#pragma once
+
+#include "VtoMath.hpp"
+
+#include <cstdint>
+
+namespace vto {
+
+/**
+ * Rough GPU/CPU budget class of the device, used to bias level of detail selection.
+ */
+enum class DeviceTier : int {
+    Low = 0,
+    Mid = 1,
+    High = 2,
+};
+
+/// Classify a device from its physical memory, CPU core count and the OS low-RAM flag
+DeviceTier classifyDeviceTier(uint64_t totalMemoryBytes, int cpuCores, bool lowRamDevice);
+
+/// Level of detail a glTF node name asks for ("Frame_LOD1" -> 1), or -1 without a _LOD<n> suffix
+int lodLevelFromName(const char* name);
+
+/**
+ * Picks which level of detail to render from the camera-to-face distance and the device tier.
+ * Level 0 is full detail. Each level switch needs the distance to cross its threshold by a
+ * hysteresis margin, so depth jitter around a threshold doesn't flip levels every frame.
+ */
+class LodSelector {
+public:
+    /// Number of levels the model has (1 = no LODs; level 0 is then always selected)
+    void setLevelCount(int count);
+    int levelCount() const { return levelCount_; }
+
+    void setDeviceTier(DeviceTier tier);
+    DeviceTier deviceTier() const { return tier_; }
+
+    /// Update with the face and camera world transforms and return the level to render
+    int update(const Mat4& faceTransform, const Mat4& cameraTransform);
+
+    /// Level chosen by the last update (the device tier's finest level before any)
+    int level() const { return level_; }
+
+    /// Forget the distance history (e.g. when the face is lost or the model changes)
+    void reset();
+
+private:
+    int finestLevel() const;
+    float switchDistance(int level) const;
+
+    int levelCount_ = 1;
+    DeviceTier tier_ = DeviceTier::High;
+    int level_ = 0;
+    bool hasLevel_ = false;
+};
+
+} // namespace vto
@@ -0,0 +1,369 @@
+#include "ModelMemory.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace vto {
+
+namespace {
+
+constexpr uint32_t kGlbMagic = 0x46546C67;     // "glTF"
+constexpr uint32_t kJsonChunkType = 0x4E4F534A; // "JSON"
+constexpr uint32_t kBinChunkType = 0x004E4942;  // "BIN\0"
+
+constexpr uint8_t kPngSignature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+constexpr uint8_t kKtx2Identifier[] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+uint32_t readLe32(const uint8_t* p) {
+    return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+}
+
+uint32_t readBe32(const uint8_t* p) {
+    return uint32_t(p[0]) << 24 | uint32_t(p[1]) << 16 | uint32_t(p[2]) << 8 | uint32_t(p[3]);
+}
+
+uint32_t readBe16(const uint8_t* p) {
+    return uint32_t(p[0]) << 8 | uint32_t(p[1]);
+}
+
+/// Just enough JSON for the glTF fields the estimate reads
+struct JsonValue {
+    enum class Type { Null, Bool, Number, String, Array, Object };
+
+    Type type = Type::Null;
+    double number = 0.0;
+    std::string string;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> members;
+
+    const JsonValue* find(const char* key) const {
+        for (const auto& member : members) {
+            if (member.first == key) return &member.second;
+        }
+        return nullptr;
+    }
+
+    const std::vector<JsonValue>& array(const char* key) const {
+        static const std::vector<JsonValue> empty;
+        const JsonValue* value = find(key);
+        return value && value->type == Type::Array ? value->items : empty;
+    }
+
+    /// Number member as an integer, or fallback when missing or not a number
+    int64_t integer(const char* key, int64_t fallback) const {
+        const JsonValue* value = find(key);
+        return value && value->type == Type::Number ? static_cast<int64_t>(value->number) : fallback;
+    }
+};
+
+class JsonParser {
+public:
+    JsonParser(const char* begin, const char* end) : p_(begin), end_(end) {}
+
+    bool parse(JsonValue& value) {
+        if (!parseValue(value, 0)) return false;
+        skipWhitespace();
+        return true;
+    }
+
+private:
+    // glTF nests a handful of levels; anything deeper is malformed or hostile
+    static constexpr int kMaxDepth = 64;
+
+    void skipWhitespace() {
+        while (p_ < end_ && (*p_ == ' ' || *p_ == '\t' || *p_ == '\n' || *p_ == '\r')) p_++;
+    }
+
+    bool consume(char c) {
+        skipWhitespace();
+        if (p_ >= end_ || *p_ != c) return false;
+        p_++;
+        return true;
+    }
+
+    bool parseLiteral(const char* literal) {
+        size_t length = std::strlen(literal);
+        if (static_cast<size_t>(end_ - p_) < length || std::memcmp(p_, literal, length) != 0) return false;
+        p_ += length;
+        return true;
+    }
+
+    bool parseString(std::string& out) {
+        if (!consume('"')) return false;
+        while (p_ < end_ && *p_ != '"') {
+            char c = *p_++;
+            if (c != '\\') {
+                out.push_back(c);
+                continue;
+            }
+            if (p_ >= end_) return false;
+            char escaped = *p_++;
+            switch (escaped) {
+                case 'b': out.push_back('\b'); break;
+                case 'f': out.push_back('\f'); break;
+                case 'n': out.push_back('\n'); break;
+                case 'r': out.push_back('\r'); break;
+                case 't': out.push_back('\t'); break;
+                case 'u':
+                    // Only ASCII keys and mime types are compared, so the code point itself is dropped
+                    if (end_ - p_ < 4) return false;
+                    p_ += 4;
+                    out.push_back('?');
+                    break;
+                default: out.push_back(escaped); break;
+            }
+        }
+        if (p_ >= end_) return false;
+        p_++;
+        return true;
+    }
+
+    bool parseNumber(double& out) {
+        const char* start = p_;
+        while (p_ < end_ && (std::strchr("+-.eE", *p_) != nullptr || (*p_ >= '0' && *p_ <= '9'))) p_++;
+        if (p_ == start) return false;
+        out = std::strtod(std::string(start, p_).c_str(), nullptr);
+        return true;
+    }
+
+    bool parseValue(JsonValue& value, int depth) {
+        if (depth > kMaxDepth) return false;
+        skipWhitespace();
+        if (p_ >= end_) return false;
+
+        switch (*p_) {
+            case '{': {
+                p_++;
+                value.type = JsonValue::Type::Object;
+                if (consume('}')) return true;
+                do {
+                    std::pair<std::string, JsonValue> member;
+                    skipWhitespace();
+                    if (!parseString(member.first) || !consume(':')) return false;
+                    if (!parseValue(member.second, depth + 1)) return false;
+                    value.members.push_back(std::move(member));
+                } while (consume(','));
+                return consume('}');
+            }
+            case '[': {
+                p_++;
+                value.type = JsonValue::Type::Array;
+                if (consume(']')) return true;
+                do {
+                    value.items.emplace_back();
+                    if (!parseValue(value.items.back(), depth + 1)) return false;
+                } while (consume(','));
+                return consume(']');
+            }
+            case '"':
+                value.type = JsonValue::Type::String;
+                return parseString(value.string);
+            case 't':
+                value.type = JsonValue::Type::Bool;
+                value.number = 1.0;
+                return parseLiteral("true");
+            case 'f':
+                value.type = JsonValue::Type::Bool;
+                return parseLiteral("false");
+            case 'n':
+                return parseLiteral("null");
+            default:
+                value.type = JsonValue::Type::Number;
+                return parseNumber(value.number);
+        }
+    }
+
+    const char* p_;
+    const char* end_;
+};
+
+uint64_t componentSize(int64_t componentType) {
+    switch (componentType) {
+        case 5120: // BYTE
+        case 5121: // UNSIGNED_BYTE
+            return 1;
+        case 5122: // SHORT
+        case 5123: // UNSIGNED_SHORT
+            return 2;
+        case 5125: // UNSIGNED_INT
+        case 5126: // FLOAT
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+uint64_t componentCount(const std::string& type) {
+    if (type == "SCALAR") return 1;
+    if (type == "VEC2") return 2;
+    if (type == "VEC3") return 3;
+    if (type == "VEC4" || type == "MAT2") return 4;
+    if (type == "MAT3") return 9;
+    if (type == "MAT4") return 16;
+    return 0;
+}
+
+int base64Value(char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '+' || c == '-') return 62;
+    if (c == '/' || c == '_') return 63;
+    return -1;
+}
+
+/// Bytes of a base64 data URI ("data:image/png;base64,..."); empty for any other URI
+std::vector<uint8_t> decodeDataUri(const std::string& uri) {
+    std::vector<uint8_t> bytes;
+    size_t comma = uri.find(',');
+    if (uri.compare(0, 5, "data:") != 0 || comma == std::string::npos ||
+        uri.rfind(";base64", comma) == std::string::npos) {
+        return bytes;
+    }
+    bytes.reserve((uri.size() - comma) * 3 / 4);
+    uint32_t bits = 0;
+    int bitCount = 0;
+    for (size_t i = comma + 1; i < uri.size(); i++) {
+        int value = base64Value(uri[i]);
+        if (value < 0) break;
+        bits = bits << 6 | static_cast<uint32_t>(value);
+        bitCount += 6;
+        if (bitCount >= 8) {
+            bitCount -= 8;
+            bytes.push_back(static_cast<uint8_t>(bits >> bitCount));
+        }
+    }
+    return bytes;
+}
+
+/// Pixel size of an embedded PNG, JPEG or KTX2 image; false if the header can't be read
+bool imageSize(const uint8_t* data, size_t size, uint32_t& width, uint32_t& height, uint32_t& levels, bool& ktx2) {
+    ktx2 = false;
+    levels = 0;
+    if (size >= 24 && std::memcmp(data, kPngSignature, sizeof(kPngSignature)) == 0) {
+        // IHDR is always the first chunk
+        width = readBe32(data + 16);
+        height = readBe32(data + 20);
+        return true;
+    }
+    if (size >= 44 && std::memcmp(data, kKtx2Identifier, sizeof(kKtx2Identifier)) == 0) {
+        ktx2 = true;
+        width = readLe32(data + 20);
+        height = readLe32(data + 24);
+        levels = readLe32(data + 40);
+        return true;
+    }
+    if (size >= 4 && data[0] == 0xFF && data[1] == 0xD8) {
+        // Walk the marker segments up to the first start-of-frame
+        size_t offset = 2;
+        while (offset + 9 <= size) {
+            if (data[offset] != 0xFF) return false;
+            uint8_t marker = data[offset + 1];
+            if (marker == 0xFF) {
+                offset++;
+                continue;
+            }
+            bool startOfFrame = marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC;
+            if (startOfFrame) {
+                height = readBe16(data + offset + 5);
+                width = readBe16(data + offset + 7);
+                return true;
+            }
+            offset += 2 + readBe16(data + offset + 2);
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+bool estimateModelMemory(const uint8_t* glb, size_t size, ModelMemoryEstimate& estimate) {
+    estimate = {};
+    if (glb == nullptr || size < 20 || readLe32(glb) != kGlbMagic) return false;
+
+    // Header, then a JSON chunk and an optional BIN chunk
+    size_t length = readLe32(glb + 8) < size ? readLe32(glb + 8) : size;
+    const uint32_t jsonLength = readLe32(glb + 12);
+    if (readLe32(glb + 16) != kJsonChunkType || 20 + static_cast<size_t>(jsonLength) > length) return false;
+    const char* json = reinterpret_cast<const char*>(glb + 20);
+
+    const uint8_t* bin = nullptr;
+    size_t binLength = 0;
+    size_t binHeader = 20 + static_cast<size_t>(jsonLength);
+    if (binHeader + 8 <= length && readLe32(glb + binHeader + 4) == kBinChunkType) {
+        bin = glb + binHeader + 8;
+        binLength = readLe32(glb + binHeader);
+        if (binHeader + 8 + binLength > length) binLength = length - binHeader - 8;
+    }
+
+    JsonValue root;
+    if (!JsonParser(json, json + jsonLength).parse(root) || root.type != JsonValue::Type::Object) return false;
+
+    // Geometry: every accessor a mesh primitive draws from, counted once however often it is shared
+    const std::vector<JsonValue>& accessors = root.array("accessors");
+    std::vector<bool> counted(accessors.size(), false);
+    auto countAccessor = [&](const JsonValue& index) {
+        if (index.type != JsonValue::Type::Number) return;
+        size_t i = static_cast<size_t>(index.number);
+        if (i >= accessors.size() || counted[i]) return;
+        counted[i] = true;
+        const JsonValue& accessor = accessors[i];
+        const JsonValue* type = accessor.find("type");
+        uint64_t elementSize = componentSize(accessor.integer("componentType", 0)) *
+                               componentCount(type ? type->string : std::string());
+        estimate.geometryBytes += elementSize * static_cast<uint64_t>(accessor.integer("count", 0));
+    };
+    for (const JsonValue& mesh : root.array("meshes")) {
+        for (const JsonValue& primitive : mesh.array("primitives")) {
+            if (const JsonValue* indices = primitive.find("indices")) countAccessor(*indices);
+            if (const JsonValue* attributes = primitive.find("attributes")) {
+                for (const auto& attribute : attributes->members) countAccessor(attribute.second);
+            }
+            for (const JsonValue& target : primitive.array("targets")) {
+                for (const auto& attribute : target.members) countAccessor(attribute.second);
+            }
+        }
+    }
+
+    // Textures: decoded size of each image in the BIN chunk or a data URI
+    const std::vector<JsonValue>& bufferViews = root.array("bufferViews");
+    for (const JsonValue& image : root.array("images")) {
+        const uint8_t* imageData = nullptr;
+        size_t imageLength = 0;
+        std::vector<uint8_t> uriBytes;
+        int64_t viewIndex = image.integer("bufferView", -1);
+        if (const JsonValue* uri = image.find("uri")) {
+            uriBytes = decodeDataUri(uri->string);
+            imageData = uriBytes.data();
+            imageLength = uriBytes.size();
+        } else if (bin != nullptr && viewIndex >= 0 && static_cast<size_t>(viewIndex) < bufferViews.size()) {
+            const JsonValue& view = bufferViews[static_cast<size_t>(viewIndex)];
+            uint64_t offset = static_cast<uint64_t>(view.integer("byteOffset", 0));
+            uint64_t viewLength = static_cast<uint64_t>(view.integer("byteLength", 0));
+            if (view.integer("buffer", 0) != 0 || offset + viewLength > binLength) continue;
+            imageData = bin + offset;
+            imageLength = static_cast<size_t>(viewLength);
+        }
+
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t levels = 0;
+        bool ktx2 = false;
+        if (imageData == nullptr || !imageSize(imageData, imageLength, width, height, levels, ktx2)) continue;
+
+        uint64_t texels = static_cast<uint64_t>(width) * height;
+        if (ktx2) {
+            // Transcoded to a block format of about a byte per texel, mips as stored in the file
+            estimate.textureBytes += levels > 1 ? texels * 4 / 3 : texels;
+        } else {
+            // Uploaded as RGBA8 and mipmapped on the GPU
+            estimate.textureBytes += texels * 4 * 4 / 3;
+        }
+    }
+    return true;
+}
+
+} // namespace vto
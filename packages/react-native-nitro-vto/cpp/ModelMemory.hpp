@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace vto {
+
+/**
+ * Memory a loaded glasses model takes, estimated from its GLB before loading it.
+ * Filament doesn't report buffer or texture sizes, so these come from the glTF itself.
+ */
+struct ModelMemoryEstimate {
+    /// Vertex and index buffers of every mesh primitive (after meshopt decompression)
+    uint64_t geometryBytes = 0;
+    /// Textures as uploaded: RGBA8 with a mip chain for PNG/JPEG, one byte per texel for
+    /// KTX2 (transcoded to ASTC 4x4 or ETC2)
+    uint64_t textureBytes = 0;
+
+    uint64_t gpuBytes() const { return geometryBytes + textureBytes; }
+};
+
+/// Estimate a GLB's GPU memory from its accessors and embedded image headers (BIN chunk or base64
+/// data URI). Images referenced by external URI aren't counted. Returns false if it isn't a valid GLB.
+bool estimateModelMemory(const uint8_t* glb, size_t size, ModelMemoryEstimate& estimate);
+
+} // namespace vto
@@ -0,0 +1,89 @@
+#include "PoseFilter.hpp"
+
+#include <algorithm>
+
+namespace vto {
+
+namespace {
+
+constexpr float kPi = 3.14159265358979f;
+
+/// Exponential smoothing factor of a first-order low-pass at cutoff Hz over dt seconds
+float smoothingFactor(float cutoff, float dt) {
+    const float tau = 1.0f / (2.0f * kPi * cutoff);
+    return 1.0f / (1.0f + tau / dt);
+}
+
+Float3 lerp(Float3 a, Float3 b, float t) {
+    return {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t};
+}
+
+Float3 scale(Float3 v, float s) {
+    return {v.x * s, v.y * s, v.z * s};
+}
+
+float length(Float3 v) {
+    return std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+}
+
+} // namespace
+
+void updatePoseFilter(PoseFilterState& state, const PoseFilterParams& params, const Pose& measurement,
+                      double timestamp) {
+    const float dt = static_cast<float>(timestamp - state.timestamp);
+    const Quat measuredRotation = quatNormalize(measurement.rotation);
+    if (!state.initialized || dt > params.maxFrameGap || dt < 0.0f) {
+        state = PoseFilterState{};
+        state.initialized = true;
+        state.timestamp = timestamp;
+        state.position = measurement.position;
+        state.rotation = measuredRotation;
+        state.measuredPosition = measurement.position;
+        state.measuredRotation = measuredRotation;
+        return;
+    }
+    // Same camera frame rendered again
+    if (dt < 1e-4f) return;
+    state.timestamp = timestamp;
+
+    // Position: velocity between consecutive measurements, smoothed; the estimate moves with it,
+    // then a speed-adaptive low-pass pulls it towards the measurement
+    const OneEuroParams& position = params.position;
+    const Float3 rawVelocity = scale({measurement.position.x - state.measuredPosition.x,
+                                      measurement.position.y - state.measuredPosition.y,
+                                      measurement.position.z - state.measuredPosition.z},
+                                     1.0f / dt);
+    state.velocity = lerp(state.velocity, rawVelocity, smoothingFactor(position.derivativeCutoff, dt));
+    const float positionCutoff = position.minCutoff + position.beta * length(state.velocity);
+    const Float3 carried = {state.position.x + state.velocity.x * dt,
+                            state.position.y + state.velocity.y * dt,
+                            state.position.z + state.velocity.z * dt};
+    state.position = lerp(carried, measurement.position, smoothingFactor(positionCutoff, dt));
+    state.measuredPosition = measurement.position;
+
+    // Rotation: the same on SO(3), with relative rotations as the differences
+    const OneEuroParams& rotation = params.rotation;
+    const Float3 rawAngularVelocity =
+        scale(quatToRotationVector(quatMultiply(measuredRotation, quatConjugate(state.measuredRotation))), 1.0f / dt);
+    state.angularVelocity =
+        lerp(state.angularVelocity, rawAngularVelocity, smoothingFactor(rotation.derivativeCutoff, dt));
+    const float rotationCutoff = rotation.minCutoff + rotation.beta * length(state.angularVelocity);
+    const Quat carriedRotation =
+        quatNormalize(quatMultiply(quatFromRotationVector(scale(state.angularVelocity, dt)), state.rotation));
+    // Slerp along the geodesic: rotate by a fraction of the remaining error
+    const Float3 error = quatToRotationVector(quatMultiply(measuredRotation, quatConjugate(carriedRotation)));
+    const Float3 step = scale(error, smoothingFactor(rotationCutoff, dt));
+    state.rotation = quatNormalize(quatMultiply(quatFromRotationVector(step), carriedRotation));
+    state.measuredRotation = measuredRotation;
+}
+
+Pose predictPose(const PoseFilterState& state, const PoseFilterParams& params, double horizon) {
+    const float t = std::clamp(static_cast<float>(horizon), 0.0f, params.maxPrediction);
+    const Float3 offset = scale(state.velocity, t);
+    return {
+        {state.position.x + offset.x, state.position.y + offset.y, state.position.z + offset.z},
+        quatNormalize(quatMultiply(quatFromRotationVector(scale(state.angularVelocity, t)), state.rotation)),
+    };
+}
+
+} // namespace vto
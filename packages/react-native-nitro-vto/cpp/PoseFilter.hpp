@@ -0,0 +1,70 @@
+#pragma once
+
+#include "VtoMath.hpp"
+
+#include <type_traits>
+
+namespace vto {
+
+/**
+ * One-Euro filter tuning: the cutoff frequency rises from minCutoff with speed, so the pose is
+ * heavily smoothed while the head is still (no jitter) and barely smoothed while it moves (no lag).
+ */
+struct OneEuroParams {
+    /// Cutoff at rest, in Hz. Lower = smoother when still.
+    float minCutoff;
+    /// Cutoff increase per unit of speed (m/s or rad/s). Higher = less lag when moving.
+    float beta;
+    /// Cutoff of the speed estimate itself, in Hz
+    float derivativeCutoff;
+};
+
+struct PoseFilterParams {
+    OneEuroParams position = {1.0f, 20.0f, 1.0f};
+    OneEuroParams rotation = {1.5f, 2.0f, 1.0f};
+    /// Longest extrapolation, in seconds; beyond it constant velocity overshoots more than it helps
+    float maxPrediction = 0.05f;
+    /// Camera frames further apart than this restart the filter instead of smoothing across the gap
+    float maxFrameGap = 0.25f;
+};
+
+struct Pose {
+    Float3 position;
+    Quat rotation;
+};
+
+/**
+ * Whole filter state: One-Euro filtered position and rotation with their filtered linear and
+ * angular velocities. The velocities come from consecutive raw measurements (not from the lagging
+ * estimate), carry the estimate forward before each correction, so constant motion is tracked
+ * without lag, and drive the constant-velocity prediction. Rotation is filtered on SO(3) (slerp
+ * towards the measurement, angular velocity from the relative rotation), so it stays a unit
+ * quaternion without renormalizing. Flat and trivially copyable: no allocations, copied or reset
+ * as a value.
+ */
+struct PoseFilterState {
+    bool initialized = false;
+    /// Camera timestamp of the last measurement, in seconds
+    double timestamp = 0.0;
+    Float3 position = {0.0f, 0.0f, 0.0f};
+    /// Filtered, in m/s
+    Float3 velocity = {0.0f, 0.0f, 0.0f};
+    Quat rotation = {0.0f, 0.0f, 0.0f, 1.0f};
+    /// Filtered, world space rotation vector per second (rad/s)
+    Float3 angularVelocity = {0.0f, 0.0f, 0.0f};
+    /// Last raw measurement, the velocities' reference
+    Float3 measuredPosition = {0.0f, 0.0f, 0.0f};
+    Quat measuredRotation = {0.0f, 0.0f, 0.0f, 1.0f};
+};
+
+static_assert(std::is_trivially_copyable_v<PoseFilterState> && std::is_standard_layout_v<PoseFilterState>,
+              "PoseFilterState must stay a flat value type");
+
+/// Filter a measurement taken at timestamp (camera clock, seconds). A repeated timestamp is ignored.
+void updatePoseFilter(PoseFilterState& state, const PoseFilterParams& params, const Pose& measurement,
+                      double timestamp);
+
+/// Filtered pose extrapolated horizon seconds past the last measurement (clamped to [0, maxPrediction])
+Pose predictPose(const PoseFilterState& state, const PoseFilterParams& params, double horizon);
+
+} // namespace vto
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "SpscQueue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace vto {
+
+enum class RendererCommandType : uint8_t {
+    None,
+    SetFaceMeshOcclusion,
+    SetBackPlaneOcclusion,
+    SetForwardOffset,
+    SetMaxFaces,
+    SetDebug,
+    SetAdaptivePerformance,
+    SwitchModel,
+    ResetSession,
+    PrefetchModels,
+    SetCompareModels,
+    SetActiveModel,
+    SetEnvironment,
+    StartFaceRecording,
+    StopFaceRecording,
+    Capture,
+    StartRecording,
+    StopRecording,
+};
+
+/**
+ * Typed renderer state change, queued by prop setters and applied by the render loop
+ * at the start of a frame, so scene mutations happen at one well-defined point.
+ */
+struct RendererCommand {
+    RendererCommandType type = RendererCommandType::None;
+    bool enabled = false;
+    float value = 0.0f;
+    std::string url;
+    std::vector<std::string> urls;
+
+    static RendererCommand setFaceMeshOcclusion(bool enabled) {
+        return {RendererCommandType::SetFaceMeshOcclusion, enabled, 0.0f, {}, {}};
+    }
+    static RendererCommand setBackPlaneOcclusion(bool enabled) {
+        return {RendererCommandType::SetBackPlaneOcclusion, enabled, 0.0f, {}, {}};
+    }
+    static RendererCommand setForwardOffset(float offset) {
+        return {RendererCommandType::SetForwardOffset, false, offset, {}, {}};
+    }
+    static RendererCommand setMaxFaces(int maxFaces) {
+        return {RendererCommandType::SetMaxFaces, false, static_cast<float>(maxFaces), {}, {}};
+    }
+    static RendererCommand setDebug(bool enabled) {
+        return {RendererCommandType::SetDebug, enabled, 0.0f, {}, {}};
+    }
+    static RendererCommand setAdaptivePerformance(bool enabled) {
+        return {RendererCommandType::SetAdaptivePerformance, enabled, 0.0f, {}, {}};
+    }
+    static RendererCommand switchModel(std::string url) {
+        return {RendererCommandType::SwitchModel, false, 0.0f, std::move(url), {}};
+    }
+    static RendererCommand resetSession() {
+        return {RendererCommandType::ResetSession, false, 0.0f, {}, {}};
+    }
+    static RendererCommand prefetchModels(std::vector<std::string> urls) {
+        return {RendererCommandType::PrefetchModels, false, 0.0f, {}, std::move(urls)};
+    }
+    static RendererCommand setCompareModels(std::vector<std::string> urls) {
+        return {RendererCommandType::SetCompareModels, false, 0.0f, {}, std::move(urls)};
+    }
+    static RendererCommand setActiveModel(int index) {
+        return {RendererCommandType::SetActiveModel, false, static_cast<float>(index), {}, {}};
+    }
+    static RendererCommand setEnvironment(std::string name) {
+        return {RendererCommandType::SetEnvironment, false, 0.0f, std::move(name), {}};
+    }
+    static RendererCommand startFaceRecording(std::string filePath) {
+        return {RendererCommandType::StartFaceRecording, false, 0.0f, std::move(filePath), {}};
+    }
+    static RendererCommand stopFaceRecording() {
+        return {RendererCommandType::StopFaceRecording, false, 0.0f, {}, {}};
+    }
+    static RendererCommand capture(std::string filePath) {
+        return {RendererCommandType::Capture, false, 0.0f, std::move(filePath), {}};
+    }
+    static RendererCommand startRecording(std::string filePath) {
+        return {RendererCommandType::StartRecording, false, 0.0f, std::move(filePath), {}};
+    }
+    static RendererCommand stopRecording() {
+        return {RendererCommandType::StopRecording, false, 0.0f, {}, {}};
+    }
+};
+
+/**
+ * Setters carry only the latest state: a newer one makes an older one still waiting redundant.
+ */
+inline bool supersedesEarlier(RendererCommandType type) {
+    switch (type) {
+        case RendererCommandType::SetFaceMeshOcclusion:
+        case RendererCommandType::SetBackPlaneOcclusion:
+        case RendererCommandType::SetForwardOffset:
+        case RendererCommandType::SetMaxFaces:
+        case RendererCommandType::SetDebug:
+        case RendererCommandType::SetAdaptivePerformance:
+        case RendererCommandType::SwitchModel:
+        case RendererCommandType::SetCompareModels:
+        case RendererCommandType::SetActiveModel:
+        case RendererCommandType::SetEnvironment:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Lock-free command ring, plus a producer-side backlog for when it is full (e.g. props set before
+ * the renderers exist, which don't drain it). In the backlog a newer setter replaces an older one
+ * of the same type, so nothing is dropped and the latest value always arrives, still in order
+ * with the other commands.
+ */
+class RendererCommandQueue {
+public:
+    /// Producer only. Queue a command behind any backlogged ones.
+    void push(RendererCommand command) {
+        flushBacklog();
+        if (backlog_.empty() && ring_.tryPush(std::move(command))) return;
+
+        if (supersedesEarlier(command.type)) {
+            backlog_.erase(std::remove_if(backlog_.begin(), backlog_.end(),
+                                          [&](const RendererCommand& queued) { return queued.type == command.type; }),
+                           backlog_.end());
+        }
+        backlog_.push_back(std::move(command));
+        backlogged_.store(true, std::memory_order_release);
+    }
+
+    /// Producer only. Move backlogged commands into the ring while they fit; returns how many moved.
+    size_t flushBacklog() {
+        size_t moved = 0;
+        while (!backlog_.empty() && ring_.tryPush(std::move(backlog_.front()))) {
+            backlog_.pop_front();
+            moved++;
+        }
+        if (backlog_.empty()) backlogged_.store(false, std::memory_order_release);
+        return moved;
+    }
+
+    /// Any thread. Whether the producer holds commands waiting for room in the ring.
+    bool isBacklogged() const { return backlogged_.load(std::memory_order_acquire); }
+
+    /// Consumer only. Apply every command in the ring, in push order; returns the count.
+    template <typename Handler>
+    size_t drain(Handler&& handler) {
+        return ring_.drain(std::forward<Handler>(handler));
+    }
+
+private:
+    // Prop changes come in bursts of a handful; 64 leaves ample headroom while paused
+    SpscQueue<RendererCommand, 64> ring_;
+    std::deque<RendererCommand> backlog_;
+    std::atomic<bool> backlogged_{false};
+};
+
+} // namespace vto
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace vto {
+
+/**
+ * Bounded single-producer / single-consumer lock-free ring.
+ * One thread pushes (e.g. prop setters on the main thread), one thread pops
+ * (the render loop), and neither ever blocks on the other.
+ * Capacity must be a power of two; one slot is kept free to tell full from empty.
+ */
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    /// Producer only. Returns false (and leaves both the queue and value untouched) when full.
+    bool tryPush(T&& value) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t next = (tail + 1) & kMask;
+        if (next == head_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        slots_[tail] = std::move(value);
+        tail_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer only. Returns false when empty.
+    bool tryPop(T& out) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        out = std::move(slots_[head]);
+        slots_[head] = T();
+        head_.store((head + 1) & kMask, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer only. Pop every queued item into `handler`, in push order; returns the count.
+    template <typename Handler>
+    size_t drain(Handler&& handler) {
+        size_t count = 0;
+        T value;
+        while (tryPop(value)) {
+            handler(value);
+            count++;
+        }
+        return count;
+    }
+
+    /// Approximate when called concurrently with push/pop
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr size_t kMask = Capacity - 1;
+    // Head and tail on separate cache lines so producer and consumer don't false-share
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+    std::array<T, Capacity> slots_{};
+};
+
+} // namespace vto
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cmath>
+
+namespace vto {
+
+/**
+ * Three-component vector, laid out like Filament's float3 and ARCore's packed mesh vertices.
+ */
+struct Float3 {
+    float x;
+    float y;
+    float z;
+};
+
+/**
+ * Quaternion stored as (x, y, z, w), matching ARCore and simd_quatf.vector.
+ */
+struct Quat {
+    float x;
+    float y;
+    float z;
+    float w;
+};
+
+/**
+ * 4x4 matrix stored column-major, matching Filament mat4f, simd_float4x4 and ARCore Pose.toMatrix().
+ */
+struct Mat4 {
+    float m[16];
+
+    float& operator()(int col, int row) { return m[col * 4 + row]; }
+    float operator()(int col, int row) const { return m[col * 4 + row]; }
+
+    static Mat4 identity() {
+        return {{1.0f, 0.0f, 0.0f, 0.0f,
+                 0.0f, 1.0f, 0.0f, 0.0f,
+                 0.0f, 0.0f, 1.0f, 0.0f,
+                 0.0f, 0.0f, 0.0f, 1.0f}};
+    }
+};
+
+/// Transform a point by an affine matrix (w = 1)
+inline Float3 transformPoint(const Mat4& t, Float3 p) {
+    return {
+        t(0, 0) * p.x + t(1, 0) * p.y + t(2, 0) * p.z + t(3, 0),
+        t(0, 1) * p.x + t(1, 1) * p.y + t(2, 1) * p.z + t(3, 1),
+        t(0, 2) * p.x + t(1, 2) * p.y + t(2, 2) * p.z + t(3, 2),
+    };
+}
+
+/// Local Z axis (third column) of an affine matrix
+inline Float3 forwardAxis(const Mat4& t) {
+    return {t(2, 0), t(2, 1), t(2, 2)};
+}
+
+/// Convert a unit quaternion to a 4x4 rotation matrix
+inline Mat4 matrixFromQuat(Quat q) {
+    const float x = q.x, y = q.y, z = q.z, w = q.w;
+    return {{1 - 2*y*y - 2*z*z, 2*x*y + 2*z*w,     2*x*z - 2*y*w,     0.0f,
+             2*x*y - 2*z*w,     1 - 2*x*x - 2*z*z, 2*y*z + 2*x*w,     0.0f,
+             2*x*z + 2*y*w,     2*y*z - 2*x*w,     1 - 2*x*x - 2*y*y, 0.0f,
+             0.0f,              0.0f,              0.0f,              1.0f}};
+}
+
+/// Hamilton product a * b (apply b, then a)
+inline Quat quatMultiply(Quat a, Quat b) {
+    return {
+        a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+        a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+        a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+        a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+    };
+}
+
+/// Inverse of a unit quaternion
+inline Quat quatConjugate(Quat q) {
+    return {-q.x, -q.y, -q.z, q.w};
+}
+
+inline Quat quatNormalize(Quat q) {
+    const float len = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    if (len < 1e-6f) return {0.0f, 0.0f, 0.0f, 1.0f};
+    return {q.x / len, q.y / len, q.z / len, q.w / len};
+}
+
+/// Rotation vector (axis * angle, radians) of a unit quaternion, taking the shorter way round
+inline Float3 quatToRotationVector(Quat q) {
+    if (q.w < 0.0f) q = {-q.x, -q.y, -q.z, -q.w};
+    const float sinHalf = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z);
+    // Small angles: angle / sin(angle / 2) -> 2
+    const float scale = sinHalf > 1e-6f ? 2.0f * std::atan2(sinHalf, q.w) / sinHalf : 2.0f;
+    return {q.x * scale, q.y * scale, q.z * scale};
+}
+
+/// Unit quaternion rotating by a rotation vector (axis * angle, radians)
+inline Quat quatFromRotationVector(Float3 v) {
+    const float angle = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+    if (angle < 1e-6f) return quatNormalize({v.x * 0.5f, v.y * 0.5f, v.z * 0.5f, 1.0f});
+    const float scale = std::sin(angle * 0.5f) / angle;
+    return {v.x * scale, v.y * scale, v.z * scale, std::cos(angle * 0.5f)};
+}
+
+/// Extract the rotation of an affine matrix (without scale) as a unit quaternion
+inline Quat quatFromMatrix(const Mat4& t) {
+    const float m00 = t(0, 0), m11 = t(1, 1), m22 = t(2, 2);
+    const float trace = m00 + m11 + m22;
+    Quat q;
+    if (trace > 0.0f) {
+        const float s = std::sqrt(trace + 1.0f) * 2.0f;
+        q = {(t(1, 2) - t(2, 1)) / s, (t(2, 0) - t(0, 2)) / s, (t(0, 1) - t(1, 0)) / s, 0.25f * s};
+    } else if (m00 > m11 && m00 > m22) {
+        const float s = std::sqrt(1.0f + m00 - m11 - m22) * 2.0f;
+        q = {0.25f * s, (t(1, 0) + t(0, 1)) / s, (t(2, 0) + t(0, 2)) / s, (t(1, 2) - t(2, 1)) / s};
+    } else if (m11 > m22) {
+        const float s = std::sqrt(1.0f + m11 - m00 - m22) * 2.0f;
+        q = {(t(1, 0) + t(0, 1)) / s, 0.25f * s, (t(2, 1) + t(1, 2)) / s, (t(2, 0) - t(0, 2)) / s};
+    } else {
+        const float s = std::sqrt(1.0f + m22 - m00 - m11) * 2.0f;
+        q = {(t(2, 0) + t(0, 2)) / s, (t(2, 1) + t(1, 2)) / s, 0.25f * s, (t(0, 1) - t(1, 0)) / s};
+    }
+    return q;
+}
+
+} // namespace vto
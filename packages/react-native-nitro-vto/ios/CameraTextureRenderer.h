@@ -6,6 +6,8 @@ namespace filament {
     class Scene;
 }
 
+@class VTOFilamentContext;
+
 NS_ASSUME_NONNULL_BEGIN
 
 /**
@@ -14,8 +16,8 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @interface CameraTextureRenderer : NSObject
 
-/// Setup the camera background rendering
-- (void)setupWithEngine:(filament::Engine *)engine scene:(filament::Scene *)scene;
+/// Setup the camera background rendering with the shared engine and materials
+- (void)setupWithContext:(VTOFilamentContext *)context scene:(filament::Scene *)scene;
 
 /// Set viewport size for correct aspect ratio transform
 - (void)setViewportSize:(CGSize)size;
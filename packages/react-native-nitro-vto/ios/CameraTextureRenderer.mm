@@ -1,5 +1,6 @@
 #import "CameraTextureRenderer.h"
-#import "LoaderUtils.h"
+#import "MatrixUtils.h"
+#import "VTOFilamentContext.h"
 
 #include <filament/Engine.h>
 #include <filament/Scene.h>
@@ -61,21 +62,13 @@ static constexpr uint16_t kIndices[6] = { 0, 1, 2, 2, 1, 3 };
 
 @implementation CameraTextureRenderer
 
-- (void)setupWithEngine:(Engine *)engine scene:(Scene *)scene {
-    _engine = engine;
+- (void)setupWithContext:(VTOFilamentContext *)context scene:(Scene *)scene {
+    _engine = context.engine;
     _scene = scene;
     _viewportSize = CGSizeMake(1, 1);  // Default, will be updated
 
-    // Load camera background material
-    NSData *materialData = [LoaderUtils loadAssetNamed:@"materials/camera_background_ios.filamat"];
-    if (!materialData) {
-        NSLog(@"%@: Failed to load camera material", TAG);
-        return;
-    }
-
-    _cameraMaterial = Material::Builder()
-        .package(materialData.bytes, materialData.length)
-        .build(*engine);
+    // Camera background material, compiled once and owned by the shared context
+    _cameraMaterial = [context materialNamed:@"materials/camera_background_ios.filamat"];
 
     if (!_cameraMaterial) {
         NSLog(@"%@: Failed to create camera material", TAG);
@@ -87,7 +80,7 @@ static constexpr uint16_t kIndices[6] = { 0, 1, 2, 2, 1, 3 };
     _cameraFeedTexture = Texture::Builder()
         .levels(1)
         .sampler(Texture::Sampler::SAMPLER_EXTERNAL)
-        .build(*engine);
+        .build(*_engine);
 
     // Create full-screen triangle renderable
     [self createCameraFeedTriangle];
@@ -149,7 +142,8 @@ static constexpr uint16_t kIndices[6] = { 0, 1, 2, 2, 1, 3 };
 - (void)createCameraFeedTriangle {
     if (!_engine || !_scene || !_cameraMaterial) return;
 
-    _cameraMaterialInstance = _cameraMaterial->getDefaultInstance();
+    // Own instance: the material (and its default instance) is shared with other views
+    _cameraMaterialInstance = _cameraMaterial->createInstance();
 
     // Create vertex buffer using full-screen quad with HALF4/HALF2 attributes
     _vertexBuffer = VertexBuffer::Builder()
@@ -186,7 +180,7 @@ static constexpr uint16_t kIndices[6] = { 0, 1, 2, 2, 1, 3 };
         .culling(false)
         .receiveShadows(false)
         .castShadows(false)
-        .priority(7)  // Render first (at the back)
+        .priority(0)  // Render first (at the back): everything else then draws over it
         .build(*_engine, _cameraFeedTriangle);
 
     // Set texture parameter
@@ -211,12 +205,7 @@ static constexpr uint16_t kIndices[6] = { 0, 1, 2, 2, 1, 3 };
     simd_float4x4 invViewProj = simd_inverse(viewProj);
 
     // Convert to Filament matrix
-    mat4f backgroundTransform;
-    for (int col = 0; col < 4; col++) {
-        for (int row = 0; row < 4; row++) {
-            backgroundTransform[col][row] = invViewProj.columns[col][row];
-        }
-    }
+    mat4f backgroundTransform = [MatrixUtils filamentMatrixFromSimd:invViewProj];
 
     // Apply transform to background quad
     TransformManager &transformManager = _engine->getTransformManager();
@@ -228,6 +217,8 @@ static constexpr uint16_t kIndices[6] = { 0, 1, 2, 2, 1, 3 };
     if (!_engine || !_scene) return;
 
     _scene->remove(_cameraFeedTriangle);
+    // Renderable components live in the shared engine, so destroy them with the entities
+    _engine->destroy(_cameraFeedTriangle);
     EntityManager::get().destroy(_cameraFeedTriangle);
 
     if (_cameraFeedTexture) {
@@ -239,8 +230,8 @@ static constexpr uint16_t kIndices[6] = { 0, 1, 2, 2, 1, 3 };
     if (_indexBuffer) {
         _engine->destroy(_indexBuffer);
     }
-    if (_cameraMaterial) {
-        _engine->destroy(_cameraMaterial);
+    if (_cameraMaterialInstance) {
+        _engine->destroy(_cameraMaterialInstance);
     }
 }
 
@@ -1,29 +1,20 @@
 #import <Foundation/Foundation.h>
-#import <ARKit/ARKit.h>
 
-namespace filament {
-    class Engine;
-    class Scene;
-}
+@class FaceOcclusionRenderer;
+@class VTOFilamentContext;
 
 NS_ASSUME_NONNULL_BEGIN
 
 /**
- * Debug renderer for visualizing face mesh and back planes.
- * Renders colored overlays: red for face mesh, green for left plane, blue for right plane.
+ * Debug renderer for visualizing the face occluder.
+ * Tints the occluder (face meshes and visible back planes) red, drawing it a second time over the
+ * occlusion renderer's own buffers and bones: one extra draw call, with no mesh uploads of its own.
  */
 @interface DebugRenderer : NSObject
 
-/// Setup the debug renderer with Filament engine and scene
-- (void)setupWithEngine:(filament::Engine *)engine scene:(filament::Scene *)scene;
-
-/// Update debug visualization with face data and back plane visibility from occlusion renderer
-- (void)updateWithFace:(ARFaceAnchor *)face
-  showLeftBackPlane:(BOOL)showLeftBackPlane
- showRightBackPlane:(BOOL)showRightBackPlane;
-
-/// Hide debug visualization
-- (void)hide;
+/// Setup the debug renderer with the shared Filament context and the occluder to visualize
+- (void)setupWithContext:(VTOFilamentContext *)context
+       occlusionRenderer:(FaceOcclusionRenderer *)occlusionRenderer;
 
 /// Set debug mode enabled
 - (void)setEnabled:(BOOL)enabled;
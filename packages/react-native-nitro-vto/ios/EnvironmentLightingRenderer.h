@@ -2,24 +2,39 @@
 #import <ARKit/ARKit.h>
 
 namespace filament {
-    class Engine;
     class Scene;
 }
 
+@class VTOFilamentContext;
+
 NS_ASSUME_NONNULL_BEGIN
 
 /**
  * Handles environment-based lighting (IBL) for AR rendering.
- * Loads skybox and indirect light from KTX files and updates
- * intensity based on ARKit light estimation.
+ * No skybox: the camera background covers the whole view. The reflections are those of a bundled
+ * environment, whose cubemap VTOFilamentContext loads off the render thread and shares between
+ * views; until it arrives the scene is lit by spherical harmonics alone. The diffuse irradiance
+ * (third-order spherical harmonics) follows ARKit's directional light estimate, which face
+ * tracking provides, and the intensity its ambient intensity. Estimates are rate-limited and
+ * smoothed by vto::LightEstimator; the indirect light is rebuilt only when the smoothed
+ * irradiance has visibly changed.
  */
 @interface EnvironmentLightingRenderer : NSObject
 
-/// Setup environment lighting with IBL from KTX files
-- (void)setupWithEngine:(filament::Engine *)engine scene:(filament::Scene *)scene;
+/// Setup environment lighting and start loading the environment's reflections, without waiting
+/// for them
+- (void)setupWithContext:(VTOFilamentContext *)context
+                   scene:(filament::Scene *)scene
+             environment:(NSString *)environment;
+
+/// Switch the reflections to another bundled environment, loading it if no view has it yet.
+/// The current reflections stay until the new ones are ready; an unknown name keeps them.
+- (void)setEnvironmentNamed:(NSString *)name;
 
-/// Update lighting intensity based on ARKit light estimation
-- (void)updateFromARKitWithLightEstimate:(ARLightEstimate *)lightEstimate;
+/// Update lighting from ARKit light estimation, once per rendered frame (nil: keep smoothing towards
+/// the last estimate)
+- (void)updateFromARKitWithLightEstimate:(nullable ARLightEstimate *)lightEstimate
+                               timestamp:(NSTimeInterval)timestamp;
 
 /// Cleanup and destroy resources
 - (void)destroy;
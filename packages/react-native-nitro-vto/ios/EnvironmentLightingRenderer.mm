@@ -1,107 +1,125 @@
 #import "EnvironmentLightingRenderer.h"
-#import "LoaderUtils.h"
+#import "VTOFilamentContext.h"
 
 #include <filament/Engine.h>
 #include <filament/Scene.h>
 #include <filament/IndirectLight.h>
-#include <filament/Skybox.h>
 #include <filament/Texture.h>
-#include <ktxreader/Ktx1Reader.h>
+#include <math/vec3.h>
+
+#include "LightEstimator.hpp"
 
 using namespace filament;
 
 static NSString *const TAG = @"EnvironmentLighting";
 
-// Intensity will range from 30_000 to 90_000 based on pixel intensity
-static const float BASE_INTENSITY = 30000.0f;
-static const float INTENSITY_FACTOR = 60000.0f;
+// vto::SphericalHarmonics is packed RGB triplets, like the float3 array Filament takes
+static_assert(sizeof(vto::SphericalHarmonics) == sizeof(math::float3) * vto::kSphericalHarmonicsCount,
+              "SphericalHarmonics must match float3[9]");
 
 @interface EnvironmentLightingRenderer ()
 
+@property (nonatomic, strong) VTOFilamentContext *context;
 @property (nonatomic, assign) Engine *engine;
+@property (nonatomic, assign) Scene *scene;
 @property (nonatomic, assign) IndirectLight *indirectLight;
-@property (nonatomic, assign) Skybox *skybox;
+/// Owned by the context; null until the first environment has loaded
 @property (nonatomic, assign) Texture *iblTexture;
-@property (nonatomic, assign) Texture *skyboxTexture;
+/// Requested environment, and the one iblTexture belongs to: a reference is held on each, so the
+/// displayed cubemap can't be evicted while the requested one loads
+@property (nonatomic, copy, nullable) NSString *environment;
+@property (nonatomic, copy, nullable) NSString *displayedEnvironment;
 
 @end
 
-@implementation EnvironmentLightingRenderer
-
-- (void)setupWithEngine:(Engine *)engine scene:(Scene *)scene {
-    _engine = engine;
-
-    // Load IBL (indirect light) from ktx file
-    NSData *iblData = [LoaderUtils loadAssetNamed:@"envs/studio_small_02_ibl.ktx"];
-    if (iblData) {
-        // Create Ktx1Bundle from raw bytes
-        auto iblBundle = new image::Ktx1Bundle(
-            (const uint8_t *)iblData.bytes,
-            (uint32_t)iblData.length
-        );
-        
-        // Create texture from bundle (takes ownership and destroys bundle after upload)
-        _iblTexture = ktxreader::Ktx1Reader::createTexture(
-            engine,
-            iblBundle,
-            false // sRGB
-        );
-
-        if (_iblTexture) {
-            _indirectLight = IndirectLight::Builder()
-                .reflections(_iblTexture)
-                .intensity(BASE_INTENSITY)
-                .build(*engine);
-
-            scene->setIndirectLight(_indirectLight);
-            NSLog(@"%@: Loaded IBL", TAG);
-        } else {
-            NSLog(@"%@: Failed to create IBL texture", TAG);
-        }
-    } else {
-        NSLog(@"%@: Failed to load IBL file", TAG);
+@implementation EnvironmentLightingRenderer {
+    vto::LightEstimator _lightEstimator;
+}
+
+- (void)setupWithContext:(VTOFilamentContext *)context scene:(Scene *)scene environment:(NSString *)environment {
+    _context = context;
+    _engine = context.engine;
+    _scene = scene;
+
+    [self rebuildIndirectLight];
+    [self setEnvironmentNamed:environment];
+    NSLog(@"%@: Environment lighting setup complete", TAG);
+}
+
+- (void)setEnvironmentNamed:(NSString *)name {
+    if (!_engine || [name isEqualToString:_environment]) return;
+    if (![VTOFilamentContext isEnvironmentAvailable:name]) {
+        NSLog(@"%@: Unknown environment: %@", TAG, name);
+        return;
     }
 
-    // Load skybox from ktx file
-    NSData *skyboxData = [LoaderUtils loadAssetNamed:@"envs/studio_small_02_skybox.ktx"];
-    if (skyboxData) {
-        // Create Ktx1Bundle from raw bytes
-        auto skyboxBundle = new image::Ktx1Bundle(
-            (const uint8_t *)skyboxData.bytes,
-            (uint32_t)skyboxData.length
-        );
-        
-        // Create texture from bundle (takes ownership and destroys bundle after upload)
-        _skyboxTexture = ktxreader::Ktx1Reader::createTexture(
-            engine,
-            skyboxBundle,
-            false // sRGB
-        );
-
-        if (_skyboxTexture) {
-            _skybox = Skybox::Builder()
-                .environment(_skyboxTexture)
-                .build(*engine);
-
-            scene->setSkybox(_skybox);
-            NSLog(@"%@: Loaded skybox", TAG);
+    NSString *previous = _environment;
+    if (previous && ![previous isEqualToString:_displayedEnvironment]) {
+        [_context relinquishEnvironmentNamed:previous];
+    }
+    self.environment = name;
+    if ([name isEqualToString:_displayedEnvironment]) return;
+
+    __weak __typeof__(self) weakSelf = self;
+    [_context acquireEnvironmentNamed:name onLoaded:^(Texture *cubemap) {
+        __typeof__(self) strongSelf = weakSelf;
+        // Switched again or destroyed while loading
+        if (!strongSelf || ![strongSelf.environment isEqualToString:name]) return;
+        strongSelf.iblTexture = cubemap;
+        [strongSelf rebuildIndirectLight];
+        if (strongSelf.displayedEnvironment) {
+            [strongSelf.context relinquishEnvironmentNamed:strongSelf.displayedEnvironment];
+        }
+        strongSelf.displayedEnvironment = name;
+        NSLog(@"%@: Loaded IBL %@", TAG, name);
+    }];
+}
+
+- (void)updateFromARKitWithLightEstimate:(ARLightEstimate *)lightEstimate timestamp:(NSTimeInterval)timestamp {
+    if (!_indirectLight) return;
+
+    if (lightEstimate) {
+        // ARKit ambientIntensity is in lumens, typically ranges 0-2000
+        // Normalize to 0-1 range for our intensity calculation
+        const float brightness = fminf((float)lightEstimate.ambientIntensity / 1000.0f, 1.0f);
+
+        NSData *coefficients = nil;
+        if ([lightEstimate isKindOfClass:[ARDirectionalLightEstimate class]]) {
+            coefficients = ((ARDirectionalLightEstimate *)lightEstimate).sphericalHarmonicsCoefficients;
+        }
+        if (coefficients.length >= sizeof(float) * vto::kSphericalHarmonicsCount * 3) {
+            if (_lightEstimator.wantsEstimate(timestamp)) {
+                _lightEstimator.addEstimate(vto::irradianceFromPlanarRadiance((const float *)coefficients.bytes),
+                                            brightness, vto::LightSource::Tracker, timestamp);
+            }
         } else {
-            NSLog(@"%@: Failed to create skybox texture", TAG);
+            _lightEstimator.addBrightness(brightness, timestamp);
         }
-    } else {
-        NSLog(@"%@: Failed to load skybox file", TAG);
     }
 
-    NSLog(@"%@: Environment lighting setup complete", TAG);
+    if (_lightEstimator.update(timestamp)) {
+        [self rebuildIndirectLight];
+    }
+    _indirectLight->setIntensity(_lightEstimator.intensity());
 }
 
-- (void)updateFromARKitWithLightEstimate:(ARLightEstimate *)lightEstimate {
-    if (!_indirectLight) return;
+/// IndirectLight irradiance can't be changed after it's built: build a new one around the same
+/// reflections cubemap (none until the environment has loaded)
+- (void)rebuildIndirectLight {
+    const vto::SphericalHarmonics &irradiance = _lightEstimator.irradiance();
+    IndirectLight::Builder builder;
+    builder.irradiance(vto::kSphericalHarmonicsBands, reinterpret_cast<const math::float3 *>(irradiance.coefficients))
+        .intensity(_lightEstimator.intensity());
+    if (_iblTexture) {
+        builder.reflections(_iblTexture);
+    }
+    IndirectLight *light = builder.build(*_engine);
 
-    // ARKit ambientIntensity is in lumens, typically ranges 0-2000
-    // Normalize to 0-1 range for our intensity calculation
-    float normalizedIntensity = fminf((float)lightEstimate.ambientIntensity / 1000.0f, 1.0f);
-    _indirectLight->setIntensity(BASE_INTENSITY + normalizedIntensity * INTENSITY_FACTOR);
+    _scene->setIndirectLight(light);
+    if (_indirectLight) {
+        _engine->destroy(_indirectLight);
+    }
+    _indirectLight = light;
 }
 
 - (void)destroy {
@@ -109,16 +127,19 @@ static const float INTENSITY_FACTOR = 60000.0f;
 
     if (_indirectLight) {
         _engine->destroy(_indirectLight);
+        _indirectLight = nullptr;
     }
-    if (_skybox) {
-        _engine->destroy(_skybox);
-    }
-    if (_iblTexture) {
-        _engine->destroy(_iblTexture);
+    // The cubemap is the context's, shared with other views
+    _iblTexture = nullptr;
+    if (_environment && ![_environment isEqualToString:_displayedEnvironment]) {
+        [_context relinquishEnvironmentNamed:_environment];
     }
-    if (_skyboxTexture) {
-        _engine->destroy(_skyboxTexture);
+    if (_displayedEnvironment) {
+        [_context relinquishEnvironmentNamed:_displayedEnvironment];
     }
+    self.environment = nil;
+    self.displayedEnvironment = nil;
+    _engine = nullptr;
 }
 
 @end
@@ -0,0 +1,38 @@
+#import <Foundation/Foundation.h>
+#import <ARKit/ARKit.h>
+
+namespace filament {
+    class Engine;
+    class VertexBuffer;
+}
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Zero-copy upload of ARKit face mesh positions into a Filament vertex buffer.
+ * The vertex buffer must declare POSITION as FLOAT3 with a stride of sizeof(simd_float3),
+ * so ARFaceGeometry.vertices can be handed to the driver as-is.
+ * Each upload retains its ARFaceGeometry in one of N slots until Filament's release
+ * callback fires, so the driver never reads memory that ARKit has recycled.
+ */
+@interface FaceMeshUploadRing : NSObject
+
+- (instancetype)initWithSlotCount:(NSUInteger)slotCount NS_DESIGNATED_INITIALIZER;
+- (instancetype)init;
+
+/// Upload the geometry vertices to buffer slot 0 of the vertex buffer.
+/// Returns NO (and uploads nothing) when every slot is still in flight.
+- (BOOL)uploadGeometry:(ARFaceGeometry *)geometry
+        toVertexBuffer:(filament::VertexBuffer *)vertexBuffer
+                engine:(filament::Engine *)engine;
+
+/// Upload the geometry vertices to buffer slot 0 of the vertex buffer, starting byteOffset bytes in
+/// (several faces batched into one vertex buffer). Each upload holds a ring slot of its own.
+- (BOOL)uploadGeometry:(ARFaceGeometry *)geometry
+        toVertexBuffer:(filament::VertexBuffer *)vertexBuffer
+            byteOffset:(uint32_t)byteOffset
+                engine:(filament::Engine *)engine;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,124 @@
+#import "FaceMeshUploadRing.h"
+
+#include <filament/Engine.h>
+#include <filament/VertexBuffer.h>
+
+#include <atomic>
+
+using namespace filament;
+
+static NSString *const TAG = @"FaceMeshUploadRing";
+
+// Filament keeps at most a few frames in flight, so three slots per uploaded mesh never stall the
+// render thread (FaceOcclusionRenderer holds 3 * kMaxTrackedFaces, one upload per face per frame)
+static const NSUInteger DEFAULT_SLOT_COUNT = 3;
+
+namespace {
+
+struct UploadRingState;
+
+struct UploadSlot {
+    UploadRingState *state;
+    std::atomic<bool> inFlight{false};
+    // Retained ARFaceGeometry (CFBridgingRetain), released by the Filament callback
+    const void *geometry = nullptr;
+};
+
+// Shared between the ring and in-flight uploads: freed by whichever lets go last,
+// so late release callbacks (e.g. during Engine::destroy) never touch freed memory.
+struct UploadRingState {
+    explicit UploadRingState(NSUInteger count) : slotCount(count), slots(new UploadSlot[count]) {
+        for (NSUInteger i = 0; i < count; i++) {
+            slots[i].state = this;
+        }
+    }
+    ~UploadRingState() { delete[] slots; }
+
+    void retain() { refs.fetch_add(1, std::memory_order_relaxed); }
+    void release() {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    std::atomic<int> refs{1};
+    NSUInteger slotCount;
+    UploadSlot *slots;
+};
+
+void releaseUploadSlot(void *, size_t, void *user) {
+    UploadSlot *slot = static_cast<UploadSlot *>(user);
+    const void *geometry = slot->geometry;
+    slot->geometry = nullptr;
+    slot->inFlight.store(false, std::memory_order_release);
+    CFBridgingRelease(geometry);
+    slot->state->release();
+}
+
+} // namespace
+
+static_assert(sizeof(simd_float3) == 4 * sizeof(float), "ARKit vertices are expected to be padded float3");
+
+@implementation FaceMeshUploadRing {
+    UploadRingState *_state;
+    NSUInteger _nextSlot;
+}
+
+- (instancetype)init {
+    return [self initWithSlotCount:DEFAULT_SLOT_COUNT];
+}
+
+- (instancetype)initWithSlotCount:(NSUInteger)slotCount {
+    self = [super init];
+    if (self) {
+        _state = new UploadRingState(MAX(slotCount, (NSUInteger)1));
+        _nextSlot = 0;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    _state->release();
+}
+
+- (BOOL)uploadGeometry:(ARFaceGeometry *)geometry
+        toVertexBuffer:(VertexBuffer *)vertexBuffer
+                engine:(Engine *)engine {
+    return [self uploadGeometry:geometry toVertexBuffer:vertexBuffer byteOffset:0 engine:engine];
+}
+
+- (BOOL)uploadGeometry:(ARFaceGeometry *)geometry
+        toVertexBuffer:(VertexBuffer *)vertexBuffer
+            byteOffset:(uint32_t)byteOffset
+                engine:(Engine *)engine {
+    // Find the next slot the driver has released
+    UploadSlot *slot = nullptr;
+    for (NSUInteger i = 0; i < _state->slotCount; i++) {
+        UploadSlot *candidate = &_state->slots[(_nextSlot + i) % _state->slotCount];
+        if (!candidate->inFlight.load(std::memory_order_acquire)) {
+            slot = candidate;
+            _nextSlot = (_nextSlot + i + 1) % _state->slotCount;
+            break;
+        }
+    }
+
+    if (!slot) {
+        // Driver is behind: keep last frame's mesh rather than block or overwrite
+        NSLog(@"%@: All %lu upload slots in flight, skipping face mesh upload", TAG,
+              (unsigned long)_state->slotCount);
+        return NO;
+    }
+
+    slot->inFlight.store(true, std::memory_order_relaxed);
+    slot->geometry = CFBridgingRetain(geometry);
+    _state->retain();
+
+    vertexBuffer->setBufferAt(*engine, 0,
+        VertexBuffer::BufferDescriptor(geometry.vertices,
+                                       geometry.vertexCount * sizeof(simd_float3),
+                                       releaseUploadSlot, slot),
+        byteOffset);
+    return YES;
+}
+
+@end
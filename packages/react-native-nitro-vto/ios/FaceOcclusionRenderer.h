@@ -1,8 +1,12 @@
 #import <Foundation/Foundation.h>
 #import <ARKit/ARKit.h>
 
+@class FaceTopology;
+@class VTOFilamentContext;
+
 namespace filament {
     class Engine;
+    class MaterialInstance;
     class Scene;
 }
 
@@ -11,19 +15,17 @@ NS_ASSUME_NONNULL_BEGIN
 /**
  * Renderer for face occlusion mesh.
  * Renders the ARKit face mesh to the depth buffer only (no color),
- * allowing the face to occlude parts of the glasses.
+ * allowing the face to occlude parts of the glasses. It draws after the camera background and
+ * before the glasses.
+ * Every tracked face gets a slot, and all slots are one skinned renderable and vertex buffer: each
+ * slot's low-poly face mesh and pair of back planes follow their own bones, and a hidden part gets
+ * a zero bone, so the whole occluder is a single draw that never leaves the scene while a face is tracked.
  */
 @interface FaceOcclusionRenderer : NSObject
 
-/// Whether the left back plane is currently visible (based on head yaw)
-@property (nonatomic, readonly) BOOL isLeftBackPlaneVisible;
-
-/// Whether the right back plane is currently visible (based on head yaw)
-@property (nonatomic, readonly) BOOL isRightBackPlaneVisible;
-
-/// Setup the face occlusion renderer with Filament engine and scene
-- (void)setupWithEngine:(filament::Engine *)engine
-                  scene:(filament::Scene *)scene;
+/// Setup the face occlusion renderer with the shared Filament context and scene
+- (void)setupWithContext:(VTOFilamentContext *)context
+                   scene:(filament::Scene *)scene;
 
 /// Set face mesh occlusion enabled
 - (void)setFaceMeshOcclusion:(BOOL)enabled;
@@ -31,10 +33,19 @@ NS_ASSUME_NONNULL_BEGIN
 /// Set back plane occlusion enabled
 - (void)setBackPlaneOcclusion:(BOOL)enabled;
 
-/// Update face mesh geometry from ARKit face anchor
-- (void)updateWithFace:(ARFaceAnchor *)face;
+/// Number of face slots, clamped to [1, kMaxTrackedFaces] (default 1)
+- (void)setMaxFaces:(NSUInteger)maxFaces;
+
+/// Draw the occluder a second time with this material, over the same buffers (one extra draw
+/// call), or stop with nullptr. The overlay has its own bones: it shows the face and back planes
+/// even where their occlusion is disabled. The caller owns the instance.
+- (void)setOverlayMaterialInstance:(nullable filament::MaterialInstance *)materialInstance;
+
+/// Update face mesh geometry from the tracked ARKit face anchors (at most maxFaces are drawn),
+/// using the cached topology for their mesh
+- (void)updateWithFaces:(NSArray<ARFaceAnchor *> *)faces topology:(FaceTopology *)topology;
 
-/// Hide the face mesh (when no face is detected)
+/// Hide the face meshes (when no face is detected)
 - (void)hide;
 
 /// Cleanup and destroy resources
@@ -1,6 +1,8 @@
 #import "FaceOcclusionRenderer.h"
-#import "LoaderUtils.h"
+#import "FaceMeshUploadRing.h"
+#import "FaceTopology.h"
 #import "MatrixUtils.h"
+#import "VTOFilamentContext.h"
 
 #include <filament/Engine.h>
 #include <filament/Scene.h>
@@ -9,21 +11,27 @@
 #include <filament/VertexBuffer.h>
 #include <filament/IndexBuffer.h>
 #include <filament/RenderableManager.h>
-#include <filament/TransformManager.h>
+#include <filament/SkinningBuffer.h>
 #include <filament/Box.h>
 #include <utils/EntityManager.h>
 #include <math/mat4.h>
 
+#include "FaceMesh.hpp"
+
 using namespace filament;
 using namespace filament::math;
 using namespace utils;
 
 static NSString *const TAG = @"FaceOcclusionRenderer";
 
-// ARKit face mesh typically has ~1220 vertices and ~2304 triangles
-// We allocate a bit more to be safe
-static const size_t MAX_VERTICES = 1500;
-static const size_t MAX_INDICES = 8000;
+static void freeBufferData(void *buffer, size_t, void *) {
+    free(buffer);
+}
+
+// After the camera background (0) and before the glasses (default 4): the depth they're tested against
+static const uint8_t OCCLUDER_PRIORITY = 1;
+// Overlay drawn after everything else
+static const uint8_t OVERLAY_PRIORITY = 7;
 
 @interface FaceOcclusionRenderer ()
 
@@ -32,427 +40,394 @@ static const size_t MAX_INDICES = 8000;
 
 @property (nonatomic, assign) Material *occlusionMaterial;
 @property (nonatomic, assign) MaterialInstance *occlusionMaterialInstance;
+// Every slot's face mesh and back planes (split left/right, hidden based on head rotation) in one
+// skinned renderable: a single depth-only draw
 @property (nonatomic, assign) Entity faceMeshEntity;
+// Positions of every face slot back to back, then the back plane quads, plus static bone
+// indices/weights binding each part to its bone
 @property (nonatomic, assign) VertexBuffer *vertexBuffer;
+// Low-poly face triangles and back planes, slot after slot
 @property (nonatomic, assign) IndexBuffer *indexBuffer;
-
-// Back clipping planes (split left/right for better occlusion based on head rotation)
-@property (nonatomic, assign) Entity backPlaneLeftEntity;
-@property (nonatomic, assign) Entity backPlaneRightEntity;
-@property (nonatomic, assign) VertexBuffer *backPlaneLeftVertexBuffer;
-@property (nonatomic, assign) VertexBuffer *backPlaneRightVertexBuffer;
-@property (nonatomic, assign) IndexBuffer *backPlaneIndexBuffer;  // Shared between both planes
-@property (nonatomic, assign) BOOL backPlaneLeftVisible;
-@property (nonatomic, assign) BOOL backPlaneRightVisible;
+// Face, left and right back plane bones of every slot (disabled parts collapsed)
+@property (nonatomic, assign) SkinningBuffer *skinningBuffer;
+@property (nonatomic, assign) NSUInteger faceSlotCount;
+// Faces covered by the draw range
+@property (nonatomic, assign) NSUInteger drawnFaceCount;
+
+// Second draw of the occluder geometry with its own material (debug visualization)
+@property (nonatomic, assign) Entity overlayEntity;
+@property (nonatomic, assign) MaterialInstance *overlayMaterialInstance;
+// The overlay's own bones: every part, whatever the occlusion settings
+@property (nonatomic, assign) SkinningBuffer *overlaySkinningBuffer;
+@property (nonatomic, assign) BOOL isOverlayVisible;
+
+// Shared, immutable face topology (owned by VTORendererBridge)
+@property (nonatomic, weak) FaceTopology *topology;
+// Low-poly occluder triangles of the attached topology
+@property (nonatomic, strong, nullable) NSData *occluderIndices;
 
 @property (nonatomic, assign) BOOL isSetup;
 @property (nonatomic, assign) BOOL isVisible;
-@property (nonatomic, assign) size_t currentVertexCount;
-@property (nonatomic, assign) size_t currentIndexCount;
 
 // Occlusion settings (both enabled by default)
 @property (nonatomic, assign) BOOL faceMeshEnabled;
 @property (nonatomic, assign) BOOL backPlaneEnabled;
 
-// Reusable buffer for vertex data
-@property (nonatomic, assign) float3 *vertexData;
-
-// Reusable buffer for index data (to avoid dangling pointer to ARKit data)
-@property (nonatomic, assign) int16_t *indexData;
-
-// Persistent back plane vertex data (to avoid dangling pointer)
-@property (nonatomic, assign) float3 *backPlaneLeftVertices;
-@property (nonatomic, assign) float3 *backPlaneRightVertices;
+// Zero-copy upload of ARKit vertices, triple-buffered for every face slot
+@property (nonatomic, strong) FaceMeshUploadRing *vertexUploadRing;
 
 @end
 
-@implementation FaceOcclusionRenderer
+@implementation FaceOcclusionRenderer {
+    // Face, left and right back plane transform of each slot: the occluder's skinning bones
+    mat4f _occluderBones[vto::kOccluderBonesPerFace * vto::kMaxTrackedFaces];
+    // The same with every part shown: the overlay's skinning bones
+    mat4f _overlayBones[vto::kOccluderBonesPerFace * vto::kMaxTrackedFaces];
+}
 
 - (instancetype)init {
     self = [super init];
     if (self) {
         _isSetup = NO;
         _isVisible = NO;
-        _backPlaneLeftVisible = NO;
-        _backPlaneRightVisible = NO;
-        _currentVertexCount = 0;
-        _currentIndexCount = 0;
         _faceMeshEnabled = YES;
         _backPlaneEnabled = YES;
-        _vertexData = (float3 *)malloc(MAX_VERTICES * sizeof(float3));
-        _indexData = (int16_t *)malloc(MAX_INDICES * sizeof(int16_t));
-        _backPlaneLeftVertices = (float3 *)malloc(4 * sizeof(float3));
-        _backPlaneRightVertices = (float3 *)malloc(4 * sizeof(float3));
+        _faceSlotCount = 1;
+        _vertexUploadRing = [[FaceMeshUploadRing alloc] initWithSlotCount:3 * vto::kMaxTrackedFaces];
     }
     return self;
 }
 
-- (void)dealloc {
-    if (_vertexData) {
-        free(_vertexData);
-        _vertexData = nullptr;
-    }
-    if (_indexData) {
-        free(_indexData);
-        _indexData = nullptr;
-    }
-    if (_backPlaneLeftVertices) {
-        free(_backPlaneLeftVertices);
-        _backPlaneLeftVertices = nullptr;
-    }
-    if (_backPlaneRightVertices) {
-        free(_backPlaneRightVertices);
-        _backPlaneRightVertices = nullptr;
-    }
-}
-
-- (BOOL)isLeftBackPlaneVisible {
-    return _backPlaneLeftVisible;
-}
-
-- (BOOL)isRightBackPlaneVisible {
-    return _backPlaneRightVisible;
-}
-
-- (void)setupWithEngine:(Engine *)engine scene:(Scene *)scene {
-    _engine = engine;
+- (void)setupWithContext:(VTOFilamentContext *)context scene:(Scene *)scene {
+    _engine = context.engine;
     _scene = scene;
 
-    // Load face occlusion material
-    NSData *materialData = [LoaderUtils loadAssetNamed:@"materials/face_occlusion.filamat"];
-    if (!materialData) {
-        NSLog(@"%@: Failed to load face occlusion material", TAG);
-        return;
-    }
-
-    _occlusionMaterial = Material::Builder()
-        .package(materialData.bytes, materialData.length)
-        .build(*engine);
+    // Face occlusion material, compiled once and owned by the shared context
+    _occlusionMaterial = [context materialNamed:@"materials/face_occlusion.filamat"];
 
     if (!_occlusionMaterial) {
         NSLog(@"%@: Failed to create face occlusion material", TAG);
         return;
     }
 
-    _occlusionMaterialInstance = _occlusionMaterial->getDefaultInstance();
+    // Own instance: the material (and its default instance) is shared with other views
+    _occlusionMaterialInstance = _occlusionMaterial->createInstance();
 
-    // Create vertex buffer with capacity for face mesh
-    // Using FLOAT3 for positions (ARKit provides float3 vertices)
-    _vertexBuffer = VertexBuffer::Builder()
-        .vertexCount((uint32_t)MAX_VERTICES)
-        .bufferCount(1)
-        .attribute(VertexAttribute::POSITION, 0,
-                   VertexBuffer::AttributeType::FLOAT3, 0, sizeof(float3))
-        .build(*engine);
+    // Create entities (renderables are built once the face topology is known)
+    _faceMeshEntity = EntityManager::get().create();
+    _overlayEntity = EntityManager::get().create();
 
-    // Create index buffer with capacity for face mesh triangles
-    _indexBuffer = IndexBuffer::Builder()
-        .indexCount((uint32_t)MAX_INDICES)
-        .bufferType(IndexBuffer::IndexType::USHORT)
-        .build(*engine);
+    // Bones for the most slots, set once per frame
+    _skinningBuffer = SkinningBuffer::Builder()
+        .boneCount((uint32_t)(vto::kOccluderBonesPerFace * vto::kMaxTrackedFaces))
+        .initialize(true)
+        .build(*_engine);
+    _overlaySkinningBuffer = SkinningBuffer::Builder()
+        .boneCount((uint32_t)(vto::kOccluderBonesPerFace * vto::kMaxTrackedFaces))
+        .initialize(true)
+        .build(*_engine);
 
-    // Create entity
-    _faceMeshEntity = EntityManager::get().create();
+    _isSetup = YES;
+    NSLog(@"%@: Face occlusion renderer setup complete", TAG);
+}
 
-    // Initial bounding box (will be updated with actual face mesh bounds)
-    filament::Box boundingBox = {{-0.2f, -0.2f, -0.2f}, {0.2f, 0.2f, 0.2f}};
+/// Take the occluder and its overlay out of the scene
+- (void)removeFromScene {
+    [self removeOccluderFromScene];
+    if (_isOverlayVisible) {
+        _scene->remove(_overlayEntity);
+        _isOverlayVisible = NO;
+    }
+}
 
-    // Build renderable - priority 0 so it renders FIRST (before camera background)
-    // Face mesh writes depth, then camera background overwrites color (with depth test disabled)
-    // Then glasses render with depth test and get occluded by face mesh depth
-    RenderableManager::Builder(1)
-        .material(0, _occlusionMaterialInstance)
-        .geometry(0, RenderableManager::PrimitiveType::TRIANGLES, _vertexBuffer, _indexBuffer, 0, 0)
-        .boundingBox(boundingBox)
-        .culling(false)
-        .receiveShadows(false)
-        .castShadows(false)
-        .priority(0)
-        .build(*engine, _faceMeshEntity);
+/// Take the occluder alone out of the scene (the overlay is independent of the occlusion settings)
+- (void)removeOccluderFromScene {
+    if (_isVisible) {
+        _scene->remove(_faceMeshEntity);
+        _isVisible = NO;
+    }
+}
 
-    // Don't add to scene yet - will add when we have valid face data
+- (void)setFaceMeshOcclusion:(BOOL)enabled {
+    // The face bones collapse with the next update; with nothing left to occlude, leave the scene now
+    _faceMeshEnabled = enabled;
+    if (!_faceMeshEnabled && !_backPlaneEnabled && _isSetup) {
+        [self removeOccluderFromScene];
+    }
+    NSLog(@"%@: Face mesh occlusion updated: %d", TAG, enabled);
+}
 
-    // Create back clipping plane (a simple quad)
-    [self createBackPlane];
+- (void)setBackPlaneOcclusion:(BOOL)enabled {
+    _backPlaneEnabled = enabled;
+    if (!_faceMeshEnabled && !_backPlaneEnabled && _isSetup) {
+        [self removeOccluderFromScene];
+    }
+    NSLog(@"%@: Back plane occlusion updated: %d", TAG, enabled);
+}
 
-    _isSetup = YES;
-    NSLog(@"%@: Face occlusion renderer setup complete", TAG);
+- (void)setMaxFaces:(NSUInteger)maxFaces {
+    NSUInteger slotCount = MIN(MAX(maxFaces, (NSUInteger)1), (NSUInteger)vto::kMaxTrackedFaces);
+    if (slotCount == _faceSlotCount) return;
+
+    _faceSlotCount = slotCount;
+    if (!_isSetup) return;
+
+    // Rebuilt for the new slot count
+    if (_topology) {
+        [self attachTopology:_topology];
+    }
+    NSLog(@"%@: Face slots updated: %lu", TAG, (unsigned long)slotCount);
 }
 
-- (void)createBackPlane {
-    // Create two quads (left and right) that clip glasses behind the face
-    // Split vertically so we can show/hide based on head rotation
-    const float planeSizeX = 0.12f;  // 12cm half-width for each plane
-    const float planeSizeY = 0.08f;  // 8cm half-height (16cm total)
-    const float gap = 0.01f;  // Small gap between planes at center
-
-    // Left back plane (user's left side, camera's right side)
-    // X range: -planeSizeX to -gap
-    _backPlaneLeftVertices[0] = float3(-planeSizeX, -planeSizeY, 0.0f);  // bottom-left
-    _backPlaneLeftVertices[1] = float3(-gap,        -planeSizeY, 0.0f);  // bottom-right
-    _backPlaneLeftVertices[2] = float3(-planeSizeX,  planeSizeY, 0.0f);  // top-left
-    _backPlaneLeftVertices[3] = float3(-gap,         planeSizeY, 0.0f);  // top-right
-
-    // Right back plane (user's right side, camera's left side)
-    // X range: gap to planeSizeX
-    _backPlaneRightVertices[0] = float3(gap,        -planeSizeY, 0.0f);  // bottom-left
-    _backPlaneRightVertices[1] = float3(planeSizeX, -planeSizeY, 0.0f);  // bottom-right
-    _backPlaneRightVertices[2] = float3(gap,         planeSizeY, 0.0f);  // top-left
-    _backPlaneRightVertices[3] = float3(planeSizeX,  planeSizeY, 0.0f);  // top-right
-
-    // Create vertex buffers for each plane
-    _backPlaneLeftVertexBuffer = VertexBuffer::Builder()
-        .vertexCount(4)
-        .bufferCount(1)
-        .attribute(VertexAttribute::POSITION, 0,
-                   VertexBuffer::AttributeType::FLOAT3, 0, sizeof(float3))
-        .build(*_engine);
+- (void)setOverlayMaterialInstance:(MaterialInstance *)materialInstance {
+    if (materialInstance == _overlayMaterialInstance) return;
 
-    _backPlaneLeftVertexBuffer->setBufferAt(*_engine, 0,
-        VertexBuffer::BufferDescriptor(_backPlaneLeftVertices, 4 * sizeof(float3), nullptr));
+    _overlayMaterialInstance = materialInstance;
+    if (!_isSetup) return;
 
-    _backPlaneRightVertexBuffer = VertexBuffer::Builder()
-        .vertexCount(4)
-        .bufferCount(1)
-        .attribute(VertexAttribute::POSITION, 0,
-                   VertexBuffer::AttributeType::FLOAT3, 0, sizeof(float3))
-        .build(*_engine);
+    if (_isOverlayVisible) {
+        _scene->remove(_overlayEntity);
+        _isOverlayVisible = NO;
+    }
+    _engine->getRenderableManager().destroy(_overlayEntity);
+    // Added back with the next tracked face
+    if (materialInstance && _topology) {
+        [self buildRenderable:_overlayEntity material:materialInstance
+                     skinning:_overlaySkinningBuffer priority:OVERLAY_PRIORITY];
+    }
+}
 
-    _backPlaneRightVertexBuffer->setBufferAt(*_engine, 0,
-        VertexBuffer::BufferDescriptor(_backPlaneRightVertices, 4 * sizeof(float3), nullptr));
+/// Low-poly occluder triangles of a topology, from the mesh of one tracked face
+- (void)decimateTopology:(FaceTopology *)topology geometry:(ARFaceGeometry *)geometry {
+    NSMutableData *indices = [NSMutableData dataWithLength:topology.indexCount * sizeof(uint16_t)];
+    size_t count = vto::decimateFaceIndices((const float *)geometry.vertices, sizeof(simd_float3) / sizeof(float),
+                                            MIN((NSUInteger)geometry.vertexCount, topology.vertexCount),
+                                            (const uint16_t *)topology.triangleIndices.bytes, topology.indexCount,
+                                            vto::kOccluderCellSize, (uint16_t *)indices.mutableBytes);
+    indices.length = count * sizeof(uint16_t);
+    _occluderIndices = indices;
+    NSLog(@"%@: Occluder mesh: %lu of %lu triangles", TAG,
+          (unsigned long)(count / 3), (unsigned long)(topology.indexCount / 3));
+}
 
-    // Shared index buffer (same topology for both planes)
-    static const uint16_t planeIndices[6] = {0, 1, 2, 2, 1, 3};
+- (void)attachTopology:(FaceTopology *)topology {
+    RenderableManager &renderableManager = _engine->getRenderableManager();
+    [self removeFromScene];
+    renderableManager.destroy(_faceMeshEntity);
+    renderableManager.destroy(_overlayEntity);
+    if (_vertexBuffer) {
+        _engine->destroy(_vertexBuffer);
+        _vertexBuffer = nullptr;
+    }
+    if (_indexBuffer) {
+        _engine->destroy(_indexBuffer);
+        _indexBuffer = nullptr;
+    }
 
-    _backPlaneIndexBuffer = IndexBuffer::Builder()
-        .indexCount(6)
+    const NSUInteger slotCount = _faceSlotCount;
+    const NSUInteger vertexCount = topology.vertexCount;
+    const size_t totalVertices = vto::occluderVertexCount(vertexCount, slotCount);
+    const size_t faceIndexCount = _occluderIndices.length / sizeof(uint16_t);
+    const size_t slotIndexCount = vto::occluderSlotIndexCount(faceIndexCount);
+
+    // One index buffer for every slot: its low-poly face, offset to its vertices, then its back planes
+    size_t indexBytes = slotIndexCount * slotCount * sizeof(uint16_t);
+    uint16_t *indices = (uint16_t *)malloc(indexBytes);
+    if (!indices || !vto::buildOccluderIndices((const uint16_t *)_occluderIndices.bytes, faceIndexCount,
+                                               vertexCount, slotCount, indices)) {
+        NSLog(@"%@: Cannot batch %lu faces of %lu vertices", TAG,
+              (unsigned long)slotCount, (unsigned long)vertexCount);
+        free(indices);
+        _topology = nil;
+        return;
+    }
+    _indexBuffer = IndexBuffer::Builder()
+        .indexCount((uint32_t)(slotIndexCount * slotCount))
         .bufferType(IndexBuffer::IndexType::USHORT)
         .build(*_engine);
+    _indexBuffer->setBuffer(*_engine, IndexBuffer::BufferDescriptor(indices, indexBytes, freeBufferData));
 
-    _backPlaneIndexBuffer->setBuffer(*_engine,
-        IndexBuffer::BufferDescriptor(planeIndices, sizeof(planeIndices), nullptr));
+    // Using FLOAT3 for positions with ARKit's padded simd_float3 stride, so
+    // ARFaceGeometry.vertices can be uploaded without repacking
+    _vertexBuffer = VertexBuffer::Builder()
+        .vertexCount((uint32_t)totalVertices)
+        .bufferCount(3)
+        .attribute(VertexAttribute::POSITION, 0,
+                   VertexBuffer::AttributeType::FLOAT3, 0, sizeof(simd_float3))
+        .attribute(VertexAttribute::BONE_INDICES, 1,
+                   VertexBuffer::AttributeType::USHORT4, 0, sizeof(ushort4))
+        .attribute(VertexAttribute::BONE_WEIGHTS, 2,
+                   VertexBuffer::AttributeType::FLOAT4, 0, sizeof(float4))
+        .build(*_engine);
 
-    // Create entities
-    _backPlaneLeftEntity = EntityManager::get().create();
-    _backPlaneRightEntity = EntityManager::get().create();
+    // The back plane quads follow the faces once: only the faces stream in every frame
+    const size_t backPlaneVertices = vto::kOccluderBackPlaneVertices * slotCount;
+    simd_float3 *backPlanes = (simd_float3 *)malloc(backPlaneVertices * sizeof(simd_float3));
+    vto::occluderBackPlaneVertices(slotCount, sizeof(simd_float3) / sizeof(float), (float *)backPlanes);
+    _vertexBuffer->setBufferAt(*_engine, 0,
+        VertexBuffer::BufferDescriptor(backPlanes, backPlaneVertices * sizeof(simd_float3), freeBufferData),
+        (uint32_t)(vertexCount * slotCount * sizeof(simd_float3)));
+
+    // Each part follows its own bone, fully weighted
+    ushort4 *boneIndices = (ushort4 *)malloc(totalVertices * sizeof(ushort4));
+    float4 *boneWeights = (float4 *)malloc(totalVertices * sizeof(float4));
+    vto::occluderBoneIndices(vertexCount, slotCount, (uint16_t *)boneIndices);
+    for (size_t i = 0; i < totalVertices; i++) {
+        boneWeights[i] = float4(1.0f, 0.0f, 0.0f, 0.0f);
+    }
+    _vertexBuffer->setBufferAt(*_engine, 1,
+        VertexBuffer::BufferDescriptor(boneIndices, totalVertices * sizeof(ushort4), freeBufferData));
+    _vertexBuffer->setBufferAt(*_engine, 2,
+        VertexBuffer::BufferDescriptor(boneWeights, totalVertices * sizeof(float4), freeBufferData));
+
+    _drawnFaceCount = slotCount;
+    _topology = topology;
+
+    // Depth only (the material writes no color), after the camera background and before the
+    // glasses, which are depth tested against it
+    [self buildRenderable:_faceMeshEntity material:_occlusionMaterialInstance
+                 skinning:_skinningBuffer priority:OCCLUDER_PRIORITY];
+    if (_overlayMaterialInstance) {
+        [self buildRenderable:_overlayEntity material:_overlayMaterialInstance
+                     skinning:_overlaySkinningBuffer priority:OVERLAY_PRIORITY];
+    }
+}
 
-    filament::Box boundingBox = {{-planeSizeX, -planeSizeY, -0.1f}, {planeSizeX, planeSizeY, 0.1f}};
+/// A renderable over the occluder buffers, drawing the attached slots with the given bones
+- (void)buildRenderable:(Entity)entity
+               material:(MaterialInstance *)materialInstance
+               skinning:(SkinningBuffer *)skinningBuffer
+               priority:(uint8_t)priority {
+    const size_t slotIndexCount = vto::occluderSlotIndexCount(_occluderIndices.length / sizeof(uint16_t));
 
-    // Build left back plane renderable
-    RenderableManager::Builder(1)
-        .material(0, _occlusionMaterialInstance)
-        .geometry(0, RenderableManager::PrimitiveType::TRIANGLES,
-                  _backPlaneLeftVertexBuffer, _backPlaneIndexBuffer, 0, 6)
-        .boundingBox(boundingBox)
-        .culling(false)
-        .receiveShadows(false)
-        .castShadows(false)
-        .priority(0)
-        .build(*_engine, _backPlaneLeftEntity);
+    // Initial bounding box (updated every frame with the actual face mesh bounds)
+    filament::Box boundingBox = {{-0.2f, -0.2f, -0.2f}, {0.2f, 0.2f, 0.2f}};
 
-    // Build right back plane renderable
     RenderableManager::Builder(1)
-        .material(0, _occlusionMaterialInstance)
-        .geometry(0, RenderableManager::PrimitiveType::TRIANGLES,
-                  _backPlaneRightVertexBuffer, _backPlaneIndexBuffer, 0, 6)
+        .material(0, materialInstance)
+        .geometry(0, RenderableManager::PrimitiveType::TRIANGLES, _vertexBuffer,
+                  _indexBuffer, 0, slotIndexCount * _drawnFaceCount)
+        .skinning(skinningBuffer, vto::kOccluderBonesPerFace * _faceSlotCount, 0)
         .boundingBox(boundingBox)
         .culling(false)
         .receiveShadows(false)
         .castShadows(false)
-        .priority(0)
-        .build(*_engine, _backPlaneRightEntity);
-}
-
-- (void)setFaceMeshOcclusion:(BOOL)enabled {
-    // If face mesh is being disabled, remove from scene
-    if (_faceMeshEnabled && !enabled && _isVisible) {
-        _scene->remove(_faceMeshEntity);
-        _isVisible = NO;
-    }
-
-    _faceMeshEnabled = enabled;
-    NSLog(@"%@: Face mesh occlusion updated: %d", TAG, enabled);
-}
-
-- (void)setBackPlaneOcclusion:(BOOL)enabled {
-    // If back planes are being disabled, remove from scene
-    if (_backPlaneEnabled && !enabled) {
-        if (_backPlaneLeftVisible) {
-            _scene->remove(_backPlaneLeftEntity);
-            _backPlaneLeftVisible = NO;
-        }
-        if (_backPlaneRightVisible) {
-            _scene->remove(_backPlaneRightEntity);
-            _backPlaneRightVisible = NO;
-        }
-    }
-
-    _backPlaneEnabled = enabled;
-    NSLog(@"%@: Back plane occlusion updated: %d", TAG, enabled);
+        .priority(priority)
+        .build(*_engine, entity);
 }
 
-- (void)updateWithFace:(ARFaceAnchor *)face {
+- (void)updateWithFaces:(NSArray<ARFaceAnchor *> *)faces topology:(FaceTopology *)topology {
     if (!_isSetup || !_engine) return;
 
-    ARFaceGeometry *geometry = face.geometry;
-    NSUInteger vertexCount = geometry.vertexCount;
-    NSUInteger triangleCount = geometry.triangleCount;
-    NSUInteger indexCount = triangleCount * 3;
-
-    if (vertexCount > MAX_VERTICES || indexCount > MAX_INDICES) {
-        NSLog(@"%@: Face mesh too large: %lu vertices, %lu indices", TAG,
-              (unsigned long)vertexCount, (unsigned long)indexCount);
-        return;
+    if (topology != _topology) {
+        if (faces.count == 0) return;
+        [self decimateTopology:topology geometry:faces[0].geometry];
+        [self attachTopology:topology];
+        if (!_topology) return;
     }
-
-    // Copy vertex positions (already in face local space)
-    const simd_float3 *vertices = geometry.vertices;
-    for (NSUInteger i = 0; i < vertexCount; i++) {
-        _vertexData[i] = float3(vertices[i].x, vertices[i].y, vertices[i].z);
-    }
-
-    // Update vertex buffer
-    _vertexBuffer->setBufferAt(*_engine, 0,
-        VertexBuffer::BufferDescriptor(_vertexData, vertexCount * sizeof(float3), nullptr));
-
-    // Update index buffer only if index count changed
-    if (indexCount != _currentIndexCount) {
-        // Copy indices to persistent buffer (ARKit data may be deallocated before Filament uses it)
-        const int16_t *indices = geometry.triangleIndices;
-        memcpy(_indexData, indices, indexCount * sizeof(int16_t));
-        _indexBuffer->setBuffer(*_engine,
-            IndexBuffer::BufferDescriptor(_indexData, indexCount * sizeof(int16_t), nullptr));
-        _currentIndexCount = indexCount;
+    // With nothing to occlude, only the overlay still follows the faces
+    const BOOL occluding = _faceMeshEnabled || _backPlaneEnabled;
+    if (!occluding && !_overlayMaterialInstance) return;
+
+    const NSUInteger faceCount = MIN(faces.count, _faceSlotCount);
+    const uint32_t slotBytes = (uint32_t)(topology.vertexCount * sizeof(simd_float3));
+    vto::FaceMeshBounds worldBounds = {};
+
+    for (NSUInteger i = 0; i < faceCount; i++) {
+        ARFaceAnchor *face = faces[i];
+        ARFaceGeometry *geometry = face.geometry;
+
+        // Upload vertex positions (already in face local space) straight from ARKit into the slot.
+        // The geometry is retained in a ring slot until Filament's release callback fires.
+        [_vertexUploadRing uploadGeometry:geometry
+                           toVertexBuffer:_vertexBuffer
+                               byteOffset:(uint32_t)i * slotBytes
+                                   engine:_engine];
+
+        // Mesh bounds in face local space (min Z is furthest from camera, used for back planes)
+        vto::FaceMeshBounds bounds = vto::packFaceVertices((const float *)geometry.vertices,
+                                                           sizeof(simd_float3) / sizeof(float),
+                                                           topology.vertexCount,
+                                                           nullptr);
+        float minZ = bounds.min.z;
+
+        // The slot's face bone moves its vertices to the face position/rotation in world space
+        vto::Mat4 faceTransform = [MatrixUtils coreMatrixFromSimd:face.transform];
+        mat4f faceMatrix = [MatrixUtils filamentMatrixFromCore:faceTransform];
+        mat4f *bones = &_occluderBones[i * vto::kOccluderBonesPerFace];
+        mat4f *overlayBones = &_overlayBones[i * vto::kOccluderBonesPerFace];
+        bones[0] = _faceMeshEnabled ? faceMatrix : mat4f(0.0f);
+        overlayBones[0] = faceMatrix;
+        vto::FaceMeshBounds faceBounds = vto::transformBounds(faceTransform, bounds);
+        worldBounds = i == 0 ? faceBounds : vto::mergeBounds(worldBounds, faceBounds);
+
+        // Back planes sit behind the face; each side is hidden when its temple turns towards the
+        // camera (a zero bone collapses it), and in the occluder when back planes are disabled
+        vto::BackPlanePlacement placement = vto::placeBackPlanes(faceTransform, minZ, true);
+        mat4f backPlaneTransform = [MatrixUtils filamentMatrixFromCore:placement.transform];
+        overlayBones[1] = placement.showLeft ? backPlaneTransform : mat4f(0.0f);
+        overlayBones[2] = placement.showRight ? backPlaneTransform : mat4f(0.0f);
+        bones[1] = _backPlaneEnabled ? overlayBones[1] : mat4f(0.0f);
+        bones[2] = _backPlaneEnabled ? overlayBones[2] : mat4f(0.0f);
     }
 
-    // Update renderable geometry count
-    if (vertexCount != _currentVertexCount || indexCount != _currentIndexCount) {
-        RenderableManager &renderableManager = _engine->getRenderableManager();
-        RenderableManager::Instance instance = renderableManager.getInstance(_faceMeshEntity);
-        renderableManager.setGeometryAt(instance, 0,
-            RenderableManager::PrimitiveType::TRIANGLES,
-            _vertexBuffer, _indexBuffer,
-            0, (uint32_t)indexCount);
-        _currentVertexCount = vertexCount;
+    const size_t boneCount = vto::kOccluderBonesPerFace * faceCount;
+    if (occluding) {
+        _skinningBuffer->setBones(*_engine, _occluderBones, boneCount, 0);
     }
-
-    // Calculate min Z (furthest from camera in face local space)
-    float minZ = FLT_MAX;
-    for (NSUInteger i = 0; i < vertexCount; i++) {
-        if (vertices[i].z < minZ) {
-            minZ = vertices[i].z;
-        }
+    if (_overlayMaterialInstance) {
+        _overlaySkinningBuffer->setBones(*_engine, _overlayBones, boneCount, 0);
     }
 
-    // Update transform to match face position/rotation in world space
-    TransformManager &transformManager = _engine->getTransformManager();
-    TransformManager::Instance faceInstance = transformManager.getInstance(_faceMeshEntity);
-
-    // Convert ARKit transform to Filament matrix
-    mat4f filamentTransform;
-    for (int col = 0; col < 4; col++) {
-        for (int row = 0; row < 4; row++) {
-            filamentTransform[col][row] = face.transform.columns[col][row];
+    // Tight world-space bounding box around the faces instead of a fixed head-sized box
+    // (the renderables themselves keep an identity transform)
+    filament::Box meshBox;
+    meshBox.set(float3(worldBounds.min.x, worldBounds.min.y, worldBounds.min.z),
+                float3(worldBounds.max.x, worldBounds.max.y, worldBounds.max.z));
+
+    // Draw only the slots holding a face this frame
+    RenderableManager &renderableManager = _engine->getRenderableManager();
+    const bool rangeChanged = faceCount != _drawnFaceCount;
+    const size_t slotIndexCount = vto::occluderSlotIndexCount(_occluderIndices.length / sizeof(uint16_t));
+    for (Entity entity : {_faceMeshEntity, _overlayEntity}) {
+        if (entity == _overlayEntity && !_overlayMaterialInstance) continue;
+        RenderableManager::Instance instance = renderableManager.getInstance(entity);
+        if (rangeChanged) {
+            renderableManager.setGeometryAt(instance, 0, RenderableManager::PrimitiveType::TRIANGLES,
+                                            _vertexBuffer, _indexBuffer, 0, slotIndexCount * faceCount);
         }
+        renderableManager.setAxisAlignedBoundingBox(instance, meshBox);
     }
+    _drawnFaceCount = faceCount;
 
-    transformManager.setTransform(faceInstance, filamentTransform);
-
-    // Calculate back plane transform (behind the face)
-    mat4f backPlaneTransform = filamentTransform;
-    // Offset along local Z axis (minZ is behind the face in ARKit coords)
-    float3 localOffset(0.0f, 0.0f, minZ + 0.03f);
-    // Transform the offset by the rotation part of the face transform
-    float3 worldOffset(
-        filamentTransform[0][0] * localOffset.x + filamentTransform[1][0] * localOffset.y + filamentTransform[2][0] * localOffset.z,
-        filamentTransform[0][1] * localOffset.x + filamentTransform[1][1] * localOffset.y + filamentTransform[2][1] * localOffset.z,
-        filamentTransform[0][2] * localOffset.x + filamentTransform[1][2] * localOffset.y + filamentTransform[2][2] * localOffset.z
-    );
-    backPlaneTransform[3][0] += worldOffset.x;
-    backPlaneTransform[3][1] += worldOffset.y;
-    backPlaneTransform[3][2] += worldOffset.z;
-
-    // Position both back planes with the same transform
-    TransformManager::Instance backPlaneLeftInstance = transformManager.getInstance(_backPlaneLeftEntity);
-    TransformManager::Instance backPlaneRightInstance = transformManager.getInstance(_backPlaneRightEntity);
-    transformManager.setTransform(backPlaneLeftInstance, backPlaneTransform);
-    transformManager.setTransform(backPlaneRightInstance, backPlaneTransform);
-
-    // Extract yaw (Y-axis rotation) from face transform to determine head rotation
-    // Yaw = atan2(m[2][0], m[0][0]) for a rotation matrix
-    // Positive yaw = head turning left (user's perspective), negative = turning right
-    float yaw = atan2f(filamentTransform[2][0], filamentTransform[0][0]);
-
-    // Threshold for when to hide a back plane (about 15 degrees)
-    const float yawThreshold = 0.12f;  // ~7 degrees in radians
-
-    // Determine which back planes should be visible based on head rotation
-    // When turning right (negative yaw): left temple visible, hide left back plane
-    // When turning left (positive yaw): right temple visible, hide right back plane
-    BOOL showLeftBackPlane = _backPlaneEnabled && (yaw < yawThreshold);
-    BOOL showRightBackPlane = _backPlaneEnabled && (yaw > -yawThreshold);
-
-    // Add face mesh to scene if enabled and not already visible
-    if (_faceMeshEnabled && !_isVisible) {
+    // Add the occluder and overlay to the scene if not already there
+    if (occluding && !_isVisible && faceCount > 0) {
         _scene->addEntity(_faceMeshEntity);
         _isVisible = YES;
     }
-
-    // Update left back plane visibility
-    if (showLeftBackPlane && !_backPlaneLeftVisible) {
-        _scene->addEntity(_backPlaneLeftEntity);
-        _backPlaneLeftVisible = YES;
-    } else if (!showLeftBackPlane && _backPlaneLeftVisible) {
-        _scene->remove(_backPlaneLeftEntity);
-        _backPlaneLeftVisible = NO;
-    }
-
-    // Update right back plane visibility
-    if (showRightBackPlane && !_backPlaneRightVisible) {
-        _scene->addEntity(_backPlaneRightEntity);
-        _backPlaneRightVisible = YES;
-    } else if (!showRightBackPlane && _backPlaneRightVisible) {
-        _scene->remove(_backPlaneRightEntity);
-        _backPlaneRightVisible = NO;
+    if (_overlayMaterialInstance && !_isOverlayVisible && faceCount > 0) {
+        _scene->addEntity(_overlayEntity);
+        _isOverlayVisible = YES;
     }
 }
 
 - (void)hide {
     if (!_isSetup || !_engine) return;
 
-    // Remove from scene if visible
-    if (_isVisible) {
-        _scene->remove(_faceMeshEntity);
-        _isVisible = NO;
-    }
-
-    if (_backPlaneLeftVisible) {
-        _scene->remove(_backPlaneLeftEntity);
-        _backPlaneLeftVisible = NO;
-    }
-
-    if (_backPlaneRightVisible) {
-        _scene->remove(_backPlaneRightEntity);
-        _backPlaneRightVisible = NO;
-    }
+    [self removeFromScene];
 }
 
 - (void)destroy {
     if (!_engine || !_scene) return;
 
-    if (_isVisible) {
-        _scene->remove(_faceMeshEntity);
-    }
-    if (_backPlaneLeftVisible) {
-        _scene->remove(_backPlaneLeftEntity);
-    }
-    if (_backPlaneRightVisible) {
-        _scene->remove(_backPlaneRightEntity);
-    }
+    [self removeFromScene];
 
+    // Renderable components live in the shared engine, so destroy them with the entities
+    _engine->destroy(_faceMeshEntity);
+    _engine->destroy(_overlayEntity);
     EntityManager::get().destroy(_faceMeshEntity);
-    EntityManager::get().destroy(_backPlaneLeftEntity);
-    EntityManager::get().destroy(_backPlaneRightEntity);
+    EntityManager::get().destroy(_overlayEntity);
+    _overlayMaterialInstance = nullptr;
 
     if (_vertexBuffer) {
         _engine->destroy(_vertexBuffer);
@@ -460,17 +435,14 @@ static const size_t MAX_INDICES = 8000;
     if (_indexBuffer) {
         _engine->destroy(_indexBuffer);
     }
-    if (_backPlaneLeftVertexBuffer) {
-        _engine->destroy(_backPlaneLeftVertexBuffer);
-    }
-    if (_backPlaneRightVertexBuffer) {
-        _engine->destroy(_backPlaneRightVertexBuffer);
+    if (_skinningBuffer) {
+        _engine->destroy(_skinningBuffer);
     }
-    if (_backPlaneIndexBuffer) {
-        _engine->destroy(_backPlaneIndexBuffer);
+    if (_overlaySkinningBuffer) {
+        _engine->destroy(_overlaySkinningBuffer);
     }
-    if (_occlusionMaterial) {
-        _engine->destroy(_occlusionMaterial);
+    if (_occlusionMaterialInstance) {
+        _engine->destroy(_occlusionMaterialInstance);
     }
 
     _isSetup = NO;
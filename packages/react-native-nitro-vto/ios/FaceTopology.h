@@ -0,0 +1,43 @@
+#import <Foundation/Foundation.h>
+#import <ARKit/ARKit.h>
+
+namespace filament {
+    class Engine;
+    class IndexBuffer;
+}
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Immutable ARKit face mesh topology (triangle indices, UVs, vertex count).
+ * ARFaceGeometry topology is constant for a session, so it is built once from the
+ * first tracked face and shared by FaceOcclusionRenderer and DebugRenderer;
+ * each frame then only streams vertex positions.
+ */
+@interface FaceTopology : NSObject
+
+@property (nonatomic, readonly) NSUInteger vertexCount;
+@property (nonatomic, readonly) NSUInteger indexCount;
+
+/// Shared index buffer, uploaded once
+@property (nonatomic, readonly) filament::IndexBuffer *indexBuffer;
+
+/// Triangle indices (uint16_t per index), for renderers that batch several faces
+@property (nonatomic, readonly) NSData *triangleIndices;
+
+/// Per-vertex UVs (simd_float2 per vertex)
+@property (nonatomic, readonly) NSData *textureCoordinates;
+
+/// Build the topology from ARKit face geometry, or nil if the geometry is invalid
++ (nullable instancetype)topologyWithGeometry:(ARFaceGeometry *)geometry
+                                       engine:(filament::Engine *)engine;
+
+/// Whether the geometry still uses this topology
+- (BOOL)matchesGeometry:(ARFaceGeometry *)geometry;
+
+/// Destroy the index buffer (renderers must no longer reference it)
+- (void)destroy;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,90 @@
+#import "FaceTopology.h"
+
+#include <filament/Engine.h>
+#include <filament/IndexBuffer.h>
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace filament;
+
+static NSString *const TAG = @"FaceTopology";
+
+static void freeIndexData(void *buffer, size_t, void *) {
+    free(buffer);
+}
+
+@implementation FaceTopology {
+    Engine *_engine;
+}
+
++ (nullable instancetype)topologyWithGeometry:(ARFaceGeometry *)geometry engine:(Engine *)engine {
+    NSUInteger vertexCount = geometry.vertexCount;
+    NSUInteger indexCount = geometry.triangleCount * 3;
+
+    if (vertexCount == 0 || indexCount == 0 || vertexCount > UINT16_MAX) {
+        NSLog(@"%@: Invalid face mesh: %lu vertices, %lu indices", TAG,
+              (unsigned long)vertexCount, (unsigned long)indexCount);
+        return nil;
+    }
+
+    // Copy indices once (ARKit may recycle the geometry before Filament uploads it)
+    size_t indexBytes = indexCount * sizeof(int16_t);
+    NSData *triangleIndices = [NSData dataWithBytes:geometry.triangleIndices length:indexBytes];
+    void *indexData = malloc(indexBytes);
+    if (!indexData) {
+        NSLog(@"%@: Failed to allocate %zu bytes of index data", TAG, indexBytes);
+        return nil;
+    }
+    memcpy(indexData, triangleIndices.bytes, indexBytes);
+
+    IndexBuffer *indexBuffer = IndexBuffer::Builder()
+        .indexCount((uint32_t)indexCount)
+        .bufferType(IndexBuffer::IndexType::USHORT)
+        .build(*engine);
+    indexBuffer->setBuffer(*engine, IndexBuffer::BufferDescriptor(indexData, indexBytes, freeIndexData));
+
+    NSData *textureCoordinates = [NSData dataWithBytes:geometry.textureCoordinates
+                                                length:geometry.textureCoordinateCount * sizeof(simd_float2)];
+
+    NSLog(@"%@: Face topology cached: %lu vertices, %lu indices", TAG,
+          (unsigned long)vertexCount, (unsigned long)indexCount);
+    return [[self alloc] initWithEngine:engine
+                            vertexCount:vertexCount
+                             indexCount:indexCount
+                            indexBuffer:indexBuffer
+                        triangleIndices:triangleIndices
+                     textureCoordinates:textureCoordinates];
+}
+
+- (instancetype)initWithEngine:(Engine *)engine
+                   vertexCount:(NSUInteger)vertexCount
+                    indexCount:(NSUInteger)indexCount
+                   indexBuffer:(IndexBuffer *)indexBuffer
+               triangleIndices:(NSData *)triangleIndices
+            textureCoordinates:(NSData *)textureCoordinates {
+    self = [super init];
+    if (self) {
+        _engine = engine;
+        _vertexCount = vertexCount;
+        _indexCount = indexCount;
+        _indexBuffer = indexBuffer;
+        _triangleIndices = triangleIndices;
+        _textureCoordinates = textureCoordinates;
+    }
+    return self;
+}
+
+- (BOOL)matchesGeometry:(ARFaceGeometry *)geometry {
+    return geometry.vertexCount == _vertexCount && geometry.triangleCount * 3 == _indexCount;
+}
+
+- (void)destroy {
+    if (_engine && _indexBuffer) {
+        _engine->destroy(_indexBuffer);
+    }
+    _indexBuffer = nullptr;
+    _engine = nullptr;
+}
+
+@end
@@ -1,36 +1,80 @@
 #import <Foundation/Foundation.h>
 #import <ARKit/ARKit.h>
+#import "VTORendererBridge.h"
 
 namespace filament {
     class Engine;
     class Scene;
 }
 
+@class VTORenderThread;
+@class VTOFilamentContext;
+
 NS_ASSUME_NONNULL_BEGIN
 
 /**
  * Renderer for glasses model with face tracking transform.
  * Handles GLTF loading and world-space positioning based on ARKit face mesh.
+ * Each tracked face gets a slot with its own instance of the loaded asset (geometry and textures
+ * are shared) and its own pose filter and level of detail.
  */
 @interface GlassesRenderer : NSObject
 
-/// Callback for when model loading completes
+/// Callback for when model loading completes (called on the render thread, or main if none is set)
 @property (nonatomic, copy, nullable) void (^onModelLoaded)(NSString *url);
 
-/// Setup the glasses renderer with Filament engine and scene
-- (void)setupWithEngine:(filament::Engine *)engine
-                  scene:(filament::Scene *)scene
-               modelUrl:(NSString *)modelUrl;
+/// Callback for model decode progress in [0, 1] (called on the render thread, or main if none is set)
+@property (nonatomic, copy, nullable) void (^onModelLoadProgress)(NSString *url, double progress);
+
+/// Thread that owns the Filament engine; download completions are delivered on it
+@property (nonatomic, strong, nullable) VTORenderThread *renderThread;
+
+/// Setup the glasses renderer with the shared Filament context (engine, ubershader materials) and scene
+- (void)setupWithContext:(VTOFilamentContext *)context
+                   scene:(filament::Scene *)scene
+                modelUrl:(NSString *)modelUrl;
 
-/// Update glasses transform based on detected face
-- (void)updateTransformWithFace:(ARFaceAnchor *)face frame:(ARFrame *)frame;
+/// Advance an in-flight model load by one step; call once per frame on the render thread.
+/// Geometry is shown as soon as the asset is created, textures stream in over later frames.
+/// Returns whether a load is in flight (so the frame has new texture data to show).
+- (BOOL)updateLoading;
 
-/// Hide glasses by moving off-screen
+/// Update glasses transforms based on the detected faces (at most maxFaces are fitted), extrapolated
+/// predictionSeconds past the camera frame to when it reaches the display
+- (void)updateTransformWithFaces:(NSArray<ARFaceAnchor *> *)faces
+                           frame:(ARFrame *)frame
+               predictionSeconds:(double)predictionSeconds;
+
+/// Number of face slots, clamped to [1, kMaxTrackedFaces] (default 1). Raising it reloads
+/// pooled models that were created with fewer instances.
+- (void)setMaxFaces:(NSUInteger)maxFaces;
+
+/// Remove the glasses from the scene until the next tracked face
 - (void)hide;
 
-/// Switch to a different glasses model
+/// Switch to a different glasses model (instant when it is already in the pool)
 - (void)switchModelWithUrl:(NSString *)modelUrl;
 
+/// Download and decode models into the warm asset pool without showing them
+- (void)prefetchModelsWithUrls:(NSArray<NSString *> *)urls;
+
+/// Byte budget of the warm asset pool (GLB size); least recently used models are evicted past it
+@property (nonatomic, assign) NSUInteger poolByteLimit;
+
+/// Keep these models loaded side by side (downloaded and decoded ahead, never evicted) for
+/// setActiveModel:. An empty array returns them to the pool's budget.
+- (void)setCompareModelsWithUrls:(NSArray<NSString *> *)urls;
+
+/// Show the compare model at index. Once it is loaded this only changes which instances are in
+/// the scene, and the glasses keep their pose.
+- (void)setActiveModel:(NSUInteger)index;
+
+/// Estimated memory of the pooled models. Any thread.
+- (VTOModelMemoryStats)memoryStats;
+
+/// Device class biasing level of detail and memory budgets: 0 = low, 1 = mid, 2 = high. Any thread.
++ (NSInteger)deviceTierLevel;
+
 /// Set forward offset for glasses positioning (in meters)
 - (void)setForwardOffset:(float)offset;
 
@@ -1,7 +1,8 @@
 #import "GlassesRenderer.h"
-#import "LoaderUtils.h"
-#import "KalmanFilter.h"
 #import "MatrixUtils.h"
+#import "ModelDownloader.h"
+#import "VTORenderThread.h"
+#import "VTOFilamentContext.h"
 
 #include <filament/Engine.h>
 #include <filament/Scene.h>
@@ -10,18 +11,58 @@
 #include <gltfio/ResourceLoader.h>
 #include <gltfio/MaterialProvider.h>
 #include <gltfio/TextureProvider.h>
-#include <gltfio/materials/uberarchive.h>
 #include <gltfio/FilamentAsset.h>
+#include <gltfio/FilamentInstance.h>
+#include <filament/MaterialInstance.h>
+#include <filament/RenderableManager.h>
 #include <utils/EntityManager.h>
 
+#include "FaceMesh.hpp"
+#include "GlassesPose.hpp"
+#include "ModelLod.hpp"
+#include "ModelMemory.hpp"
+
+#include <atomic>
+#include <map>
+#include <vector>
+
+#include <sys/mman.h>
+
 using namespace filament;
 using namespace filament::gltfio;
 using namespace utils;
 
 static NSString *const TAG = @"GlassesRenderer";
 
+// Budget for warm models kept in the pool, measured in GLB bytes (a proxy for GPU memory)
+static const NSUInteger DEFAULT_POOL_BYTE_LIMIT = 64 * 1024 * 1024;
+
+/// Renderables of each level of detail of one glasses instance (0 = full detail); empty when the model has none
+using LodLevels = std::vector<std::vector<Entity>>;
+
+/// A created asset kept in the pool, shown or not. One instance per face slot, all sharing the
+/// asset's geometry, textures and materials.
+@interface GlassesPoolEntry : NSObject {
+@public
+    /// Levels of detail of each instance
+    std::vector<LodLevels> instanceLods;
+}
+@property (nonatomic, copy) NSString *url;
+@property (nonatomic, assign) FilamentAsset *asset;
+@property (nonatomic, assign) NSUInteger instanceCount;
+@property (nonatomic, assign) NSUInteger byteSize;
+/// Estimated vertex, index and texture bytes on the GPU (shared by every instance)
+@property (nonatomic, assign) uint64_t gpuBytes;
+/// All resources decoded and source data released
+@property (nonatomic, assign) BOOL decoded;
+@end
+
+@implementation GlassesPoolEntry
+@end
+
 @interface GlassesRenderer ()
 
+@property (nonatomic, weak) VTOFilamentContext *filamentContext;
 @property (nonatomic, assign) Engine *engine;
 @property (nonatomic, assign) Scene *scene;
 @property (nonatomic, assign) AssetLoader *assetLoader;
@@ -29,48 +70,107 @@ static NSString *const TAG = @"GlassesRenderer";
 @property (nonatomic, assign) FilamentAsset *glassesAsset;
 @property (nonatomic, assign) MaterialProvider *materialProvider;
 @property (nonatomic, assign) TextureProvider *textureProvider;
+@property (nonatomic, assign) TextureProvider *ktx2Provider;
 
 // Thread management
 @property (nonatomic, strong) dispatch_queue_t loadQueue;
 
-// Loading state
-@property (nonatomic, assign) BOOL isLoading;
+// Warm asset pool, keyed by URL; lruOrder lists URLs from least to most recently used
+@property (nonatomic, strong) NSMutableDictionary<NSString *, GlassesPoolEntry *> *pool;
+@property (nonatomic, strong) NSMutableArray<NSString *> *lruOrder;
+@property (nonatomic, assign) NSUInteger poolBytes;
+
+// Loading state: downloads in flight, and assets waiting for the (single) async resource load
+@property (nonatomic, strong) NSMutableDictionary<NSString *, ModelDownloadToken *> *pendingDownloads;
+// URLs asked for by prefetchModels, whose downloads survive switching away from them
+@property (nonatomic, strong) NSMutableSet<NSString *> *prefetchedUrls;
+@property (nonatomic, strong) NSMutableArray<NSString *> *decodeQueue;
+@property (nonatomic, strong, nullable) GlassesPoolEntry *decodingEntry;
+@property (nonatomic, assign) double lastReportedProgress;
 
 // Current model info
 @property (nonatomic, copy) NSString *currentModelUrl;
-
-// Kalman filters for smoothing
-@property (nonatomic, strong) KalmanFilter3D *positionFilter;
-@property (nonatomic, strong) KalmanFilterQuaternion *rotationFilter;
-
-// Forward offset for glasses positioning (in meters)
-@property (nonatomic, assign) float forwardOffset;
+@property (nonatomic, strong, nullable) GlassesPoolEntry *shownEntry;
+// Faces fitted with glasses at once; new assets get one instance per slot
+@property (nonatomic, assign) NSUInteger faceSlotCount;
+// Models kept loaded for setActiveModel: downloaded ahead, decoded ahead, never evicted
+@property (nonatomic, copy) NSArray<NSString *> *compareUrls;
 
 @end
 
-@implementation GlassesRenderer
+namespace {
+
+/// Glasses of one tracked face: an instance of the shown asset and the face's filter state
+struct GlassesFaceSlot {
+    // Nose bridge anchoring, pose filtering and prediction, forward offset (shared C++ core)
+    vto::GlassesPoseSolver poseSolver;
+    // Level of detail from face distance, biased by the device tier (shared C++ core)
+    vto::LodSelector lodSelector;
+    int shownLod = -1;
+    // Whether the slot's instance entities are in the scene (only while its face is tracked)
+    bool visible = false;
+    // Anchor of the face the slot follows, so each face keeps its own filter history
+    NSUUID *faceId = nil;
+};
+
+} // namespace
+
+@implementation GlassesRenderer {
+    std::vector<GlassesFaceSlot> _faceSlots;
+    // Pool totals, published by the render thread for memoryStats on any thread
+    std::atomic<NSUInteger> _statsModelCount;
+    std::atomic<NSUInteger> _statsCompareModelCount;
+    std::atomic<uint64_t> _statsGpuBytes;
+    std::atomic<uint64_t> _statsCpuBytes;
+}
 
 - (instancetype)init {
     self = [super init];
     if (self) {
-        _loadQueue = dispatch_queue_create("com.nitrovto.glassesloader", DISPATCH_QUEUE_SERIAL);
-        _isLoading = NO;
-        _positionFilter = [[KalmanFilter3D alloc] initWithProcessNoise:0.1f measurementNoise:0.05f];
-        _rotationFilter = [[KalmanFilterQuaternion alloc] initWithProcessNoise:0.1f measurementNoise:0.05f];
-        _forwardOffset = 0.005f; // Default: 5mm forward
+        // Concurrent, so reading one cached model never holds up another
+        _loadQueue = dispatch_queue_create("com.nitrovto.glassesloader", DISPATCH_QUEUE_CONCURRENT);
+        _pool = [NSMutableDictionary dictionary];
+        _lruOrder = [NSMutableArray array];
+        _pendingDownloads = [NSMutableDictionary dictionary];
+        _prefetchedUrls = [NSMutableSet set];
+        _decodeQueue = [NSMutableArray array];
+        _poolByteLimit = DEFAULT_POOL_BYTE_LIMIT;
+        _faceSlotCount = 1;
+        _compareUrls = @[];
+        _statsModelCount = 0;
+        _statsCompareModelCount = 0;
+        _statsGpuBytes = 0;
+        _statsCpuBytes = 0;
+        vto::DeviceTier deviceTier = [GlassesRenderer deviceTier];
+        _faceSlots.resize(vto::kMaxTrackedFaces);
+        for (GlassesFaceSlot &slot : _faceSlots) {
+            slot.poseSolver = vto::GlassesPoseSolver(vto::kARKitNoseBridge);
+            slot.lodSelector.setDeviceTier(deviceTier);
+        }
     }
     return self;
 }
 
-- (void)setupWithEngine:(Engine *)engine
-                  scene:(Scene *)scene
-               modelUrl:(NSString *)modelUrl {
++ (vto::DeviceTier)deviceTier {
+    NSProcessInfo *processInfo = [NSProcessInfo processInfo];
+    return vto::classifyDeviceTier(processInfo.physicalMemory, (int)processInfo.activeProcessorCount, false);
+}
+
++ (NSInteger)deviceTierLevel {
+    return (NSInteger)[self deviceTier];
+}
+
+- (void)setupWithContext:(VTOFilamentContext *)context
+                   scene:(Scene *)scene
+                modelUrl:(NSString *)modelUrl {
+    Engine *engine = context.engine;
+    _filamentContext = context;
     _engine = engine;
     _scene = scene;
     _currentModelUrl = modelUrl;
 
-    // Setup GLTF loader
-    _materialProvider = createUbershaderProvider(engine, UBERARCHIVE_DEFAULT_DATA, UBERARCHIVE_DEFAULT_SIZE);
+    // Setup GLTF loader on the shared ubershader provider, so its materials are built once per process
+    _materialProvider = context.materialProvider;
     _assetLoader = AssetLoader::create({
         .engine = engine,
         .materials = _materialProvider,
@@ -79,206 +179,562 @@ static NSString *const TAG = @"GlassesRenderer";
     });
     _resourceLoader = new ResourceLoader({engine, ".", true});
 
-    // Create texture provider for PNG/JPEG decoding using stb_image
+    // PNG/JPEG are decoded with stb_image; KTX2 (KHR_texture_basisu) is transcoded to a GPU
+    // compressed format the device supports (ASTC, else ETC2). Meshopt-compressed buffers
+    // (EXT_meshopt_compression) are decoded by the ResourceLoader itself.
     _textureProvider = createStbProvider(engine);
+    _ktx2Provider = createKtx2Provider(engine);
     _resourceLoader->addTextureProvider("image/png", _textureProvider);
     _resourceLoader->addTextureProvider("image/jpeg", _textureProvider);
+    _resourceLoader->addTextureProvider("image/ktx2", _ktx2Provider);
 
     // Load model
-    [self loadModelFromUrl:modelUrl];
+    [self showModelWithUrl:modelUrl];
 }
 
-- (void)loadModelFromUrl:(NSString *)url {
+#pragma mark - Loading
+
+/// Show the model as soon as it is available: instantly when pooled, otherwise once downloaded
+- (void)showModelWithUrl:(NSString *)url {
     if (url.length == 0) {
         NSLog(@"%@: Empty URL, skipping model load", TAG);
         return;
     }
 
-    if (_isLoading) {
-        NSLog(@"%@: Already loading a model, skipping request for: %@", TAG, url);
+    GlassesPoolEntry *entry = _pool[url];
+    if (entry) {
+        [self activateEntry:entry keepPose:NO];
         return;
     }
 
-    _isLoading = YES;
+    // Not pooled yet: download it (no-op if a prefetch is already in flight), shown when it lands
+    [self downloadModelFromUrl:url];
+}
+
+- (void)prefetchModelsWithUrls:(NSArray<NSString *> *)urls {
+    for (NSString *url in urls) {
+        if (url.length == 0 || _pool[url]) continue;
+        [_prefetchedUrls addObject:url];
+        [self downloadModelFromUrl:url];
+    }
+}
+
+- (void)downloadModelFromUrl:(NSString *)url {
+    if (_pendingDownloads[url]) return;
+
     NSLog(@"%@: Starting download from URL: %@", TAG, url);
 
     __weak __typeof__(self) weakSelf = self;
-    dispatch_async(_loadQueue, ^{
-        __strong __typeof__(weakSelf) strongSelf = weakSelf;
-        if (!strongSelf) return;
-
-        NSError *error = nil;
-        NSData *modelData = [LoaderUtils loadFromUrl:url error:&error];
-
-        dispatch_async(dispatch_get_main_queue(), ^{
-            if (error) {
-                NSLog(@"%@: Failed to download GLB from URL: %@", TAG, error.localizedDescription);
-                strongSelf.isLoading = NO;
-                return;
+    dispatch_queue_t loadQueue = _loadQueue;
+    _pendingDownloads[url] = [[ModelDownloader sharedDownloader] downloadUrl:url
+                                                                  completion:^(NSURL *fileUrl, NSError *downloadError) {
+        dispatch_async(loadQueue, ^{
+            // Map the cached file rather than reading it onto the heap. createAsset copies what it
+            // needs, so the mapping only lives until then; prefault it here, off the render thread.
+            NSError *error = downloadError;
+            NSData *modelData = fileUrl ? [NSData dataWithContentsOfURL:fileUrl
+                                                                options:NSDataReadingMappedAlways
+                                                                  error:&error] : nil;
+            if (modelData.length > 0) {
+                madvise((void *)modelData.bytes, modelData.length, MADV_WILLNEED);
             }
 
-            [strongSelf loadModelFromData:modelData];
-
-            if (strongSelf.onModelLoaded) {
-                strongSelf.onModelLoaded(url);
+            // Filament objects must be created on the thread that owns the engine
+            dispatch_block_t completion = ^{
+                __strong __typeof__(weakSelf) strongSelf = weakSelf;
+                if (!strongSelf) return;
+
+                [strongSelf.pendingDownloads removeObjectForKey:url];
+                [strongSelf.prefetchedUrls removeObject:url];
+                if (!modelData) {
+                    NSLog(@"%@: Failed to download GLB from URL: %@", TAG, error.localizedDescription);
+                    return;
+                }
+
+                [strongSelf addModelData:modelData forUrl:url];
+            };
+
+            __strong __typeof__(weakSelf) strongSelf = weakSelf;
+            if (strongSelf.renderThread) {
+                [strongSelf.renderThread performAsync:completion];
+            } else {
+                dispatch_async(dispatch_get_main_queue(), completion);
             }
-            strongSelf.isLoading = NO;
         });
-    });
+    }];
+}
+
+/// Stop downloading a model nobody is waiting for any more; its partial file is kept for resuming
+- (void)cancelDownloadForUrl:(NSString *)url {
+    if ([_prefetchedUrls containsObject:url] || [_compareUrls containsObject:url]) return;
+
+    ModelDownloadToken *token = _pendingDownloads[url];
+    if (!token) return;
+    [token cancel];
+    [_pendingDownloads removeObjectForKey:url];
 }
 
-- (void)loadModelFromData:(NSData *)data {
+/// Create the asset for downloaded GLB data, pool it, and show it if it is the current model
+- (void)addModelData:(NSData *)data forUrl:(NSString *)url {
     if (!_assetLoader || !_resourceLoader || !_scene) return;
+    if (_pool[url]) return;
 
-    _glassesAsset = _assetLoader->createAsset((const uint8_t *)data.bytes, (uint32_t)data.length);
+    // One instance per face slot: geometry and textures are loaded once and shared
+    std::vector<FilamentInstance *> instances(_faceSlotCount);
+    FilamentAsset *asset = _assetLoader->createInstancedAsset((const uint8_t *)data.bytes, (uint32_t)data.length,
+                                                             instances.data(), instances.size());
+    if (!asset) {
+        NSLog(@"%@: Failed to create glasses asset", TAG);
+        return;
+    }
+
+    // Filament doesn't report buffer or texture sizes: estimate them from the GLB (shared C++ core)
+    vto::ModelMemoryEstimate memory;
+    if (!vto::estimateModelMemory((const uint8_t *)data.bytes, data.length, memory)) {
+        NSLog(@"%@: Couldn't estimate the memory of %@", TAG, url);
+    }
 
-    if (_glassesAsset) {
-        _resourceLoader->loadResources(_glassesAsset);
-        _glassesAsset->releaseSourceData();
+    GlassesPoolEntry *entry = [[GlassesPoolEntry alloc] init];
+    entry.url = url;
+    entry.asset = asset;
+    entry.instanceCount = asset->getAssetInstanceCount();
+    entry.byteSize = data.length;
+    entry.gpuBytes = memory.gpuBytes();
+    _pool[url] = entry;
+    [_lruOrder addObject:url];
+    _poolBytes += entry.byteSize;
+    [_decodeQueue addObject:url];
+    [self collectLodLevelsOfEntry:entry];
+    NSLog(@"%@: Glasses model created: %lu instances of %zu entities, %zu LODs, ~%llu KB on the GPU, decoding resources",
+          TAG, (unsigned long)entry.instanceCount, asset->getAssetInstances()[0]->getEntityCount(),
+          entry->instanceLods[0].size(), entry.gpuBytes / 1024);
+
+    // Compile the model's uber shader variants now (instances share their materials), while the camera preview runs without a face
+    FilamentInstance *instance = asset->getInstance();
+    MaterialInstance *const *materialInstances = instance->getMaterialInstances();
+    for (size_t i = 0; i < instance->getMaterialInstanceCount(); i++) {
+        [_filamentContext compileMaterial:const_cast<Material *>(materialInstances[i]->getMaterial())];
+    }
 
-        // Add all entities to scene
-        const Entity *entities = _glassesAsset->getEntities();
-        size_t entityCount = _glassesAsset->getEntityCount();
-        for (size_t i = 0; i < entityCount; i++) {
-            _scene->addEntity(entities[i]);
-        }
+    if ([url isEqualToString:_currentModelUrl]) {
+        [self activateEntry:entry keepPose:NO];
+    }
+    [self evictToBudget];
+    [self publishMemoryStats];
+    [self updateLoading];
+}
 
-        NSLog(@"%@: Glasses model loaded: %zu entities", TAG, entityCount);
+/// Put a pooled model in the scene, replacing whatever was shown. With keepPose the face slots
+/// keep their faces and filters, so the new model appears exactly where the old one was.
+- (void)activateEntry:(GlassesPoolEntry *)entry keepPose:(BOOL)keepPose {
+    [self removeShownAssetFromScene];
+
+    // Mark most recently used
+    [_lruOrder removeObject:entry.url];
+    [_lruOrder addObject:entry.url];
+
+    // Enters the scene with the next tracked face; geometry renders with default material params
+    // until textures land
+    _glassesAsset = entry.asset;
+    _shownEntry = entry;
+    for (GlassesFaceSlot &slot : _faceSlots) {
+        slot.lodSelector.setLevelCount((int)entry->instanceLods[0].size());
+        slot.shownLod = slot.lodSelector.level();
+    }
+    if (!keepPose) {
         [self hide];
-    } else {
-        NSLog(@"%@: Failed to create glasses asset", TAG);
     }
+
+    if (entry.decoded) {
+        if (self.onModelLoaded) {
+            self.onModelLoaded(entry.url);
+        }
+        return;
+    }
+
+    // Decode the visible model before any prefetched ones
+    [_decodeQueue removeObject:entry.url];
+    [_decodeQueue insertObject:entry.url atIndex:0];
+    _lastReportedProgress = -1.0;
 }
 
-- (void)updateTransformWithFace:(ARFaceAnchor *)face frame:(ARFrame *)frame {
-    if (!_glassesAsset || !_engine) return;
+- (void)removeShownAssetFromScene {
+    if (!_glassesAsset) return;
+
+    // Entities only: the slots keep their faces and filters for whatever is shown next
+    for (NSUInteger s = 0; s < _faceSlots.size(); s++) {
+        [self removeSlotFromScene:s];
+    }
+    _glassesAsset = nullptr;
+    _shownEntry = nil;
+    for (GlassesFaceSlot &slot : _faceSlots) {
+        slot.shownLod = -1;
+    }
+}
+
+#pragma mark - Level of Detail
 
+/// Group each instance's renderables by the _LOD<n> suffix on their node or its closest tagged ancestor.
+/// Levels are renumbered in order (LOD0, LOD2 -> 0, 1); untagged renderables show at every level.
+- (void)collectLodLevelsOfEntry:(GlassesPoolEntry *)entry {
+    FilamentAsset *asset = entry.asset;
     TransformManager &transformManager = _engine->getTransformManager();
-    TransformManager::Instance instance = transformManager.getInstance(_glassesAsset->getRoot());
+    RenderableManager &renderableManager = _engine->getRenderableManager();
+
+    entry->instanceLods.assign(entry.instanceCount, LodLevels());
+    for (NSUInteger index = 0; index < entry.instanceCount; index++) {
+        FilamentInstance *instance = asset->getAssetInstances()[index];
+        std::map<int, std::vector<Entity>> byLevel;
+
+        const Entity *entities = instance->getEntities();
+        for (size_t i = 0; i < instance->getEntityCount(); i++) {
+            if (!renderableManager.hasComponent(entities[i])) continue;
+            Entity node = entities[i];
+            int level = -1;
+            while (!node.isNull() && level < 0) {
+                level = vto::lodLevelFromName(asset->getName(node));
+                if (node == instance->getRoot()) break;
+                TransformManager::Instance transform = transformManager.getInstance(node);
+                node = transform ? transformManager.getParent(transform) : Entity();
+            }
+            if (level >= 0) byLevel[level].push_back(entities[i]);
+        }
+
+        // A single tagged level is no choice at all
+        if (byLevel.size() < 2) continue;
+        for (auto &level : byLevel) {
+            entry->instanceLods[index].push_back(std::move(level.second));
+        }
+    }
+}
+
+/// Keep only the given level's renderables of the slot's instance of the shown model in the scene
+- (void)showLod:(int)level inSlot:(NSUInteger)slotIndex {
+    GlassesFaceSlot &slot = _faceSlots[slotIndex];
+    slot.shownLod = level;
+    GlassesPoolEntry *entry = _shownEntry;
+    if (!entry || slotIndex >= entry.instanceCount || !slot.visible) return;
+
+    const LodLevels &lodLevels = entry->instanceLods[slotIndex];
+    for (size_t i = 0; i < lodLevels.size(); i++) {
+        const std::vector<Entity> &entities = lodLevels[i];
+        if ((int)i == level) {
+            _scene->addEntities(entities.data(), entities.size());
+        } else {
+            _scene->removeEntities(entities.data(), entities.size());
+        }
+    }
+}
+
+- (BOOL)updateLoading {
+    if (!_resourceLoader) return NO;
+
+    // ResourceLoader decodes one asset at a time: start the next queued one
+    if (!_decodingEntry) {
+        while (_decodeQueue.count > 0 && !_decodingEntry) {
+            NSString *url = _decodeQueue.firstObject;
+            [_decodeQueue removeObjectAtIndex:0];
+            GlassesPoolEntry *entry = _pool[url];
+            if (!entry) continue;
+
+            // Upload geometry now and decode textures across frames, so the render thread never stalls
+            if (_resourceLoader->asyncBeginLoad(entry.asset)) {
+                _decodingEntry = entry;
+            } else {
+                NSLog(@"%@: Failed to begin loading glasses resources: %@", TAG, url);
+                [self destroyEntry:entry];
+            }
+        }
+        if (!_decodingEntry) return NO;
+    }
 
-    // Get nose bridge position in world space
-    simd_float3 noseBridgeWorld = [self getNoseBridgeWorldPosWithFace:face];
+    _resourceLoader->asyncUpdateLoad();
+    double progress = _resourceLoader->asyncGetLoadProgress();
 
-    // Get face rotation from transform (world space)
-    simd_quatf faceRotationWorld = simd_quaternion(face.transform);
+    GlassesPoolEntry *entry = _decodingEntry;
+    BOOL isCurrent = entry.asset == _glassesAsset;
+    if (isCurrent && progress != _lastReportedProgress) {
+        _lastReportedProgress = progress;
+        if (self.onModelLoadProgress) {
+            self.onModelLoadProgress(entry.url, progress);
+        }
+    }
 
-    // Apply Kalman filter smoothing
-    simd_float3 smoothedPosition = [_positionFilter updateWithX:noseBridgeWorld.x y:noseBridgeWorld.y z:noseBridgeWorld.z];
-    simd_quatf smoothedRotation = [_rotationFilter updateWithQuaternion:faceRotationWorld];
+    if (progress < 1.0) return YES;
 
-    // Build world-space transform matrix (no scaling - models are in real-world meters)
-    simd_float4x4 rotationMatrix = [MatrixUtils quaternionToMatrix:smoothedRotation];
+    _decodingEntry = nil;
+    entry.decoded = YES;
+    entry.asset->releaseSourceData();
+    NSLog(@"%@: Glasses model loaded: %@", TAG, entry.url);
 
-    // Offset glasses along face's Z axis (forward/backward)
-    simd_float3 forward = simd_make_float3(rotationMatrix.columns[2].x,
-                                            rotationMatrix.columns[2].y,
-                                            rotationMatrix.columns[2].z);
+    [self publishMemoryStats];
 
-    // Set world-space position with forward offset
-    rotationMatrix.columns[3].x = smoothedPosition.x + forward.x * _forwardOffset;
-    rotationMatrix.columns[3].y = smoothedPosition.y + forward.y * _forwardOffset;
-    rotationMatrix.columns[3].z = smoothedPosition.z + forward.z * _forwardOffset;
+    if (isCurrent && self.onModelLoaded) {
+        self.onModelLoaded(entry.url);
+    }
+    return YES;
+}
 
-    // Convert simd matrix to filament matrix
-    filament::math::mat4f filamentTransform;
-    for (int col = 0; col < 4; col++) {
-        for (int row = 0; row < 4; row++) {
-            filamentTransform[col][row] = rotationMatrix.columns[col][row];
+/// Drop least recently used models until the pool fits its budget; the shown model and the compare
+/// models are never evicted
+- (void)evictToBudget {
+    NSUInteger index = 0;
+    while (_poolBytes > _poolByteLimit && index < _lruOrder.count) {
+        GlassesPoolEntry *entry = _pool[_lruOrder[index]];
+        if (entry.asset == _glassesAsset || [_compareUrls containsObject:entry.url]) {
+            index++;
+            continue;
         }
+        NSLog(@"%@: Evicting pooled model: %@", TAG, entry.url);
+        [self destroyEntry:entry];
+    }
+}
+
+- (void)destroyEntry:(GlassesPoolEntry *)entry {
+    // Stop decoding before the asset's textures and buffers go away
+    if (entry == _decodingEntry) {
+        _resourceLoader->asyncCancelLoad();
+        _decodingEntry = nil;
     }
+    if (entry.asset == _glassesAsset) {
+        [self removeShownAssetFromScene];
+    }
+
+    [_pool removeObjectForKey:entry.url];
+    [_lruOrder removeObject:entry.url];
+    [_decodeQueue removeObject:entry.url];
+    _poolBytes -= entry.byteSize;
 
-    transformManager.setTransform(instance, filamentTransform);
+    _assetLoader->destroyAsset(entry.asset);
+    entry.asset = nullptr;
+    [self publishMemoryStats];
 }
 
-- (simd_float3)getNoseBridgeWorldPosWithFace:(ARFaceAnchor *)face {
-    // ARKit face mesh vertex indices for nose bridge
-    // Reference: https://www.oxfordechoes.com/ios-arkit-face-tracking-vertices/
-    const int leftIndex = 818;  // Left side of nose bridge
-    const int rightIndex = 366; // Right side of nose bridge
+/// Refresh the totals memoryStats reports (render thread, whenever the pool changes)
+- (void)publishMemoryStats {
+    NSUInteger compareModelCount = 0;
+    uint64_t gpuBytes = 0;
+    uint64_t cpuBytes = 0;
+    for (GlassesPoolEntry *entry in _pool.objectEnumerator) {
+        gpuBytes += entry.gpuBytes;
+        // The asset holds on to its GLB until releaseSourceData, once its textures are decoded
+        if (!entry.decoded) cpuBytes += entry.byteSize;
+        if ([_compareUrls containsObject:entry.url]) compareModelCount++;
+    }
+    _statsModelCount.store(_pool.count, std::memory_order_relaxed);
+    _statsCompareModelCount.store(compareModelCount, std::memory_order_relaxed);
+    _statsGpuBytes.store(gpuBytes, std::memory_order_relaxed);
+    _statsCpuBytes.store(cpuBytes, std::memory_order_relaxed);
+}
 
-    ARFaceGeometry *geometry = face.geometry;
-    const simd_float3 *vertices = geometry.vertices;
-    NSUInteger vertexCount = geometry.vertexCount;
+- (VTOModelMemoryStats)memoryStats {
+    VTOModelMemoryStats stats;
+    stats.modelCount = _statsModelCount.load(std::memory_order_relaxed);
+    stats.compareModelCount = _statsCompareModelCount.load(std::memory_order_relaxed);
+    stats.gpuBytes = _statsGpuBytes.load(std::memory_order_relaxed);
+    stats.cpuBytes = _statsCpuBytes.load(std::memory_order_relaxed);
+    stats.deviceTier = [GlassesRenderer deviceTierLevel];
+    return stats;
+}
+
+#pragma mark - Transform
+
+- (void)updateTransformWithFaces:(NSArray<ARFaceAnchor *> *)faces
+                           frame:(ARFrame *)frame
+               predictionSeconds:(double)predictionSeconds {
+    if (!_glassesAsset || !_engine) return;
 
-    if (leftIndex >= vertexCount || rightIndex >= vertexCount) {
-        // Fallback to face center
-        return simd_make_float3(face.transform.columns[3].x,
-                                face.transform.columns[3].y,
-                                face.transform.columns[3].z);
+    const NSUInteger slotCount = MIN(_faceSlotCount, _shownEntry.instanceCount);
+    const NSUInteger faceCount = MIN(faces.count, slotCount);
+
+    // Faces keep the slot that followed them last frame; new faces take a free slot with fresh filters
+    NSInteger slotOfFace[vto::kMaxTrackedFaces];
+    bool claimed[vto::kMaxTrackedFaces] = {};
+    for (NSUInteger f = 0; f < faceCount; f++) {
+        slotOfFace[f] = -1;
+        for (NSUInteger s = 0; s < slotCount; s++) {
+            if (!claimed[s] && [_faceSlots[s].faceId isEqual:faces[f].identifier]) {
+                slotOfFace[f] = s;
+                claimed[s] = true;
+                break;
+            }
+        }
+    }
+    for (NSUInteger f = 0; f < faceCount; f++) {
+        if (slotOfFace[f] >= 0) continue;
+        for (NSUInteger s = 0; s < slotCount; s++) {
+            if (claimed[s]) continue;
+            [self hideSlot:s];
+            _faceSlots[s].faceId = faces[f].identifier;
+            slotOfFace[f] = s;
+            claimed[s] = true;
+            break;
+        }
+    }
+    for (NSUInteger s = 0; s < _faceSlots.size(); s++) {
+        if (!claimed[s]) [self hideSlot:s];
     }
 
-    simd_float3 left = vertices[leftIndex];
-    simd_float3 right = vertices[rightIndex];
+    TransformManager &transformManager = _engine->getTransformManager();
+    vto::Mat4 cameraTransform = [MatrixUtils coreMatrixFromSimd:frame.camera.transform];
+
+    for (NSUInteger f = 0; f < faceCount; f++) {
+        ARFaceAnchor *face = faces[f];
+        NSUInteger slotIndex = slotOfFace[f];
+        GlassesFaceSlot &slot = _faceSlots[slotIndex];
+        FilamentInstance *instance = _glassesAsset->getAssetInstances()[slotIndex];
+
+        // Nose bridge position (vertices 818 and 366) and face rotation, smoothed in world space
+        // and extrapolated to when this frame is displayed
+        ARFaceGeometry *geometry = face.geometry;
+        vto::Mat4 faceTransform = [MatrixUtils coreMatrixFromSimd:face.transform];
+        vto::Mat4 glassesTransform = slot.poseSolver.update(faceTransform,
+                                                            (const float *)geometry.vertices,
+                                                            sizeof(simd_float3) / sizeof(float),
+                                                            geometry.vertexCount,
+                                                            frame.timestamp,
+                                                            predictionSeconds);
+
+        transformManager.setTransform(transformManager.getInstance(instance->getRoot()),
+                                      [MatrixUtils filamentMatrixFromCore:glassesTransform]);
+
+        // Coarser levels as the face moves away from the camera
+        if (!_shownEntry->instanceLods[slotIndex].empty()) {
+            int level = slot.lodSelector.update(faceTransform, cameraTransform);
+            if (level != slot.shownLod) {
+                [self showLod:level inSlot:slotIndex];
+            }
+        }
 
-    // Calculate center in local face coordinates
-    float centerX = (left.x + right.x) / 2.0f;
-    float centerY = (left.y + right.y) / 2.0f;
-    float centerZ = (left.z + right.z) / 2.0f;
+        if (!slot.visible) {
+            _scene->addEntities(instance->getEntities(), instance->getEntityCount());
+            slot.visible = true;
+            // Drop the levels of detail that aren't selected again
+            [self showLod:slot.shownLod inSlot:slotIndex];
+        }
+    }
+}
 
-    // Transform to world coordinates
-    simd_float4 localPos = simd_make_float4(centerX, centerY, centerZ, 1.0f);
-    simd_float4 worldPos = simd_mul(face.transform, localPos);
+/// Take a slot's instance of the shown model out of the scene
+- (void)removeSlotFromScene:(NSUInteger)slotIndex {
+    GlassesFaceSlot &slot = _faceSlots[slotIndex];
+    // Out of the scene, so Filament neither culls nor transforms the glasses while no face is tracked
+    if (slot.visible) {
+        FilamentInstance *instance = _glassesAsset->getAssetInstances()[slotIndex];
+        _scene->removeEntities(instance->getEntities(), instance->getEntityCount());
+        slot.visible = false;
+    }
+}
 
-    return simd_make_float3(worldPos.x, worldPos.y, worldPos.z);
+/// Take a slot's glasses out of the scene and forget the face it followed
+- (void)hideSlot:(NSUInteger)slotIndex {
+    GlassesFaceSlot &slot = _faceSlots[slotIndex];
+    [self removeSlotFromScene:slotIndex];
+    slot.faceId = nil;
+    slot.poseSolver.reset();
+    slot.lodSelector.reset();
 }
 
 - (void)hide {
-    if (!_glassesAsset || !_engine) return;
+    for (NSUInteger s = 0; s < _faceSlots.size(); s++) {
+        [self hideSlot:s];
+    }
+}
 
-    TransformManager &transformManager = _engine->getTransformManager();
-    TransformManager::Instance instance = transformManager.getInstance(_glassesAsset->getRoot());
+- (void)setMaxFaces:(NSUInteger)maxFaces {
+    NSUInteger slotCount = MIN(MAX(maxFaces, (NSUInteger)1), (NSUInteger)vto::kMaxTrackedFaces);
+    if (slotCount == _faceSlotCount) return;
+    _faceSlotCount = slotCount;
+    NSLog(@"%@: Face slots updated: %lu", TAG, (unsigned long)slotCount);
+    if (!_assetLoader) return;
+
+    // Instances can't be added once an asset's source data is released: pooled models with too few
+    // are dropped, and the shown one is loaded again (from the download cache)
+    BOOL reloadShown = _shownEntry && _shownEntry.instanceCount < slotCount;
+    for (GlassesPoolEntry *entry in _pool.allValues) {
+        if (entry.instanceCount < slotCount) {
+            [self destroyEntry:entry];
+        }
+    }
+    if (reloadShown) {
+        [self showModelWithUrl:_currentModelUrl];
+    }
+    [self prefetchModelsWithUrls:_compareUrls];
+}
 
-    filament::math::mat4f hideMatrix = [MatrixUtils createHideMatrix];
-    transformManager.setTransform(instance, hideMatrix);
+#pragma mark - Compare mode
 
-    [self resetFilters];
+- (void)setCompareModelsWithUrls:(NSArray<NSString *> *)urls {
+    NSArray<NSString *> *previousUrls = _compareUrls;
+    _compareUrls = [urls copy];
+    NSLog(@"%@: Compare models updated: %lu", TAG, (unsigned long)urls.count);
+
+    // Models dropped from the set go back to the pool's budget; a download nobody waits for stops
+    for (NSString *url in previousUrls) {
+        if (![_compareUrls containsObject:url] && ![url isEqualToString:_currentModelUrl]) {
+            [self cancelDownloadForUrl:url];
+        }
+    }
+    [self prefetchModelsWithUrls:_compareUrls];
+    [self evictToBudget];
+    [self publishMemoryStats];
 }
 
-- (void)resetFilters {
-    [_positionFilter reset];
-    [_rotationFilter reset];
+- (void)setActiveModel:(NSUInteger)index {
+    if (index >= _compareUrls.count) {
+        NSLog(@"%@: No compare model at index %lu (%lu set)", TAG, (unsigned long)index,
+              (unsigned long)_compareUrls.count);
+        return;
+    }
+    NSString *url = _compareUrls[index];
+    GlassesPoolEntry *entry = _pool[url];
+    if (!entry) {
+        // Still downloading: shown once it lands, like any other switch
+        [self switchModelWithUrl:url];
+        return;
+    }
+    if (entry == _shownEntry) return;
+
+    // Already resident: swap which instances are in the scene, keeping the glasses' pose
+    _currentModelUrl = url;
+    [self activateEntry:entry keepPose:YES];
+    NSLog(@"%@: Active compare model %lu: %@", TAG, (unsigned long)index, url);
 }
 
 - (void)setForwardOffset:(float)offset {
-    _forwardOffset = offset;
+    for (GlassesFaceSlot &slot : _faceSlots) {
+        slot.poseSolver.setForwardOffset(offset);
+    }
 }
 
 - (void)switchModelWithUrl:(NSString *)modelUrl {
     if (!_scene || !_assetLoader) return;
 
-    // Remove current model from scene
-    if (_glassesAsset) {
-        const Entity *entities = _glassesAsset->getEntities();
-        size_t entityCount = _glassesAsset->getEntityCount();
-        for (size_t i = 0; i < entityCount; i++) {
-            _scene->remove(entities[i]);
-        }
-        _assetLoader->destroyAsset(_glassesAsset);
-        _glassesAsset = nullptr;
-    }
-
-    [self resetFilters];
+    // Take the current model out of the scene; it stays warm in the pool
+    [self removeShownAssetFromScene];
+    [self hide];
 
-    // Update current model info
+    // Latest request wins: a download of the previous model no longer holds up bandwidth
+    if (![_currentModelUrl isEqualToString:modelUrl]) {
+        [self cancelDownloadForUrl:_currentModelUrl];
+    }
     _currentModelUrl = modelUrl;
 
-    // Load new model
-    [self loadModelFromUrl:modelUrl];
+    // Load new model (instant when prefetched)
+    [self showModelWithUrl:modelUrl];
     NSLog(@"%@: Switched to model: %@", TAG, modelUrl);
 }
 
 - (void)destroy {
     if (!_assetLoader) return;
 
-    if (_glassesAsset) {
-        if (_scene) {
-            const Entity *entities = _glassesAsset->getEntities();
-            size_t entityCount = _glassesAsset->getEntityCount();
-            for (size_t i = 0; i < entityCount; i++) {
-                _scene->remove(entities[i]);
-            }
-        }
-        _assetLoader->destroyAsset(_glassesAsset);
+    for (ModelDownloadToken *token in _pendingDownloads.allValues) {
+        [token cancel];
+    }
+    [_pendingDownloads removeAllObjects];
+
+    for (GlassesPoolEntry *entry in _pool.allValues) {
+        [self destroyEntry:entry];
     }
 
     // ResourceLoader must be destroyed before TextureProvider
@@ -288,13 +744,14 @@ static NSString *const TAG = @"GlassesRenderer";
     if (_textureProvider) {
         delete _textureProvider;
     }
+    if (_ktx2Provider) {
+        delete _ktx2Provider;
+    }
     if (_assetLoader) {
         AssetLoader::destroy(&_assetLoader);
     }
-    if (_materialProvider) {
-        _materialProvider->destroyMaterials();
-        delete _materialProvider;
-    }
+    // The material provider belongs to the shared context
+    _materialProvider = nullptr;
 }
 
 @end
@@ -12,6 +12,14 @@ class HybridNitroVtoView: HybridNitroVtoViewSpec {
     // The underlying native view
     private let nitroVtoView: NitroVtoView
 
+    // JS handle on the view's face pose buffer, wrapped without a copy; the closure keeps the memory alive
+    private lazy var facePoseArrayBuffer: ArrayBuffer = {
+        let buffer = nitroVtoView.facePoseBuffer
+        return ArrayBuffer.wrap(dataWithoutCopy: buffer.mutableBytes.assumingMemoryBound(to: UInt8.self),
+                                size: buffer.length,
+                                onDelete: { withExtendedLifetime(buffer) {} })
+    }()
+
     public required override init() {
         self.nitroVtoView = NitroVtoView()
         super.init()
@@ -42,6 +50,12 @@ class HybridNitroVtoView: HybridNitroVtoViewSpec {
         }
     }
 
+    public var onModelLoadProgress: ((String, Double) -> Void)? = nil {
+        didSet {
+            nitroVtoView.onModelLoadProgress = onModelLoadProgress
+        }
+    }
+
     public var faceMeshOcclusion: Bool? = nil {
         didSet {
             nitroVtoView.setFaceMeshOcclusion(faceMeshOcclusion)
@@ -60,12 +74,36 @@ class HybridNitroVtoView: HybridNitroVtoViewSpec {
         }
     }
 
+    public var maxFaces: Double? = nil {
+        didSet {
+            nitroVtoView.setMaxFaces(maxFaces)
+        }
+    }
+
     public var debug: Bool? = nil {
         didSet {
             nitroVtoView.setDebug(debug)
         }
     }
 
+    public var adaptivePerformance: Bool? = nil {
+        didSet {
+            nitroVtoView.setAdaptivePerformance(adaptivePerformance)
+        }
+    }
+
+    public var onPerformanceChange: ((Double, Double, String) -> Void)? = nil {
+        didSet {
+            nitroVtoView.onPerformanceChange = onPerformanceChange
+        }
+    }
+
+    public var onCaptureComplete: ((String, Double) -> Void)? = nil {
+        didSet {
+            nitroVtoView.onCaptureComplete = onCaptureComplete
+        }
+    }
+
     // MARK: - Methods implementation
 
     public func switchModel(modelUrl: String) throws {
@@ -76,6 +114,77 @@ class HybridNitroVtoView: HybridNitroVtoViewSpec {
         nitroVtoView.resetSession()
     }
 
+    public func prefetchModels(modelUrls: [String]) throws {
+        nitroVtoView.prefetchModels(modelUrls: modelUrls)
+    }
+
+    public func setCompareModels(modelUrls: [String]) throws {
+        nitroVtoView.setCompareModels(modelUrls: modelUrls)
+    }
+
+    public func setActiveModel(index: Double) throws {
+        nitroVtoView.setActiveModel(index: max(Int(index), 0))
+    }
+
+    public func setEnvironment(name: String) throws {
+        nitroVtoView.setEnvironment(name: name)
+    }
+
+    public func warmUp() throws {
+        nitroVtoView.warmUp()
+    }
+
+    public func getModelCacheStats() throws -> ModelCacheStats {
+        let stats = ModelDownloader.shared().cacheStats()
+        return ModelCacheStats(
+            fileCount: Double(stats.fileCount),
+            totalBytes: Double(stats.totalBytes),
+            byteLimit: Double(stats.byteLimit),
+            hitCount: Double(stats.hitCount),
+            missCount: Double(stats.missCount)
+        )
+    }
+
+    public func getModelMemoryStats() throws -> ModelMemoryStats {
+        return nitroVtoView.getModelMemoryStats()
+    }
+
+    public func getPerformanceStats() throws -> PerformanceStats {
+        return nitroVtoView.getPerformanceStats()
+    }
+
+    public func getFacePoseBuffer() throws -> ArrayBuffer {
+        return facePoseArrayBuffer
+    }
+
+    public func startFaceRecording(filePath: String) throws {
+        nitroVtoView.startFaceRecording(filePath: filePath)
+    }
+
+    public func stopFaceRecording() throws {
+        nitroVtoView.stopFaceRecording()
+    }
+
+    public func capture(filePath: String) throws {
+        nitroVtoView.capture(filePath: filePath)
+    }
+
+    public func startRecording(filePath: String) throws {
+        nitroVtoView.startRecording(filePath: filePath)
+    }
+
+    public func stopRecording() throws {
+        nitroVtoView.stopRecording()
+    }
+
+    public func clearModelCache() throws {
+        ModelDownloader.shared().clearCache()
+    }
+
+    public func setModelCacheLimit(maxBytes: Double) throws {
+        ModelDownloader.shared().cacheByteLimit = UInt64(max(maxBytes, 0))
+    }
+
     // MARK: - Lifecycle callbacks from HybridView protocol
 
     public func beforeUpdate() {
@@ -3,16 +3,13 @@
 NS_ASSUME_NONNULL_BEGIN
 
 /**
- * Utility functions for loading assets and remote files.
+ * Utility functions for loading bundled assets (remote models go through ModelDownloader).
  */
 @interface LoaderUtils : NSObject
 
 /// Load an asset file from the bundle into NSData
 + (nullable NSData *)loadAssetNamed:(NSString *)filename;
 
-/// Load a GLB file from a remote URL with caching
-+ (nullable NSData *)loadFromUrl:(NSString *)urlString error:(NSError **)error;
-
 @end
 
 NS_ASSUME_NONNULL_END
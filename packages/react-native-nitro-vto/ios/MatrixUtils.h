@@ -2,19 +2,27 @@
 #import <simd/simd.h>
 
 #include <math/mat4.h>
+#include "VtoMath.hpp"
 
 NS_ASSUME_NONNULL_BEGIN
 
 /**
  * Utility functions for matrix operations.
+ * All matrices (simd, Filament and shared core) are column-major with the same memory layout.
  */
 @interface MatrixUtils : NSObject
 
-/// Convert quaternion to 4x4 rotation matrix
-+ (simd_float4x4)quaternionToMatrix:(simd_quatf)q;
+/// Convert an ARKit simd matrix to a shared core matrix
++ (vto::Mat4)coreMatrixFromSimd:(simd_float4x4)matrix;
 
-/// Create a hide matrix (translates far on Z axis)
-+ (filament::math::mat4f)createHideMatrix;
+/// Convert a shared core matrix to a Filament matrix
++ (filament::math::mat4f)filamentMatrixFromCore:(const vto::Mat4 &)matrix;
+
+/// Convert an ARKit simd matrix to a Filament matrix (straight column copy)
++ (filament::math::mat4f)filamentMatrixFromSimd:(simd_float4x4)matrix;
+
+/// Convert an ARKit simd matrix to a double precision Filament matrix (e.g. for custom projections)
++ (filament::math::mat4)filamentDoubleMatrixFromSimd:(simd_float4x4)matrix;
 
 @end
 
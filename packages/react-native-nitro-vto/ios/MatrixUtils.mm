@@ -1,33 +1,37 @@
 #import "MatrixUtils.h"
 
+static_assert(sizeof(simd_float4x4) == sizeof(vto::Mat4), "simd and core matrices must share a layout");
+static_assert(sizeof(filament::math::mat4f) == sizeof(vto::Mat4), "Filament and core matrices must share a layout");
+
 @implementation MatrixUtils
 
-+ (simd_float4x4)quaternionToMatrix:(simd_quatf)q {
-    float qx = q.vector.x;
-    float qy = q.vector.y;
-    float qz = q.vector.z;
-    float qw = q.vector.w;
++ (vto::Mat4)coreMatrixFromSimd:(simd_float4x4)matrix {
+    vto::Mat4 result;
+    memcpy(result.m, &matrix, sizeof(result.m));
+    return result;
+}
 
-    simd_float4x4 result;
-    result.columns[0] = simd_make_float4(1 - 2*qy*qy - 2*qz*qz, 2*qx*qy + 2*qz*qw, 2*qx*qz - 2*qy*qw, 0);
-    result.columns[1] = simd_make_float4(2*qx*qy - 2*qz*qw, 1 - 2*qx*qx - 2*qz*qz, 2*qy*qz + 2*qx*qw, 0);
-    result.columns[2] = simd_make_float4(2*qx*qz + 2*qy*qw, 2*qy*qz - 2*qx*qw, 1 - 2*qx*qx - 2*qy*qy, 0);
-    result.columns[3] = simd_make_float4(0, 0, 0, 1);
++ (filament::math::mat4f)filamentMatrixFromCore:(const vto::Mat4 &)matrix {
+    filament::math::mat4f result;
+    memcpy(&result, matrix.m, sizeof(matrix.m));
+    return result;
+}
 
++ (filament::math::mat4f)filamentMatrixFromSimd:(simd_float4x4)matrix {
+    filament::math::mat4f result;
+    memcpy(&result, &matrix, sizeof(matrix));
     return result;
 }
 
-+ (filament::math::mat4f)createHideMatrix {
-    filament::math::mat4f hideMatrix;
-    // Set identity
-    for (int i = 0; i < 4; i++) {
-        for (int j = 0; j < 4; j++) {
-            hideMatrix[i][j] = (i == j) ? 1.0f : 0.0f;
-        }
++ (filament::math::mat4)filamentDoubleMatrixFromSimd:(simd_float4x4)matrix {
+    // Widen one column (4 floats) at a time
+    static_assert(sizeof(simd_double4) == sizeof(filament::math::double4), "Column layouts must match");
+    filament::math::mat4 result;
+    for (int col = 0; col < 4; col++) {
+        simd_double4 column = simd_double(matrix.columns[col]);
+        memcpy(&result[col], &column, sizeof(column));
     }
-    // Translate far on Z axis
-    hideMatrix[3][2] = -1000.0f;
-    return hideMatrix;
+    return result;
 }
 
 @end
@@ -0,0 +1,55 @@
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Called on a background queue with the cached model file, or an error. Must not block.
+typedef void (^ModelDownloadCompletion)(NSURL *_Nullable fileUrl, NSError *_Nullable error);
+
+/// Snapshot of the on-disk model cache
+typedef struct {
+    NSUInteger fileCount;
+    unsigned long long totalBytes;
+    unsigned long long byteLimit;
+    /// Loads served from the cache / loads that had to download, since app start
+    NSUInteger hitCount;
+    NSUInteger missCount;
+} VTOModelCacheStats;
+
+/**
+ * One caller's interest in a download. Cancelling drops its completion, and stops the
+ * transfer once no other caller is waiting on the same URL.
+ */
+@interface ModelDownloadToken : NSObject
+
+- (void)cancel;
+
+@end
+
+/**
+ * Streams remote GLB models straight into the glb_cache directory.
+ * - Requests for the same URL share one transfer; different URLs download concurrently.
+ * - Cancelled or interrupted transfers keep their partial file and resume with a Range request.
+ * - Cached files are revalidated with If-None-Match / If-Modified-Since once older than the
+ *   revalidation interval. The cached copy is still served when the network is unavailable.
+ * - An index (size, last access, SHA-256, validators) tracks every cached file. Files are only
+ *   trusted when they match it, and least recently used ones are evicted beyond cacheByteLimit.
+ */
+@interface ModelDownloader : NSObject
+
++ (ModelDownloader *)sharedDownloader NS_SWIFT_NAME(shared());
+
+/// Byte budget for cached models (default 200 MB). Lowering it evicts right away. Any thread.
+@property (nonatomic, assign) unsigned long long cacheByteLimit;
+
+/// Make the model at urlString available in the cache, downloading or revalidating as needed
+- (ModelDownloadToken *)downloadUrl:(NSString *)urlString completion:(ModelDownloadCompletion)completion;
+
+/// Current cache usage (waits for queued cache work, so call it off hot paths)
+- (VTOModelCacheStats)cacheStats;
+
+/// Delete every cached model; downloads in flight still complete into the cache
+- (void)clearCache;
+
+@end
+
+NS_ASSUME_NONNULL_END
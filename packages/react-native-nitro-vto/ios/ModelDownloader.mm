@@ -0,0 +1,733 @@
+#import "ModelDownloader.h"
+#import <CommonCrypto/CommonDigest.h>
+
+static NSString *const TAG = @"ModelDownloader";
+static NSString *const CACHE_DIR = @"glb_cache";
+static NSString *const ERROR_DOMAIN = @"ModelDownloader";
+
+static const NSInteger MAX_CONCURRENT_DOWNLOADS = 4;
+static const NSTimeInterval REQUEST_TIMEOUT_SECONDS = 30;
+// Cached models are trusted this long before the next conditional request
+static const NSTimeInterval REVALIDATE_INTERVAL_SECONDS = 60 * 60;
+static const unsigned long long DEFAULT_CACHE_BYTE_LIMIT = 200ull * 1024 * 1024;
+// Partial files nobody resumed within this long are deleted at startup
+static const NSTimeInterval PART_FILE_MAX_AGE_SECONDS = 24 * 60 * 60;
+static const NSUInteger HASH_CHUNK_SIZE = 1024 * 1024;
+
+// Cache index (index.json): URL hash -> entry
+static NSString *const INDEX_FILE = @"index.json";
+static const NSInteger INDEX_VERSION = 1;
+static NSString *const INDEX_KEY_VERSION = @"version";
+static NSString *const INDEX_KEY_ENTRIES = @"entries";
+
+// Index entry keys; ETag and Last-Modified also go in <hash>.part.plist next to a partial file
+static NSString *const ENTRY_URL = @"url";
+static NSString *const ENTRY_SIZE = @"size";
+static NSString *const ENTRY_SHA256 = @"sha256";
+static NSString *const ENTRY_LAST_ACCESS = @"lastAccess";
+static NSString *const ENTRY_VALIDATED_AT = @"validatedAt";
+static NSString *const ENTRY_ETAG = @"etag";
+static NSString *const ENTRY_LAST_MODIFIED = @"lastModified";
+
+@interface ModelDownloadToken ()
+@property (nonatomic, weak) ModelDownloader *downloader;
+@property (nonatomic, copy) NSString *url;
+@property (nonatomic, copy, nullable) ModelDownloadCompletion completion;
+@end
+
+/// One transfer, shared by every token waiting on its URL. Only touched on the downloader queue.
+@interface ModelDownload : NSObject
+@property (nonatomic, copy) NSString *url;
+@property (nonatomic, copy) NSString *urlHash;
+@property (nonatomic, strong) NSURL *cacheFile;
+@property (nonatomic, strong) NSURL *partFile;
+@property (nonatomic, strong) NSMutableArray<ModelDownloadToken *> *tokens;
+@property (nonatomic, strong, nullable) NSURLSessionDataTask *task;
+@property (nonatomic, strong, nullable) NSFileHandle *fileHandle;
+/// A trusted cached copy exists and this is a conditional request for it
+@property (nonatomic, assign) BOOL revalidating;
+/// Validators of the body being received, saved with the file it ends up in
+@property (nonatomic, copy, nullable) NSDictionary *responseMeta;
+@property (nonatomic, strong, nullable) NSError *failure;
+@property (nonatomic, assign) BOOL notModified;
+@property (nonatomic, assign) BOOL cancelled;
+@property (nonatomic, assign) unsigned long long bytesWritten;
+@end
+
+@implementation ModelDownload
+@end
+
+@interface ModelDownloader () <NSURLSessionDataDelegate>
+- (void)cancelToken:(ModelDownloadToken *)token;
+@end
+
+@implementation ModelDownloadToken
+
+- (void)cancel {
+    [self.downloader cancelToken:self];
+}
+
+@end
+
+@implementation ModelDownloader {
+    // Serial queue owning all state below; also the session's delegate queue
+    dispatch_queue_t _queue;
+    NSURLSession *_session;
+    NSMutableDictionary<NSString *, ModelDownload *> *_downloads;
+    NSURL *_cacheDirectory;
+
+    NSMutableDictionary<NSString *, NSMutableDictionary *> *_index;
+    // Files whose SHA-256 was checked against the index since launch
+    NSMutableSet<NSString *> *_verifiedHashes;
+    unsigned long long _cacheByteLimit;
+    NSUInteger _hitCount;
+    NSUInteger _missCount;
+}
+
++ (ModelDownloader *)sharedDownloader {
+    static ModelDownloader *shared = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        shared = [[ModelDownloader alloc] init];
+    });
+    return shared;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _queue = dispatch_queue_create("com.nitrovto.downloader", DISPATCH_QUEUE_SERIAL);
+        _downloads = [NSMutableDictionary dictionary];
+        _cacheDirectory = [self createCacheDirectory];
+        _index = [NSMutableDictionary dictionary];
+        _verifiedHashes = [NSMutableSet set];
+        _cacheByteLimit = DEFAULT_CACHE_BYTE_LIMIT;
+
+        NSOperationQueue *delegateQueue = [[NSOperationQueue alloc] init];
+        delegateQueue.underlyingQueue = _queue;
+        delegateQueue.maxConcurrentOperationCount = 1;
+
+        // glb_cache is the only cache: keep multi-megabyte bodies out of NSURLCache
+        NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration defaultSessionConfiguration];
+        configuration.URLCache = nil;
+        configuration.requestCachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+        configuration.HTTPMaximumConnectionsPerHost = MAX_CONCURRENT_DOWNLOADS;
+        configuration.timeoutIntervalForRequest = REQUEST_TIMEOUT_SECONDS;
+        _session = [NSURLSession sessionWithConfiguration:configuration
+                                                 delegate:self
+                                            delegateQueue:delegateQueue];
+
+        // Runs before any request, since the queue is serial
+        dispatch_async(_queue, ^{
+            [self loadIndex];
+        });
+    }
+    return self;
+}
+
+#pragma mark - Public API
+
+- (ModelDownloadToken *)downloadUrl:(NSString *)urlString completion:(ModelDownloadCompletion)completion {
+    ModelDownloadToken *token = [[ModelDownloadToken alloc] init];
+    token.downloader = self;
+    token.url = urlString;
+    token.completion = completion;
+
+    dispatch_async(_queue, ^{
+        [self addToken:token];
+    });
+    return token;
+}
+
+- (void)cancelToken:(ModelDownloadToken *)token {
+    dispatch_async(_queue, ^{
+        if (!token.completion) return;
+        token.completion = nil;
+
+        ModelDownload *download = self->_downloads[token.url];
+        [download.tokens removeObject:token];
+        if (download && download.tokens.count == 0 && !download.cancelled) {
+            // The partial file stays on disk, so a later request resumes where this one stopped
+            NSLog(@"%@: Cancelling download: %@", TAG, token.url);
+            download.cancelled = YES;
+            [download.task cancel];
+        }
+    });
+}
+
+- (unsigned long long)cacheByteLimit {
+    __block unsigned long long limit;
+    dispatch_sync(_queue, ^{
+        limit = self->_cacheByteLimit;
+    });
+    return limit;
+}
+
+- (void)setCacheByteLimit:(unsigned long long)cacheByteLimit {
+    dispatch_async(_queue, ^{
+        self->_cacheByteLimit = cacheByteLimit;
+        if ([self evictToBudgetKeeping:nil]) {
+            [self saveIndex];
+        }
+    });
+}
+
+- (VTOModelCacheStats)cacheStats {
+    __block VTOModelCacheStats stats = {};
+    dispatch_sync(_queue, ^{
+        stats.fileCount = self->_index.count;
+        stats.totalBytes = [self indexedBytes];
+        stats.byteLimit = self->_cacheByteLimit;
+        stats.hitCount = self->_hitCount;
+        stats.missCount = self->_missCount;
+    });
+    return stats;
+}
+
+- (void)clearCache {
+    dispatch_async(_queue, ^{
+        NSSet<NSString *> *activeHashes = [self activeDownloadHashes];
+        NSFileManager *fileManager = [NSFileManager defaultManager];
+        NSArray<NSURL *> *files = [fileManager contentsOfDirectoryAtURL:self->_cacheDirectory
+                                             includingPropertiesForKeys:nil
+                                                                options:0
+                                                                  error:nil];
+        for (NSURL *file in files) {
+            NSString *name = file.lastPathComponent;
+            NSString *hash = [name componentsSeparatedByString:@"."].firstObject;
+            if ([name isEqualToString:INDEX_FILE] || [activeHashes containsObject:hash]) continue;
+            [fileManager removeItemAtURL:file error:nil];
+        }
+
+        for (NSString *hash in self->_index.allKeys) {
+            if (![activeHashes containsObject:hash]) {
+                [self->_index removeObjectForKey:hash];
+            }
+        }
+        [self saveIndex];
+        NSLog(@"%@: Cache cleared", TAG);
+    });
+}
+
+#pragma mark - Scheduling
+
+- (void)addToken:(ModelDownloadToken *)token {
+    if (!token.completion) return;
+
+    ModelDownload *download = _downloads[token.url];
+    if (download) {
+        // Joining a transfer that is being cancelled restarts it once the cancel lands
+        [download.tokens addObject:token];
+        return;
+    }
+
+    NSString *hash = [self hashUrl:token.url];
+    NSURL *cacheFile = [self cacheFileForHash:hash extension:@"glb"];
+    NSMutableDictionary *entry = [self trustedEntryForHash:hash];
+    if (entry) {
+        NSTimeInterval validatedAt = [entry[ENTRY_VALIDATED_AT] doubleValue];
+        if ([NSDate date].timeIntervalSince1970 - validatedAt < REVALIDATE_INTERVAL_SECONDS) {
+            NSLog(@"%@: Cache hit: %@", TAG, cacheFile.path);
+            [self touchEntry:entry];
+            _hitCount++;
+            [self saveIndex];
+            [self completeToken:token fileUrl:cacheFile error:nil];
+            return;
+        }
+    }
+
+    download = [[ModelDownload alloc] init];
+    download.url = token.url;
+    download.urlHash = hash;
+    download.cacheFile = cacheFile;
+    download.partFile = [self cacheFileForHash:hash extension:@"part"];
+    download.tokens = [NSMutableArray arrayWithObject:token];
+    download.revalidating = entry != nil;
+    _downloads[token.url] = download;
+    [self startDownload:download];
+}
+
+- (void)startDownload:(ModelDownload *)download {
+    NSURL *url = [NSURL URLWithString:download.url];
+    if (!url) {
+        download.failure = [NSError errorWithDomain:ERROR_DOMAIN
+                                               code:-1
+                                           userInfo:@{NSLocalizedDescriptionKey: @"Invalid URL"}];
+        [self finishDownload:download];
+        return;
+    }
+
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:url];
+
+    if (download.revalidating) {
+        // Conditional GET: 304 keeps the cached file, 200 replaces it
+        NSDictionary *entry = _index[download.urlHash];
+        if (entry[ENTRY_ETAG]) {
+            [request setValue:entry[ENTRY_ETAG] forHTTPHeaderField:@"If-None-Match"];
+        }
+        if (entry[ENTRY_LAST_MODIFIED]) {
+            [request setValue:entry[ENTRY_LAST_MODIFIED] forHTTPHeaderField:@"If-Modified-Since"];
+        }
+        NSLog(@"%@: Revalidating cached model: %@", TAG, download.url);
+    } else {
+        // Resume a partial file when its validator lets the server confirm it is the same version
+        NSDictionary *partMeta = [self readPartMetaForFile:download.partFile];
+        NSString *validator = partMeta[ENTRY_ETAG] ?: partMeta[ENTRY_LAST_MODIFIED];
+        unsigned long long partSize = [self sizeOfFile:download.partFile];
+        if (validator && partSize > 0) {
+            [request setValue:[NSString stringWithFormat:@"bytes=%llu-", partSize] forHTTPHeaderField:@"Range"];
+            [request setValue:validator forHTTPHeaderField:@"If-Range"];
+            NSLog(@"%@: Resuming download at %llu bytes: %@", TAG, partSize, download.url);
+        } else {
+            NSLog(@"%@: Starting download: %@", TAG, download.url);
+        }
+    }
+
+    NSURLSessionDataTask *task = [_session dataTaskWithRequest:request];
+    task.taskDescription = download.url;
+    download.task = task;
+    [task resume];
+}
+
+- (void)finishDownload:(ModelDownload *)download {
+    [download.fileHandle closeAndReturnError:nil];
+    download.fileHandle = nil;
+
+    // Nobody wants it any more; keep the partial file for the next request
+    if (download.cancelled && download.tokens.count == 0) {
+        [_downloads removeObjectForKey:download.url];
+        return;
+    }
+
+    // Cancelled, then requested again before the cancel landed: start over (resuming)
+    if (download.cancelled) {
+        ModelDownload *restarted = [[ModelDownload alloc] init];
+        restarted.url = download.url;
+        restarted.urlHash = download.urlHash;
+        restarted.cacheFile = download.cacheFile;
+        restarted.partFile = download.partFile;
+        restarted.tokens = download.tokens;
+        restarted.revalidating = download.revalidating;
+        _downloads[download.url] = restarted;
+        [self startDownload:restarted];
+        return;
+    }
+
+    [_downloads removeObjectForKey:download.url];
+
+    NSURL *fileUrl = nil;
+    NSError *error = download.failure;
+    NSMutableDictionary *entry = _index[download.urlHash];
+    if (download.notModified && entry) {
+        entry[ENTRY_VALIDATED_AT] = @([NSDate date].timeIntervalSince1970);
+        fileUrl = download.cacheFile;
+        NSLog(@"%@: Cached model still current: %@", TAG, download.url);
+    } else if (!error && !download.notModified) {
+        fileUrl = [self commitPartFileOfDownload:download error:&error];
+    }
+
+    if (!fileUrl && download.revalidating && _index[download.urlHash]) {
+        // Offline or server trouble: the cached copy beats no model
+        NSLog(@"%@: Revalidation failed (%@), using cached model", TAG, error.localizedDescription);
+        fileUrl = download.cacheFile;
+        error = nil;
+    }
+
+    if (fileUrl) {
+        [self touchEntry:_index[download.urlHash]];
+        if (download.bytesWritten > 0 && !download.notModified && !download.failure) {
+            _missCount++;
+        } else {
+            _hitCount++;
+        }
+        [self saveIndex];
+    }
+
+    for (ModelDownloadToken *token in download.tokens) {
+        [self completeToken:token fileUrl:fileUrl error:error];
+    }
+}
+
+/// Atomically move a complete partial file over the cached one, then index it
+- (nullable NSURL *)commitPartFileOfDownload:(ModelDownload *)download error:(NSError **)error {
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    NSString *sha256 = [self sha256OfFile:download.partFile];
+    if (!sha256) {
+        *error = [NSError errorWithDomain:ERROR_DOMAIN
+                                     code:-1
+                                 userInfo:@{NSLocalizedDescriptionKey: @"Failed to read downloaded file"}];
+        return nil;
+    }
+
+    // The old file leaves the index first: a crash past this point leaves an unindexed file,
+    // which is deleted at startup rather than trusted
+    [_index removeObjectForKey:download.urlHash];
+    [_verifiedHashes removeObject:download.urlHash];
+    [self saveIndex];
+
+    BOOL committed;
+    if ([fileManager fileExistsAtPath:download.cacheFile.path]) {
+        committed = [fileManager replaceItemAtURL:download.cacheFile
+                                    withItemAtURL:download.partFile
+                                   backupItemName:nil
+                                          options:0
+                                 resultingItemURL:nil
+                                            error:error];
+    } else {
+        committed = [fileManager moveItemAtURL:download.partFile toURL:download.cacheFile error:error];
+    }
+    if (!committed) {
+        NSLog(@"%@: Failed to save to cache: %@", TAG, (*error).localizedDescription);
+        return nil;
+    }
+    [fileManager removeItemAtURL:[self partMetaFileForFile:download.partFile] error:nil];
+
+    NSMutableDictionary *entry = [NSMutableDictionary dictionaryWithDictionary:download.responseMeta ?: @{}];
+    entry[ENTRY_URL] = download.url;
+    entry[ENTRY_SIZE] = @([self sizeOfFile:download.cacheFile]);
+    entry[ENTRY_SHA256] = sha256;
+    entry[ENTRY_VALIDATED_AT] = @([NSDate date].timeIntervalSince1970);
+    _index[download.urlHash] = entry;
+    [_verifiedHashes addObject:download.urlHash];
+    [self touchEntry:entry];
+
+    [self evictToBudgetKeeping:download.urlHash];
+    [self saveIndex];
+    NSLog(@"%@: Saved %@ bytes to cache: %@", TAG, entry[ENTRY_SIZE], download.cacheFile.path);
+    return download.cacheFile;
+}
+
+- (void)completeToken:(ModelDownloadToken *)token fileUrl:(nullable NSURL *)fileUrl error:(nullable NSError *)error {
+    ModelDownloadCompletion completion = token.completion;
+    token.completion = nil;
+    if (completion) {
+        completion(fileUrl, error);
+    }
+}
+
+#pragma mark - NSURLSessionDataDelegate
+
+- (void)URLSession:(NSURLSession *)session
+          dataTask:(NSURLSessionDataTask *)dataTask
+didReceiveResponse:(NSURLResponse *)response
+ completionHandler:(void (^)(NSURLSessionResponseDisposition))completionHandler {
+    ModelDownload *download = _downloads[dataTask.taskDescription];
+    if (!download || download.task != dataTask || ![response isKindOfClass:[NSHTTPURLResponse class]]) {
+        completionHandler(NSURLSessionResponseCancel);
+        return;
+    }
+
+    NSHTTPURLResponse *httpResponse = (NSHTTPURLResponse *)response;
+    NSInteger statusCode = httpResponse.statusCode;
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+
+    if (statusCode == 304 && download.revalidating) {
+        download.notModified = YES;
+        completionHandler(NSURLSessionResponseCancel);
+        return;
+    }
+
+    if (statusCode != 200 && statusCode != 206) {
+        if (statusCode == 416) {
+            // The partial file no longer matches anything the server has
+            [fileManager removeItemAtURL:download.partFile error:nil];
+        }
+        download.failure = [NSError errorWithDomain:ERROR_DOMAIN
+                                               code:statusCode
+                                           userInfo:@{NSLocalizedDescriptionKey:
+                                                          [NSString stringWithFormat:@"HTTP error code: %ld", (long)statusCode]}];
+        completionHandler(NSURLSessionResponseCancel);
+        return;
+    }
+
+    // 206 continues the partial file; a 200 (new version, or no range support) starts it over
+    BOOL resuming = statusCode == 206;
+    unsigned long long offset = resuming ? [self sizeOfFile:download.partFile] : 0;
+    if (resuming) {
+        NSString *contentRange = [httpResponse valueForHTTPHeaderField:@"Content-Range"];
+        NSString *expected = [NSString stringWithFormat:@"bytes %llu-", offset];
+        if (![contentRange hasPrefix:expected]) {
+            [fileManager removeItemAtURL:download.partFile error:nil];
+            download.failure = [NSError errorWithDomain:ERROR_DOMAIN
+                                                   code:-1
+                                               userInfo:@{NSLocalizedDescriptionKey: @"Unexpected Content-Range"}];
+            completionHandler(NSURLSessionResponseCancel);
+            return;
+        }
+    } else {
+        [fileManager createFileAtPath:download.partFile.path contents:nil attributes:nil];
+    }
+
+    NSError *error = nil;
+    NSFileHandle *fileHandle = [NSFileHandle fileHandleForWritingToURL:download.partFile error:&error];
+    if (!fileHandle || ![fileHandle truncateAtOffset:offset error:&error]) {
+        download.failure = error;
+        completionHandler(NSURLSessionResponseCancel);
+        return;
+    }
+    download.fileHandle = fileHandle;
+    download.bytesWritten = offset;
+
+    if (!resuming) {
+        NSMutableDictionary *meta = [NSMutableDictionary dictionary];
+        NSString *etag = [httpResponse valueForHTTPHeaderField:@"ETag"];
+        NSString *lastModified = [httpResponse valueForHTTPHeaderField:@"Last-Modified"];
+        if (etag) meta[ENTRY_ETAG] = etag;
+        if (lastModified) meta[ENTRY_LAST_MODIFIED] = lastModified;
+        download.responseMeta = meta;
+        // Written up front, so an interrupted transfer can be resumed with If-Range
+        [self writePartMeta:meta forFile:download.partFile];
+    } else {
+        download.responseMeta = [self readPartMetaForFile:download.partFile];
+    }
+
+    completionHandler(NSURLSessionResponseAllow);
+}
+
+- (void)URLSession:(NSURLSession *)session dataTask:(NSURLSessionDataTask *)dataTask didReceiveData:(NSData *)data {
+    ModelDownload *download = _downloads[dataTask.taskDescription];
+    if (!download || download.task != dataTask || !download.fileHandle) return;
+
+    // Streamed straight to disk: the model is never held in memory as a whole
+    NSError *error = nil;
+    if (![download.fileHandle writeData:data error:&error]) {
+        download.failure = error;
+        [dataTask cancel];
+        return;
+    }
+    download.bytesWritten += data.length;
+}
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didCompleteWithError:(nullable NSError *)error {
+    ModelDownload *download = _downloads[task.taskDescription];
+    if (!download || download.task != task) return;
+
+    // Our own cancels (304, HTTP errors) already recorded their outcome
+    BOOL cancelledByUs = [error.domain isEqualToString:NSURLErrorDomain] && error.code == NSURLErrorCancelled;
+    if (error && !cancelledByUs && !download.failure) {
+        download.failure = error;
+    }
+    if (!error && !download.fileHandle && !download.failure) {
+        download.failure = [NSError errorWithDomain:ERROR_DOMAIN
+                                               code:-1
+                                           userInfo:@{NSLocalizedDescriptionKey: @"No data received"}];
+    }
+    if (!download.failure && !download.notModified) {
+        NSLog(@"%@: Downloaded %llu bytes: %@", TAG, download.bytesWritten, download.url);
+    }
+
+    [self finishDownload:download];
+}
+
+#pragma mark - Cache Index
+
+- (NSURL *)indexFile {
+    return [_cacheDirectory URLByAppendingPathComponent:INDEX_FILE];
+}
+
+/// Load the index and make the directory match it: unindexed models and old partial files go
+- (void)loadIndex {
+    NSData *data = [NSData dataWithContentsOfURL:[self indexFile]];
+    NSDictionary *json = data ? [NSJSONSerialization JSONObjectWithData:data options:0 error:nil] : nil;
+    if ([json isKindOfClass:[NSDictionary class]] && [json[INDEX_KEY_VERSION] integerValue] == INDEX_VERSION) {
+        NSDictionary *entries = json[INDEX_KEY_ENTRIES];
+        for (NSString *hash in entries) {
+            _index[hash] = [entries[hash] mutableCopy];
+        }
+    }
+
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    NSArray<NSURL *> *files = [fileManager contentsOfDirectoryAtURL:_cacheDirectory
+                                         includingPropertiesForKeys:@[NSURLContentModificationDateKey]
+                                                            options:0
+                                                              error:nil];
+    NSMutableSet<NSString *> *presentHashes = [NSMutableSet set];
+    for (NSURL *file in files) {
+        NSString *name = file.lastPathComponent;
+        if ([name isEqualToString:INDEX_FILE]) continue;
+
+        NSString *hash = [name componentsSeparatedByString:@"."].firstObject;
+        BOOL keep = NO;
+        if ([file.pathExtension isEqualToString:@"glb"]) {
+            keep = _index[hash] != nil;
+            if (keep) [presentHashes addObject:hash];
+        } else if ([file.pathExtension isEqualToString:@"part"] || [name hasSuffix:@".part.plist"]) {
+            NSDate *modified = nil;
+            [file getResourceValue:&modified forKey:NSURLContentModificationDateKey error:nil];
+            keep = modified && -modified.timeIntervalSinceNow < PART_FILE_MAX_AGE_SECONDS;
+        }
+        if (!keep) {
+            [fileManager removeItemAtURL:file error:nil];
+        }
+    }
+
+    for (NSString *hash in _index.allKeys) {
+        if (![presentHashes containsObject:hash]) {
+            [_index removeObjectForKey:hash];
+        }
+    }
+    [self evictToBudgetKeeping:nil];
+    [self saveIndex];
+    NSLog(@"%@: Cache index loaded: %lu models, %llu bytes", TAG, (unsigned long)_index.count, [self indexedBytes]);
+}
+
+- (void)saveIndex {
+    NSDictionary *json = @{INDEX_KEY_VERSION: @(INDEX_VERSION), INDEX_KEY_ENTRIES: _index};
+    NSError *error = nil;
+    NSData *data = [NSJSONSerialization dataWithJSONObject:json options:0 error:&error];
+    if (!data || ![data writeToURL:[self indexFile] options:NSDataWritingAtomic error:&error]) {
+        NSLog(@"%@: Failed to write cache index: %@", TAG, error.localizedDescription);
+    }
+}
+
+/// The index entry for a hash, if its file is present and matches it (content checked once per launch)
+- (nullable NSMutableDictionary *)trustedEntryForHash:(NSString *)hash {
+    NSMutableDictionary *entry = _index[hash];
+    if (!entry) return nil;
+
+    NSURL *cacheFile = [self cacheFileForHash:hash extension:@"glb"];
+    BOOL intact = [self sizeOfFile:cacheFile] == [entry[ENTRY_SIZE] unsignedLongLongValue];
+    if (intact && ![_verifiedHashes containsObject:hash]) {
+        intact = [[self sha256OfFile:cacheFile] isEqualToString:entry[ENTRY_SHA256]];
+        if (intact) [_verifiedHashes addObject:hash];
+    }
+
+    if (!intact) {
+        NSLog(@"%@: Cached model does not match the index, discarding: %@", TAG, entry[ENTRY_URL]);
+        [[NSFileManager defaultManager] removeItemAtURL:cacheFile error:nil];
+        [_index removeObjectForKey:hash];
+        [self saveIndex];
+        return nil;
+    }
+    return entry;
+}
+
+- (void)touchEntry:(nullable NSMutableDictionary *)entry {
+    entry[ENTRY_LAST_ACCESS] = @([NSDate date].timeIntervalSince1970);
+}
+
+- (unsigned long long)indexedBytes {
+    unsigned long long total = 0;
+    for (NSDictionary *entry in _index.allValues) {
+        total += [entry[ENTRY_SIZE] unsignedLongLongValue];
+    }
+    return total;
+}
+
+- (NSSet<NSString *> *)activeDownloadHashes {
+    NSMutableSet<NSString *> *hashes = [NSMutableSet set];
+    for (ModelDownload *download in _downloads.allValues) {
+        [hashes addObject:download.urlHash];
+    }
+    return hashes;
+}
+
+/// Delete least recently used models until the index fits the budget. Returns YES if any went.
+/// Files being revalidated are kept; a model already loaded stays valid after its file is deleted.
+- (BOOL)evictToBudgetKeeping:(nullable NSString *)keepHash {
+    unsigned long long total = [self indexedBytes];
+    if (total <= _cacheByteLimit) return NO;
+
+    NSSet<NSString *> *activeHashes = [self activeDownloadHashes];
+    NSArray<NSString *> *hashes = [_index keysSortedByValueUsingComparator:^NSComparisonResult(NSDictionary *a, NSDictionary *b) {
+        return [a[ENTRY_LAST_ACCESS] compare:b[ENTRY_LAST_ACCESS]];
+    }];
+
+    BOOL evicted = NO;
+    for (NSString *hash in hashes) {
+        if (total <= _cacheByteLimit) break;
+        if ([hash isEqualToString:keepHash] || [activeHashes containsObject:hash]) continue;
+
+        NSDictionary *entry = _index[hash];
+        [[NSFileManager defaultManager] removeItemAtURL:[self cacheFileForHash:hash extension:@"glb"] error:nil];
+        [_index removeObjectForKey:hash];
+        total -= [entry[ENTRY_SIZE] unsignedLongLongValue];
+        evicted = YES;
+        NSLog(@"%@: Evicted %@ (%@ bytes)", TAG, entry[ENTRY_URL], entry[ENTRY_SIZE]);
+    }
+    return evicted;
+}
+
+#pragma mark - Cache Files
+
+- (NSURL *)createCacheDirectory {
+    NSArray *paths = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES);
+    NSURL *cachesDir = [NSURL fileURLWithPath:paths.firstObject];
+    NSURL *glbCacheDir = [cachesDir URLByAppendingPathComponent:CACHE_DIR];
+
+    if (![[NSFileManager defaultManager] fileExistsAtPath:glbCacheDir.path]) {
+        [[NSFileManager defaultManager] createDirectoryAtURL:glbCacheDir
+                                 withIntermediateDirectories:YES
+                                                  attributes:nil
+                                                       error:nil];
+    }
+
+    return glbCacheDir;
+}
+
+- (NSURL *)cacheFileForHash:(NSString *)hash extension:(NSString *)extension {
+    return [_cacheDirectory URLByAppendingPathComponent:[hash stringByAppendingPathExtension:extension]];
+}
+
+- (NSString *)hexString:(const unsigned char *)hash {
+    NSMutableString *hexString = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (int i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
+        [hexString appendFormat:@"%02x", hash[i]];
+    }
+    return hexString;
+}
+
+- (NSString *)hashUrl:(NSString *)urlString {
+    NSData *data = [urlString dataUsingEncoding:NSUTF8StringEncoding];
+    unsigned char hash[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, hash);
+    return [self hexString:hash];
+}
+
+/// SHA-256 of a file's content, read in chunks; nil if it can't be read
+- (nullable NSString *)sha256OfFile:(NSURL *)file {
+    NSFileHandle *fileHandle = [NSFileHandle fileHandleForReadingFromURL:file error:nil];
+    if (!fileHandle) return nil;
+
+    CC_SHA256_CTX context;
+    CC_SHA256_Init(&context);
+    while (true) {
+        @autoreleasepool {
+            NSError *error = nil;
+            NSData *chunk = [fileHandle readDataUpToLength:HASH_CHUNK_SIZE error:&error];
+            if (error) {
+                [fileHandle closeAndReturnError:nil];
+                return nil;
+            }
+            if (chunk.length == 0) break;
+            CC_SHA256_Update(&context, chunk.bytes, (CC_LONG)chunk.length);
+        }
+    }
+    [fileHandle closeAndReturnError:nil];
+
+    unsigned char hash[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256_Final(hash, &context);
+    return [self hexString:hash];
+}
+
+- (unsigned long long)sizeOfFile:(NSURL *)file {
+    NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:file.path error:nil];
+    return attributes ? attributes.fileSize : 0;
+}
+
+- (NSURL *)partMetaFileForFile:(NSURL *)partFile {
+    return [partFile URLByAppendingPathExtension:@"plist"];
+}
+
+- (NSDictionary *)readPartMetaForFile:(NSURL *)partFile {
+    return [NSDictionary dictionaryWithContentsOfURL:[self partMetaFileForFile:partFile] error:nil] ?: @{};
+}
+
+- (void)writePartMeta:(NSDictionary *)meta forFile:(NSURL *)partFile {
+    NSError *error = nil;
+    if (![meta writeToURL:[self partMetaFileForFile:partFile] error:&error]) {
+        NSLog(@"%@: Failed to write partial download metadata: %@", TAG, error.localizedDescription);
+    }
+}
+
+@end
@@ -15,9 +15,9 @@
 #import "CameraTextureRenderer.h"
 #import "EnvironmentLightingRenderer.h"
 #import "GlassesRenderer.h"
-#import "KalmanFilter.h"
 #import "LoaderUtils.h"
 #import "MatrixUtils.h"
+#import "ModelDownloader.h"
 
 FOUNDATION_EXPORT double NitroVtoVersionNumber;
 FOUNDATION_EXPORT const unsigned char NitroVtoVersionString[];
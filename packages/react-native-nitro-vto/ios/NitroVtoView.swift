@@ -7,7 +7,8 @@ import MetalKit
  *
  * This view handles:
  * - ARKit session management for face tracking
- * - Filament rendering via VTORendererBridge
+ * - Filament rendering via VTORendererBridge (on its own render thread and display link,
+ *   so a busy main / JS thread doesn't drop VTO frames)
  * - Face tracking and glasses overlay
  *
  * Note: Camera permissions must be handled by the consuming React Native app
@@ -27,24 +28,48 @@ class NitroVtoView: UIView {
     // Filament renderer (Objective-C++ bridge)
     private var vtoRenderer: VTORendererBridge?
 
+    // Per-stage frame times over the view while debug is on, refreshed twice a second
+    private var debugHud: UILabel?
+    private var debugHudTimer: Timer?
+
     // Configuration
     private var modelUrl: String = ""
     private var isActiveState: Bool = true
     private var faceMeshOcclusionState: Bool = true
     private var backPlaneOcclusionState: Bool = true
     private var forwardOffsetState: Float = 0.005
+    private var maxFacesState: Int = 1
     private var debugState: Bool = false
+    private var adaptivePerformanceState: Bool = false
+    // Prefetch requests made before the renderer exists
+    private var pendingPrefetchUrls: [String] = []
+    // Compare set and active model asked for before the renderer exists
+    private var compareModelUrls: [String] = []
+    private var pendingActiveModel: Int?
+    // Kept across renderer recreation, like the compare models
+    private var environment: String?
+
+    // Face pose buffer shared with JS; the renderer overwrites it every frame
+    let facePoseBuffer = NSMutableData(length: Int(VTORendererBridge.facePoseBufferLength()))!
 
     // Callbacks
     var onModelLoaded: ((String) -> Void)?
+    var onModelLoadProgress: ((String, Double) -> Void)?
+    var onPerformanceChange: ((Double, Double, String) -> Void)? {
+        didSet {
+            vtoRenderer?.onPerformanceChange = onPerformanceChange
+        }
+    }
+    var onCaptureComplete: ((String, Double) -> Void)? {
+        didSet {
+            vtoRenderer?.onCaptureComplete = onCaptureComplete
+        }
+    }
 
     // State
     private var isInitialized = false
     private var isResumed = false
 
-    // Display link for rendering
-    private var displayLink: CADisplayLink?
-
     override init(frame: CGRect) {
         super.init(frame: frame)
         setupMetalView()
@@ -95,15 +120,133 @@ class NitroVtoView: UIView {
     }
 
     func switchModel(modelUrl: String) {
-        self.modelUrl = modelUrl
-        vtoRenderer?.switchModel(withUrl: modelUrl)
+        onMainThread { [weak self] in
+            guard let self = self else { return }
+            self.modelUrl = modelUrl
+            self.vtoRenderer?.switchModel(withUrl: modelUrl)
+        }
+    }
+
+    func prefetchModels(modelUrls: [String]) {
+        onMainThread { [weak self] in
+            guard let self = self else { return }
+            guard let renderer = self.vtoRenderer else {
+                self.pendingPrefetchUrls.append(contentsOf: modelUrls)
+                return
+            }
+            renderer.prefetchModels(withUrls: modelUrls)
+        }
+    }
+
+    func setCompareModels(modelUrls: [String]) {
+        onMainThread { [weak self] in
+            guard let self = self else { return }
+            self.compareModelUrls = modelUrls
+            self.vtoRenderer?.setCompareModelsWithUrls(modelUrls)
+        }
+    }
+
+    func setActiveModel(index: Int) {
+        onMainThread { [weak self] in
+            guard let self = self else { return }
+            guard let renderer = self.vtoRenderer else {
+                self.pendingActiveModel = index
+                return
+            }
+            renderer.setActiveModel(index)
+        }
+    }
+
+    func setEnvironment(name: String) {
+        onMainThread { [weak self] in
+            guard let self = self else { return }
+            self.environment = name
+            self.vtoRenderer?.setEnvironmentNamed(name)
+        }
+    }
+
+    func getModelMemoryStats() -> ModelMemoryStats {
+        // Empty before the renderer exists, apart from the device tier
+        let stats = vtoRenderer?.modelMemoryStats() ?? VTOModelMemoryStats()
+        return ModelMemoryStats(
+            modelCount: Double(stats.modelCount),
+            compareModelCount: Double(stats.compareModelCount),
+            gpuBytes: Double(stats.gpuBytes),
+            cpuBytes: Double(stats.cpuBytes),
+            deviceTier: Double(vtoRenderer == nil ? VTORendererBridge.deviceTier() : stats.deviceTier)
+        )
+    }
+
+    func warmUp() {
+        // The engine and materials are shared, so this also covers a view that isn't initialized yet
+        VTORendererBridge.warmUp()
+    }
+
+    func getPerformanceStats() -> PerformanceStats {
+        // Zeroed before the renderer exists
+        let stats = vtoRenderer?.performanceStats() ?? VTOPerformanceStats()
+        return PerformanceStats(
+            frameCount: Double(stats.frameCount),
+            droppedFrames: Double(stats.droppedFrames),
+            session: StageTiming(stats.session),
+            camera: StageTiming(stats.camera),
+            faceMesh: StageTiming(stats.faceMesh),
+            glassesPose: StageTiming(stats.glassesPose),
+            resources: StageTiming(stats.resources),
+            render: StageTiming(stats.render),
+            frame: StageTiming(stats.frame),
+            gpu: StageTiming(stats.gpu)
+        )
+    }
+
+    func startFaceRecording(filePath: String) {
+        onMainThread { [weak self] in
+            self?.vtoRenderer?.startFaceRecording(toPath: filePath)
+        }
+    }
+
+    func stopFaceRecording() {
+        onMainThread { [weak self] in
+            self?.vtoRenderer?.stopFaceRecording()
+        }
+    }
+
+    func capture(filePath: String) {
+        onMainThread { [weak self] in
+            self?.vtoRenderer?.capture(toPath: filePath)
+        }
+    }
+
+    func startRecording(filePath: String) {
+        onMainThread { [weak self] in
+            self?.vtoRenderer?.startRecording(toPath: filePath)
+        }
+    }
+
+    func stopRecording() {
+        onMainThread { [weak self] in
+            self?.vtoRenderer?.stopRecording()
+        }
     }
 
     func resetSession() {
-        vtoRenderer?.resetSession()
-        if let session = arSession {
-            let configuration = createARConfiguration()
-            session.run(configuration, options: [.resetTracking, .removeExistingAnchors])
+        onMainThread { [weak self] in
+            guard let self = self else { return }
+            self.vtoRenderer?.resetSession()
+            if let session = self.arSession {
+                let configuration = self.createARConfiguration()
+                session.run(configuration, options: [.resetTracking, .removeExistingAnchors])
+            }
+        }
+    }
+
+    /// Hybrid methods arrive on the JS thread: run them on the main thread, where the view's state
+    /// lives and the renderer's command ring has its single producer (right away when already there)
+    private func onMainThread(_ block: @escaping () -> Void) {
+        if Thread.isMainThread {
+            block()
+        } else {
+            DispatchQueue.main.async(execute: block)
         }
     }
 
@@ -122,9 +265,26 @@ class NitroVtoView: UIView {
         vtoRenderer?.setForwardOffset(forwardOffsetState)
     }
 
+    func setMaxFaces(_ maxFaces: Double?) {
+        let count = max(1, Int(maxFaces ?? 1))
+        guard count != maxFacesState else { return }
+        maxFacesState = count
+        vtoRenderer?.setMaxFaces(count)
+        // Track the new number of faces without resetting the session (a paused one picks it up on resume)
+        if isResumed && isActiveState, let session = arSession {
+            session.run(createARConfiguration())
+        }
+    }
+
     func setDebug(_ enabled: Bool?) {
         debugState = enabled ?? false
         vtoRenderer?.setDebug(debugState)
+        updateDebugHud()
+    }
+
+    func setAdaptivePerformance(_ enabled: Bool?) {
+        adaptivePerformanceState = enabled ?? false
+        vtoRenderer?.setAdaptivePerformance(adaptivePerformanceState)
     }
 
     // MARK: - Initialization
@@ -139,13 +299,32 @@ class NitroVtoView: UIView {
         // Create and initialize renderer
         vtoRenderer = VTORendererBridge(metalView: mtkView)
         vtoRenderer?.onModelLoaded = onModelLoaded
+        vtoRenderer?.onModelLoadProgress = onModelLoadProgress
+        vtoRenderer?.onPerformanceChange = onPerformanceChange
+        vtoRenderer?.onCaptureComplete = onCaptureComplete
+        vtoRenderer?.facePoseBuffer = facePoseBuffer
+        vtoRenderer?.initialEnvironment = environment
         vtoRenderer?.initialize(withModelUrl: modelUrl)
 
         // Apply stored configuration states
         vtoRenderer?.setFaceMeshOcclusion(faceMeshOcclusionState)
         vtoRenderer?.setBackPlaneOcclusion(backPlaneOcclusionState)
         vtoRenderer?.setForwardOffset(forwardOffsetState)
+        vtoRenderer?.setMaxFaces(maxFacesState)
         vtoRenderer?.setDebug(debugState)
+        vtoRenderer?.setAdaptivePerformance(adaptivePerformanceState)
+        updateDebugHud()
+        if !pendingPrefetchUrls.isEmpty {
+            vtoRenderer?.prefetchModels(withUrls: pendingPrefetchUrls)
+            pendingPrefetchUrls.removeAll()
+        }
+        if !compareModelUrls.isEmpty {
+            vtoRenderer?.setCompareModelsWithUrls(compareModelUrls)
+        }
+        if let index = pendingActiveModel {
+            vtoRenderer?.setActiveModel(index)
+            pendingActiveModel = nil
+        }
 
         isInitialized = true
         print("\(NitroVtoView.TAG): NitroVtoView initialized")
@@ -166,53 +345,57 @@ class NitroVtoView: UIView {
         // Setup AR session if needed
         setupARSession()
 
-        // Start display link for rendering
-        startDisplayLink()
-
-        // Resume renderer
+        // Resume renderer (starts its display link on the render thread)
         vtoRenderer?.resume()
     }
 
     func pause() {
-        stopDisplayLink()
         vtoRenderer?.pause()
         arSession?.pause()
         isResumed = false
     }
 
     func destroy() {
-        stopDisplayLink()
         arSession?.pause()
         arSession = nil
         vtoRenderer?.destroy()
         vtoRenderer = nil
         isInitialized = false
+        updateDebugHud()
     }
 
-    // MARK: - Display Link
-
-    private func startDisplayLink() {
-        guard displayLink == nil else { return }
-        displayLink = CADisplayLink(target: self, selector: #selector(render))
-        displayLink?.preferredFramesPerSecond = 60
-        displayLink?.add(to: .main, forMode: .common)
-    }
+    // MARK: - Debug HUD
 
-    private func stopDisplayLink() {
-        displayLink?.invalidate()
-        displayLink = nil
+    private func updateDebugHud() {
+        guard debugState && vtoRenderer != nil else {
+            debugHudTimer?.invalidate()
+            debugHudTimer = nil
+            debugHud?.removeFromSuperview()
+            debugHud = nil
+            return
+        }
+        guard debugHud == nil else { return }
+
+        let label = UILabel()
+        label.numberOfLines = 0
+        label.font = UIFont.monospacedSystemFont(ofSize: 11, weight: .regular)
+        label.textColor = .white
+        label.backgroundColor = UIColor.black.withAlphaComponent(0.5)
+        label.isUserInteractionEnabled = false
+        addSubview(label)
+        debugHud = label
+        refreshDebugHud()
+
+        debugHudTimer = Timer.scheduledTimer(withTimeInterval: 0.5, repeats: true) { [weak self] _ in
+            self?.refreshDebugHud()
+        }
     }
 
-    @objc private func render() {
-        guard isInitialized, isActiveState else { return }
-        guard let session = arSession, let frame = session.currentFrame else { return }
-
-        // Get tracked faces
-        let faces = frame.anchors.compactMap { $0 as? ARFaceAnchor }
-            .filter { $0.isTracked }
-
-        // Update renderer with current frame
-        vtoRenderer?.render(with: frame, faces: faces)
+    private func refreshDebugHud() {
+        guard let label = debugHud, let renderer = vtoRenderer else { return }
+        label.text = renderer.performanceSummary()
+        let size = label.sizeThatFits(CGSize(width: bounds.width, height: bounds.height))
+        label.frame = CGRect(x: 8, y: safeAreaInsets.top + 8, width: size.width, height: size.height)
     }
 
     // MARK: - ARKit Setup
@@ -246,7 +429,9 @@ class NitroVtoView: UIView {
         let configuration = ARFaceTrackingConfiguration()
         configuration.isLightEstimationEnabled = true
         if #available(iOS 13.0, *) {
-            configuration.maximumNumberOfTrackedFaces = 1
+            // Devices before A12 track a single face
+            configuration.maximumNumberOfTrackedFaces =
+                min(maxFacesState, ARFaceTrackingConfiguration.supportedNumberOfTrackedFaces)
         }
         return configuration
     }
@@ -274,3 +459,15 @@ class NitroVtoView: UIView {
         }
     }
 }
+
+private extension StageTiming {
+    init(_ timing: VTOStageTiming) {
+        self.init(
+            p50: timing.p50,
+            p95: timing.p95,
+            p99: timing.p99,
+            max: timing.max,
+            samples: Double(timing.samples)
+        )
+    }
+}
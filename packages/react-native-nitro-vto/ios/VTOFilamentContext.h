@@ -0,0 +1,79 @@
+#import <Foundation/Foundation.h>
+
+namespace filament {
+    class Engine;
+    class Material;
+    class Texture;
+    namespace gltfio {
+        class MaterialProvider;
+    }
+}
+
+@class VTORenderThread;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Environment selected until a view picks another one
+extern NSString *const VTODefaultEnvironmentName;
+
+/// Called on the render thread with an environment's reflections cubemap, owned by the context
+typedef void (^VTOEnvironmentLoadedBlock)(filament::Texture *cubemap);
+
+/**
+ * Process-wide Filament state shared by every VTO view: render thread, engine,
+ * glTF ubershader material provider, the package's compiled materials and the environment
+ * reflection cubemaps.
+ * Reference counted; when the last view lets go it lingers for a grace period,
+ * so remounting a view skips engine startup and shader compilation.
+ * Engine, materialProvider and materialNamed: must only be used on renderThread.
+ */
+@interface VTOFilamentContext : NSObject
+
+/// Take a reference to the shared context, creating it if needed (any thread)
++ (VTOFilamentContext *)acquire;
+
+/// Create the shared context ahead of the first view, e.g. at app start, and compile the bundled
+/// materials' shader variants. It lingers for the grace period.
++ (void)warmUp;
+
+/// Drop a reference taken with +acquire; the context is torn down once unused for the grace period
+- (void)relinquish;
+
+/// Thread that owns the engine; every Filament call for this context goes through it
+@property (nonatomic, readonly) VTORenderThread *renderThread;
+
+/// Shared engine (render thread only; null until the creation block has run)
+@property (nonatomic, readonly) filament::Engine *engine;
+
+/// Shared glTF ubershader material provider (render thread only)
+@property (nonatomic, readonly) filament::gltfio::MaterialProvider *materialProvider;
+
+/// Material built once from a bundled .filamat asset and owned by the context (render thread only).
+/// Callers create their own MaterialInstances and destroy them, never the material.
+- (nullable filament::Material *)materialNamed:(NSString *)assetName;
+
+/// Compile the shader variants VTO renders with, once per material (render thread only).
+/// Without this, variants compile lazily on first draw and stall that frame.
+- (void)compileMaterial:(filament::Material *)material;
+
+/// Build and compile every bundled material (render thread only)
+- (void)warmUpMaterials;
+
+/// Whether name is one of the bundled environments (any thread)
++ (BOOL)isEnvironmentAvailable:(NSString *)name;
+
+/// Take a reference to an environment's reflections cubemap, loading it off the render thread if
+/// no view has it yet (render thread only). onLoaded is called on the render thread once it is
+/// ready (right away if it already is); it may run after a matching -relinquishEnvironmentNamed:,
+/// so callers check the environment is still the one they want. Callers never destroy the cubemap.
+/// If loading fails, onLoaded never runs and the next acquire of that environment retries.
+/// Returns NO if there's no such environment.
+- (BOOL)acquireEnvironmentNamed:(NSString *)name onLoaded:(VTOEnvironmentLoadedBlock)onLoaded;
+
+/// Drop a reference taken with -acquireEnvironmentNamed:onLoaded: (render thread only).
+/// Unused environments are kept until another one loads or the context is torn down.
+- (void)relinquishEnvironmentNamed:(NSString *)name;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,341 @@
+#import "VTOFilamentContext.h"
+#import "LoaderUtils.h"
+#import "VTORenderThread.h"
+
+#include <filament/Engine.h>
+#include <filament/Material.h>
+#include <filament/Texture.h>
+#include <ktxreader/Ktx1Reader.h>
+#include <gltfio/MaterialProvider.h>
+#include <gltfio/materials/uberarchive.h>
+
+using namespace filament;
+using namespace filament::gltfio;
+
+static NSString *const TAG = @"VTOFilamentContext";
+
+// How long the context outlives its last view (covers navigating away and back)
+static const NSTimeInterval TEARDOWN_DELAY_SECONDS = 30.0;
+
+// Scenes are lit by IBL only (no directional or dynamic lights, shadows or fog), so the base
+// variants are the only ones ever drawn, plus skinning for the face occluder and its overlay
+static const UserVariantFilterMask WARM_UP_VARIANTS = 0;
+static const UserVariantFilterMask SKINNED_WARM_UP_VARIANTS =
+    WARM_UP_VARIANTS | (UserVariantFilterMask)UserVariantFilterBit::SKINNING;
+
+// Materials the renderers use, compiled by -warmUpMaterials
+static NSArray<NSString *> *bundledMaterialNames(void) {
+    return @[
+        @"materials/camera_background_ios.filamat",
+        @"materials/face_occlusion.filamat",
+        @"materials/debug_face_material.filamat",
+    ];
+}
+
+// Bundled materials drawn on skinned renderables
+static NSSet<NSString *> *skinnedMaterialNames(void) {
+    return [NSSet setWithArray:@[
+        @"materials/face_occlusion.filamat",
+        @"materials/debug_face_material.filamat",
+    ]];
+}
+
+NSString *const VTODefaultEnvironmentName = @"studio";
+
+// Selectable environments and their reflection cubemaps (prefiltered IBL KTX) in the bundle
+static NSDictionary<NSString *, NSString *> *environmentAssetNames(void) {
+    return @{
+        @"studio": @"envs/studio_small_02_ibl.ktx",
+        @"brownPhotostudio": @"envs/brown_photostudio_01_ibl.ktx",
+        @"neonPhotostudio": @"envs/neon_photostudio_ibl.ktx",
+    };
+}
+
+/// Reflections cubemap of one environment, loaded once for every view showing it (render thread only)
+@interface VTOSharedEnvironment : NSObject
+@property (nonatomic, assign) Texture *cubemap;
+@property (nonatomic, assign) NSInteger refCount;
+@property (nonatomic, strong) NSMutableArray<VTOEnvironmentLoadedBlock> *onLoaded;
+// The last load failed; the next acquire loads it again
+@property (nonatomic, assign) BOOL failed;
+@end
+
+@implementation VTOSharedEnvironment
+@end
+
+// Guarded by @synchronized([VTOFilamentContext class])
+static VTOFilamentContext *sharedContext = nil;
+
+@implementation VTOFilamentContext {
+    NSInteger _refCount;
+    // Bumped on every acquire, so a stale delayed teardown knows it was superseded
+    NSUInteger _generation;
+
+    // Only touched on the render thread
+    Engine *_engine;
+    MaterialProvider *_materialProvider;
+    NSMutableDictionary<NSString *, NSValue *> *_materials;
+    NSMutableSet<NSValue *> *_compiledMaterials;
+    NSMutableDictionary<NSString *, VTOSharedEnvironment *> *_environments;
+}
+
++ (VTOFilamentContext *)acquire {
+    @synchronized (self) {
+        if (!sharedContext) {
+            sharedContext = [[VTOFilamentContext alloc] initPrivate];
+        }
+        sharedContext->_refCount++;
+        sharedContext->_generation++;
+        return sharedContext;
+    }
+}
+
++ (void)warmUp {
+    VTOFilamentContext *context = [self acquire];
+    [context.renderThread performAsync:^{
+        [context warmUpMaterials];
+    }];
+    [context relinquish];
+}
+
+- (instancetype)initPrivate {
+    self = [super init];
+    if (self) {
+        _renderThread = [[VTORenderThread alloc] initWithName:@"com.nitrovto.render"];
+        _materials = [NSMutableDictionary dictionary];
+        _compiledMaterials = [NSMutableSet set];
+        _environments = [NSMutableDictionary dictionary];
+        _refCount = 0;
+        _generation = 0;
+
+        // Queued first, so every block a view submits afterwards sees the engine
+        [_renderThread performAsync:^{
+            [self createOnRenderThread];
+        }];
+    }
+    return self;
+}
+
+- (void)createOnRenderThread {
+    NSDate *start = [NSDate date];
+
+    // In Filament 1.67.0, the Engine creates and manages its own Metal backend
+    _engine = Engine::create(Engine::Backend::METAL);
+    if (!_engine) {
+        NSLog(@"%@: Failed to create Filament engine", TAG);
+        return;
+    }
+    _materialProvider = createUbershaderProvider(_engine, UBERARCHIVE_DEFAULT_DATA, UBERARCHIVE_DEFAULT_SIZE);
+
+    NSLog(@"%@: Shared Filament engine created in %.0f ms", TAG, -start.timeIntervalSinceNow * 1000.0);
+}
+
+- (Engine *)engine {
+    return _engine;
+}
+
+- (MaterialProvider *)materialProvider {
+    return _materialProvider;
+}
+
+- (Material *)materialNamed:(NSString *)assetName {
+    if (!_engine) return nullptr;
+
+    NSValue *cached = _materials[assetName];
+    if (cached) {
+        return (Material *)cached.pointerValue;
+    }
+
+    NSData *materialData = [LoaderUtils loadAssetNamed:assetName];
+    if (!materialData) {
+        NSLog(@"%@: Failed to load material: %@", TAG, assetName);
+        return nullptr;
+    }
+
+    Material *material = Material::Builder()
+        .package(materialData.bytes, materialData.length)
+        .build(*_engine);
+    if (!material) {
+        NSLog(@"%@: Failed to build material: %@", TAG, assetName);
+        return nullptr;
+    }
+
+    _materials[assetName] = [NSValue valueWithPointer:material];
+    return material;
+}
+
+- (void)compileMaterial:(Material *)material {
+    [self compileMaterial:material skinned:NO];
+}
+
+- (void)compileMaterial:(Material *)material skinned:(BOOL)skinned {
+    if (!_engine || !material) return;
+
+    NSValue *key = [NSValue valueWithPointer:material];
+    if ([_compiledMaterials containsObject:key]) return;
+    [_compiledMaterials addObject:key];
+
+    // Queued on the driver's parallel compiler; draws wait only if the variant isn't ready yet
+    material->compile(Material::CompilerPriorityQueue::HIGH, skinned ? SKINNED_WARM_UP_VARIANTS : WARM_UP_VARIANTS);
+}
+
+- (void)warmUpMaterials {
+    if (!_engine) return;
+
+    NSSet<NSString *> *skinnedNames = skinnedMaterialNames();
+    for (NSString *name in bundledMaterialNames()) {
+        [self compileMaterial:[self materialNamed:name] skinned:[skinnedNames containsObject:name]];
+    }
+}
+
++ (BOOL)isEnvironmentAvailable:(NSString *)name {
+    return environmentAssetNames()[name] != nil;
+}
+
+- (BOOL)acquireEnvironmentNamed:(NSString *)name onLoaded:(VTOEnvironmentLoadedBlock)onLoaded {
+    NSString *assetName = environmentAssetNames()[name];
+    if (!assetName || !_engine) return NO;
+
+    VTOSharedEnvironment *existing = _environments[name];
+    if (existing) {
+        existing.refCount++;
+        if (existing.cubemap) {
+            onLoaded(existing.cubemap);
+            return YES;
+        }
+        [existing.onLoaded addObject:[onLoaded copy]];
+        if (existing.failed) {
+            existing.failed = NO;
+            [self loadEnvironment:existing named:name asset:assetName];
+        }
+        return YES;
+    }
+
+    [self evictUnusedEnvironments];
+    VTOSharedEnvironment *environment = [[VTOSharedEnvironment alloc] init];
+    environment.refCount = 1;
+    environment.onLoaded = [NSMutableArray arrayWithObject:[onLoaded copy]];
+    _environments[name] = environment;
+    [self loadEnvironment:environment named:name asset:assetName];
+    return YES;
+}
+
+/// Read and parse an environment's KTX off the render thread, then upload it and notify its listeners
+- (void)loadEnvironment:(VTOSharedEnvironment *)environment named:(NSString *)name asset:(NSString *)assetName {
+    NSDate *start = [NSDate date];
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        NSData *data = [LoaderUtils loadAssetNamed:assetName];
+        // Parsed here too: the render thread only uploads
+        auto bundle = data ? new image::Ktx1Bundle((const uint8_t *)data.bytes, (uint32_t)data.length) : nullptr;
+
+        [self.renderThread performAsync:^{
+            // Evicted or torn down while loading
+            if (!self->_engine || self->_environments[name] != environment) {
+                delete bundle;
+                return;
+            }
+            // Takes ownership of the bundle and destroys it after upload
+            Texture *cubemap = bundle ? ktxreader::Ktx1Reader::createTexture(self->_engine, bundle, false) : nullptr;
+            if (!cubemap) {
+                [self failEnvironment:environment named:name];
+                return;
+            }
+            environment.cubemap = cubemap;
+            NSLog(@"%@: Environment %@ loaded in %.0f ms", TAG, name, -start.timeIntervalSinceNow * 1000.0);
+
+            NSArray<VTOEnvironmentLoadedBlock> *listeners = [environment.onLoaded copy];
+            [environment.onLoaded removeAllObjects];
+            for (VTOEnvironmentLoadedBlock listener in listeners) {
+                listener(cubemap);
+            }
+        }];
+    });
+}
+
+/// A load failed (render thread): its listeners never fire, and the next acquire retries. The
+/// entry stays so the references already taken on it still balance.
+- (void)failEnvironment:(VTOSharedEnvironment *)environment named:(NSString *)name {
+    NSLog(@"%@: Failed to load environment %@", TAG, name);
+    environment.failed = YES;
+    [environment.onLoaded removeAllObjects];
+}
+
+- (void)relinquishEnvironmentNamed:(NSString *)name {
+    VTOSharedEnvironment *environment = _environments[name];
+    if (!environment) return;
+    if (environment.refCount <= 0) {
+        NSLog(@"%@: Unbalanced environment relinquish: %@", TAG, name);
+        return;
+    }
+    if (--environment.refCount > 0) return;
+    [environment.onLoaded removeAllObjects];
+}
+
+- (void)evictUnusedEnvironments {
+    for (NSString *name in _environments.allKeys) {
+        VTOSharedEnvironment *environment = _environments[name];
+        if (environment.refCount > 0) continue;
+        if (environment.cubemap) {
+            _engine->destroy(environment.cubemap);
+        }
+        [_environments removeObjectForKey:name];
+    }
+}
+
+- (void)relinquish {
+    NSUInteger generation;
+    @synchronized ([VTOFilamentContext class]) {
+        if (_refCount <= 0) {
+            NSLog(@"%@: Unbalanced relinquish", TAG);
+            return;
+        }
+        if (--_refCount > 0) return;
+        generation = _generation;
+    }
+
+    __weak __typeof__(self) weakSelf = self;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(TEARDOWN_DELAY_SECONDS * NSEC_PER_SEC)),
+                   dispatch_get_main_queue(), ^{
+        [weakSelf teardownIfUnusedSinceGeneration:generation];
+    });
+}
+
+- (void)teardownIfUnusedSinceGeneration:(NSUInteger)generation {
+    @synchronized ([VTOFilamentContext class]) {
+        // Re-acquired in the meantime: a later relinquish schedules its own teardown
+        if (_refCount > 0 || _generation != generation) return;
+        if (sharedContext == self) {
+            sharedContext = nil;
+        }
+    }
+
+    [_renderThread performSync:^{
+        [self destroyOnRenderThread];
+    }];
+    [_renderThread stop];
+    NSLog(@"%@: Shared Filament engine destroyed", TAG);
+}
+
+- (void)destroyOnRenderThread {
+    if (!_engine) return;
+
+    // Every view has relinquished its environment by now
+    [self evictUnusedEnvironments];
+
+    for (NSValue *material in _materials.allValues) {
+        _engine->destroy((Material *)material.pointerValue);
+    }
+    [_materials removeAllObjects];
+    [_compiledMaterials removeAllObjects];
+
+    if (_materialProvider) {
+        _materialProvider->destroyMaterials();
+        delete _materialProvider;
+        _materialProvider = nullptr;
+    }
+
+    Engine::destroy(&_engine);
+    _engine = nullptr;
+}
+
+@end
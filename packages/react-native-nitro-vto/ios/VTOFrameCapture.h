@@ -0,0 +1,45 @@
+#import <Foundation/Foundation.h>
+#import <QuartzCore/QuartzCore.h>
+
+namespace filament {
+    class Renderer;
+}
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Photo and video capture of the rendered view, without stalling the render thread.
+ * Frames are read back with Renderer::readPixels into a small pool of pixel buffers; Filament
+ * fills them a few frames later and the encoding (HEIC/JPEG with Core Image, H.264 with
+ * AVAssetWriter) runs on a background queue. With every buffer in flight a video frame is
+ * dropped from the recording, never from the display.
+ * Render thread only, except for the completion callback.
+ */
+@interface VTOFrameCapture : NSObject
+
+/// Called on the main thread once a file is written: durationSeconds is the video length,
+/// 0 for a photo, or -1 if writing failed
+@property (nonatomic, copy, nullable) void (^onCaptureComplete)(NSString *filePath, double durationSeconds);
+
+/// Save the next rendered frame to filePath: HEIC if it ends in .heic, JPEG otherwise
+- (void)capturePhotoToPath:(NSString *)filePath;
+
+/// Record rendered frames to an H.264 MP4 at filePath (replaces a recording in progress)
+- (void)startRecordingToPath:(NSString *)filePath;
+
+/// Finish the recording once its frames in flight are encoded
+- (void)stopRecording;
+
+/// Whether the frame rendered at timestamp (ARFrame clock) should be read back
+- (BOOL)wantsFrameAtTimestamp:(NSTimeInterval)timestamp;
+
+/// Read back the frame being rendered. Between Renderer::render and Renderer::endFrame; the
+/// renderer's swap chain must be readable (SwapChain::CONFIG_READABLE).
+- (void)readFrameFromRenderer:(filament::Renderer *)renderer
+                        width:(uint32_t)width
+                       height:(uint32_t)height
+                    timestamp:(NSTimeInterval)timestamp;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,382 @@
+#import "VTOFrameCapture.h"
+
+#import <Accelerate/Accelerate.h>
+#import <AVFoundation/AVFoundation.h>
+#import <CoreImage/CoreImage.h>
+#import <ImageIO/ImageIO.h>
+
+#include <filament/Renderer.h>
+#include <backend/PixelBufferDescriptor.h>
+
+#include <atomic>
+
+using namespace filament;
+
+static NSString *const TAG = @"VTOFrameCapture";
+
+// Readbacks in flight at once: Filament fills a buffer a few frames after the request
+static const NSUInteger MAX_BUFFERS_IN_FLIGHT = 3;
+
+static const NSInteger VIDEO_FRAMES_PER_SECOND = 30;
+// Slack when spacing video frames out (half a 60 Hz refresh)
+static const NSTimeInterval VIDEO_FRAME_INTERVAL_SLACK = 0.008;
+
+static const CGFloat PHOTO_QUALITY = 0.9;
+
+#pragma mark - Video recording
+
+/// One MP4 recording: the writer is created with the first frame's size, on the encode queue
+@interface VTOVideoRecording : NSObject
+@property (nonatomic, copy) NSString *filePath;
+@property (nonatomic, strong, nullable) AVAssetWriter *writer;
+@property (nonatomic, strong, nullable) AVAssetWriterInput *input;
+@property (nonatomic, strong, nullable) AVAssetWriterInputPixelBufferAdaptor *adaptor;
+@property (nonatomic, assign) NSTimeInterval firstTimestamp;
+@property (nonatomic, assign) NSTimeInterval lastTimestamp;
+// Render thread
+@property (nonatomic, assign) NSTimeInterval lastReadTimestamp;
+// Encode queue
+@property (nonatomic, assign) BOOL stopRequested;
+@property (nonatomic, assign) BOOL finished;
+@property (nonatomic, assign) BOOL failed;
+@end
+
+@implementation VTOVideoRecording {
+@public
+    // Readbacks issued on the render thread and not yet encoded
+    std::atomic<int> _framesInFlight;
+}
+
+- (instancetype)initWithFilePath:(NSString *)filePath {
+    self = [super init];
+    if (self) {
+        _filePath = [filePath copy];
+        _firstTimestamp = -1;
+        _lastTimestamp = -1;
+        _lastReadTimestamp = -1;
+        _framesInFlight.store(0);
+    }
+    return self;
+}
+
+@end
+
+#pragma mark - Readback
+
+/// A frame on its way back from the GPU, and what it is for
+@interface VTOReadback : NSObject
+@property (nonatomic, strong) VTOFrameCapture *capture;
+@property (nonatomic, strong) NSMutableData *pixels;
+@property (nonatomic, assign) uint32_t width;
+@property (nonatomic, assign) uint32_t height;
+@property (nonatomic, assign) NSTimeInterval timestamp;
+@property (nonatomic, copy) NSArray<NSString *> *photoPaths;
+@property (nonatomic, strong, nullable) VTOVideoRecording *recording;
+@end
+
+@implementation VTOReadback
+@end
+
+@interface VTOFrameCapture ()
+// Photos asked for since the last readback (render thread)
+@property (nonatomic, strong) NSMutableArray<NSString *> *pendingPhotoPaths;
+@property (nonatomic, strong, nullable) VTOVideoRecording *recording;
+@property (nonatomic, strong) dispatch_queue_t encodeQueue;
+@property (nonatomic, strong, nullable) CIContext *imageContext;
+// Pixel buffers not in flight, shared by the render thread and the encode queue
+@property (nonatomic, strong) NSMutableArray<NSMutableData *> *freeBuffers;
+@property (nonatomic, assign) NSUInteger buffersInFlight;
+
+- (void)encodeReadback:(VTOReadback *)readback;
+@end
+
+// Filament's readPixels callback: the buffer is filled, hand it to the encode queue
+static void readbackComplete(void *, size_t, void *user) {
+    VTOReadback *readback = (__bridge_transfer VTOReadback *)user;
+    VTOFrameCapture *capture = readback.capture;
+    dispatch_async(capture.encodeQueue, ^{
+        [capture encodeReadback:readback];
+    });
+}
+
+@implementation VTOFrameCapture
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _pendingPhotoPaths = [NSMutableArray array];
+        _encodeQueue = dispatch_queue_create("com.margelo.nitrovto.capture",
+                                             dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0));
+        _freeBuffers = [NSMutableArray array];
+    }
+    return self;
+}
+
+#pragma mark - Requests (render thread)
+
+- (void)capturePhotoToPath:(NSString *)filePath {
+    [_pendingPhotoPaths addObject:[filePath copy]];
+}
+
+- (void)startRecordingToPath:(NSString *)filePath {
+    [self stopRecording];
+    _recording = [[VTOVideoRecording alloc] initWithFilePath:filePath];
+    NSLog(@"%@: Recording to %@", TAG, filePath);
+}
+
+- (void)stopRecording {
+    VTOVideoRecording *recording = _recording;
+    if (!recording) return;
+    _recording = nil;
+    dispatch_async(_encodeQueue, ^{
+        recording.stopRequested = YES;
+        [self finishRecordingIfDone:recording];
+    });
+}
+
+- (BOOL)wantsFrameAtTimestamp:(NSTimeInterval)timestamp {
+    if (_pendingPhotoPaths.count > 0) return YES;
+    if (!_recording) return NO;
+    return _recording.lastReadTimestamp < 0 ||
+           timestamp - _recording.lastReadTimestamp >= 1.0 / VIDEO_FRAMES_PER_SECOND - VIDEO_FRAME_INTERVAL_SLACK;
+}
+
+- (void)readFrameFromRenderer:(Renderer *)renderer
+                        width:(uint32_t)width
+                       height:(uint32_t)height
+                    timestamp:(NSTimeInterval)timestamp {
+    if (width == 0 || height == 0) return;
+
+    // Every buffer in flight: photos wait for the next frame, the video skips this one
+    NSMutableData *pixels = [self takeBufferWithLength:(NSUInteger)width * height * 4];
+    if (!pixels) return;
+
+    VTOReadback *readback = [[VTOReadback alloc] init];
+    readback.capture = self;
+    readback.pixels = pixels;
+    readback.width = width;
+    readback.height = height;
+    readback.timestamp = timestamp;
+    readback.photoPaths = [_pendingPhotoPaths copy];
+    [_pendingPhotoPaths removeAllObjects];
+    if (_recording) {
+        readback.recording = _recording;
+        _recording.lastReadTimestamp = timestamp;
+        _recording->_framesInFlight.fetch_add(1);
+    }
+
+    // Bottom row first (Filament's readPixels convention)
+    backend::PixelBufferDescriptor descriptor(pixels.mutableBytes, pixels.length,
+                                              backend::PixelDataFormat::RGBA, backend::PixelDataType::UBYTE,
+                                              readbackComplete, (__bridge_retained void *)readback);
+    renderer->readPixels(0, 0, width, height, std::move(descriptor));
+}
+
+#pragma mark - Buffer pool
+
+- (nullable NSMutableData *)takeBufferWithLength:(NSUInteger)length {
+    @synchronized (self) {
+        if (_buffersInFlight >= MAX_BUFFERS_IN_FLIGHT) return nil;
+        _buffersInFlight++;
+        NSMutableData *buffer = _freeBuffers.lastObject;
+        if (!buffer) return [NSMutableData dataWithLength:length];
+        [_freeBuffers removeLastObject];
+        // A changed render scale resizes the buffer once
+        if (buffer.length != length) buffer.length = length;
+        return buffer;
+    }
+}
+
+- (void)returnBuffer:(NSMutableData *)buffer {
+    @synchronized (self) {
+        _buffersInFlight--;
+        [_freeBuffers addObject:buffer];
+    }
+}
+
+#pragma mark - Encoding (encode queue)
+
+- (void)encodeReadback:(VTOReadback *)readback {
+    for (NSString *path in readback.photoPaths) {
+        BOOL written = [self writePhoto:readback toPath:path];
+        [self reportCompletion:path duration:written ? 0 : -1];
+    }
+
+    VTOVideoRecording *recording = readback.recording;
+    if (recording) {
+        if (!recording.finished && !recording.failed) {
+            [self appendFrame:readback toRecording:recording];
+        }
+        recording->_framesInFlight.fetch_sub(1);
+        [self finishRecordingIfDone:recording];
+    }
+
+    [self returnBuffer:readback.pixels];
+}
+
+- (BOOL)writePhoto:(VTOReadback *)readback toPath:(NSString *)path {
+    if (!_imageContext) {
+        _imageContext = [CIContext contextWithOptions:@{kCIContextCacheIntermediates: @NO}];
+    }
+
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateWithName(kCGColorSpaceSRGB);
+    CIImage *image = [CIImage imageWithBitmapData:readback.pixels
+                                      bytesPerRow:readback.width * 4
+                                             size:CGSizeMake(readback.width, readback.height)
+                                           format:kCIFormatRGBA8
+                                       colorSpace:colorSpace];
+    // Rows were read bottom first
+    image = [image imageByApplyingCGOrientation:kCGImagePropertyOrientationDownMirrored];
+
+    NSURL *url = [NSURL fileURLWithPath:path];
+    NSDictionary *options = @{(__bridge NSString *)kCGImageDestinationLossyCompressionQuality: @(PHOTO_QUALITY)};
+    NSError *error = nil;
+    BOOL written;
+    if ([path.pathExtension.lowercaseString isEqualToString:@"heic"]) {
+        written = [_imageContext writeHEIFRepresentationOfImage:image
+                                                          toURL:url
+                                                         format:kCIFormatRGBA8
+                                                     colorSpace:colorSpace
+                                                        options:options
+                                                          error:&error];
+    } else {
+        written = [_imageContext writeJPEGRepresentationOfImage:image
+                                                          toURL:url
+                                                     colorSpace:colorSpace
+                                                        options:options
+                                                          error:&error];
+    }
+    CGColorSpaceRelease(colorSpace);
+
+    if (!written) {
+        NSLog(@"%@: Failed to write photo %@: %@", TAG, path, error.localizedDescription);
+    }
+    return written;
+}
+
+- (BOOL)startWriter:(VTOVideoRecording *)recording width:(uint32_t)width height:(uint32_t)height {
+    // H.264 wants even dimensions
+    width &= ~1u;
+    height &= ~1u;
+
+    NSURL *url = [NSURL fileURLWithPath:recording.filePath];
+    [[NSFileManager defaultManager] removeItemAtURL:url error:nil];
+    NSError *error = nil;
+    AVAssetWriter *writer = [AVAssetWriter assetWriterWithURL:url fileType:AVFileTypeMPEG4 error:&error];
+    if (!writer) {
+        NSLog(@"%@: Failed to create video writer: %@", TAG, error.localizedDescription);
+        return NO;
+    }
+
+    NSDictionary *settings = @{
+        AVVideoCodecKey: AVVideoCodecTypeH264,
+        AVVideoWidthKey: @(width),
+        AVVideoHeightKey: @(height),
+        AVVideoCompressionPropertiesKey: @{
+            AVVideoAverageBitRateKey: @(width * height * 4),
+            AVVideoExpectedSourceFrameRateKey: @(VIDEO_FRAMES_PER_SECOND),
+        },
+    };
+    AVAssetWriterInput *input = [AVAssetWriterInput assetWriterInputWithMediaType:AVMediaTypeVideo outputSettings:settings];
+    input.expectsMediaDataInRealTime = YES;
+    NSDictionary *pixelBufferAttributes = @{
+        (__bridge NSString *)kCVPixelBufferPixelFormatTypeKey: @(kCVPixelFormatType_32BGRA),
+        (__bridge NSString *)kCVPixelBufferWidthKey: @(width),
+        (__bridge NSString *)kCVPixelBufferHeightKey: @(height),
+    };
+    AVAssetWriterInputPixelBufferAdaptor *adaptor =
+        [AVAssetWriterInputPixelBufferAdaptor assetWriterInputPixelBufferAdaptorWithAssetWriterInput:input
+                                                                         sourcePixelBufferAttributes:pixelBufferAttributes];
+    if (![writer canAddInput:input]) {
+        NSLog(@"%@: Video writer rejected %ux%u H.264", TAG, width, height);
+        return NO;
+    }
+    [writer addInput:input];
+    if (![writer startWriting]) {
+        NSLog(@"%@: Failed to start video writer: %@", TAG, writer.error.localizedDescription);
+        return NO;
+    }
+    [writer startSessionAtSourceTime:kCMTimeZero];
+
+    recording.writer = writer;
+    recording.input = input;
+    recording.adaptor = adaptor;
+    return YES;
+}
+
+- (void)appendFrame:(VTOReadback *)readback toRecording:(VTOVideoRecording *)recording {
+    if (!recording.writer && ![self startWriter:recording width:readback.width height:readback.height]) {
+        recording.failed = YES;
+        return;
+    }
+    // The encoder is behind, or the frame is out of order: drop it from the video
+    if (!recording.input.readyForMoreMediaData || readback.timestamp <= recording.lastTimestamp) return;
+
+    CVPixelBufferRef pixelBuffer = NULL;
+    if (CVPixelBufferPoolCreatePixelBuffer(NULL, recording.adaptor.pixelBufferPool, &pixelBuffer) != kCVReturnSuccess) {
+        return;
+    }
+
+    // Flip to top row first and swizzle RGBA to BGRA, into the encoder's own buffer
+    vImage_Buffer source = {readback.pixels.mutableBytes, readback.height, readback.width, readback.width * 4};
+    vImageVerticalReflect_ARGB8888(&source, &source, kvImageNoFlags);
+    CVPixelBufferLockBaseAddress(pixelBuffer, 0);
+    vImage_Buffer destination = {
+        CVPixelBufferGetBaseAddress(pixelBuffer),
+        CVPixelBufferGetHeight(pixelBuffer),
+        CVPixelBufferGetWidth(pixelBuffer),
+        CVPixelBufferGetBytesPerRow(pixelBuffer),
+    };
+    const uint8_t rgbaToBgra[4] = {2, 1, 0, 3};
+    if (source.width == destination.width && source.height == destination.height) {
+        vImagePermuteChannels_ARGB8888(&source, &destination, rgbaToBgra, kvImageNoFlags);
+    } else {
+        // Odd sizes and render scale changes since the recording started
+        vImagePermuteChannels_ARGB8888(&source, &source, rgbaToBgra, kvImageNoFlags);
+        vImageScale_ARGB8888(&source, &destination, NULL, kvImageNoFlags);
+    }
+    CVPixelBufferUnlockBaseAddress(pixelBuffer, 0);
+
+    if (recording.firstTimestamp < 0) recording.firstTimestamp = readback.timestamp;
+    CMTime time = CMTimeMakeWithSeconds(readback.timestamp - recording.firstTimestamp, 600);
+    if ([recording.adaptor appendPixelBuffer:pixelBuffer withPresentationTime:time]) {
+        recording.lastTimestamp = readback.timestamp;
+    }
+    CVPixelBufferRelease(pixelBuffer);
+}
+
+- (void)finishRecordingIfDone:(VTOVideoRecording *)recording {
+    if (!recording.stopRequested || recording.finished || recording->_framesInFlight.load() > 0) return;
+    recording.finished = YES;
+
+    NSString *path = recording.filePath;
+    if (!recording.writer || recording.failed) {
+        [self reportCompletion:path duration:-1];
+        return;
+    }
+
+    double duration = recording.lastTimestamp > recording.firstTimestamp
+        ? recording.lastTimestamp - recording.firstTimestamp + 1.0 / VIDEO_FRAMES_PER_SECOND
+        : 0;
+    [recording.input markAsFinished];
+    AVAssetWriter *writer = recording.writer;
+    [writer finishWritingWithCompletionHandler:^{
+        BOOL written = writer.status == AVAssetWriterStatusCompleted;
+        if (written) {
+            NSLog(@"%@: Recording finished: %.1f s", TAG, duration);
+        } else {
+            NSLog(@"%@: Failed to finish recording %@: %@", TAG, path, writer.error.localizedDescription);
+        }
+        [self reportCompletion:path duration:written ? duration : -1];
+    }];
+}
+
+- (void)reportCompletion:(NSString *)path duration:(double)duration {
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if (self.onCaptureComplete) {
+            self.onCaptureComplete(path, duration);
+        }
+    });
+}
+
+@end
@@ -0,0 +1,39 @@
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Dedicated render thread with its own run loop and display link.
+ * All Filament and ARKit frame work runs here, so a busy main (UI / JS) thread
+ * doesn't drop VTO frames. Blocks are executed in submission order.
+ * Shared by every view of a VTOFilamentContext: each view registers its own frame handler
+ * under a key, and one display link drives them all.
+ */
+@interface VTORenderThread : NSObject
+
+- (instancetype)initWithName:(NSString *)name NS_DESIGNATED_INITIALIZER;
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Whether the caller is running on the render thread
+@property (nonatomic, readonly) BOOL isCurrentThread;
+
+/// Enqueue a block on the render thread
+- (void)performAsync:(dispatch_block_t)block;
+
+/// Run a block on the render thread and wait for it (runs inline when already on it)
+- (void)performSync:(dispatch_block_t)block;
+
+/// Start calling onFrame from the render thread on every display refresh (replaces the key's previous handler)
+- (void)startDisplayLinkForKey:(id<NSCopying>)key
+      preferredFramesPerSecond:(NSInteger)framesPerSecond
+                       onFrame:(dispatch_block_t)onFrame;
+
+/// Remove the key's frame handler; the display link stops with the last one (pending blocks still run)
+- (void)stopDisplayLinkForKey:(id<NSCopying>)key;
+
+/// Stop the display link and the run loop, then wait for the thread to exit
+- (void)stop;
+
+@end
+
+NS_ASSUME_NONNULL_END
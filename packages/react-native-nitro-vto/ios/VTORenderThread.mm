@@ -0,0 +1,152 @@
+#import "VTORenderThread.h"
+#import <QuartzCore/QuartzCore.h>
+
+#include <atomic>
+
+static NSString *const TAG = @"VTORenderThread";
+
+@implementation VTORenderThread {
+    NSThread *_thread;
+    CFRunLoopRef _runLoop;
+    dispatch_semaphore_t _exited;
+    std::atomic<bool> _stopped;
+
+    // Only touched on the render thread
+    CADisplayLink *_displayLink;
+    NSMutableDictionary<id<NSCopying>, dispatch_block_t> *_frameHandlers;
+}
+
+- (instancetype)initWithName:(NSString *)name {
+    self = [super init];
+    if (self) {
+        dispatch_semaphore_t ready = dispatch_semaphore_create(0);
+        _exited = dispatch_semaphore_create(0);
+
+        __block CFRunLoopRef runLoop = nullptr;
+        dispatch_semaphore_t exited = _exited;
+        _thread = [[NSThread alloc] initWithBlock:^{
+            // A port keeps the run loop alive while no source or timer is attached
+            NSRunLoop *currentRunLoop = [NSRunLoop currentRunLoop];
+            [currentRunLoop addPort:[NSMachPort port] forMode:NSDefaultRunLoopMode];
+            runLoop = (CFRunLoopRef)CFRetain(currentRunLoop.getCFRunLoop);
+            dispatch_semaphore_signal(ready);
+
+            // Returns after each handled source; CFRunLoopStop breaks out for good
+            CFRunLoopRun();
+
+            NSLog(@"%@: Render thread exited", TAG);
+            dispatch_semaphore_signal(exited);
+        }];
+        _thread.name = name;
+        _thread.qualityOfService = NSQualityOfServiceUserInteractive;
+        [_thread start];
+
+        dispatch_semaphore_wait(ready, DISPATCH_TIME_FOREVER);
+        _runLoop = runLoop;
+        _frameHandlers = [NSMutableDictionary dictionary];
+        _stopped.store(false);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    // A live display link retains us, so only the run loop can still be running here
+    if (!_stopped.exchange(true)) {
+        CFRunLoopPerformBlock(_runLoop, kCFRunLoopCommonModes, ^{
+            CFRunLoopStop(CFRunLoopGetCurrent());
+        });
+        CFRunLoopWakeUp(_runLoop);
+        dispatch_semaphore_wait(_exited, DISPATCH_TIME_FOREVER);
+    }
+    if (_runLoop) {
+        CFRelease(_runLoop);
+        _runLoop = nullptr;
+    }
+}
+
+- (BOOL)isCurrentThread {
+    return [NSThread currentThread] == _thread;
+}
+
+- (void)performAsync:(dispatch_block_t)block {
+    if (_stopped.load()) {
+        NSLog(@"%@: Render thread stopped, dropping block", TAG);
+        return;
+    }
+    CFRunLoopPerformBlock(_runLoop, kCFRunLoopCommonModes, block);
+    CFRunLoopWakeUp(_runLoop);
+}
+
+- (void)performSync:(dispatch_block_t)block {
+    if (self.isCurrentThread) {
+        block();
+        return;
+    }
+    if (_stopped.load()) {
+        NSLog(@"%@: Render thread stopped, dropping block", TAG);
+        return;
+    }
+    dispatch_semaphore_t done = dispatch_semaphore_create(0);
+    [self performAsync:^{
+        block();
+        dispatch_semaphore_signal(done);
+    }];
+    dispatch_semaphore_wait(done, DISPATCH_TIME_FOREVER);
+}
+
+- (void)startDisplayLinkForKey:(id<NSCopying>)key
+      preferredFramesPerSecond:(NSInteger)framesPerSecond
+                       onFrame:(dispatch_block_t)onFrame {
+    dispatch_block_t handler = [onFrame copy];
+    [self performAsync:^{
+        self->_frameHandlers[key] = handler;
+        if (self->_displayLink) return;
+
+        self->_displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(displayLinkFired:)];
+        self->_displayLink.preferredFramesPerSecond = framesPerSecond;
+        [self->_displayLink addToRunLoop:[NSRunLoop currentRunLoop] forMode:NSRunLoopCommonModes];
+    }];
+}
+
+- (void)stopDisplayLinkForKey:(id<NSCopying>)key {
+    [self performAsync:^{
+        [self->_frameHandlers removeObjectForKey:key];
+        if (self->_frameHandlers.count == 0) {
+            [self invalidateDisplayLink];
+        }
+    }];
+}
+
+- (void)invalidateDisplayLink {
+    // The display link retains its target, so it must be invalidated to release us
+    [_displayLink invalidate];
+    _displayLink = nil;
+    [_frameHandlers removeAllObjects];
+}
+
+- (void)displayLinkFired:(CADisplayLink *)displayLink {
+    // Copy: a handler may stop its own display link mid-iteration
+    for (dispatch_block_t handler in [_frameHandlers.allValues copy]) {
+        handler();
+    }
+}
+
+- (void)stop {
+    if (self.isCurrentThread) {
+        // Can't join ourselves: just stop the run loop after the current block
+        if (_stopped.exchange(true)) return;
+        [self invalidateDisplayLink];
+        CFRunLoopStop(_runLoop);
+        return;
+    }
+
+    if (_stopped.load()) return;
+    [self performAsync:^{
+        [self invalidateDisplayLink];
+        CFRunLoopStop(CFRunLoopGetCurrent());
+    }];
+    _stopped.store(true);
+    dispatch_semaphore_wait(_exited, DISPATCH_TIME_FOREVER);
+}
+
+@end
@@ -5,15 +5,83 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/// Distribution of one frame stage over the rolling window, in milliseconds
+typedef struct {
+    double p50;
+    double p95;
+    double p99;
+    double max;
+    NSUInteger samples;
+} VTOStageTiming;
+
+/// Snapshot of a view's frame times (see FrameStage in cpp/FrameStats.hpp for what each stage covers)
+typedef struct {
+    NSUInteger frameCount;
+    /// Frames Filament skipped because the GPU was behind
+    NSUInteger droppedFrames;
+    VTOStageTiming session;
+    VTOStageTiming camera;
+    VTOStageTiming faceMesh;
+    VTOStageTiming glassesPose;
+    VTOStageTiming resources;
+    VTOStageTiming render;
+    VTOStageTiming frame;
+    VTOStageTiming gpu;
+} VTOPerformanceStats;
+
+/// Estimated memory of the glasses models a view keeps loaded
+typedef struct {
+    NSUInteger modelCount;
+    /// Compare models (setCompareModelsWithUrls:) among them
+    NSUInteger compareModelCount;
+    /// Vertex, index and texture bytes on the GPU, estimated from each GLB
+    uint64_t gpuBytes;
+    /// GLB source data held until each model's textures are decoded
+    uint64_t cpuBytes;
+    /// vto::DeviceTier: 0 = low, 1 = mid, 2 = high
+    NSInteger deviceTier;
+} VTOModelMemoryStats;
+
 /**
  * Objective-C bridge for the Filament VTO Renderer.
  * Provides a Swift-accessible interface to the C++ Filament rendering code.
+ * Filament and ARKit frame processing run on a dedicated render thread: the methods below
+ * may be called from the main thread and are marshalled onto it in call order.
  */
 @interface VTORendererBridge : NSObject
 
-/// Callback for when model loading completes
+/// Callback for when model loading completes (called on the main thread)
 @property (nonatomic, copy, nullable) void (^onModelLoaded)(NSString *url);
 
+/// Callback for model resource decode progress in [0, 1] (called on the main thread)
+@property (nonatomic, copy, nullable) void (^onModelLoadProgress)(NSString *url, double progress);
+
+/// Callback for when a capture or recording file is written: durationSeconds is the video length,
+/// 0 for a photo, or -1 on failure (called on the main thread)
+@property (nonatomic, copy, nullable) void (^onCaptureComplete)(NSString *filePath, double durationSeconds);
+
+/// Callback for adaptive performance render scale / frame rate changes (called on the main thread)
+@property (nonatomic, copy, nullable) void (^onPerformanceChange)(double renderScale, double framesPerSecond, NSString *reason);
+
+/// Buffer of facePoseBufferLength bytes the renderer overwrites every frame with the tracked faces'
+/// poses, under a seqlock. Shared with JS without copies; set it before initializeWithModelUrl:.
+@property (atomic, strong, nullable) NSMutableData *facePoseBuffer;
+
+/// Environment the lighting starts with (default "studio"); set it before initializeWithModelUrl:,
+/// then switch with setEnvironmentNamed:
+@property (atomic, copy, nullable) NSString *initialEnvironment;
+
+/// Create the shared Filament engine and compile its materials ahead of the first view (e.g. at app
+/// launch), so mounting NitroVtoView pays for neither engine startup nor shader compilation.
+/// Safe to call from any thread.
++ (void)warmUp;
+
+/// Device class biasing level of detail, to size model budgets by: 0 = low, 1 = mid, 2 = high
++ (NSInteger)deviceTier;
+
+/// Byte length of a face pose buffer (layout in cpp/FacePoseStream.hpp)
++ (NSUInteger)facePoseBufferLength;
+
 /// Initialize with Metal view
 - (instancetype)initWithMetalView:(MTKView *)metalView;
 
@@ -23,18 +91,48 @@ NS_ASSUME_NONNULL_BEGIN
 /// Set viewport size
 - (void)setViewportSizeWithWidth:(int)width height:(int)height;
 
-/// Resume rendering
+/// Resume rendering (starts the render thread's display link)
 - (void)resume;
 
-/// Pause rendering
+/// Pause rendering (stops the render thread's display link)
 - (void)pause;
 
 /// Switch to a different model
 - (void)switchModelWithUrl:(NSString *)modelUrl;
 
+/// Download and decode models into the warm asset pool, so switching to them is instant
+- (void)prefetchModelsWithUrls:(NSArray<NSString *> *)modelUrls;
+
+/// Keep these models loaded side by side for setActiveModel: (an empty array releases them)
+- (void)setCompareModelsWithUrls:(NSArray<NSString *> *)modelUrls;
+
+/// Show the compare model at index, keeping the glasses' pose
+- (void)setActiveModel:(NSInteger)index;
+
+/// Switch the reflections to another bundled environment, shared with the other views
+- (void)setEnvironmentNamed:(NSString *)name;
+
+/// Estimated memory of the loaded glasses models. Any thread.
+- (VTOModelMemoryStats)modelMemoryStats;
+
 /// Reset the AR session
 - (void)resetSession;
 
+/// Record camera and face tracking data of every rendered frame to filePath
+- (void)startFaceRecordingToPath:(NSString *)filePath;
+
+/// Finish the face recording started by startFaceRecordingToPath:
+- (void)stopFaceRecording;
+
+/// Save the next rendered frame to filePath (HEIC for a .heic path, JPEG otherwise)
+- (void)captureToPath:(NSString *)filePath;
+
+/// Record the rendered view to an H.264 MP4 at filePath
+- (void)startRecordingToPath:(NSString *)filePath;
+
+/// Finish the recording started by startRecordingToPath:
+- (void)stopRecording;
+
 /// Set face mesh occlusion enabled
 - (void)setFaceMeshOcclusion:(BOOL)enabled;
 
@@ -44,16 +142,25 @@ NS_ASSUME_NONNULL_BEGIN
 /// Set forward offset for glasses positioning (in meters)
 - (void)setForwardOffset:(float)offset;
 
+/// Set how many tracked faces are fitted with glasses (clamped to [1, 3])
+- (void)setMaxFaces:(NSInteger)maxFaces;
+
 /// Set debug mode enabled
 - (void)setDebug:(BOOL)enabled;
 
-/// Render a frame with ARKit data
-- (void)renderWithFrame:(ARFrame *)frame faces:(NSArray<ARFaceAnchor *> *)faces;
+/// Adapt render scale and frame rate to the thermal state and frame times
+- (void)setAdaptivePerformance:(BOOL)enabled;
+
+/// Per-stage frame time percentiles over the last few seconds. Any thread.
+- (VTOPerformanceStats)performanceStats;
+
+/// The same percentiles as debug HUD text, one stage per line. Any thread.
+- (NSString *)performanceSummary;
 
 /// Set the AR session reference
 - (void)setARSession:(ARSession *)session;
 
-/// Cleanup and destroy resources
+/// Cleanup and destroy resources (blocks until the render thread has torn down)
 - (void)destroy;
 
 @end
@@ -10,19 +10,91 @@
 #include <utils/EntityManager.h>
 #include <math/mat4.h>
 
+#include <os/signpost.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+
+#include "FacePoseStream.hpp"
+#include "FaceRecording.hpp"
+#include "FramePacer.hpp"
+#include "FrameStats.hpp"
+#include "RendererCommand.hpp"
+
 #import "CameraTextureRenderer.h"
 #import "EnvironmentLightingRenderer.h"
 #import "FaceOcclusionRenderer.h"
+#import "FaceTopology.h"
 #import "GlassesRenderer.h"
 #import "DebugRenderer.h"
+#import "MatrixUtils.h"
+#import "VTOFrameCapture.h"
+#import "VTORenderThread.h"
+#import "VTOFilamentContext.h"
 
 using namespace filament;
 
 static NSString *const TAG = @"VTORenderer";
 
+static const NSInteger PREFERRED_FRAMES_PER_SECOND = 60;
+
+// Slack when skipping display refreshes for a lowered frame rate (half a 60 Hz refresh)
+static const CFTimeInterval FRAME_INTERVAL_SLACK = 0.008;
+
+// Camera-only pass-through rate once no face has been tracked for IDLE_DELAY seconds
+static const NSInteger IDLE_FRAMES_PER_SECOND = 30;
+static const CFTimeInterval IDLE_DELAY = 1.0;
+
+// Frame stages are signpost intervals under Instruments' Points of Interest
+static os_log_t VTOSignpostLog(void) {
+    static os_log_t log;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        log = os_log_create("com.margelo.nitrovto", OS_LOG_CATEGORY_POINTS_OF_INTEREST);
+    });
+    return log;
+}
+
+namespace {
+
+/// Times the enclosing scope as one frame stage, and marks it as a signpost interval
+class StageScope {
+public:
+    StageScope(vto::FrameTimings &timings, vto::FrameStage stage, const char *name)
+        : timings_(timings), stage_(stage), start_(CACurrentMediaTime()) {
+        signpost_ = os_signpost_id_generate(VTOSignpostLog());
+        os_signpost_interval_begin(VTOSignpostLog(), signpost_, "Frame stage", "%{public}s", name);
+    }
+
+    ~StageScope() {
+        os_signpost_interval_end(VTOSignpostLog(), signpost_, "Frame stage");
+        timings_.set(stage_, CACurrentMediaTime() - start_);
+    }
+
+private:
+    vto::FrameTimings &timings_;
+    vto::FrameStage stage_;
+    CFTimeInterval start_;
+    os_signpost_id_t signpost_;
+};
+
+} // namespace
+
+typedef NS_ENUM(NSInteger, VTOFrameOutcome) {
+    /// Nothing new to draw (no ARKit frame yet, or the same one with no scene changes)
+    VTOFrameOutcomeIdle,
+    VTOFrameOutcomePresented,
+    /// Filament skipped the frame because the GPU was behind
+    VTOFrameOutcomeDropped,
+};
+
 @interface VTORendererBridge ()
 
 @property (nonatomic, strong) MTKView *metalView;
+// Captured on the main thread: UIKit views must not be touched from the render thread
+@property (nonatomic, strong) CAMetalLayer *metalLayer;
 @property (nonatomic, assign) id<MTLDevice> metalDevice;
 @property (nonatomic, assign) id<MTLCommandQueue> commandQueue;
 
@@ -41,41 +113,108 @@ static NSString *const TAG = @"VTORenderer";
 @property (nonatomic, strong) FaceOcclusionRenderer *faceOcclusionRenderer;
 @property (nonatomic, strong) GlassesRenderer *glassesRenderer;
 @property (nonatomic, strong) DebugRenderer *debugRenderer;
+@property (nonatomic, strong) VTOFrameCapture *frameCapture;
+
+// Face mesh topology, cached from the first tracked face and shared by the face renderers
+@property (nonatomic, strong) FaceTopology *faceTopology;
 
-// ARKit
-@property (nonatomic, weak) ARSession *arSession;
+// ARKit (set from the main thread, read by the render loop)
+@property (atomic, weak) ARSession *arSession;
+
+// Shared engine, materials and render thread (refcounted across views)
+@property (nonatomic, strong, nullable) VTOFilamentContext *filamentContext;
+
+// Render thread: owns all Filament state below, so every public method hops onto it
+@property (nonatomic, strong) VTORenderThread *renderThread;
+// This view's frame handler on the shared render thread's display link
+@property (nonatomic, copy) NSString *displayLinkKey;
 
 // State
 @property (nonatomic, assign) BOOL initialized;
 @property (nonatomic, assign) int width;
 @property (nonatomic, assign) int height;
 
+// Adaptive performance (render thread), with the drawable scale mirrored on the main thread
+@property (nonatomic, assign) float renderScale;
+@property (nonatomic, assign) CFTimeInterval lastRenderedFrameTime;
+@property (nonatomic, assign) float drawableScale;
+@property (nonatomic, strong, nullable) id thermalObserver;
+
+// Idle tracking (render thread): faces and frames seen by the last rendered frame
+@property (nonatomic, assign) BOOL faceTracked;
+@property (nonatomic, assign) CFTimeInterval faceLostTime;
+@property (nonatomic, assign) NSTimeInterval lastARFrameTimestamp;
+
 // Model configuration
 @property (nonatomic, copy) NSString *modelUrl;
 
 @end
 
-@implementation VTORendererBridge
+@implementation VTORendererBridge {
+    // Prop changes: pushed by the main thread, drained by the render loop at the start of a frame
+    std::unique_ptr<vto::RendererCommandQueue> _commands;
+    std::atomic<bool> _renderLoopRunning;
+    // Present while adaptive performance is on (render thread only)
+    std::unique_ptr<vto::FramePacer> _framePacer;
+    // Per-stage frame times: recorded on the render thread, read by performanceStats from any thread
+    std::unique_ptr<vto::FrameStats> _frameStats;
+    vto::FrameTimings _frameTimings;
+    uint32_t _lastGpuFrameId;
+    // Filament's submit-to-display time of recent frames, rounded up to whole display intervals
+    double _presentLatency;
+    // Present while a face session is being recorded for scripts/replay-bench.ts (render thread only)
+    std::unique_ptr<vto::FaceRecordingWriter> _faceRecorder;
+}
+
++ (void)warmUp {
+    [VTOFilamentContext warmUp];
+}
+
++ (NSInteger)deviceTier {
+    return [GlassesRenderer deviceTierLevel];
+}
+
++ (NSUInteger)facePoseBufferLength {
+    return vto::kFacePoseBufferBytes;
+}
 
 - (instancetype)initWithMetalView:(MTKView *)metalView {
     self = [super init];
     if (self) {
         _metalView = metalView;
+        _metalLayer = (CAMetalLayer *)metalView.layer;
+        _metalLayer.opaque = YES;  // We don't need transparency - we render full camera background
+        _metalLayer.framebufferOnly = NO;  // Captured frames are read back from the drawable
         _metalDevice = metalView.device;
         _commandQueue = [_metalDevice newCommandQueue];
         _initialized = NO;
         _width = 0;
         _height = 0;
+        _renderScale = 1.0f;
+        _drawableScale = 1.0f;
+        _filamentContext = [VTOFilamentContext acquire];
+        _renderThread = _filamentContext.renderThread;
+        _displayLinkKey = [NSUUID UUID].UUIDString;
+        _commands = std::make_unique<vto::RendererCommandQueue>();
+        _renderLoopRunning.store(false);
+        _frameStats = std::make_unique<vto::FrameStats>();
+        _lastGpuFrameId = UINT32_MAX;
+        _presentLatency = 2.0 / PREFERRED_FRAMES_PER_SECOND;
     }
     return self;
 }
 
 - (void)initializeWithModelUrl:(NSString *)modelUrl {
+    [_renderThread performAsync:^{
+        [self initializeOnRenderThreadWithModelUrl:modelUrl];
+    }];
+}
+
+- (void)initializeOnRenderThreadWithModelUrl:(NSString *)modelUrl {
     _modelUrl = modelUrl;
 
-    // Initialize Filament engine with Metal backend
-    // In Filament 1.67.0, the Engine creates and manages its own Metal backend
-    _engine = Engine::create(Engine::Backend::METAL);
+    // Shared Metal engine, created on the render thread ahead of this block
+    _engine = _filamentContext.engine;
 
     if (!_engine) {
         NSLog(@"%@: Failed to create Filament engine", TAG);
@@ -97,49 +236,90 @@ static NSString *const TAG = @"VTORenderer";
     // Configure view
     _filamentView->setPostProcessingEnabled(false);
 
-    // Create swap chain from Metal layer
-    CAMetalLayer *metalLayer = (CAMetalLayer *)_metalView.layer;
-    metalLayer.opaque = YES;  // We don't need transparency - we render full camera background
-    _swapChain = _engine->createSwapChain((__bridge void *)metalLayer);
+    // Create swap chain from Metal layer, readable for photo and video capture
+    _swapChain = _engine->createSwapChain((__bridge void *)_metalLayer, SwapChain::CONFIG_READABLE);
 
     // Setup environment lighting
     _environmentLightingRenderer = [[EnvironmentLightingRenderer alloc] init];
-    [_environmentLightingRenderer setupWithEngine:_engine scene:_scene];
+    [_environmentLightingRenderer setupWithContext:_filamentContext
+                                             scene:_scene
+                                       environment:self.initialEnvironment ?: VTODefaultEnvironmentName];
 
     // Setup camera background
     _cameraTextureRenderer = [[CameraTextureRenderer alloc] init];
-    [_cameraTextureRenderer setupWithEngine:_engine scene:_scene];
+    [_cameraTextureRenderer setupWithContext:_filamentContext scene:_scene];
 
     // Setup face occlusion (renders face mesh to depth buffer for occlusion)
     _faceOcclusionRenderer = [[FaceOcclusionRenderer alloc] init];
-    [_faceOcclusionRenderer setupWithEngine:_engine scene:_scene];
+    [_faceOcclusionRenderer setupWithContext:_filamentContext scene:_scene];
 
     // Setup glasses renderer
     _glassesRenderer = [[GlassesRenderer alloc] init];
+    _glassesRenderer.renderThread = _renderThread;
     __weak __typeof__(self) weakSelf = self;
     _glassesRenderer.onModelLoaded = ^(NSString *url) {
-        if (weakSelf.onModelLoaded) {
-            weakSelf.onModelLoaded(url);
-        }
+        // Report on the main thread, as before the render thread existed
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (weakSelf.onModelLoaded) {
+                weakSelf.onModelLoaded(url);
+            }
+        });
     };
-    [_glassesRenderer setupWithEngine:_engine scene:_scene modelUrl:modelUrl];
+    _glassesRenderer.onModelLoadProgress = ^(NSString *url, double progress) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (weakSelf.onModelLoadProgress) {
+                weakSelf.onModelLoadProgress(url, progress);
+            }
+        });
+    };
+    [_glassesRenderer setupWithContext:_filamentContext scene:_scene modelUrl:modelUrl];
 
     // Setup debug renderer
     _debugRenderer = [[DebugRenderer alloc] init];
-    [_debugRenderer setupWithEngine:_engine scene:_scene];
+    [_debugRenderer setupWithContext:_filamentContext occlusionRenderer:_faceOcclusionRenderer];
+
+    // Setup photo and video capture (already reports on the main thread)
+    _frameCapture = [[VTOFrameCapture alloc] init];
+    _frameCapture.onCaptureComplete = ^(NSString *filePath, double durationSeconds) {
+        if (weakSelf.onCaptureComplete) {
+            weakSelf.onCaptureComplete(filePath, durationSeconds);
+        }
+    };
+
+    // Compile shader variants behind the camera preview, before a face is found
+    [_filamentContext warmUpMaterials];
 
     _initialized = YES;
     NSLog(@"%@: Filament renderer initialized", TAG);
+
+    // Apply props set while the renderer was being created
+    [self drainCommands];
 }
 
 - (void)setViewportSizeWithWidth:(int)width height:(int)height {
     if (width <= 0 || height <= 0) return;
 
-    _width = width;
-    _height = height;
+    // A scaled-down drawable has to follow layout changes by hand
+    if (_drawableScale < 1.0f) {
+        _metalLayer.drawableSize = CGSizeMake(width * _drawableScale, height * _drawableScale);
+    }
+
+    [_renderThread performAsync:^{
+        if (!self.initialized) return;
+
+        self.width = width;
+        self.height = height;
 
-    _filamentView->setViewport({0, 0, (uint32_t)width, (uint32_t)height});
-    [_cameraTextureRenderer setViewportSize:CGSizeMake(width, height)];
+        [self applyViewport];
+        [self.cameraTextureRenderer setViewportSize:CGSizeMake(width, height)];
+    }];
+}
+
+/// Viewport for the current size and render scale (render thread only)
+- (void)applyViewport {
+    uint32_t width = MAX(1u, (uint32_t)(_width * _renderScale));
+    uint32_t height = MAX(1u, (uint32_t)(_height * _renderScale));
+    _filamentView->setViewport({0, 0, width, height});
 }
 
 - (void)updateCameraProjectionWithFrame:(ARFrame *)frame {
@@ -160,15 +340,8 @@ static NSString *const TAG = @"VTORenderer";
 
     // Convert simd matrices to Filament matrices
     // Note: setCustomProjection requires mat4 (double), setModelMatrix requires mat4f (float)
-    filament::math::mat4f filamentModel;
-    filament::math::mat4 filamentProj;  // double precision for projection
-
-    for (int col = 0; col < 4; col++) {
-        for (int row = 0; row < 4; row++) {
-            filamentModel[col][row] = cameraModelMatrix.columns[col][row];
-            filamentProj[col][row] = (double)projMatrix.columns[col][row];
-        }
-    }
+    filament::math::mat4f filamentModel = [MatrixUtils filamentMatrixFromSimd:cameraModelMatrix];
+    filament::math::mat4 filamentProj = [MatrixUtils filamentDoubleMatrixFromSimd:projMatrix];
 
     // Set custom projection and camera model matrix
     _camera->setCustomProjection(filamentProj, 0.01, 100.0);
@@ -176,91 +349,627 @@ static NSString *const TAG = @"VTORenderer";
 }
 
 - (void)resume {
-    // Nothing specific needed for resume
+    // Pull ARKit frames and render from the render thread's display link
+    _renderLoopRunning.store(true);
+    __weak __typeof__(self) weakSelf = self;
+    [_renderThread startDisplayLinkForKey:_displayLinkKey
+                  preferredFramesPerSecond:PREFERRED_FRAMES_PER_SECOND
+                                   onFrame:^{
+        [weakSelf renderCurrentFrame];
+    }];
 }
 
 - (void)pause {
-    // Nothing specific needed for pause
+    _renderLoopRunning.store(false);
+    [_renderThread stopDisplayLinkForKey:_displayLinkKey];
+    [_renderThread performAsync:^{
+        [self publishFacePoses:@[] frame:nil state:vto::FaceTrackingState::NotRunning];
+    }];
 }
 
 - (void)switchModelWithUrl:(NSString *)modelUrl {
-    _modelUrl = modelUrl;
-    [_glassesRenderer switchModelWithUrl:modelUrl];
+    [self enqueueCommand:vto::RendererCommand::switchModel(modelUrl.UTF8String ?: "")];
+}
+
+- (void)prefetchModelsWithUrls:(NSArray<NSString *> *)modelUrls {
+    std::vector<std::string> urls;
+    urls.reserve(modelUrls.count);
+    for (NSString *url in modelUrls) {
+        urls.emplace_back(url.UTF8String ?: "");
+    }
+    [self enqueueCommand:vto::RendererCommand::prefetchModels(std::move(urls))];
+}
+
+- (void)setCompareModelsWithUrls:(NSArray<NSString *> *)modelUrls {
+    std::vector<std::string> urls;
+    urls.reserve(modelUrls.count);
+    for (NSString *url in modelUrls) {
+        urls.emplace_back(url.UTF8String ?: "");
+    }
+    [self enqueueCommand:vto::RendererCommand::setCompareModels(std::move(urls))];
+}
+
+- (void)setActiveModel:(NSInteger)index {
+    [self enqueueCommand:vto::RendererCommand::setActiveModel((int)index)];
+}
+
+- (void)setEnvironmentNamed:(NSString *)name {
+    [self enqueueCommand:vto::RendererCommand::setEnvironment(name.UTF8String ?: "")];
+}
+
+- (VTOModelMemoryStats)modelMemoryStats {
+    GlassesRenderer *glassesRenderer = _glassesRenderer;
+    if (!glassesRenderer) {
+        VTOModelMemoryStats stats = {};
+        stats.deviceTier = [VTORendererBridge deviceTier];
+        return stats;
+    }
+    return [glassesRenderer memoryStats];
 }
 
 - (void)resetSession {
-    [_glassesRenderer hide];
+    [self enqueueCommand:vto::RendererCommand::resetSession()];
 }
 
-- (void)setFaceMeshOcclusion:(BOOL)enabled {
-    if (_initialized) {
-        [_faceOcclusionRenderer setFaceMeshOcclusion:enabled];
+- (void)startFaceRecordingToPath:(NSString *)filePath {
+    // Nil or not representable as UTF-8: there's no file to open
+    const char *path = filePath.UTF8String ?: "";
+    if (path[0] == '\0') {
+        NSLog(@"%@: Failed to open face recording: no file path", TAG);
+        return;
     }
+    [self enqueueCommand:vto::RendererCommand::startFaceRecording(path)];
+}
+
+- (void)stopFaceRecording {
+    [self enqueueCommand:vto::RendererCommand::stopFaceRecording()];
+}
+
+- (void)captureToPath:(NSString *)filePath {
+    [self enqueueCommand:vto::RendererCommand::capture(filePath.UTF8String ?: "")];
+}
+
+- (void)startRecordingToPath:(NSString *)filePath {
+    [self enqueueCommand:vto::RendererCommand::startRecording(filePath.UTF8String ?: "")];
+}
+
+- (void)stopRecording {
+    [self enqueueCommand:vto::RendererCommand::stopRecording()];
+}
+
+- (void)setFaceMeshOcclusion:(BOOL)enabled {
+    [self enqueueCommand:vto::RendererCommand::setFaceMeshOcclusion(enabled)];
 }
 
 - (void)setBackPlaneOcclusion:(BOOL)enabled {
-    if (_initialized) {
-        [_faceOcclusionRenderer setBackPlaneOcclusion:enabled];
-    }
+    [self enqueueCommand:vto::RendererCommand::setBackPlaneOcclusion(enabled)];
 }
 
 - (void)setForwardOffset:(float)offset {
-    if (_initialized) {
-        [_glassesRenderer setForwardOffset:offset];
-    }
+    [self enqueueCommand:vto::RendererCommand::setForwardOffset(offset)];
+}
+
+- (void)setMaxFaces:(NSInteger)maxFaces {
+    [self enqueueCommand:vto::RendererCommand::setMaxFaces((int)maxFaces)];
 }
 
 - (void)setDebug:(BOOL)enabled {
-    if (_initialized) {
-        [_debugRenderer setEnabled:enabled];
+    [self enqueueCommand:vto::RendererCommand::setDebug(enabled)];
+}
+
+- (void)setAdaptivePerformance:(BOOL)enabled {
+    [self enqueueCommand:vto::RendererCommand::setAdaptivePerformance(enabled)];
+}
+
+#pragma mark - Commands
+
+/// Main thread only: the command ring has a single producer
+- (void)enqueueCommand:(vto::RendererCommand)command {
+    vto::RendererCommandType type = command.type;
+    BOOL wasBacklogged = _commands->isBacklogged();
+    _commands->push(std::move(command));
+    if (!wasBacklogged && _commands->isBacklogged()) {
+        NSLog(@"%@: Command queue full, holding command %d until it drains", TAG, (int)type);
+    }
+    [self scheduleDrainIfPaused];
+}
+
+/// No frame will drain the queue while paused: apply it on the render thread right away
+- (void)scheduleDrainIfPaused {
+    if (_renderLoopRunning.load()) return;
+    [_renderThread performAsync:^{
+        [self drainCommands];
+    }];
+}
+
+/// Apply queued commands (render thread only) and return how many were applied.
+/// Commands stay queued until the renderers exist.
+- (size_t)drainCommands {
+    if (!_initialized) return 0;
+
+    size_t count = _commands->drain([self](const vto::RendererCommand &command) {
+        [self applyCommand:command];
+    });
+    // The ring has room again: the producer moves its backlog in
+    if (_commands->isBacklogged()) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (self->_commands->flushBacklog() > 0) {
+                [self scheduleDrainIfPaused];
+            }
+        });
     }
+    return count;
 }
 
-- (void)renderWithFrame:(ARFrame *)frame faces:(NSArray<ARFaceAnchor *> *)faces {
+- (void)applyCommand:(const vto::RendererCommand &)command {
+    switch (command.type) {
+        case vto::RendererCommandType::SetFaceMeshOcclusion:
+            [_faceOcclusionRenderer setFaceMeshOcclusion:command.enabled];
+            break;
+        case vto::RendererCommandType::SetBackPlaneOcclusion:
+            [_faceOcclusionRenderer setBackPlaneOcclusion:command.enabled];
+            break;
+        case vto::RendererCommandType::SetForwardOffset:
+            [_glassesRenderer setForwardOffset:command.value];
+            break;
+        case vto::RendererCommandType::SetMaxFaces:
+            [_faceOcclusionRenderer setMaxFaces:(NSUInteger)MAX(command.value, 1.0f)];
+            [_glassesRenderer setMaxFaces:(NSUInteger)MAX(command.value, 1.0f)];
+            break;
+        case vto::RendererCommandType::SetDebug:
+            [_debugRenderer setEnabled:command.enabled];
+            break;
+        case vto::RendererCommandType::SetAdaptivePerformance:
+            [self applyAdaptivePerformance:command.enabled];
+            break;
+        case vto::RendererCommandType::SwitchModel: {
+            NSString *modelUrl = [NSString stringWithUTF8String:command.url.c_str()];
+            _modelUrl = modelUrl;
+            [_glassesRenderer switchModelWithUrl:modelUrl];
+            break;
+        }
+        case vto::RendererCommandType::ResetSession:
+            [_glassesRenderer hide];
+            break;
+        case vto::RendererCommandType::PrefetchModels: {
+            NSMutableArray<NSString *> *urls = [NSMutableArray arrayWithCapacity:command.urls.size()];
+            for (const std::string &url : command.urls) {
+                [urls addObject:[NSString stringWithUTF8String:url.c_str()]];
+            }
+            [_glassesRenderer prefetchModelsWithUrls:urls];
+            break;
+        }
+        case vto::RendererCommandType::SetCompareModels: {
+            NSMutableArray<NSString *> *urls = [NSMutableArray arrayWithCapacity:command.urls.size()];
+            for (const std::string &url : command.urls) {
+                [urls addObject:[NSString stringWithUTF8String:url.c_str()]];
+            }
+            [_glassesRenderer setCompareModelsWithUrls:urls];
+            break;
+        }
+        case vto::RendererCommandType::SetActiveModel:
+            [_glassesRenderer setActiveModel:(NSUInteger)MAX(command.value, 0.0f)];
+            break;
+        case vto::RendererCommandType::SetEnvironment:
+            [_environmentLightingRenderer setEnvironmentNamed:[NSString stringWithUTF8String:command.url.c_str()]];
+            break;
+        case vto::RendererCommandType::StartFaceRecording:
+            [self stopFaceRecordingNow];
+            _faceRecorder = std::make_unique<vto::FaceRecordingWriter>();
+            if (!_faceRecorder->open(command.url, vto::RecordingSource::ARKit)) {
+                NSLog(@"[VTORendererBridge] Failed to open face recording: %s", command.url.c_str());
+                _faceRecorder.reset();
+            }
+            break;
+        case vto::RendererCommandType::StopFaceRecording:
+            [self stopFaceRecordingNow];
+            break;
+        case vto::RendererCommandType::Capture:
+            [_frameCapture capturePhotoToPath:[NSString stringWithUTF8String:command.url.c_str()]];
+            break;
+        case vto::RendererCommandType::StartRecording:
+            [_frameCapture startRecordingToPath:[NSString stringWithUTF8String:command.url.c_str()]];
+            break;
+        case vto::RendererCommandType::StopRecording:
+            [_frameCapture stopRecording];
+            break;
+        case vto::RendererCommandType::None:
+            break;
+    }
+}
+
+#pragma mark - Rendering
+
+- (void)renderCurrentFrame {
     if (!_initialized) return;
 
-    // Update Filament camera with ARKit camera matrices
-    [self updateCameraProjectionWithFrame:frame];
+    // The display link is shared by every view, so a lowered frame rate skips refreshes here
+    CFTimeInterval frameStart = CACurrentMediaTime();
+    NSInteger framesPerSecond = _framePacer ? _framePacer->framesPerSecond() : PREFERRED_FRAMES_PER_SECOND;
+    if (!_faceTracked && frameStart - _faceLostTime >= IDLE_DELAY) {
+        framesPerSecond = MIN(framesPerSecond, IDLE_FRAMES_PER_SECOND);
+    }
+    if (framesPerSecond < PREFERRED_FRAMES_PER_SECOND &&
+        frameStart - _lastRenderedFrameTime < 1.0 / framesPerSecond - FRAME_INTERVAL_SLACK) {
+        return;
+    }
+    _lastRenderedFrameTime = frameStart;
+
+    _frameTimings.clear();
+    VTOFrameOutcome outcome;
+    {
+        StageScope stage(_frameTimings, vto::FrameStage::Frame, "frame");
+        outcome = [self renderFrame];
+    }
+    if (outcome != VTOFrameOutcomeIdle) {
+        [self recordGpuTime];
+        _frameStats->addFrame(_frameTimings, outcome == VTOFrameOutcomeDropped);
+    }
+
+    if (_framePacer && outcome != VTOFrameOutcomeIdle) {
+        [self recordFrameAt:frameStart
+                   workTime:CACurrentMediaTime() - frameStart
+                  presented:outcome == VTOFrameOutcomePresented];
+    }
+}
 
-    // Update camera texture and background transform
-    [_cameraTextureRenderer updateTextureWithFrame:frame];
-    [_cameraTextureRenderer updateTransformWithFrame:frame];
+- (VTOFrameOutcome)renderFrame {
+    // Apply prop changes once, before any scene work for this frame
+    BOOL sceneChanged = [self drainCommands] > 0;
 
-    // Update lighting from ARKit light estimation
-    if (frame.lightEstimate) {
-        [_environmentLightingRenderer updateFromARKitWithLightEstimate:frame.lightEstimate];
+    // Stream in glasses textures a slice at a time, even before a face is tracked
+    {
+        StageScope stage(_frameTimings, vto::FrameStage::Resources, "resources");
+        sceneChanged = [_glassesRenderer updateLoading] || sceneChanged;
+    }
+
+    ARFrame *frame;
+    {
+        StageScope stage(_frameTimings, vto::FrameStage::Session, "session");
+        frame = self.arSession.currentFrame;
+    }
+    if (!frame) return VTOFrameOutcomeIdle;
+
+    // The display link can outpace the camera: don't redraw a frame that's already on screen
+    if (frame.timestamp == _lastARFrameTimestamp && !sceneChanged) return VTOFrameOutcomeIdle;
+    _lastARFrameTimestamp = frame.timestamp;
+
+    // Get tracked faces
+    NSMutableArray<ARFaceAnchor *> *faces = [NSMutableArray array];
+    for (ARAnchor *anchor in frame.anchors) {
+        if ([anchor isKindOfClass:[ARFaceAnchor class]] && ((ARFaceAnchor *)anchor).isTracked) {
+            [faces addObject:(ARFaceAnchor *)anchor];
+        }
+    }
+
+    return [self renderWithFrame:frame faces:faces];
+}
+
+- (VTOFrameOutcome)renderWithFrame:(ARFrame *)frame faces:(NSArray<ARFaceAnchor *> *)faces {
+
+    {
+        StageScope stage(_frameTimings, vto::FrameStage::Camera, "camera");
+
+        // Update Filament camera with ARKit camera matrices
+        [self updateCameraProjectionWithFrame:frame];
+
+        // Update camera texture and background transform
+        [_cameraTextureRenderer updateTextureWithFrame:frame];
+        [_cameraTextureRenderer updateTransformWithFrame:frame];
+
+        // Update lighting from ARKit light estimation
+        [_environmentLightingRenderer updateFromARKitWithLightEstimate:frame.lightEstimate
+                                                             timestamp:frame.timestamp];
     }
 
     // Update face occlusion and glasses transform if face detected
     if (faces.count > 0) {
-        [_faceOcclusionRenderer updateWithFace:faces[0]];
-        [_glassesRenderer updateTransformWithFace:faces[0] frame:frame];
-        [_debugRenderer updateWithFace:faces[0]
-                     showLeftBackPlane:_faceOcclusionRenderer.isLeftBackPlaneVisible
-                    showRightBackPlane:_faceOcclusionRenderer.isRightBackPlaneVisible];
-    } else {
+        _faceTracked = YES;
+        FaceTopology *previousTopology = _faceTopology;
+        {
+            StageScope stage(_frameTimings, vto::FrameStage::FaceMesh, "faceMesh");
+            FaceTopology *topology = [self faceTopologyForFace:faces[0]];
+            if (topology) {
+                // Also moves the debug overlay, which draws the occluder's own buffers
+                [_faceOcclusionRenderer updateWithFaces:faces topology:topology];
+            }
+        }
+        {
+            StageScope stage(_frameTimings, vto::FrameStage::GlassesPose, "glassesPose");
+            // ARFrame timestamps share CACurrentMediaTime's clock: age of the camera frame, plus render latency
+            double prediction = CACurrentMediaTime() - frame.timestamp + _presentLatency;
+            [_glassesRenderer updateTransformWithFaces:faces frame:frame predictionSeconds:prediction];
+        }
+        // Release a replaced topology once the renderers have moved off its index buffer
+        if (previousTopology && previousTopology != _faceTopology) {
+            [previousTopology destroy];
+        }
+    } else if (_faceTracked) {
+        // Face lost: take the face entities out of the scene once, then render the camera alone
+        _faceTracked = NO;
+        _faceLostTime = CACurrentMediaTime();
         [_faceOcclusionRenderer hide];
         [_glassesRenderer hide];
-        [_debugRenderer hide];
     }
 
+    [self recordFaceFrame:frame face:faces.firstObject];
+    [self publishFacePoses:faces
+                     frame:frame
+                     state:faces.count > 0 ? vto::FaceTrackingState::Tracking : vto::FaceTrackingState::Searching];
+
     // Render frame with Filament
+    StageScope stage(_frameTimings, vto::FrameStage::Render, "render");
     if (_renderer->beginFrame(_swapChain)) {
         _renderer->render(_filamentView);
+        if ([_frameCapture wantsFrameAtTimestamp:frame.timestamp]) {
+            const Viewport &viewport = _filamentView->getViewport();
+            [_frameCapture readFrameFromRenderer:_renderer
+                                           width:viewport.width
+                                          height:viewport.height
+                                       timestamp:frame.timestamp];
+        }
         _renderer->endFrame();
+        return VTOFrameOutcomePresented;
+    }
+    return VTOFrameOutcomeDropped;
+}
+
+#pragma mark - Face pose stream
+
+/// Overwrite the face pose buffer shared with JS with this frame's faces (render thread only)
+- (void)publishFacePoses:(NSArray<ARFaceAnchor *> *)faces
+                   frame:(nullable ARFrame *)frame
+                   state:(vto::FaceTrackingState)state {
+    NSMutableData *buffer = self.facePoseBuffer;
+    if (!buffer) return;
+
+    vto::FacePoseSample samples[vto::kMaxTrackedFaces];
+    int count = 0;
+    if (frame && faces.count > 0 && _width > 0 && _height > 0) {
+        // Same matrices updateCameraProjectionWithFrame hands to Filament
+        vto::Mat4 view = [MatrixUtils coreMatrixFromSimd:[frame.camera viewMatrixForOrientation:UIInterfaceOrientationPortrait]];
+        vto::Mat4 projection = [MatrixUtils coreMatrixFromSimd:[frame.camera projectionMatrixForOrientation:UIInterfaceOrientationPortrait
+                                                                                                  viewportSize:CGSizeMake(_width, _height)
+                                                                                                         zNear:0.01
+                                                                                                          zFar:100.0]];
+        for (ARFaceAnchor *face in faces) {
+            if (count == vto::kMaxTrackedFaces) break;
+            vto::Mat4 faceTransform = [MatrixUtils coreMatrixFromSimd:face.transform];
+            ARFaceGeometry *geometry = face.geometry;
+            vto::Float3 noseBridge = vto::noseBridgeWorldPosition(faceTransform, (const float *)geometry.vertices, 4,
+                                                                  geometry.vertexCount, vto::kARKitNoseBridge);
+            samples[count++] = vto::makeFacePoseSample(faceTransform, noseBridge, view, projection);
+        }
+    }
+    vto::writeFacePoses(buffer.mutableBytes, state, frame ? frame.timestamp : _lastARFrameTimestamp, samples, count);
+}
+
+#pragma mark - Face recording
+
+- (void)stopFaceRecordingNow {
+    if (!_faceRecorder) return;
+    NSLog(@"[VTORendererBridge] Face recording finished: %u frames", _faceRecorder->frameCount());
+    _faceRecorder.reset();
+}
+
+/// Append this frame's camera and face tracking data to the recording, if one is running
+- (void)recordFaceFrame:(ARFrame *)frame face:(nullable ARFaceAnchor *)face {
+    if (!_faceRecorder || _width <= 0 || _height <= 0) return;
+
+    // Same matrices updateCameraProjectionWithFrame hands to Filament
+    simd_float3x3 intrinsics = frame.camera.intrinsics;
+    vto::RecordedCamera camera;
+    camera.timestamp = frame.timestamp;
+    camera.focalLengthX = intrinsics.columns[0][0];
+    camera.focalLengthY = intrinsics.columns[1][1];
+    camera.principalPointX = intrinsics.columns[2][0];
+    camera.principalPointY = intrinsics.columns[2][1];
+    camera.imageWidth = (uint32_t)frame.camera.imageResolution.width;
+    camera.imageHeight = (uint32_t)frame.camera.imageResolution.height;
+    camera.projection = [MatrixUtils coreMatrixFromSimd:[frame.camera projectionMatrixForOrientation:UIInterfaceOrientationPortrait
+                                                                                         viewportSize:CGSizeMake(_width, _height)
+                                                                                                zNear:0.01
+                                                                                                 zFar:100.0]];
+    camera.transform = [MatrixUtils coreMatrixFromSimd:simd_inverse([frame.camera viewMatrixForOrientation:UIInterfaceOrientationPortrait])];
+
+    if (!face) {
+        _faceRecorder->writeFrame(camera, nullptr, nullptr, 4, 0);
+        return;
+    }
+    vto::Mat4 faceTransform = [MatrixUtils coreMatrixFromSimd:face.transform];
+    ARFaceGeometry *geometry = face.geometry;
+    // simd_float3 is padded to four floats
+    _faceRecorder->writeFrame(camera, &faceTransform, (const float *)geometry.vertices, 4, geometry.vertexCount);
+}
+
+#pragma mark - Performance stats
+
+- (void)recordGpuTime {
+    // Filament measures GPU time once a frame's command buffer completes, a few frames after it was
+    // submitted: take the newest completed frame, once
+    auto history = _renderer->getFrameInfoHistory(1);
+    if (history.empty()) return;
+    const Renderer::FrameInfo &info = history[0];
+    if (info.frameId == _lastGpuFrameId || info.gpuFrameDuration <= 0) return;
+    _lastGpuFrameId = info.frameId;
+    _frameTimings.set(vto::FrameStage::Gpu, info.gpuFrameDuration * 1e-9);
+
+    // The frame is shown at the first vsync after its GPU work completes
+    if (info.gpuFrameComplete > info.beginFrame) {
+        const double interval = 1.0 / PREFERRED_FRAMES_PER_SECOND;
+        const double latency = (info.gpuFrameComplete - info.beginFrame) * 1e-9;
+        _presentLatency = std::ceil(latency / interval) * interval;
+    }
+}
+
+static VTOStageTiming VTOStageTimingFromSummary(const vto::StageSummary &summary) {
+    VTOStageTiming timing;
+    timing.p50 = summary.p50 * 1000.0;
+    timing.p95 = summary.p95 * 1000.0;
+    timing.p99 = summary.p99 * 1000.0;
+    timing.max = summary.max * 1000.0;
+    timing.samples = (NSUInteger)summary.samples;
+    return timing;
+}
+
+- (VTOPerformanceStats)performanceStats {
+    vto::FrameStatsSnapshot snapshot = _frameStats->snapshot();
+    auto stage = [&snapshot](vto::FrameStage stage) {
+        return VTOStageTimingFromSummary(snapshot.stages[(int)stage]);
+    };
+
+    VTOPerformanceStats stats;
+    stats.frameCount = (NSUInteger)snapshot.frameCount;
+    stats.droppedFrames = (NSUInteger)snapshot.droppedFrames;
+    stats.session = stage(vto::FrameStage::Session);
+    stats.camera = stage(vto::FrameStage::Camera);
+    stats.faceMesh = stage(vto::FrameStage::FaceMesh);
+    stats.glassesPose = stage(vto::FrameStage::GlassesPose);
+    stats.resources = stage(vto::FrameStage::Resources);
+    stats.render = stage(vto::FrameStage::Render);
+    stats.frame = stage(vto::FrameStage::Frame);
+    stats.gpu = stage(vto::FrameStage::Gpu);
+    return stats;
+}
+
+- (NSString *)performanceSummary {
+    std::string summary = vto::formatFrameStats(_frameStats->snapshot());
+    return [NSString stringWithUTF8String:summary.c_str()];
+}
+
+#pragma mark - Adaptive performance
+
+- (void)applyAdaptivePerformance:(BOOL)enabled {
+    if (enabled == (_framePacer != nullptr)) return;
+
+    if (enabled) {
+        _framePacer = std::make_unique<vto::FramePacer>();
+        [self startThermalMonitoring];
+    } else {
+        [self stopThermalMonitoring];
+        _framePacer.reset();
+        [self applyRenderScale:1.0f framesPerSecond:PREFERRED_FRAMES_PER_SECOND];
     }
 }
 
+- (void)recordFrameAt:(CFTimeInterval)timestamp workTime:(CFTimeInterval)workTime presented:(BOOL)presented {
+    if (!_framePacer->addFrame(timestamp, workTime, presented)) return;
+
+    float renderScale = _framePacer->renderScale();
+    int framesPerSecond = _framePacer->framesPerSecond();
+    NSString *reason = @(vto::pacingReasonName(_framePacer->reason()));
+    NSLog(@"%@: Adaptive performance: scale %.2f, %d fps (%@)", TAG, renderScale, framesPerSecond, reason);
+    [self applyRenderScale:renderScale framesPerSecond:framesPerSecond];
+
+    __weak __typeof__(self) weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if (weakSelf.onPerformanceChange) {
+            weakSelf.onPerformanceChange(renderScale, framesPerSecond, reason);
+        }
+    });
+}
+
+/**
+ * Apply a render scale and frame rate (render thread only). Filament's dynamic resolution needs
+ * post-processing, which stays off to keep the camera feed's colors untouched, so the drawable
+ * is shrunk instead and Core Animation scales it up to the layer.
+ */
+- (void)applyRenderScale:(float)renderScale framesPerSecond:(int)framesPerSecond {
+    // Let Filament's frame pacing know how many refreshes each frame spans
+    Renderer::FrameRateOptions frameRateOptions;
+    frameRateOptions.interval = (uint8_t)MAX(1, PREFERRED_FRAMES_PER_SECOND / framesPerSecond);
+    _renderer->setFrameRateOptions(frameRateOptions);
+
+    if (renderScale == _renderScale) return;
+
+    // Resize the drawable on the main thread first, then match the viewport on the next frames
+    dispatch_async(dispatch_get_main_queue(), ^{
+        self.drawableScale = renderScale;
+        self.metalView.autoResizeDrawable = renderScale >= 1.0f;
+        CGSize size = self.metalView.bounds.size;
+        CGFloat contentScale = self.metalView.contentScaleFactor * renderScale;
+        self.metalLayer.drawableSize = CGSizeMake(size.width * contentScale, size.height * contentScale);
+
+        [self.renderThread performAsync:^{
+            if (!self.initialized) return;
+            self.renderScale = renderScale;
+            [self applyViewport];
+        }];
+    });
+}
+
+- (void)startThermalMonitoring {
+    _framePacer->setThermalLevel((vto::ThermalLevel)[NSProcessInfo processInfo].thermalState);
+
+    // Posted on an arbitrary thread: hop onto the render thread, which owns the pacer
+    __weak __typeof__(self) weakSelf = self;
+    _thermalObserver = [[NSNotificationCenter defaultCenter]
+        addObserverForName:NSProcessInfoThermalStateDidChangeNotification
+                    object:nil
+                     queue:nil
+                usingBlock:^(NSNotification *note) {
+        NSProcessInfoThermalState state = [NSProcessInfo processInfo].thermalState;
+        [weakSelf.renderThread performAsync:^{
+            __typeof__(self) strongSelf = weakSelf;
+            if (strongSelf && strongSelf->_framePacer) {
+                strongSelf->_framePacer->setThermalLevel((vto::ThermalLevel)state);
+            }
+        }];
+    }];
+}
+
+- (void)stopThermalMonitoring {
+    if (!_thermalObserver) return;
+    [[NSNotificationCenter defaultCenter] removeObserver:_thermalObserver];
+    _thermalObserver = nil;
+}
+
+/// Get the cached face topology, building it on the first face (or if ARKit changes the mesh layout)
+- (nullable FaceTopology *)faceTopologyForFace:(ARFaceAnchor *)face {
+    ARFaceGeometry *geometry = face.geometry;
+    if (_faceTopology && [_faceTopology matchesGeometry:geometry]) {
+        return _faceTopology;
+    }
+    FaceTopology *topology = [FaceTopology topologyWithGeometry:geometry engine:_engine];
+    if (topology) {
+        _faceTopology = topology;
+    }
+    return [_faceTopology matchesGeometry:geometry] ? _faceTopology : nil;
+}
+
 - (void)setARSession:(ARSession *)session {
     _arSession = session;
 }
 
 - (void)destroy {
+    if (!_filamentContext) return;
+
+    // Tear down on the render thread (Filament objects belong to it), then hand the shared engine back
+    _renderLoopRunning.store(false);
+    [_renderThread stopDisplayLinkForKey:_displayLinkKey];
+    [_renderThread performSync:^{
+        [self destroyOnRenderThread];
+    }];
+    [_filamentContext relinquish];
+    _filamentContext = nil;
+}
+
+- (void)destroyOnRenderThread {
     if (!_engine) return;
 
+    [self stopThermalMonitoring];
+    _framePacer.reset();
+    [self stopFaceRecordingNow];
+    // Run the readPixels callbacks still queued, so their frames reach the recording before it finishes
+    [_frameCapture stopRecording];
+    _engine->flushAndWait();
+    _frameCapture = nil;
+
     [_debugRenderer destroy];
     [_glassesRenderer destroy];
     [_faceOcclusionRenderer destroy];
+    [_faceTopology destroy];
+    _faceTopology = nil;
     [_cameraTextureRenderer destroy];
     [_environmentLightingRenderer destroy];
 
@@ -282,7 +991,7 @@ static NSString *const TAG = @"VTORenderer";
         _engine->destroy(_renderer);
     }
 
-    _engine->destroy(&_engine);
+    // The engine itself belongs to the shared context
     _engine = nullptr;
     _initialized = NO;
 }
@@ -17,6 +17,8 @@
 
 #include "JHybridNitroVtoViewSpec.hpp"
 #include "JFunc_void_std__string.hpp"
+#include "JFunc_void_std__string_double.hpp"
+#include "JFunc_void_double_double_std__string.hpp"
 #include "views/JHybridNitroVtoViewStateUpdater.hpp"
 #include <NitroModules/DefaultConstructableObject.hpp>
 
@@ -31,6 +33,8 @@ int initialize(JavaVM* vm) {
     // Register native JNI methods
     margelo::nitro::nitrovto::JHybridNitroVtoViewSpec::registerNatives();
     margelo::nitro::nitrovto::JFunc_void_std__string_cxx::registerNatives();
+    margelo::nitro::nitrovto::JFunc_void_std__string_double_cxx::registerNatives();
+    margelo::nitro::nitrovto::JFunc_void_double_double_std__string_cxx::registerNatives();
     margelo::nitro::nitrovto::views::JHybridNitroVtoViewStateUpdater::registerNatives();
 
     // Register Nitro Hybrid Objects
@@ -0,0 +1,76 @@
+///
+/// JFunc_void_double_double_std__string.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2026 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#include <fbjni/fbjni.h>
+#include <functional>
+
+#include <string>
+#include <functional>
+#include <NitroModules/JNICallable.hpp>
+
+namespace margelo::nitro::nitrovto {
+
+  using namespace facebook;
+
+  /**
+   * Represents the Java/Kotlin callback `(renderScale: Double, frameRate: Double, reason: String) -> Unit`.
+   * This can be passed around between C++ and Java/Kotlin.
+   */
+  struct JFunc_void_double_double_std__string: public jni::JavaClass<JFunc_void_double_double_std__string> {
+  public:
+    static auto constexpr kJavaDescriptor = "Lcom/margelo/nitro/nitrovto/Func_void_double_double_std__string;";
+
+  public:
+    /**
+     * Invokes the function this `JFunc_void_double_double_std__string` instance holds through JNI.
+     */
+    void invoke(double renderScale, double frameRate, const std::string& reason) const {
+      static const auto method = javaClassStatic()->getMethod<void(double /* renderScale */, double /* frameRate */, jni::alias_ref<jni::JString> /* reason */)>("invoke");
+      method(self(), renderScale, frameRate, jni::make_jstring(reason));
+    }
+  };
+
+  /**
+   * An implementation of Func_void_double_double_std__string that is backed by a C++ implementation (using `std::function<...>`)
+   */
+  class JFunc_void_double_double_std__string_cxx final: public jni::HybridClass<JFunc_void_double_double_std__string_cxx, JFunc_void_double_double_std__string> {
+  public:
+    static jni::local_ref<JFunc_void_double_double_std__string::javaobject> fromCpp(const std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>& func) {
+      return JFunc_void_double_double_std__string_cxx::newObjectCxxArgs(func);
+    }
+
+  public:
+    /**
+     * Invokes the C++ `std::function<...>` this `JFunc_void_double_double_std__string_cxx` instance holds.
+     */
+    void invoke_cxx(double renderScale, double frameRate, jni::alias_ref<jni::JString> reason) {
+      _func(renderScale, frameRate, reason->toStdString());
+    }
+
+  public:
+    [[nodiscard]]
+    inline const std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>& getFunction() const {
+      return _func;
+    }
+
+  public:
+    static auto constexpr kJavaDescriptor = "Lcom/margelo/nitro/nitrovto/Func_void_double_double_std__string_cxx;";
+    static void registerNatives() {
+      registerHybrid({makeNativeMethod("invoke_cxx", JFunc_void_double_double_std__string_cxx::invoke_cxx)});
+    }
+
+  private:
+    explicit JFunc_void_double_double_std__string_cxx(const std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>& func): _func(func) { }
+
+  private:
+    friend HybridBase;
+    std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)> _func;
+  };
+
+} // namespace margelo::nitro::nitrovto
@@ -0,0 +1,76 @@
+///
+/// JFunc_void_std__string_double.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2026 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#include <fbjni/fbjni.h>
+#include <functional>
+
+#include <string>
+#include <functional>
+#include <NitroModules/JNICallable.hpp>
+
+namespace margelo::nitro::nitrovto {
+
+  using namespace facebook;
+
+  /**
+   * Represents the Java/Kotlin callback `(modelUrl: String, progress: Double) -> Unit`.
+   * This can be passed around between C++ and Java/Kotlin.
+   */
+  struct JFunc_void_std__string_double: public jni::JavaClass<JFunc_void_std__string_double> {
+  public:
+    static auto constexpr kJavaDescriptor = "Lcom/margelo/nitro/nitrovto/Func_void_std__string_double;";
+
+  public:
+    /**
+     * Invokes the function this `JFunc_void_std__string_double` instance holds through JNI.
+     */
+    void invoke(const std::string& modelUrl, double progress) const {
+      static const auto method = javaClassStatic()->getMethod<void(jni::alias_ref<jni::JString> /* modelUrl */, double /* progress */)>("invoke");
+      method(self(), jni::make_jstring(modelUrl), progress);
+    }
+  };
+
+  /**
+   * An implementation of Func_void_std__string_double that is backed by a C++ implementation (using `std::function<...>`)
+   */
+  class JFunc_void_std__string_double_cxx final: public jni::HybridClass<JFunc_void_std__string_double_cxx, JFunc_void_std__string_double> {
+  public:
+    static jni::local_ref<JFunc_void_std__string_double::javaobject> fromCpp(const std::function<void(const std::string& /* modelUrl */, double /* progress */)>& func) {
+      return JFunc_void_std__string_double_cxx::newObjectCxxArgs(func);
+    }
+
+  public:
+    /**
+     * Invokes the C++ `std::function<...>` this `JFunc_void_std__string_double_cxx` instance holds.
+     */
+    void invoke_cxx(jni::alias_ref<jni::JString> modelUrl, double progress) {
+      _func(modelUrl->toStdString(), progress);
+    }
+
+  public:
+    [[nodiscard]]
+    inline const std::function<void(const std::string& /* modelUrl */, double /* progress */)>& getFunction() const {
+      return _func;
+    }
+
+  public:
+    static auto constexpr kJavaDescriptor = "Lcom/margelo/nitro/nitrovto/Func_void_std__string_double_cxx;";
+    static void registerNatives() {
+      registerHybrid({makeNativeMethod("invoke_cxx", JFunc_void_std__string_double_cxx::invoke_cxx)});
+    }
+
+  private:
+    explicit JFunc_void_std__string_double_cxx(const std::function<void(const std::string& /* modelUrl */, double /* progress */)>& func): _func(func) { }
+
+  private:
+    friend HybridBase;
+    std::function<void(const std::string& /* modelUrl */, double /* progress */)> _func;
+  };
+
+} // namespace margelo::nitro::nitrovto
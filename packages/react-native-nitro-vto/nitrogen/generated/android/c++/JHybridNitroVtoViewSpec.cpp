@@ -7,12 +7,32 @@
 
 #include "JHybridNitroVtoViewSpec.hpp"
 
+// Forward declaration of `ModelCacheStats` to properly resolve imports.
+namespace margelo::nitro::nitrovto { struct ModelCacheStats; }
+// Forward declaration of `ModelMemoryStats` to properly resolve imports.
+namespace margelo::nitro::nitrovto { struct ModelMemoryStats; }
+// Forward declaration of `PerformanceStats` to properly resolve imports.
+namespace margelo::nitro::nitrovto { struct PerformanceStats; }
+// Forward declaration of `StageTiming` to properly resolve imports.
+namespace margelo::nitro::nitrovto { struct StageTiming; }
 
-
+#include "ModelCacheStats.hpp"
+#include "JModelCacheStats.hpp"
+#include "ModelMemoryStats.hpp"
+#include "JModelMemoryStats.hpp"
+#include "PerformanceStats.hpp"
+#include "JPerformanceStats.hpp"
+#include "StageTiming.hpp"
+#include "JStageTiming.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/JArrayBuffer.hpp>
 #include <string>
 #include <functional>
 #include <optional>
+#include <vector>
 #include "JFunc_void_std__string.hpp"
+#include "JFunc_void_std__string_double.hpp"
+#include "JFunc_void_double_double_std__string.hpp"
 #include <NitroModules/JNICallable.hpp>
 
 namespace margelo::nitro::nitrovto {
@@ -79,6 +99,23 @@ namespace margelo::nitro::nitrovto {
     static const auto method = javaClassStatic()->getMethod<void(jni::alias_ref<JFunc_void_std__string::javaobject> /* onModelLoaded */)>("setOnModelLoaded_cxx");
     method(_javaPart, onModelLoaded.has_value() ? JFunc_void_std__string_cxx::fromCpp(onModelLoaded.value()) : nullptr);
   }
+  std::optional<std::function<void(const std::string& /* modelUrl */, double /* progress */)>> JHybridNitroVtoViewSpec::getOnModelLoadProgress() {
+    static const auto method = javaClassStatic()->getMethod<jni::local_ref<JFunc_void_std__string_double::javaobject>()>("getOnModelLoadProgress_cxx");
+    auto __result = method(_javaPart);
+    return __result != nullptr ? std::make_optional([&]() -> std::function<void(const std::string& /* modelUrl */, double /* progress */)> {
+      if (__result->isInstanceOf(JFunc_void_std__string_double_cxx::javaClassStatic())) [[likely]] {
+        auto downcast = jni::static_ref_cast<JFunc_void_std__string_double_cxx::javaobject>(__result);
+        return downcast->cthis()->getFunction();
+      } else {
+        auto __resultRef = jni::make_global(__result);
+        return JNICallable<JFunc_void_std__string_double, void(std::string, double)>(std::move(__resultRef));
+      }
+    }()) : std::nullopt;
+  }
+  void JHybridNitroVtoViewSpec::setOnModelLoadProgress(const std::optional<std::function<void(const std::string& /* modelUrl */, double /* progress */)>>& onModelLoadProgress) {
+    static const auto method = javaClassStatic()->getMethod<void(jni::alias_ref<JFunc_void_std__string_double::javaobject> /* onModelLoadProgress */)>("setOnModelLoadProgress_cxx");
+    method(_javaPart, onModelLoadProgress.has_value() ? JFunc_void_std__string_double_cxx::fromCpp(onModelLoadProgress.value()) : nullptr);
+  }
   std::optional<bool> JHybridNitroVtoViewSpec::getFaceMeshOcclusion() {
     static const auto method = javaClassStatic()->getMethod<jni::local_ref<jni::JBoolean>()>("getFaceMeshOcclusion");
     auto __result = method(_javaPart);
@@ -106,6 +143,15 @@ namespace margelo::nitro::nitrovto {
     static const auto method = javaClassStatic()->getMethod<void(jni::alias_ref<jni::JDouble> /* forwardOffset */)>("setForwardOffset");
     method(_javaPart, forwardOffset.has_value() ? jni::JDouble::valueOf(forwardOffset.value()) : nullptr);
   }
+  std::optional<double> JHybridNitroVtoViewSpec::getMaxFaces() {
+    static const auto method = javaClassStatic()->getMethod<jni::local_ref<jni::JDouble>()>("getMaxFaces");
+    auto __result = method(_javaPart);
+    return __result != nullptr ? std::make_optional(__result->value()) : std::nullopt;
+  }
+  void JHybridNitroVtoViewSpec::setMaxFaces(std::optional<double> maxFaces) {
+    static const auto method = javaClassStatic()->getMethod<void(jni::alias_ref<jni::JDouble> /* maxFaces */)>("setMaxFaces");
+    method(_javaPart, maxFaces.has_value() ? jni::JDouble::valueOf(maxFaces.value()) : nullptr);
+  }
   std::optional<bool> JHybridNitroVtoViewSpec::getDebug() {
     static const auto method = javaClassStatic()->getMethod<jni::local_ref<jni::JBoolean>()>("getDebug");
     auto __result = method(_javaPart);
@@ -115,6 +161,49 @@ namespace margelo::nitro::nitrovto {
     static const auto method = javaClassStatic()->getMethod<void(jni::alias_ref<jni::JBoolean> /* debug */)>("setDebug");
     method(_javaPart, debug.has_value() ? jni::JBoolean::valueOf(debug.value()) : nullptr);
   }
+  std::optional<bool> JHybridNitroVtoViewSpec::getAdaptivePerformance() {
+    static const auto method = javaClassStatic()->getMethod<jni::local_ref<jni::JBoolean>()>("getAdaptivePerformance");
+    auto __result = method(_javaPart);
+    return __result != nullptr ? std::make_optional(static_cast<bool>(__result->value())) : std::nullopt;
+  }
+  void JHybridNitroVtoViewSpec::setAdaptivePerformance(std::optional<bool> adaptivePerformance) {
+    static const auto method = javaClassStatic()->getMethod<void(jni::alias_ref<jni::JBoolean> /* adaptivePerformance */)>("setAdaptivePerformance");
+    method(_javaPart, adaptivePerformance.has_value() ? jni::JBoolean::valueOf(adaptivePerformance.value()) : nullptr);
+  }
+  std::optional<std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>> JHybridNitroVtoViewSpec::getOnPerformanceChange() {
+    static const auto method = javaClassStatic()->getMethod<jni::local_ref<JFunc_void_double_double_std__string::javaobject>()>("getOnPerformanceChange_cxx");
+    auto __result = method(_javaPart);
+    return __result != nullptr ? std::make_optional([&]() -> std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)> {
+      if (__result->isInstanceOf(JFunc_void_double_double_std__string_cxx::javaClassStatic())) [[likely]] {
+        auto downcast = jni::static_ref_cast<JFunc_void_double_double_std__string_cxx::javaobject>(__result);
+        return downcast->cthis()->getFunction();
+      } else {
+        auto __resultRef = jni::make_global(__result);
+        return JNICallable<JFunc_void_double_double_std__string, void(double, double, std::string)>(std::move(__resultRef));
+      }
+    }()) : std::nullopt;
+  }
+  void JHybridNitroVtoViewSpec::setOnPerformanceChange(const std::optional<std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>>& onPerformanceChange) {
+    static const auto method = javaClassStatic()->getMethod<void(jni::alias_ref<JFunc_void_double_double_std__string::javaobject> /* onPerformanceChange */)>("setOnPerformanceChange_cxx");
+    method(_javaPart, onPerformanceChange.has_value() ? JFunc_void_double_double_std__string_cxx::fromCpp(onPerformanceChange.value()) : nullptr);
+  }
+  std::optional<std::function<void(const std::string& /* filePath */, double /* durationSeconds */)>> JHybridNitroVtoViewSpec::getOnCaptureComplete() {
+    static const auto method = javaClassStatic()->getMethod<jni::local_ref<JFunc_void_std__string_double::javaobject>()>("getOnCaptureComplete_cxx");
+    auto __result = method(_javaPart);
+    return __result != nullptr ? std::make_optional([&]() -> std::function<void(const std::string& /* filePath */, double /* durationSeconds */)> {
+      if (__result->isInstanceOf(JFunc_void_std__string_double_cxx::javaClassStatic())) [[likely]] {
+        auto downcast = jni::static_ref_cast<JFunc_void_std__string_double_cxx::javaobject>(__result);
+        return downcast->cthis()->getFunction();
+      } else {
+        auto __resultRef = jni::make_global(__result);
+        return JNICallable<JFunc_void_std__string_double, void(std::string, double)>(std::move(__resultRef));
+      }
+    }()) : std::nullopt;
+  }
+  void JHybridNitroVtoViewSpec::setOnCaptureComplete(const std::optional<std::function<void(const std::string& /* filePath */, double /* durationSeconds */)>>& onCaptureComplete) {
+    static const auto method = javaClassStatic()->getMethod<void(jni::alias_ref<JFunc_void_std__string_double::javaobject> /* onCaptureComplete */)>("setOnCaptureComplete_cxx");
+    method(_javaPart, onCaptureComplete.has_value() ? JFunc_void_std__string_double_cxx::fromCpp(onCaptureComplete.value()) : nullptr);
+  }
 
   // Methods
   void JHybridNitroVtoViewSpec::switchModel(const std::string& modelUrl) {
@@ -125,5 +214,89 @@ namespace margelo::nitro::nitrovto {
     static const auto method = javaClassStatic()->getMethod<void()>("resetSession");
     method(_javaPart);
   }
+  void JHybridNitroVtoViewSpec::prefetchModels(const std::vector<std::string>& modelUrls) {
+    static const auto method = javaClassStatic()->getMethod<void(jni::alias_ref<jni::JArrayClass<jni::JString>> /* modelUrls */)>("prefetchModels");
+    method(_javaPart, [&]() {
+      size_t __size = modelUrls.size();
+      jni::local_ref<jni::JArrayClass<jni::JString>> __array = jni::JArrayClass<jni::JString>::newArray(__size);
+      for (size_t __i = 0; __i < __size; __i++) {
+        const auto& __element = modelUrls[__i];
+        __array->setElement(__i, *jni::make_jstring(__element));
+      }
+      return __array;
+    }());
+  }
+  void JHybridNitroVtoViewSpec::setCompareModels(const std::vector<std::string>& modelUrls) {
+    static const auto method = javaClassStatic()->getMethod<void(jni::alias_ref<jni::JArrayClass<jni::JString>> /* modelUrls */)>("setCompareModels");
+    method(_javaPart, [&]() {
+      size_t __size = modelUrls.size();
+      jni::local_ref<jni::JArrayClass<jni::JString>> __array = jni::JArrayClass<jni::JString>::newArray(__size);
+      for (size_t __i = 0; __i < __size; __i++) {
+        const auto& __element = modelUrls[__i];
+        __array->setElement(__i, *jni::make_jstring(__element));
+      }
+      return __array;
+    }());
+  }
+  void JHybridNitroVtoViewSpec::setActiveModel(double index) {
+    static const auto method = javaClassStatic()->getMethod<void(double /* index */)>("setActiveModel");
+    method(_javaPart, index);
+  }
+  void JHybridNitroVtoViewSpec::setEnvironment(const std::string& name) {
+    static const auto method = javaClassStatic()->getMethod<void(jni::alias_ref<jni::JString> /* name */)>("setEnvironment");
+    method(_javaPart, jni::make_jstring(name));
+  }
+  void JHybridNitroVtoViewSpec::warmUp() {
+    static const auto method = javaClassStatic()->getMethod<void()>("warmUp");
+    method(_javaPart);
+  }
+  ModelCacheStats JHybridNitroVtoViewSpec::getModelCacheStats() {
+    static const auto method = javaClassStatic()->getMethod<jni::local_ref<JModelCacheStats>()>("getModelCacheStats");
+    auto __result = method(_javaPart);
+    return __result->toCpp();
+  }
+  ModelMemoryStats JHybridNitroVtoViewSpec::getModelMemoryStats() {
+    static const auto method = javaClassStatic()->getMethod<jni::local_ref<JModelMemoryStats>()>("getModelMemoryStats");
+    auto __result = method(_javaPart);
+    return __result->toCpp();
+  }
+  PerformanceStats JHybridNitroVtoViewSpec::getPerformanceStats() {
+    static const auto method = javaClassStatic()->getMethod<jni::local_ref<JPerformanceStats>()>("getPerformanceStats");
+    auto __result = method(_javaPart);
+    return __result->toCpp();
+  }
+  std::shared_ptr<ArrayBuffer> JHybridNitroVtoViewSpec::getFacePoseBuffer() {
+    static const auto method = javaClassStatic()->getMethod<jni::local_ref<JArrayBuffer::javaobject>()>("getFacePoseBuffer");
+    auto __result = method(_javaPart);
+    return __result->cthis()->getArrayBuffer();
+  }
+  void JHybridNitroVtoViewSpec::startFaceRecording(const std::string& filePath) {
+    static const auto method = javaClassStatic()->getMethod<void(jni::alias_ref<jni::JString> /* filePath */)>("startFaceRecording");
+    method(_javaPart, jni::make_jstring(filePath));
+  }
+  void JHybridNitroVtoViewSpec::stopFaceRecording() {
+    static const auto method = javaClassStatic()->getMethod<void()>("stopFaceRecording");
+    method(_javaPart);
+  }
+  void JHybridNitroVtoViewSpec::capture(const std::string& filePath) {
+    static const auto method = javaClassStatic()->getMethod<void(jni::alias_ref<jni::JString> /* filePath */)>("capture");
+    method(_javaPart, jni::make_jstring(filePath));
+  }
+  void JHybridNitroVtoViewSpec::startRecording(const std::string& filePath) {
+    static const auto method = javaClassStatic()->getMethod<void(jni::alias_ref<jni::JString> /* filePath */)>("startRecording");
+    method(_javaPart, jni::make_jstring(filePath));
+  }
+  void JHybridNitroVtoViewSpec::stopRecording() {
+    static const auto method = javaClassStatic()->getMethod<void()>("stopRecording");
+    method(_javaPart);
+  }
+  void JHybridNitroVtoViewSpec::clearModelCache() {
+    static const auto method = javaClassStatic()->getMethod<void()>("clearModelCache");
+    method(_javaPart);
+  }
+  void JHybridNitroVtoViewSpec::setModelCacheLimit(double maxBytes) {
+    static const auto method = javaClassStatic()->getMethod<void(double /* maxBytes */)>("setModelCacheLimit");
+    method(_javaPart, maxBytes);
+  }
 
 } // namespace margelo::nitro::nitrovto
@@ -56,19 +56,45 @@ namespace margelo::nitro::nitrovto {
     void setIsActive(bool isActive) override;
     std::optional<std::function<void(const std::string& /* modelUrl */)>> getOnModelLoaded() override;
     void setOnModelLoaded(const std::optional<std::function<void(const std::string& /* modelUrl */)>>& onModelLoaded) override;
+    std::optional<std::function<void(const std::string& /* modelUrl */, double /* progress */)>> getOnModelLoadProgress() override;
+    void setOnModelLoadProgress(const std::optional<std::function<void(const std::string& /* modelUrl */, double /* progress */)>>& onModelLoadProgress) override;
     std::optional<bool> getFaceMeshOcclusion() override;
     void setFaceMeshOcclusion(std::optional<bool> faceMeshOcclusion) override;
     std::optional<bool> getBackPlaneOcclusion() override;
     void setBackPlaneOcclusion(std::optional<bool> backPlaneOcclusion) override;
     std::optional<double> getForwardOffset() override;
     void setForwardOffset(std::optional<double> forwardOffset) override;
+    std::optional<double> getMaxFaces() override;
+    void setMaxFaces(std::optional<double> maxFaces) override;
     std::optional<bool> getDebug() override;
     void setDebug(std::optional<bool> debug) override;
+    std::optional<bool> getAdaptivePerformance() override;
+    void setAdaptivePerformance(std::optional<bool> adaptivePerformance) override;
+    std::optional<std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>> getOnPerformanceChange() override;
+    void setOnPerformanceChange(const std::optional<std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>>& onPerformanceChange) override;
+    std::optional<std::function<void(const std::string& /* filePath */, double /* durationSeconds */)>> getOnCaptureComplete() override;
+    void setOnCaptureComplete(const std::optional<std::function<void(const std::string& /* filePath */, double /* durationSeconds */)>>& onCaptureComplete) override;
 
   public:
     // Methods
     void switchModel(const std::string& modelUrl) override;
     void resetSession() override;
+    void prefetchModels(const std::vector<std::string>& modelUrls) override;
+    void setCompareModels(const std::vector<std::string>& modelUrls) override;
+    void setActiveModel(double index) override;
+    void setEnvironment(const std::string& name) override;
+    void warmUp() override;
+    ModelCacheStats getModelCacheStats() override;
+    ModelMemoryStats getModelMemoryStats() override;
+    PerformanceStats getPerformanceStats() override;
+    std::shared_ptr<ArrayBuffer> getFacePoseBuffer() override;
+    void startFaceRecording(const std::string& filePath) override;
+    void stopFaceRecording() override;
+    void capture(const std::string& filePath) override;
+    void startRecording(const std::string& filePath) override;
+    void stopRecording() override;
+    void clearModelCache() override;
+    void setModelCacheLimit(double maxBytes) override;
 
   private:
     friend HybridBase;
@@ -0,0 +1,73 @@
+///
+/// JModelCacheStats.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2026 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#include <fbjni/fbjni.h>
+#include "ModelCacheStats.hpp"
+
+
+
+namespace margelo::nitro::nitrovto {
+
+  using namespace facebook;
+
+  /**
+   * The C++ JNI bridge between the C++ struct "ModelCacheStats" and the the Kotlin data class "ModelCacheStats".
+   */
+  struct JModelCacheStats final: public jni::JavaClass<JModelCacheStats> {
+  public:
+    static auto constexpr kJavaDescriptor = "Lcom/margelo/nitro/nitrovto/ModelCacheStats;";
+
+  public:
+    /**
+     * Convert this Java/Kotlin-based struct to the C++ struct ModelCacheStats by copying all values to C++.
+     */
+    [[maybe_unused]]
+    [[nodiscard]]
+    ModelCacheStats toCpp() const {
+      static const auto clazz = javaClassStatic();
+      static const auto fieldFileCount = clazz->getField<double>("fileCount");
+      double fileCount = this->getFieldValue(fieldFileCount);
+      static const auto fieldTotalBytes = clazz->getField<double>("totalBytes");
+      double totalBytes = this->getFieldValue(fieldTotalBytes);
+      static const auto fieldByteLimit = clazz->getField<double>("byteLimit");
+      double byteLimit = this->getFieldValue(fieldByteLimit);
+      static const auto fieldHitCount = clazz->getField<double>("hitCount");
+      double hitCount = this->getFieldValue(fieldHitCount);
+      static const auto fieldMissCount = clazz->getField<double>("missCount");
+      double missCount = this->getFieldValue(fieldMissCount);
+      return ModelCacheStats(
+        fileCount,
+        totalBytes,
+        byteLimit,
+        hitCount,
+        missCount
+      );
+    }
+
+  public:
+    /**
+     * Create a Java/Kotlin-based struct by copying all values from the given C++ struct to Java.
+     */
+    [[maybe_unused]]
+    static jni::local_ref<JModelCacheStats::javaobject> fromCpp(const ModelCacheStats& value) {
+      using JSignature = JModelCacheStats(double, double, double, double, double);
+      static const auto clazz = javaClassStatic();
+      static const auto create = clazz->getStaticMethod<JSignature>("fromCpp");
+      return create(
+        clazz,
+        value.fileCount,
+        value.totalBytes,
+        value.byteLimit,
+        value.hitCount,
+        value.missCount
+      );
+    }
+  };
+
+} // namespace margelo::nitro::nitrovto
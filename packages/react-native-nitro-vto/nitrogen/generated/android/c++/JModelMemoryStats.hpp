@@ -0,0 +1,73 @@
+///
+/// JModelMemoryStats.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2026 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#include <fbjni/fbjni.h>
+#include "ModelMemoryStats.hpp"
+
+
+
+namespace margelo::nitro::nitrovto {
+
+  using namespace facebook;
+
+  /**
+   * The C++ JNI bridge between the C++ struct "ModelMemoryStats" and the the Kotlin data class "ModelMemoryStats".
+   */
+  struct JModelMemoryStats final: public jni::JavaClass<JModelMemoryStats> {
+  public:
+    static auto constexpr kJavaDescriptor = "Lcom/margelo/nitro/nitrovto/ModelMemoryStats;";
+
+  public:
+    /**
+     * Convert this Java/Kotlin-based struct to the C++ struct ModelMemoryStats by copying all values to C++.
+     */
+    [[maybe_unused]]
+    [[nodiscard]]
+    ModelMemoryStats toCpp() const {
+      static const auto clazz = javaClassStatic();
+      static const auto fieldModelCount = clazz->getField<double>("modelCount");
+      double modelCount = this->getFieldValue(fieldModelCount);
+      static const auto fieldCompareModelCount = clazz->getField<double>("compareModelCount");
+      double compareModelCount = this->getFieldValue(fieldCompareModelCount);
+      static const auto fieldGpuBytes = clazz->getField<double>("gpuBytes");
+      double gpuBytes = this->getFieldValue(fieldGpuBytes);
+      static const auto fieldCpuBytes = clazz->getField<double>("cpuBytes");
+      double cpuBytes = this->getFieldValue(fieldCpuBytes);
+      static const auto fieldDeviceTier = clazz->getField<double>("deviceTier");
+      double deviceTier = this->getFieldValue(fieldDeviceTier);
+      return ModelMemoryStats(
+        modelCount,
+        compareModelCount,
+        gpuBytes,
+        cpuBytes,
+        deviceTier
+      );
+    }
+
+  public:
+    /**
+     * Create a Java/Kotlin-based struct by copying all values from the given C++ struct to Java.
+     */
+    [[maybe_unused]]
+    static jni::local_ref<JModelMemoryStats::javaobject> fromCpp(const ModelMemoryStats& value) {
+      using JSignature = JModelMemoryStats(double, double, double, double, double);
+      static const auto clazz = javaClassStatic();
+      static const auto create = clazz->getStaticMethod<JSignature>("fromCpp");
+      return create(
+        clazz,
+        value.modelCount,
+        value.compareModelCount,
+        value.gpuBytes,
+        value.cpuBytes,
+        value.deviceTier
+      );
+    }
+  };
+
+} // namespace margelo::nitro::nitrovto
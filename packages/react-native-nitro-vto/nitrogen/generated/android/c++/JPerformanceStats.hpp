@@ -0,0 +1,94 @@
+///
+/// JPerformanceStats.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2026 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#include <fbjni/fbjni.h>
+#include "PerformanceStats.hpp"
+
+#include "JStageTiming.hpp"
+#include "StageTiming.hpp"
+
+namespace margelo::nitro::nitrovto {
+
+  using namespace facebook;
+
+  /**
+   * The C++ JNI bridge between the C++ struct "PerformanceStats" and the the Kotlin data class "PerformanceStats".
+   */
+  struct JPerformanceStats final: public jni::JavaClass<JPerformanceStats> {
+  public:
+    static auto constexpr kJavaDescriptor = "Lcom/margelo/nitro/nitrovto/PerformanceStats;";
+
+  public:
+    /**
+     * Convert this Java/Kotlin-based struct to the C++ struct PerformanceStats by copying all values to C++.
+     */
+    [[maybe_unused]]
+    [[nodiscard]]
+    PerformanceStats toCpp() const {
+      static const auto clazz = javaClassStatic();
+      static const auto fieldFrameCount = clazz->getField<double>("frameCount");
+      double frameCount = this->getFieldValue(fieldFrameCount);
+      static const auto fieldDroppedFrames = clazz->getField<double>("droppedFrames");
+      double droppedFrames = this->getFieldValue(fieldDroppedFrames);
+      static const auto fieldSession = clazz->getField<JStageTiming>("session");
+      jni::local_ref<JStageTiming> session = this->getFieldValue(fieldSession);
+      static const auto fieldCamera = clazz->getField<JStageTiming>("camera");
+      jni::local_ref<JStageTiming> camera = this->getFieldValue(fieldCamera);
+      static const auto fieldFaceMesh = clazz->getField<JStageTiming>("faceMesh");
+      jni::local_ref<JStageTiming> faceMesh = this->getFieldValue(fieldFaceMesh);
+      static const auto fieldGlassesPose = clazz->getField<JStageTiming>("glassesPose");
+      jni::local_ref<JStageTiming> glassesPose = this->getFieldValue(fieldGlassesPose);
+      static const auto fieldResources = clazz->getField<JStageTiming>("resources");
+      jni::local_ref<JStageTiming> resources = this->getFieldValue(fieldResources);
+      static const auto fieldRender = clazz->getField<JStageTiming>("render");
+      jni::local_ref<JStageTiming> render = this->getFieldValue(fieldRender);
+      static const auto fieldFrame = clazz->getField<JStageTiming>("frame");
+      jni::local_ref<JStageTiming> frame = this->getFieldValue(fieldFrame);
+      static const auto fieldGpu = clazz->getField<JStageTiming>("gpu");
+      jni::local_ref<JStageTiming> gpu = this->getFieldValue(fieldGpu);
+      return PerformanceStats(
+        frameCount,
+        droppedFrames,
+        session->toCpp(),
+        camera->toCpp(),
+        faceMesh->toCpp(),
+        glassesPose->toCpp(),
+        resources->toCpp(),
+        render->toCpp(),
+        frame->toCpp(),
+        gpu->toCpp()
+      );
+    }
+
+  public:
+    /**
+     * Create a Java/Kotlin-based struct by copying all values from the given C++ struct to Java.
+     */
+    [[maybe_unused]]
+    static jni::local_ref<JPerformanceStats::javaobject> fromCpp(const PerformanceStats& value) {
+      using JSignature = JPerformanceStats(double, double, jni::alias_ref<JStageTiming>, jni::alias_ref<JStageTiming>, jni::alias_ref<JStageTiming>, jni::alias_ref<JStageTiming>, jni::alias_ref<JStageTiming>, jni::alias_ref<JStageTiming>, jni::alias_ref<JStageTiming>, jni::alias_ref<JStageTiming>);
+      static const auto clazz = javaClassStatic();
+      static const auto create = clazz->getStaticMethod<JSignature>("fromCpp");
+      return create(
+        clazz,
+        value.frameCount,
+        value.droppedFrames,
+        JStageTiming::fromCpp(value.session),
+        JStageTiming::fromCpp(value.camera),
+        JStageTiming::fromCpp(value.faceMesh),
+        JStageTiming::fromCpp(value.glassesPose),
+        JStageTiming::fromCpp(value.resources),
+        JStageTiming::fromCpp(value.render),
+        JStageTiming::fromCpp(value.frame),
+        JStageTiming::fromCpp(value.gpu)
+      );
+    }
+  };
+
+} // namespace margelo::nitro::nitrovto
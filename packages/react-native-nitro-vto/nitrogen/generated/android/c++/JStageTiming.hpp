@@ -0,0 +1,73 @@
+///
+/// JStageTiming.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2026 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#include <fbjni/fbjni.h>
+#include "StageTiming.hpp"
+
+
+
+namespace margelo::nitro::nitrovto {
+
+  using namespace facebook;
+
+  /**
+   * The C++ JNI bridge between the C++ struct "StageTiming" and the the Kotlin data class "StageTiming".
+   */
+  struct JStageTiming final: public jni::JavaClass<JStageTiming> {
+  public:
+    static auto constexpr kJavaDescriptor = "Lcom/margelo/nitro/nitrovto/StageTiming;";
+
+  public:
+    /**
+     * Convert this Java/Kotlin-based struct to the C++ struct StageTiming by copying all values to C++.
+     */
+    [[maybe_unused]]
+    [[nodiscard]]
+    StageTiming toCpp() const {
+      static const auto clazz = javaClassStatic();
+      static const auto fieldP50 = clazz->getField<double>("p50");
+      double p50 = this->getFieldValue(fieldP50);
+      static const auto fieldP95 = clazz->getField<double>("p95");
+      double p95 = this->getFieldValue(fieldP95);
+      static const auto fieldP99 = clazz->getField<double>("p99");
+      double p99 = this->getFieldValue(fieldP99);
+      static const auto fieldMax = clazz->getField<double>("max");
+      double max = this->getFieldValue(fieldMax);
+      static const auto fieldSamples = clazz->getField<double>("samples");
+      double samples = this->getFieldValue(fieldSamples);
+      return StageTiming(
+        p50,
+        p95,
+        p99,
+        max,
+        samples
+      );
+    }
+
+  public:
+    /**
+     * Create a Java/Kotlin-based struct by copying all values from the given C++ struct to Java.
+     */
+    [[maybe_unused]]
+    static jni::local_ref<JStageTiming::javaobject> fromCpp(const StageTiming& value) {
+      using JSignature = JStageTiming(double, double, double, double, double);
+      static const auto clazz = javaClassStatic();
+      static const auto create = clazz->getStaticMethod<JSignature>("fromCpp");
+      return create(
+        clazz,
+        value.p50,
+        value.p95,
+        value.p99,
+        value.max,
+        value.samples
+      );
+    }
+  };
+
+} // namespace margelo::nitro::nitrovto
@@ -48,6 +48,10 @@ void JHybridNitroVtoViewStateUpdater::updateViewProps(jni::alias_ref<jni::JClass
     view->setOnModelLoaded(props.onModelLoaded.value);
     // TODO: Set isDirty = false
   }
+  if (props.onModelLoadProgress.isDirty) {
+    view->setOnModelLoadProgress(props.onModelLoadProgress.value);
+    // TODO: Set isDirty = false
+  }
   if (props.faceMeshOcclusion.isDirty) {
     view->setFaceMeshOcclusion(props.faceMeshOcclusion.value);
     // TODO: Set isDirty = false
@@ -60,10 +64,26 @@ void JHybridNitroVtoViewStateUpdater::updateViewProps(jni::alias_ref<jni::JClass
     view->setForwardOffset(props.forwardOffset.value);
     // TODO: Set isDirty = false
   }
+  if (props.maxFaces.isDirty) {
+    view->setMaxFaces(props.maxFaces.value);
+    // TODO: Set isDirty = false
+  }
   if (props.debug.isDirty) {
     view->setDebug(props.debug.value);
     // TODO: Set isDirty = false
   }
+  if (props.adaptivePerformance.isDirty) {
+    view->setAdaptivePerformance(props.adaptivePerformance.value);
+    // TODO: Set isDirty = false
+  }
+  if (props.onPerformanceChange.isDirty) {
+    view->setOnPerformanceChange(props.onPerformanceChange.value);
+    // TODO: Set isDirty = false
+  }
+  if (props.onCaptureComplete.isDirty) {
+    view->setOnCaptureComplete(props.onCaptureComplete.value);
+    // TODO: Set isDirty = false
+  }
 
   // Update hybridRef if it changed
   if (props.hybridRef.isDirty) {
@@ -0,0 +1,80 @@
+///
+/// Func_void_double_double_std__string.kt
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2026 Marc Rousavy @ Margelo
+///
+
+package com.margelo.nitro.nitrovto
+
+import androidx.annotation.Keep
+import com.facebook.jni.HybridData
+import com.facebook.proguard.annotations.DoNotStrip
+import dalvik.annotation.optimization.FastNative
+
+
+/**
+ * Represents the JavaScript callback `(renderScale: number, frameRate: number, reason: string) => void`.
+ * This can be either implemented in C++ (in which case it might be a callback coming from JS),
+ * or in Kotlin/Java (in which case it is a native callback).
+ */
+@DoNotStrip
+@Keep
+@Suppress("ClassName", "RedundantUnitReturnType")
+fun interface Func_void_double_double_std__string: (Double, Double, String) -> Unit {
+  /**
+   * Call the given JS callback.
+   * @throws Throwable if the JS function itself throws an error, or if the JS function/runtime has already been deleted.
+   */
+  @DoNotStrip
+  @Keep
+  override fun invoke(renderScale: Double, frameRate: Double, reason: String): Unit
+}
+
+/**
+ * Represents the JavaScript callback `(renderScale: number, frameRate: number, reason: string) => void`.
+ * This is implemented in C++, via a `std::function<...>`.
+ * The callback might be coming from JS.
+ */
+@DoNotStrip
+@Keep
+@Suppress(
+  "KotlinJniMissingFunction", "unused",
+  "RedundantSuppression", "RedundantUnitReturnType", "FunctionName",
+  "ConvertSecondaryConstructorToPrimary", "ClassName", "LocalVariableName",
+)
+class Func_void_double_double_std__string_cxx: Func_void_double_double_std__string {
+  @DoNotStrip
+  @Keep
+  private val mHybridData: HybridData
+
+  @DoNotStrip
+  @Keep
+  private constructor(hybridData: HybridData) {
+    mHybridData = hybridData
+  }
+
+  @DoNotStrip
+  @Keep
+  override fun invoke(renderScale: Double, frameRate: Double, reason: String): Unit
+    = invoke_cxx(renderScale, frameRate, reason)
+
+  @FastNative
+  private external fun invoke_cxx(renderScale: Double, frameRate: Double, reason: String): Unit
+}
+
+/**
+ * Represents the JavaScript callback `(renderScale: number, frameRate: number, reason: string) => void`.
+ * This is implemented in Java/Kotlin, via a `(Double, Double, String) -> Unit`.
+ * The callback is always coming from native.
+ */
+@DoNotStrip
+@Keep
+@Suppress("ClassName", "RedundantUnitReturnType", "unused")
+class Func_void_double_double_std__string_java(private val function: (Double, Double, String) -> Unit): Func_void_double_double_std__string {
+  @DoNotStrip
+  @Keep
+  override fun invoke(renderScale: Double, frameRate: Double, reason: String): Unit {
+    return this.function(renderScale, frameRate, reason)
+  }
+}
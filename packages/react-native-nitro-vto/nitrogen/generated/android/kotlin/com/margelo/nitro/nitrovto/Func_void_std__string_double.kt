@@ -0,0 +1,80 @@
+///
+/// Func_void_std__string_double.kt
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2026 Marc Rousavy @ Margelo
+///
+
+package com.margelo.nitro.nitrovto
+
+import androidx.annotation.Keep
+import com.facebook.jni.HybridData
+import com.facebook.proguard.annotations.DoNotStrip
+import dalvik.annotation.optimization.FastNative
+
+
+/**
+ * Represents the JavaScript callback `(modelUrl: string, progress: number) => void`.
+ * This can be either implemented in C++ (in which case it might be a callback coming from JS),
+ * or in Kotlin/Java (in which case it is a native callback).
+ */
+@DoNotStrip
+@Keep
+@Suppress("ClassName", "RedundantUnitReturnType")
+fun interface Func_void_std__string_double: (String, Double) -> Unit {
+  /**
+   * Call the given JS callback.
+   * @throws Throwable if the JS function itself throws an error, or if the JS function/runtime has already been deleted.
+   */
+  @DoNotStrip
+  @Keep
+  override fun invoke(modelUrl: String, progress: Double): Unit
+}
+
+/**
+ * Represents the JavaScript callback `(modelUrl: string, progress: number) => void`.
+ * This is implemented in C++, via a `std::function<...>`.
+ * The callback might be coming from JS.
+ */
+@DoNotStrip
+@Keep
+@Suppress(
+  "KotlinJniMissingFunction", "unused",
+  "RedundantSuppression", "RedundantUnitReturnType", "FunctionName",
+  "ConvertSecondaryConstructorToPrimary", "ClassName", "LocalVariableName",
+)
+class Func_void_std__string_double_cxx: Func_void_std__string_double {
+  @DoNotStrip
+  @Keep
+  private val mHybridData: HybridData
+
+  @DoNotStrip
+  @Keep
+  private constructor(hybridData: HybridData) {
+    mHybridData = hybridData
+  }
+
+  @DoNotStrip
+  @Keep
+  override fun invoke(modelUrl: String, progress: Double): Unit
+    = invoke_cxx(modelUrl, progress)
+
+  @FastNative
+  private external fun invoke_cxx(modelUrl: String, progress: Double): Unit
+}
+
+/**
+ * Represents the JavaScript callback `(modelUrl: string, progress: number) => void`.
+ * This is implemented in Java/Kotlin, via a `(String, Double) -> Unit`.
+ * The callback is always coming from native.
+ */
+@DoNotStrip
+@Keep
+@Suppress("ClassName", "RedundantUnitReturnType", "unused")
+class Func_void_std__string_double_java(private val function: (String, Double) -> Unit): Func_void_std__string_double {
+  @DoNotStrip
+  @Keep
+  override fun invoke(modelUrl: String, progress: Double): Unit {
+    return this.function(modelUrl, progress)
+  }
+}
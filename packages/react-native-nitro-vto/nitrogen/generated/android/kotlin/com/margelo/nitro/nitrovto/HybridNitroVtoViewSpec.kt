@@ -10,6 +10,7 @@ package com.margelo.nitro.nitrovto
 import androidx.annotation.Keep
 import com.facebook.jni.HybridData
 import com.facebook.proguard.annotations.DoNotStrip
+import com.margelo.nitro.core.ArrayBuffer
 import com.margelo.nitro.views.HybridView
 
 /**
@@ -68,6 +69,20 @@ abstract class HybridNitroVtoViewSpec: HybridView() {
       onModelLoaded = value?.let { it }
     }
   
+  abstract var onModelLoadProgress: ((modelUrl: String, progress: Double) -> Unit)?
+  
+  private var onModelLoadProgress_cxx: Func_void_std__string_double?
+    @Keep
+    @DoNotStrip
+    get() {
+      return onModelLoadProgress?.let { Func_void_std__string_double_java(it) }
+    }
+    @Keep
+    @DoNotStrip
+    set(value) {
+      onModelLoadProgress = value?.let { it }
+    }
+  
   @get:DoNotStrip
   @get:Keep
   @set:DoNotStrip
@@ -86,11 +101,51 @@ abstract class HybridNitroVtoViewSpec: HybridView() {
   @set:Keep
   abstract var forwardOffset: Double?
   
+  @get:DoNotStrip
+  @get:Keep
+  @set:DoNotStrip
+  @set:Keep
+  abstract var maxFaces: Double?
+  
   @get:DoNotStrip
   @get:Keep
   @set:DoNotStrip
   @set:Keep
   abstract var debug: Boolean?
+  
+  @get:DoNotStrip
+  @get:Keep
+  @set:DoNotStrip
+  @set:Keep
+  abstract var adaptivePerformance: Boolean?
+  
+  abstract var onPerformanceChange: ((renderScale: Double, frameRate: Double, reason: String) -> Unit)?
+  
+  private var onPerformanceChange_cxx: Func_void_double_double_std__string?
+    @Keep
+    @DoNotStrip
+    get() {
+      return onPerformanceChange?.let { Func_void_double_double_std__string_java(it) }
+    }
+    @Keep
+    @DoNotStrip
+    set(value) {
+      onPerformanceChange = value?.let { it }
+    }
+  
+  abstract var onCaptureComplete: ((filePath: String, durationSeconds: Double) -> Unit)?
+  
+  private var onCaptureComplete_cxx: Func_void_std__string_double?
+    @Keep
+    @DoNotStrip
+    get() {
+      return onCaptureComplete?.let { Func_void_std__string_double_java(it) }
+    }
+    @Keep
+    @DoNotStrip
+    set(value) {
+      onCaptureComplete = value?.let { it }
+    }
 
   // Methods
   @DoNotStrip
@@ -100,6 +155,70 @@ abstract class HybridNitroVtoViewSpec: HybridView() {
   @DoNotStrip
   @Keep
   abstract fun resetSession(): Unit
+  
+  @DoNotStrip
+  @Keep
+  abstract fun prefetchModels(modelUrls: Array<String>): Unit
+  
+  @DoNotStrip
+  @Keep
+  abstract fun setCompareModels(modelUrls: Array<String>): Unit
+  
+  @DoNotStrip
+  @Keep
+  abstract fun setActiveModel(index: Double): Unit
+  
+  @DoNotStrip
+  @Keep
+  abstract fun setEnvironment(name: String): Unit
+  
+  @DoNotStrip
+  @Keep
+  abstract fun warmUp(): Unit
+  
+  @DoNotStrip
+  @Keep
+  abstract fun getModelCacheStats(): ModelCacheStats
+  
+  @DoNotStrip
+  @Keep
+  abstract fun getModelMemoryStats(): ModelMemoryStats
+  
+  @DoNotStrip
+  @Keep
+  abstract fun getPerformanceStats(): PerformanceStats
+  
+  @DoNotStrip
+  @Keep
+  abstract fun getFacePoseBuffer(): ArrayBuffer
+  
+  @DoNotStrip
+  @Keep
+  abstract fun startFaceRecording(filePath: String): Unit
+  
+  @DoNotStrip
+  @Keep
+  abstract fun stopFaceRecording(): Unit
+  
+  @DoNotStrip
+  @Keep
+  abstract fun capture(filePath: String): Unit
+  
+  @DoNotStrip
+  @Keep
+  abstract fun startRecording(filePath: String): Unit
+  
+  @DoNotStrip
+  @Keep
+  abstract fun stopRecording(): Unit
+  
+  @DoNotStrip
+  @Keep
+  abstract fun clearModelCache(): Unit
+  
+  @DoNotStrip
+  @Keep
+  abstract fun setModelCacheLimit(maxBytes: Double): Unit
 
   private external fun initHybrid(): HybridData
 
@@ -0,0 +1,50 @@
+///
+/// ModelCacheStats.kt
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2026 Marc Rousavy @ Margelo
+///
+
+package com.margelo.nitro.nitrovto
+
+import androidx.annotation.Keep
+import com.facebook.proguard.annotations.DoNotStrip
+
+
+/**
+ * Represents the JavaScript object/struct "ModelCacheStats".
+ */
+@DoNotStrip
+@Keep
+data class ModelCacheStats(
+  @DoNotStrip
+  @Keep
+  val fileCount: Double,
+  @DoNotStrip
+  @Keep
+  val totalBytes: Double,
+  @DoNotStrip
+  @Keep
+  val byteLimit: Double,
+  @DoNotStrip
+  @Keep
+  val hitCount: Double,
+  @DoNotStrip
+  @Keep
+  val missCount: Double
+) {
+  /* primary constructor */
+
+  private companion object {
+    /**
+     * Constructor called from C++
+     */
+    @DoNotStrip
+    @Keep
+    @Suppress("unused")
+    @JvmStatic
+    private fun fromCpp(fileCount: Double, totalBytes: Double, byteLimit: Double, hitCount: Double, missCount: Double): ModelCacheStats {
+      return ModelCacheStats(fileCount, totalBytes, byteLimit, hitCount, missCount)
+    }
+  }
+}
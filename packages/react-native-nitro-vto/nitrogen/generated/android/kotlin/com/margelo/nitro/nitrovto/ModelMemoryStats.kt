@@ -0,0 +1,50 @@
+///
+/// ModelMemoryStats.kt
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2026 Marc Rousavy @ Margelo
+///
+
+package com.margelo.nitro.nitrovto
+
+import androidx.annotation.Keep
+import com.facebook.proguard.annotations.DoNotStrip
+
+
+/**
+ * Represents the JavaScript object/struct "ModelMemoryStats".
+ */
+@DoNotStrip
+@Keep
+data class ModelMemoryStats(
+  @DoNotStrip
+  @Keep
+  val modelCount: Double,
+  @DoNotStrip
+  @Keep
+  val compareModelCount: Double,
+  @DoNotStrip
+  @Keep
+  val gpuBytes: Double,
+  @DoNotStrip
+  @Keep
+  val cpuBytes: Double,
+  @DoNotStrip
+  @Keep
+  val deviceTier: Double
+) {
+  /* primary constructor */
+
+  private companion object {
+    /**
+     * Constructor called from C++
+     */
+    @DoNotStrip
+    @Keep
+    @Suppress("unused")
+    @JvmStatic
+    private fun fromCpp(modelCount: Double, compareModelCount: Double, gpuBytes: Double, cpuBytes: Double, deviceTier: Double): ModelMemoryStats {
+      return ModelMemoryStats(modelCount, compareModelCount, gpuBytes, cpuBytes, deviceTier)
+    }
+  }
+}
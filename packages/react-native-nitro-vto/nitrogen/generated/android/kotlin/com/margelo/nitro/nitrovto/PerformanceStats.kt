@@ -0,0 +1,65 @@
+///
+/// PerformanceStats.kt
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2026 Marc Rousavy @ Margelo
+///
+
+package com.margelo.nitro.nitrovto
+
+import androidx.annotation.Keep
+import com.facebook.proguard.annotations.DoNotStrip
+
+
+/**
+ * Represents the JavaScript object/struct "PerformanceStats".
+ */
+@DoNotStrip
+@Keep
+data class PerformanceStats(
+  @DoNotStrip
+  @Keep
+  val frameCount: Double,
+  @DoNotStrip
+  @Keep
+  val droppedFrames: Double,
+  @DoNotStrip
+  @Keep
+  val session: StageTiming,
+  @DoNotStrip
+  @Keep
+  val camera: StageTiming,
+  @DoNotStrip
+  @Keep
+  val faceMesh: StageTiming,
+  @DoNotStrip
+  @Keep
+  val glassesPose: StageTiming,
+  @DoNotStrip
+  @Keep
+  val resources: StageTiming,
+  @DoNotStrip
+  @Keep
+  val render: StageTiming,
+  @DoNotStrip
+  @Keep
+  val frame: StageTiming,
+  @DoNotStrip
+  @Keep
+  val gpu: StageTiming
+) {
+  /* primary constructor */
+
+  private companion object {
+    /**
+     * Constructor called from C++
+     */
+    @DoNotStrip
+    @Keep
+    @Suppress("unused")
+    @JvmStatic
+    private fun fromCpp(frameCount: Double, droppedFrames: Double, session: StageTiming, camera: StageTiming, faceMesh: StageTiming, glassesPose: StageTiming, resources: StageTiming, render: StageTiming, frame: StageTiming, gpu: StageTiming): PerformanceStats {
+      return PerformanceStats(frameCount, droppedFrames, session, camera, faceMesh, glassesPose, resources, render, frame, gpu)
+    }
+  }
+}
@@ -0,0 +1,50 @@
+///
+/// StageTiming.kt
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2026 Marc Rousavy @ Margelo
+///
+
+package com.margelo.nitro.nitrovto
+
+import androidx.annotation.Keep
+import com.facebook.proguard.annotations.DoNotStrip
+
+
+/**
+ * Represents the JavaScript object/struct "StageTiming".
+ */
+@DoNotStrip
+@Keep
+data class StageTiming(
+  @DoNotStrip
+  @Keep
+  val p50: Double,
+  @DoNotStrip
+  @Keep
+  val p95: Double,
+  @DoNotStrip
+  @Keep
+  val p99: Double,
+  @DoNotStrip
+  @Keep
+  val max: Double,
+  @DoNotStrip
+  @Keep
+  val samples: Double
+) {
+  /* primary constructor */
+
+  private companion object {
+    /**
+     * Constructor called from C++
+     */
+    @DoNotStrip
+    @Keep
+    @Suppress("unused")
+    @JvmStatic
+    private fun fromCpp(p50: Double, p95: Double, p99: Double, max: Double, samples: Double): StageTiming {
+      return StageTiming(p50, p95, p99, max, samples)
+    }
+  }
+}
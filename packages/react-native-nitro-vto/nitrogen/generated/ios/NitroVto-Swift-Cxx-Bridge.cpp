@@ -22,6 +22,22 @@ namespace margelo::nitro::nitrovto::bridge::swift {
     };
   }
   
+  // pragma MARK: std::function<void(const std::string& /* modelUrl */, double /* progress */)>
+  Func_void_std__string_double create_Func_void_std__string_double(void* NON_NULL swiftClosureWrapper) noexcept {
+    auto swiftClosure = NitroVto::Func_void_std__string_double::fromUnsafe(swiftClosureWrapper);
+    return [swiftClosure = std::move(swiftClosure)](const std::string& modelUrl, double progress) mutable -> void {
+      swiftClosure.call(modelUrl, std::forward<decltype(progress)>(progress));
+    };
+  }
+  
+  // pragma MARK: std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>
+  Func_void_double_double_std__string create_Func_void_double_double_std__string(void* NON_NULL swiftClosureWrapper) noexcept {
+    auto swiftClosure = NitroVto::Func_void_double_double_std__string::fromUnsafe(swiftClosureWrapper);
+    return [swiftClosure = std::move(swiftClosure)](double renderScale, double frameRate, const std::string& reason) mutable -> void {
+      swiftClosure.call(std::forward<decltype(renderScale)>(renderScale), std::forward<decltype(frameRate)>(frameRate), reason);
+    };
+  }
+  
   // pragma MARK: std::shared_ptr<HybridNitroVtoViewSpec>
   std::shared_ptr<HybridNitroVtoViewSpec> create_std__shared_ptr_HybridNitroVtoViewSpec_(void* NON_NULL swiftUnsafePointer) noexcept {
     NitroVto::HybridNitroVtoViewSpec_cxx swiftPart = NitroVto::HybridNitroVtoViewSpec_cxx::fromUnsafe(swiftUnsafePointer);
@@ -10,6 +10,14 @@
 // Forward declarations of C++ defined types
 // Forward declaration of `HybridNitroVtoViewSpec` to properly resolve imports.
 namespace margelo::nitro::nitrovto { class HybridNitroVtoViewSpec; }
+// Forward declaration of `ModelCacheStats` to properly resolve imports.
+namespace margelo::nitro::nitrovto { struct ModelCacheStats; }
+// Forward declaration of `ModelMemoryStats` to properly resolve imports.
+namespace margelo::nitro::nitrovto { struct ModelMemoryStats; }
+// Forward declaration of `PerformanceStats` to properly resolve imports.
+namespace margelo::nitro::nitrovto { struct PerformanceStats; }
+// Forward declaration of `StageTiming` to properly resolve imports.
+namespace margelo::nitro::nitrovto { struct StageTiming; }
 
 // Forward declarations of Swift defined types
 // Forward declaration of `HybridNitroVtoViewSpec_cxx` to properly resolve imports.
@@ -17,12 +25,19 @@ namespace NitroVto { class HybridNitroVtoViewSpec_cxx; }
 
 // Include C++ defined types
 #include "HybridNitroVtoViewSpec.hpp"
+#include "ModelCacheStats.hpp"
+#include "ModelMemoryStats.hpp"
+#include "PerformanceStats.hpp"
+#include "StageTiming.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/ArrayBufferHolder.hpp>
 #include <NitroModules/Result.hpp>
 #include <exception>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 /**
  * Contains specialized versions of C++ templated types so they can be accessed from Swift,
@@ -67,6 +82,95 @@ namespace margelo::nitro::nitrovto::bridge::swift {
     return *optional;
   }
   
+  // pragma MARK: std::function<void(const std::string& /* modelUrl */, double /* progress */)>
+  /**
+   * Specialized version of `std::function<void(const std::string&, double)>`.
+   */
+  using Func_void_std__string_double = std::function<void(const std::string& /* modelUrl */, double /* progress */)>;
+  /**
+   * Wrapper class for a `std::function<void(const std::string& / * modelUrl * /, double / * progress * /)>`, this can be used from Swift.
+   */
+  class Func_void_std__string_double_Wrapper final {
+  public:
+    explicit Func_void_std__string_double_Wrapper(std::function<void(const std::string& /* modelUrl */, double /* progress */)>&& func): _function(std::make_unique<std::function<void(const std::string& /* modelUrl */, double /* progress */)>>(std::move(func))) {}
+    inline void call(std::string modelUrl, double progress) const noexcept {
+      _function->operator()(modelUrl, std::forward<decltype(progress)>(progress));
+    }
+  private:
+    std::unique_ptr<std::function<void(const std::string& /* modelUrl */, double /* progress */)>> _function;
+  } SWIFT_NONCOPYABLE;
+  Func_void_std__string_double create_Func_void_std__string_double(void* NON_NULL swiftClosureWrapper) noexcept;
+  inline Func_void_std__string_double_Wrapper wrap_Func_void_std__string_double(Func_void_std__string_double value) noexcept {
+    return Func_void_std__string_double_Wrapper(std::move(value));
+  }
+  
+  // pragma MARK: std::optional<std::function<void(const std::string& /* modelUrl */, double /* progress */)>>
+  /**
+   * Specialized version of `std::optional<std::function<void(const std::string& / * modelUrl * /, double / * progress * /)>>`.
+   */
+  using std__optional_std__function_void_const_std__string_____modelUrl_____double____progress______ = std::optional<std::function<void(const std::string& /* modelUrl */, double /* progress */)>>;
+  inline std::optional<std::function<void(const std::string& /* modelUrl */, double /* progress */)>> create_std__optional_std__function_void_const_std__string_____modelUrl_____double____progress______(const std::function<void(const std::string& /* modelUrl */, double /* progress */)>& value) noexcept {
+    return std::optional<std::function<void(const std::string& /* modelUrl */, double /* progress */)>>(value);
+  }
+  inline bool has_value_std__optional_std__function_void_const_std__string_____modelUrl_____double____progress______(const std::optional<std::function<void(const std::string& /* modelUrl */, double /* progress */)>>& optional) noexcept {
+    return optional.has_value();
+  }
+  inline std::function<void(const std::string& /* modelUrl */, double /* progress */)> get_std__optional_std__function_void_const_std__string_____modelUrl_____double____progress______(const std::optional<std::function<void(const std::string& /* modelUrl */, double /* progress */)>>& optional) noexcept {
+    return *optional;
+  }
+  
+  // pragma MARK: std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>
+  /**
+   * Specialized version of `std::function<void(double, double, const std::string&)>`.
+   */
+  using Func_void_double_double_std__string = std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>;
+  /**
+   * Wrapper class for a `std::function<void(double / * renderScale * /, double / * frameRate * /, const std::string& / * reason * /)>`, this can be used from Swift.
+   */
+  class Func_void_double_double_std__string_Wrapper final {
+  public:
+    explicit Func_void_double_double_std__string_Wrapper(std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>&& func): _function(std::make_unique<std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>>(std::move(func))) {}
+    inline void call(double renderScale, double frameRate, std::string reason) const noexcept {
+      _function->operator()(std::forward<decltype(renderScale)>(renderScale), std::forward<decltype(frameRate)>(frameRate), reason);
+    }
+  private:
+    std::unique_ptr<std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>> _function;
+  } SWIFT_NONCOPYABLE;
+  Func_void_double_double_std__string create_Func_void_double_double_std__string(void* NON_NULL swiftClosureWrapper) noexcept;
+  inline Func_void_double_double_std__string_Wrapper wrap_Func_void_double_double_std__string(Func_void_double_double_std__string value) noexcept {
+    return Func_void_double_double_std__string_Wrapper(std::move(value));
+  }
+  
+  // pragma MARK: std::optional<std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>>
+  /**
+   * Specialized version of `std::optional<std::function<void(double / * renderScale * /, double / * frameRate * /, const std::string& / * reason * /)>>`.
+   */
+  using std__optional_std__function_void_double____renderScale_____double____frameRate_____const_std__string_____reason______ = std::optional<std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>>;
+  inline std::optional<std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>> create_std__optional_std__function_void_double____renderScale_____double____frameRate_____const_std__string_____reason______(const std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>& value) noexcept {
+    return std::optional<std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>>(value);
+  }
+  inline bool has_value_std__optional_std__function_void_double____renderScale_____double____frameRate_____const_std__string_____reason______(const std::optional<std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>>& optional) noexcept {
+    return optional.has_value();
+  }
+  inline std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)> get_std__optional_std__function_void_double____renderScale_____double____frameRate_____const_std__string_____reason______(const std::optional<std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>>& optional) noexcept {
+    return *optional;
+  }
+  
+  // pragma MARK: std::optional<std::function<void(const std::string& /* filePath */, double /* durationSeconds */)>>
+  /**
+   * Specialized version of `std::optional<std::function<void(const std::string& / * filePath * /, double / * durationSeconds * /)>>`.
+   */
+  using std__optional_std__function_void_const_std__string_____filePath_____double____durationSeconds______ = std::optional<std::function<void(const std::string& /* filePath */, double /* durationSeconds */)>>;
+  inline std::optional<std::function<void(const std::string& /* filePath */, double /* durationSeconds */)>> create_std__optional_std__function_void_const_std__string_____filePath_____double____durationSeconds______(const std::function<void(const std::string& /* filePath */, double /* durationSeconds */)>& value) noexcept {
+    return std::optional<std::function<void(const std::string& /* filePath */, double /* durationSeconds */)>>(value);
+  }
+  inline bool has_value_std__optional_std__function_void_const_std__string_____filePath_____double____durationSeconds______(const std::optional<std::function<void(const std::string& /* filePath */, double /* durationSeconds */)>>& optional) noexcept {
+    return optional.has_value();
+  }
+  inline std::function<void(const std::string& /* filePath */, double /* durationSeconds */)> get_std__optional_std__function_void_const_std__string_____filePath_____double____durationSeconds______(const std::optional<std::function<void(const std::string& /* filePath */, double /* durationSeconds */)>>& optional) noexcept {
+    return *optional;
+  }
+  
   // pragma MARK: std::optional<bool>
   /**
    * Specialized version of `std::optional<bool>`.
@@ -97,6 +201,17 @@ namespace margelo::nitro::nitrovto::bridge::swift {
     return *optional;
   }
   
+  // pragma MARK: std::vector<std::string>
+  /**
+   * Specialized version of `std::vector<std::string>`.
+   */
+  using std__vector_std__string_ = std::vector<std::string>;
+  inline std::vector<std::string> create_std__vector_std__string_(size_t size) noexcept {
+    std::vector<std::string> vector;
+    vector.reserve(size);
+    return vector;
+  }
+  
   // pragma MARK: std::shared_ptr<HybridNitroVtoViewSpec>
   /**
    * Specialized version of `std::shared_ptr<HybridNitroVtoViewSpec>`.
@@ -109,6 +224,42 @@ namespace margelo::nitro::nitrovto::bridge::swift {
   using std__weak_ptr_HybridNitroVtoViewSpec_ = std::weak_ptr<HybridNitroVtoViewSpec>;
   inline std__weak_ptr_HybridNitroVtoViewSpec_ weakify_std__shared_ptr_HybridNitroVtoViewSpec_(const std::shared_ptr<HybridNitroVtoViewSpec>& strong) noexcept { return strong; }
   
+  // pragma MARK: Result<ModelCacheStats>
+  using Result_ModelCacheStats_ = Result<ModelCacheStats>;
+  inline Result_ModelCacheStats_ create_Result_ModelCacheStats_(const ModelCacheStats& value) noexcept {
+    return Result<ModelCacheStats>::withValue(value);
+  }
+  inline Result_ModelCacheStats_ create_Result_ModelCacheStats_(const std::exception_ptr& error) noexcept {
+    return Result<ModelCacheStats>::withError(error);
+  }
+  
+  // pragma MARK: Result<ModelMemoryStats>
+  using Result_ModelMemoryStats_ = Result<ModelMemoryStats>;
+  inline Result_ModelMemoryStats_ create_Result_ModelMemoryStats_(const ModelMemoryStats& value) noexcept {
+    return Result<ModelMemoryStats>::withValue(value);
+  }
+  inline Result_ModelMemoryStats_ create_Result_ModelMemoryStats_(const std::exception_ptr& error) noexcept {
+    return Result<ModelMemoryStats>::withError(error);
+  }
+  
+  // pragma MARK: Result<PerformanceStats>
+  using Result_PerformanceStats_ = Result<PerformanceStats>;
+  inline Result_PerformanceStats_ create_Result_PerformanceStats_(const PerformanceStats& value) noexcept {
+    return Result<PerformanceStats>::withValue(value);
+  }
+  inline Result_PerformanceStats_ create_Result_PerformanceStats_(const std::exception_ptr& error) noexcept {
+    return Result<PerformanceStats>::withError(error);
+  }
+  
+  // pragma MARK: Result<std::shared_ptr<ArrayBuffer>>
+  using Result_std__shared_ptr_ArrayBuffer__ = Result<std::shared_ptr<ArrayBuffer>>;
+  inline Result_std__shared_ptr_ArrayBuffer__ create_Result_std__shared_ptr_ArrayBuffer__(const std::shared_ptr<ArrayBuffer>& value) noexcept {
+    return Result<std::shared_ptr<ArrayBuffer>>::withValue(value);
+  }
+  inline Result_std__shared_ptr_ArrayBuffer__ create_Result_std__shared_ptr_ArrayBuffer__(const std::exception_ptr& error) noexcept {
+    return Result<std::shared_ptr<ArrayBuffer>>::withError(error);
+  }
+  
   // pragma MARK: Result<void>
   using Result_void_ = Result<void>;
   inline Result_void_ create_Result_void_() noexcept {
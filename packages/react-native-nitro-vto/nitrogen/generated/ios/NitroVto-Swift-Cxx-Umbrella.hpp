@@ -10,15 +10,28 @@
 // Forward declarations of C++ defined types
 // Forward declaration of `HybridNitroVtoViewSpec` to properly resolve imports.
 namespace margelo::nitro::nitrovto { class HybridNitroVtoViewSpec; }
+// Forward declaration of `ModelCacheStats` to properly resolve imports.
+namespace margelo::nitro::nitrovto { struct ModelCacheStats; }
+// Forward declaration of `ModelMemoryStats` to properly resolve imports.
+namespace margelo::nitro::nitrovto { struct ModelMemoryStats; }
+// Forward declaration of `PerformanceStats` to properly resolve imports.
+namespace margelo::nitro::nitrovto { struct PerformanceStats; }
+// Forward declaration of `StageTiming` to properly resolve imports.
+namespace margelo::nitro::nitrovto { struct StageTiming; }
 
 // Include C++ defined types
 #include "HybridNitroVtoViewSpec.hpp"
+#include "ModelCacheStats.hpp"
+#include "ModelMemoryStats.hpp"
+#include "PerformanceStats.hpp"
+#include "StageTiming.hpp"
 #include <NitroModules/Result.hpp>
 #include <exception>
 #include <functional>
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 // C++ helpers for Swift
 #include "NitroVto-Swift-Cxx-Bridge.hpp"
@@ -12,11 +12,25 @@
 // Forward declaration of `HybridNitroVtoViewSpec_cxx` to properly resolve imports.
 namespace NitroVto { class HybridNitroVtoViewSpec_cxx; }
 
+// Forward declaration of `ModelCacheStats` to properly resolve imports.
+namespace margelo::nitro::nitrovto { struct ModelCacheStats; }
+// Forward declaration of `ModelMemoryStats` to properly resolve imports.
+namespace margelo::nitro::nitrovto { struct ModelMemoryStats; }
+// Forward declaration of `PerformanceStats` to properly resolve imports.
+namespace margelo::nitro::nitrovto { struct PerformanceStats; }
+// Forward declaration of `StageTiming` to properly resolve imports.
+namespace margelo::nitro::nitrovto { struct StageTiming; }
 
-
+#include "ModelCacheStats.hpp"
+#include "ModelMemoryStats.hpp"
+#include "PerformanceStats.hpp"
+#include "StageTiming.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/ArrayBufferHolder.hpp>
 #include <string>
 #include <functional>
 #include <optional>
+#include <vector>
 
 #include "NitroVto-Swift-Cxx-Umbrella.hpp"
 
@@ -78,6 +92,13 @@ namespace margelo::nitro::nitrovto {
     inline void setOnModelLoaded(const std::optional<std::function<void(const std::string& /* modelUrl */)>>& onModelLoaded) noexcept override {
       _swiftPart.setOnModelLoaded(onModelLoaded);
     }
+    inline std::optional<std::function<void(const std::string& /* modelUrl */, double /* progress */)>> getOnModelLoadProgress() noexcept override {
+      auto __result = _swiftPart.getOnModelLoadProgress();
+      return __result;
+    }
+    inline void setOnModelLoadProgress(const std::optional<std::function<void(const std::string& /* modelUrl */, double /* progress */)>>& onModelLoadProgress) noexcept override {
+      _swiftPart.setOnModelLoadProgress(onModelLoadProgress);
+    }
     inline std::optional<bool> getFaceMeshOcclusion() noexcept override {
       auto __result = _swiftPart.getFaceMeshOcclusion();
       return __result;
@@ -99,6 +120,13 @@ namespace margelo::nitro::nitrovto {
     inline void setForwardOffset(std::optional<double> forwardOffset) noexcept override {
       _swiftPart.setForwardOffset(forwardOffset);
     }
+    inline std::optional<double> getMaxFaces() noexcept override {
+      auto __result = _swiftPart.getMaxFaces();
+      return __result;
+    }
+    inline void setMaxFaces(std::optional<double> maxFaces) noexcept override {
+      _swiftPart.setMaxFaces(maxFaces);
+    }
     inline std::optional<bool> getDebug() noexcept override {
       auto __result = _swiftPart.getDebug();
       return __result;
@@ -106,6 +134,27 @@ namespace margelo::nitro::nitrovto {
     inline void setDebug(std::optional<bool> debug) noexcept override {
       _swiftPart.setDebug(debug);
     }
+    inline std::optional<bool> getAdaptivePerformance() noexcept override {
+      auto __result = _swiftPart.getAdaptivePerformance();
+      return __result;
+    }
+    inline void setAdaptivePerformance(std::optional<bool> adaptivePerformance) noexcept override {
+      _swiftPart.setAdaptivePerformance(adaptivePerformance);
+    }
+    inline std::optional<std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>> getOnPerformanceChange() noexcept override {
+      auto __result = _swiftPart.getOnPerformanceChange();
+      return __result;
+    }
+    inline void setOnPerformanceChange(const std::optional<std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>>& onPerformanceChange) noexcept override {
+      _swiftPart.setOnPerformanceChange(onPerformanceChange);
+    }
+    inline std::optional<std::function<void(const std::string& /* filePath */, double /* durationSeconds */)>> getOnCaptureComplete() noexcept override {
+      auto __result = _swiftPart.getOnCaptureComplete();
+      return __result;
+    }
+    inline void setOnCaptureComplete(const std::optional<std::function<void(const std::string& /* filePath */, double /* durationSeconds */)>>& onCaptureComplete) noexcept override {
+      _swiftPart.setOnCaptureComplete(onCaptureComplete);
+    }
 
   public:
     // Methods
@@ -121,6 +170,110 @@ namespace margelo::nitro::nitrovto {
         std::rethrow_exception(__result.error());
       }
     }
+    inline void prefetchModels(const std::vector<std::string>& modelUrls) override {
+      auto __result = _swiftPart.prefetchModels(modelUrls);
+      if (__result.hasError()) [[unlikely]] {
+        std::rethrow_exception(__result.error());
+      }
+    }
+    inline void setCompareModels(const std::vector<std::string>& modelUrls) override {
+      auto __result = _swiftPart.setCompareModels(modelUrls);
+      if (__result.hasError()) [[unlikely]] {
+        std::rethrow_exception(__result.error());
+      }
+    }
+    inline void setActiveModel(double index) override {
+      auto __result = _swiftPart.setActiveModel(std::forward<decltype(index)>(index));
+      if (__result.hasError()) [[unlikely]] {
+        std::rethrow_exception(__result.error());
+      }
+    }
+    inline void setEnvironment(const std::string& name) override {
+      auto __result = _swiftPart.setEnvironment(name);
+      if (__result.hasError()) [[unlikely]] {
+        std::rethrow_exception(__result.error());
+      }
+    }
+    inline void warmUp() override {
+      auto __result = _swiftPart.warmUp();
+      if (__result.hasError()) [[unlikely]] {
+        std::rethrow_exception(__result.error());
+      }
+    }
+    inline ModelCacheStats getModelCacheStats() override {
+      auto __result = _swiftPart.getModelCacheStats();
+      if (__result.hasError()) [[unlikely]] {
+        std::rethrow_exception(__result.error());
+      }
+      auto __value = std::move(__result.value());
+      return __value;
+    }
+    inline ModelMemoryStats getModelMemoryStats() override {
+      auto __result = _swiftPart.getModelMemoryStats();
+      if (__result.hasError()) [[unlikely]] {
+        std::rethrow_exception(__result.error());
+      }
+      auto __value = std::move(__result.value());
+      return __value;
+    }
+    inline PerformanceStats getPerformanceStats() override {
+      auto __result = _swiftPart.getPerformanceStats();
+      if (__result.hasError()) [[unlikely]] {
+        std::rethrow_exception(__result.error());
+      }
+      auto __value = std::move(__result.value());
+      return __value;
+    }
+    inline std::shared_ptr<ArrayBuffer> getFacePoseBuffer() override {
+      auto __result = _swiftPart.getFacePoseBuffer();
+      if (__result.hasError()) [[unlikely]] {
+        std::rethrow_exception(__result.error());
+      }
+      auto __value = std::move(__result.value());
+      return __value;
+    }
+    inline void startFaceRecording(const std::string& filePath) override {
+      auto __result = _swiftPart.startFaceRecording(filePath);
+      if (__result.hasError()) [[unlikely]] {
+        std::rethrow_exception(__result.error());
+      }
+    }
+    inline void stopFaceRecording() override {
+      auto __result = _swiftPart.stopFaceRecording();
+      if (__result.hasError()) [[unlikely]] {
+        std::rethrow_exception(__result.error());
+      }
+    }
+    inline void capture(const std::string& filePath) override {
+      auto __result = _swiftPart.capture(filePath);
+      if (__result.hasError()) [[unlikely]] {
+        std::rethrow_exception(__result.error());
+      }
+    }
+    inline void startRecording(const std::string& filePath) override {
+      auto __result = _swiftPart.startRecording(filePath);
+      if (__result.hasError()) [[unlikely]] {
+        std::rethrow_exception(__result.error());
+      }
+    }
+    inline void stopRecording() override {
+      auto __result = _swiftPart.stopRecording();
+      if (__result.hasError()) [[unlikely]] {
+        std::rethrow_exception(__result.error());
+      }
+    }
+    inline void clearModelCache() override {
+      auto __result = _swiftPart.clearModelCache();
+      if (__result.hasError()) [[unlikely]] {
+        std::rethrow_exception(__result.error());
+      }
+    }
+    inline void setModelCacheLimit(double maxBytes) override {
+      auto __result = _swiftPart.setModelCacheLimit(std::forward<decltype(maxBytes)>(maxBytes));
+      if (__result.hasError()) [[unlikely]] {
+        std::rethrow_exception(__result.error());
+      }
+    }
 
   private:
     NitroVto::HybridNitroVtoViewSpec_cxx _swiftPart;
@@ -86,6 +86,11 @@ using namespace margelo::nitro::nitrovto::views;
     swiftPart.setOnModelLoaded(newViewProps.onModelLoaded.value);
     newViewProps.onModelLoaded.isDirty = false;
   }
+  // onModelLoadProgress: optional
+  if (newViewProps.onModelLoadProgress.isDirty) {
+    swiftPart.setOnModelLoadProgress(newViewProps.onModelLoadProgress.value);
+    newViewProps.onModelLoadProgress.isDirty = false;
+  }
   // faceMeshOcclusion: optional
   if (newViewProps.faceMeshOcclusion.isDirty) {
     swiftPart.setFaceMeshOcclusion(newViewProps.faceMeshOcclusion.value);
@@ -101,11 +106,31 @@ using namespace margelo::nitro::nitrovto::views;
     swiftPart.setForwardOffset(newViewProps.forwardOffset.value);
     newViewProps.forwardOffset.isDirty = false;
   }
+  // maxFaces: optional
+  if (newViewProps.maxFaces.isDirty) {
+    swiftPart.setMaxFaces(newViewProps.maxFaces.value);
+    newViewProps.maxFaces.isDirty = false;
+  }
   // debug: optional
   if (newViewProps.debug.isDirty) {
     swiftPart.setDebug(newViewProps.debug.value);
     newViewProps.debug.isDirty = false;
   }
+  // adaptivePerformance: optional
+  if (newViewProps.adaptivePerformance.isDirty) {
+    swiftPart.setAdaptivePerformance(newViewProps.adaptivePerformance.value);
+    newViewProps.adaptivePerformance.isDirty = false;
+  }
+  // onPerformanceChange: optional
+  if (newViewProps.onPerformanceChange.isDirty) {
+    swiftPart.setOnPerformanceChange(newViewProps.onPerformanceChange.value);
+    newViewProps.onPerformanceChange.isDirty = false;
+  }
+  // onCaptureComplete: optional
+  if (newViewProps.onCaptureComplete.isDirty) {
+    swiftPart.setOnCaptureComplete(newViewProps.onCaptureComplete.value);
+    newViewProps.onCaptureComplete.isDirty = false;
+  }
 
   swiftPart.afterUpdate();
 
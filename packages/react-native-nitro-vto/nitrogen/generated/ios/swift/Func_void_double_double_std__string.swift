@@ -0,0 +1,47 @@
+///
+/// Func_void_double_double_std__string.swift
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2026 Marc Rousavy @ Margelo
+///
+
+import Foundation
+import NitroModules
+
+/**
+ * Wraps a Swift `(_ renderScale: Double, _ frameRate: Double, _ reason: String) -> Void` as a class.
+ * This class can be used from C++, e.g. to wrap the Swift closure as a `std::function`.
+ */
+public final class Func_void_double_double_std__string {
+  public typealias bridge = margelo.nitro.nitrovto.bridge.swift
+
+  private let closure: (_ renderScale: Double, _ frameRate: Double, _ reason: String) -> Void
+
+  public init(_ closure: @escaping (_ renderScale: Double, _ frameRate: Double, _ reason: String) -> Void) {
+    self.closure = closure
+  }
+
+  @inline(__always)
+  public func call(renderScale: Double, frameRate: Double, reason: std.string) -> Void {
+    self.closure(renderScale, frameRate, String(reason))
+  }
+
+  /**
+   * Casts this instance to a retained unsafe raw pointer.
+   * This acquires one additional strong reference on the object!
+   */
+  @inline(__always)
+  public func toUnsafe() -> UnsafeMutableRawPointer {
+    return Unmanaged.passRetained(self).toOpaque()
+  }
+
+  /**
+   * Casts an unsafe pointer to a `Func_void_double_double_std__string`.
+   * The pointer has to be a retained opaque `Unmanaged<Func_void_double_double_std__string>`.
+   * This removes one strong reference from the object!
+   */
+  @inline(__always)
+  public static func fromUnsafe(_ pointer: UnsafeMutableRawPointer) -> Func_void_double_double_std__string {
+    return Unmanaged<Func_void_double_double_std__string>.fromOpaque(pointer).takeRetainedValue()
+  }
+}
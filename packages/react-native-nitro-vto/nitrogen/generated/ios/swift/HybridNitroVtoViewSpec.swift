@@ -14,14 +14,35 @@ public protocol HybridNitroVtoViewSpec_protocol: HybridObject, HybridView {
   var modelUrl: String { get set }
   var isActive: Bool { get set }
   var onModelLoaded: ((_ modelUrl: String) -> Void)? { get set }
+  var onModelLoadProgress: ((_ modelUrl: String, _ progress: Double) -> Void)? { get set }
   var faceMeshOcclusion: Bool? { get set }
   var backPlaneOcclusion: Bool? { get set }
   var forwardOffset: Double? { get set }
+  var maxFaces: Double? { get set }
   var debug: Bool? { get set }
+  var adaptivePerformance: Bool? { get set }
+  var onPerformanceChange: ((_ renderScale: Double, _ frameRate: Double, _ reason: String) -> Void)? { get set }
+  var onCaptureComplete: ((_ filePath: String, _ durationSeconds: Double) -> Void)? { get set }
 
   // Methods
   func switchModel(modelUrl: String) throws -> Void
   func resetSession() throws -> Void
+  func prefetchModels(modelUrls: [String]) throws -> Void
+  func setCompareModels(modelUrls: [String]) throws -> Void
+  func setActiveModel(index: Double) throws -> Void
+  func setEnvironment(name: String) throws -> Void
+  func warmUp() throws -> Void
+  func getModelCacheStats() throws -> ModelCacheStats
+  func getModelMemoryStats() throws -> ModelMemoryStats
+  func getPerformanceStats() throws -> PerformanceStats
+  func getFacePoseBuffer() throws -> ArrayBuffer
+  func startFaceRecording(filePath: String) throws -> Void
+  func stopFaceRecording() throws -> Void
+  func capture(filePath: String) throws -> Void
+  func startRecording(filePath: String) throws -> Void
+  func stopRecording() throws -> Void
+  func clearModelCache() throws -> Void
+  func setModelCacheLimit(maxBytes: Double) throws -> Void
 }
 
 public extension HybridNitroVtoViewSpec_protocol {
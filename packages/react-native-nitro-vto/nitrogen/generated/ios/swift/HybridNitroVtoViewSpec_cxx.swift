@@ -168,6 +168,38 @@ open class HybridNitroVtoViewSpec_cxx {
     }
   }
   
+  public final var onModelLoadProgress: bridge.std__optional_std__function_void_const_std__string_____modelUrl_____double____progress______ {
+    @inline(__always)
+    get {
+      return { () -> bridge.std__optional_std__function_void_const_std__string_____modelUrl_____double____progress______ in
+        if let __unwrappedValue = self.__implementation.onModelLoadProgress {
+          return bridge.create_std__optional_std__function_void_const_std__string_____modelUrl_____double____progress______({ () -> bridge.Func_void_std__string_double in
+            let __closureWrapper = Func_void_std__string_double(__unwrappedValue)
+            return bridge.create_Func_void_std__string_double(__closureWrapper.toUnsafe())
+          }())
+        } else {
+          return .init()
+        }
+      }()
+    }
+    @inline(__always)
+    set {
+      self.__implementation.onModelLoadProgress = { () -> ((_ modelUrl: String, _ progress: Double) -> Void)? in
+        if bridge.has_value_std__optional_std__function_void_const_std__string_____modelUrl_____double____progress______(newValue) {
+          let __unwrapped = bridge.get_std__optional_std__function_void_const_std__string_____modelUrl_____double____progress______(newValue)
+          return { () -> (String, Double) -> Void in
+            let __wrappedFunction = bridge.wrap_Func_void_std__string_double(__unwrapped)
+            return { (__modelUrl: String, __progress: Double) -> Void in
+              __wrappedFunction.call(std.string(__modelUrl), __progress)
+            }
+          }()
+        } else {
+          return nil
+        }
+      }()
+    }
+  }
+  
   public final var faceMeshOcclusion: bridge.std__optional_bool_ {
     @inline(__always)
     get {
@@ -233,6 +265,23 @@ open class HybridNitroVtoViewSpec_cxx {
     }
   }
   
+  public final var maxFaces: bridge.std__optional_double_ {
+    @inline(__always)
+    get {
+      return { () -> bridge.std__optional_double_ in
+        if let __unwrappedValue = self.__implementation.maxFaces {
+          return bridge.create_std__optional_double_(__unwrappedValue)
+        } else {
+          return .init()
+        }
+      }()
+    }
+    @inline(__always)
+    set {
+      self.__implementation.maxFaces = newValue.value
+    }
+  }
+  
   public final var debug: bridge.std__optional_bool_ {
     @inline(__always)
     get {
@@ -256,6 +305,94 @@ open class HybridNitroVtoViewSpec_cxx {
       }()
     }
   }
+  
+  public final var adaptivePerformance: bridge.std__optional_bool_ {
+    @inline(__always)
+    get {
+      return { () -> bridge.std__optional_bool_ in
+        if let __unwrappedValue = self.__implementation.adaptivePerformance {
+          return bridge.create_std__optional_bool_(__unwrappedValue)
+        } else {
+          return .init()
+        }
+      }()
+    }
+    @inline(__always)
+    set {
+      self.__implementation.adaptivePerformance = { () -> Bool? in
+        if bridge.has_value_std__optional_bool_(newValue) {
+          let __unwrapped = bridge.get_std__optional_bool_(newValue)
+          return __unwrapped
+        } else {
+          return nil
+        }
+      }()
+    }
+  }
+  
+  public final var onPerformanceChange: bridge.std__optional_std__function_void_double____renderScale_____double____frameRate_____const_std__string_____reason______ {
+    @inline(__always)
+    get {
+      return { () -> bridge.std__optional_std__function_void_double____renderScale_____double____frameRate_____const_std__string_____reason______ in
+        if let __unwrappedValue = self.__implementation.onPerformanceChange {
+          return bridge.create_std__optional_std__function_void_double____renderScale_____double____frameRate_____const_std__string_____reason______({ () -> bridge.Func_void_double_double_std__string in
+            let __closureWrapper = Func_void_double_double_std__string(__unwrappedValue)
+            return bridge.create_Func_void_double_double_std__string(__closureWrapper.toUnsafe())
+          }())
+        } else {
+          return .init()
+        }
+      }()
+    }
+    @inline(__always)
+    set {
+      self.__implementation.onPerformanceChange = { () -> ((_ renderScale: Double, _ frameRate: Double, _ reason: String) -> Void)? in
+        if bridge.has_value_std__optional_std__function_void_double____renderScale_____double____frameRate_____const_std__string_____reason______(newValue) {
+          let __unwrapped = bridge.get_std__optional_std__function_void_double____renderScale_____double____frameRate_____const_std__string_____reason______(newValue)
+          return { () -> (Double, Double, String) -> Void in
+            let __wrappedFunction = bridge.wrap_Func_void_double_double_std__string(__unwrapped)
+            return { (__renderScale: Double, __frameRate: Double, __reason: String) -> Void in
+              __wrappedFunction.call(__renderScale, __frameRate, std.string(__reason))
+            }
+          }()
+        } else {
+          return nil
+        }
+      }()
+    }
+  }
+  
+  public final var onCaptureComplete: bridge.std__optional_std__function_void_const_std__string_____filePath_____double____durationSeconds______ {
+    @inline(__always)
+    get {
+      return { () -> bridge.std__optional_std__function_void_const_std__string_____filePath_____double____durationSeconds______ in
+        if let __unwrappedValue = self.__implementation.onCaptureComplete {
+          return bridge.create_std__optional_std__function_void_const_std__string_____filePath_____double____durationSeconds______({ () -> bridge.Func_void_std__string_double in
+            let __closureWrapper = Func_void_std__string_double(__unwrappedValue)
+            return bridge.create_Func_void_std__string_double(__closureWrapper.toUnsafe())
+          }())
+        } else {
+          return .init()
+        }
+      }()
+    }
+    @inline(__always)
+    set {
+      self.__implementation.onCaptureComplete = { () -> ((_ filePath: String, _ durationSeconds: Double) -> Void)? in
+        if bridge.has_value_std__optional_std__function_void_const_std__string_____filePath_____double____durationSeconds______(newValue) {
+          let __unwrapped = bridge.get_std__optional_std__function_void_const_std__string_____filePath_____double____durationSeconds______(newValue)
+          return { () -> (String, Double) -> Void in
+            let __wrappedFunction = bridge.wrap_Func_void_std__string_double(__unwrapped)
+            return { (__filePath: String, __durationSeconds: Double) -> Void in
+              __wrappedFunction.call(std.string(__filePath), __durationSeconds)
+            }
+          }()
+        } else {
+          return nil
+        }
+      }()
+    }
+  }
 
   // Methods
   @inline(__always)
@@ -280,6 +417,186 @@ open class HybridNitroVtoViewSpec_cxx {
     }
   }
   
+  @inline(__always)
+  public final func prefetchModels(modelUrls: bridge.std__vector_std__string_) -> bridge.Result_void_ {
+    do {
+      try self.__implementation.prefetchModels(modelUrls: modelUrls.map({ __item in String(__item) }))
+      return bridge.create_Result_void_()
+    } catch (let __error) {
+      let __exceptionPtr = __error.toCpp()
+      return bridge.create_Result_void_(__exceptionPtr)
+    }
+  }
+  
+  @inline(__always)
+  public final func setCompareModels(modelUrls: bridge.std__vector_std__string_) -> bridge.Result_void_ {
+    do {
+      try self.__implementation.setCompareModels(modelUrls: modelUrls.map({ __item in String(__item) }))
+      return bridge.create_Result_void_()
+    } catch (let __error) {
+      let __exceptionPtr = __error.toCpp()
+      return bridge.create_Result_void_(__exceptionPtr)
+    }
+  }
+  
+  @inline(__always)
+  public final func setActiveModel(index: Double) -> bridge.Result_void_ {
+    do {
+      try self.__implementation.setActiveModel(index: index)
+      return bridge.create_Result_void_()
+    } catch (let __error) {
+      let __exceptionPtr = __error.toCpp()
+      return bridge.create_Result_void_(__exceptionPtr)
+    }
+  }
+  
+  @inline(__always)
+  public final func setEnvironment(name: std.string) -> bridge.Result_void_ {
+    do {
+      try self.__implementation.setEnvironment(name: String(name))
+      return bridge.create_Result_void_()
+    } catch (let __error) {
+      let __exceptionPtr = __error.toCpp()
+      return bridge.create_Result_void_(__exceptionPtr)
+    }
+  }
+  
+  @inline(__always)
+  public final func warmUp() -> bridge.Result_void_ {
+    do {
+      try self.__implementation.warmUp()
+      return bridge.create_Result_void_()
+    } catch (let __error) {
+      let __exceptionPtr = __error.toCpp()
+      return bridge.create_Result_void_(__exceptionPtr)
+    }
+  }
+  
+  @inline(__always)
+  public final func getModelCacheStats() -> bridge.Result_ModelCacheStats_ {
+    do {
+      let __result = try self.__implementation.getModelCacheStats()
+      let __resultCpp = __result
+      return bridge.create_Result_ModelCacheStats_(__resultCpp)
+    } catch (let __error) {
+      let __exceptionPtr = __error.toCpp()
+      return bridge.create_Result_ModelCacheStats_(__exceptionPtr)
+    }
+  }
+  
+  @inline(__always)
+  public final func getModelMemoryStats() -> bridge.Result_ModelMemoryStats_ {
+    do {
+      let __result = try self.__implementation.getModelMemoryStats()
+      let __resultCpp = __result
+      return bridge.create_Result_ModelMemoryStats_(__resultCpp)
+    } catch (let __error) {
+      let __exceptionPtr = __error.toCpp()
+      return bridge.create_Result_ModelMemoryStats_(__exceptionPtr)
+    }
+  }
+  
+  @inline(__always)
+  public final func getPerformanceStats() -> bridge.Result_PerformanceStats_ {
+    do {
+      let __result = try self.__implementation.getPerformanceStats()
+      let __resultCpp = __result
+      return bridge.create_Result_PerformanceStats_(__resultCpp)
+    } catch (let __error) {
+      let __exceptionPtr = __error.toCpp()
+      return bridge.create_Result_PerformanceStats_(__exceptionPtr)
+    }
+  }
+  
+  @inline(__always)
+  public final func getFacePoseBuffer() -> bridge.Result_std__shared_ptr_ArrayBuffer__ {
+    do {
+      let __result = try self.__implementation.getFacePoseBuffer()
+      let __resultCpp = __result.getArrayBuffer()
+      return bridge.create_Result_std__shared_ptr_ArrayBuffer__(__resultCpp)
+    } catch (let __error) {
+      let __exceptionPtr = __error.toCpp()
+      return bridge.create_Result_std__shared_ptr_ArrayBuffer__(__exceptionPtr)
+    }
+  }
+  
+  @inline(__always)
+  public final func startFaceRecording(filePath: std.string) -> bridge.Result_void_ {
+    do {
+      try self.__implementation.startFaceRecording(filePath: String(filePath))
+      return bridge.create_Result_void_()
+    } catch (let __error) {
+      let __exceptionPtr = __error.toCpp()
+      return bridge.create_Result_void_(__exceptionPtr)
+    }
+  }
+  
+  @inline(__always)
+  public final func stopFaceRecording() -> bridge.Result_void_ {
+    do {
+      try self.__implementation.stopFaceRecording()
+      return bridge.create_Result_void_()
+    } catch (let __error) {
+      let __exceptionPtr = __error.toCpp()
+      return bridge.create_Result_void_(__exceptionPtr)
+    }
+  }
+  
+  @inline(__always)
+  public final func capture(filePath: std.string) -> bridge.Result_void_ {
+    do {
+      try self.__implementation.capture(filePath: String(filePath))
+      return bridge.create_Result_void_()
+    } catch (let __error) {
+      let __exceptionPtr = __error.toCpp()
+      return bridge.create_Result_void_(__exceptionPtr)
+    }
+  }
+  
+  @inline(__always)
+  public final func startRecording(filePath: std.string) -> bridge.Result_void_ {
+    do {
+      try self.__implementation.startRecording(filePath: String(filePath))
+      return bridge.create_Result_void_()
+    } catch (let __error) {
+      let __exceptionPtr = __error.toCpp()
+      return bridge.create_Result_void_(__exceptionPtr)
+    }
+  }
+  
+  @inline(__always)
+  public final func stopRecording() -> bridge.Result_void_ {
+    do {
+      try self.__implementation.stopRecording()
+      return bridge.create_Result_void_()
+    } catch (let __error) {
+      let __exceptionPtr = __error.toCpp()
+      return bridge.create_Result_void_(__exceptionPtr)
+    }
+  }
+  
+  @inline(__always)
+  public final func clearModelCache() -> bridge.Result_void_ {
+    do {
+      try self.__implementation.clearModelCache()
+      return bridge.create_Result_void_()
+    } catch (let __error) {
+      let __exceptionPtr = __error.toCpp()
+      return bridge.create_Result_void_(__exceptionPtr)
+    }
+  }
+  
+  @inline(__always)
+  public final func setModelCacheLimit(maxBytes: Double) -> bridge.Result_void_ {
+    do {
+      try self.__implementation.setModelCacheLimit(maxBytes: maxBytes)
+      return bridge.create_Result_void_()
+    } catch (let __error) {
+      let __exceptionPtr = __error.toCpp()
+      return bridge.create_Result_void_(__exceptionPtr)
+    }
+  }
+  
   public final func getView() -> UnsafeMutableRawPointer {
     return Unmanaged.passRetained(__implementation.view).toOpaque()
   }
@@ -0,0 +1,80 @@
+///
+/// ModelCacheStats.swift
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2026 Marc Rousavy @ Margelo
+///
+
+import Foundation
+import NitroModules
+
+/**
+ * Represents an instance of `ModelCacheStats`, backed by a C++ struct.
+ */
+public typealias ModelCacheStats = margelo.nitro.nitrovto.ModelCacheStats
+
+public extension ModelCacheStats {
+  private typealias bridge = margelo.nitro.nitrovto.bridge.swift
+
+  /**
+   * Create a new instance of `ModelCacheStats`.
+   */
+  init(fileCount: Double, totalBytes: Double, byteLimit: Double, hitCount: Double, missCount: Double) {
+    self.init(fileCount, totalBytes, byteLimit, hitCount, missCount)
+  }
+
+  var fileCount: Double {
+    @inline(__always)
+    get {
+      return self.__fileCount
+    }
+    @inline(__always)
+    set {
+      self.__fileCount = newValue
+    }
+  }
+
+  var totalBytes: Double {
+    @inline(__always)
+    get {
+      return self.__totalBytes
+    }
+    @inline(__always)
+    set {
+      self.__totalBytes = newValue
+    }
+  }
+
+  var byteLimit: Double {
+    @inline(__always)
+    get {
+      return self.__byteLimit
+    }
+    @inline(__always)
+    set {
+      self.__byteLimit = newValue
+    }
+  }
+
+  var hitCount: Double {
+    @inline(__always)
+    get {
+      return self.__hitCount
+    }
+    @inline(__always)
+    set {
+      self.__hitCount = newValue
+    }
+  }
+
+  var missCount: Double {
+    @inline(__always)
+    get {
+      return self.__missCount
+    }
+    @inline(__always)
+    set {
+      self.__missCount = newValue
+    }
+  }
+}
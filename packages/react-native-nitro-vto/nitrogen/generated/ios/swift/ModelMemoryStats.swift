@@ -0,0 +1,80 @@
+///
+/// ModelMemoryStats.swift
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2026 Marc Rousavy @ Margelo
+///
+
+import Foundation
+import NitroModules
+
+/**
+ * Represents an instance of `ModelMemoryStats`, backed by a C++ struct.
+ */
+public typealias ModelMemoryStats = margelo.nitro.nitrovto.ModelMemoryStats
+
+public extension ModelMemoryStats {
+  private typealias bridge = margelo.nitro.nitrovto.bridge.swift
+
+  /**
+   * Create a new instance of `ModelMemoryStats`.
+   */
+  init(modelCount: Double, compareModelCount: Double, gpuBytes: Double, cpuBytes: Double, deviceTier: Double) {
+    self.init(modelCount, compareModelCount, gpuBytes, cpuBytes, deviceTier)
+  }
+
+  var modelCount: Double {
+    @inline(__always)
+    get {
+      return self.__modelCount
+    }
+    @inline(__always)
+    set {
+      self.__modelCount = newValue
+    }
+  }
+
+  var compareModelCount: Double {
+    @inline(__always)
+    get {
+      return self.__compareModelCount
+    }
+    @inline(__always)
+    set {
+      self.__compareModelCount = newValue
+    }
+  }
+
+  var gpuBytes: Double {
+    @inline(__always)
+    get {
+      return self.__gpuBytes
+    }
+    @inline(__always)
+    set {
+      self.__gpuBytes = newValue
+    }
+  }
+
+  var cpuBytes: Double {
+    @inline(__always)
+    get {
+      return self.__cpuBytes
+    }
+    @inline(__always)
+    set {
+      self.__cpuBytes = newValue
+    }
+  }
+
+  var deviceTier: Double {
+    @inline(__always)
+    get {
+      return self.__deviceTier
+    }
+    @inline(__always)
+    set {
+      self.__deviceTier = newValue
+    }
+  }
+}
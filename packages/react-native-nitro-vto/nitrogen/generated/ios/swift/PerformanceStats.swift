@@ -0,0 +1,135 @@
+///
+/// PerformanceStats.swift
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2026 Marc Rousavy @ Margelo
+///
+
+import Foundation
+import NitroModules
+
+/**
+ * Represents an instance of `PerformanceStats`, backed by a C++ struct.
+ */
+public typealias PerformanceStats = margelo.nitro.nitrovto.PerformanceStats
+
+public extension PerformanceStats {
+  private typealias bridge = margelo.nitro.nitrovto.bridge.swift
+
+  /**
+   * Create a new instance of `PerformanceStats`.
+   */
+  init(frameCount: Double, droppedFrames: Double, session: StageTiming, camera: StageTiming, faceMesh: StageTiming, glassesPose: StageTiming, resources: StageTiming, render: StageTiming, frame: StageTiming, gpu: StageTiming) {
+    self.init(frameCount, droppedFrames, session, camera, faceMesh, glassesPose, resources, render, frame, gpu)
+  }
+
+  var frameCount: Double {
+    @inline(__always)
+    get {
+      return self.__frameCount
+    }
+    @inline(__always)
+    set {
+      self.__frameCount = newValue
+    }
+  }
+
+  var droppedFrames: Double {
+    @inline(__always)
+    get {
+      return self.__droppedFrames
+    }
+    @inline(__always)
+    set {
+      self.__droppedFrames = newValue
+    }
+  }
+
+  var session: StageTiming {
+    @inline(__always)
+    get {
+      return self.__session
+    }
+    @inline(__always)
+    set {
+      self.__session = newValue
+    }
+  }
+
+  var camera: StageTiming {
+    @inline(__always)
+    get {
+      return self.__camera
+    }
+    @inline(__always)
+    set {
+      self.__camera = newValue
+    }
+  }
+
+  var faceMesh: StageTiming {
+    @inline(__always)
+    get {
+      return self.__faceMesh
+    }
+    @inline(__always)
+    set {
+      self.__faceMesh = newValue
+    }
+  }
+
+  var glassesPose: StageTiming {
+    @inline(__always)
+    get {
+      return self.__glassesPose
+    }
+    @inline(__always)
+    set {
+      self.__glassesPose = newValue
+    }
+  }
+
+  var resources: StageTiming {
+    @inline(__always)
+    get {
+      return self.__resources
+    }
+    @inline(__always)
+    set {
+      self.__resources = newValue
+    }
+  }
+
+  var render: StageTiming {
+    @inline(__always)
+    get {
+      return self.__render
+    }
+    @inline(__always)
+    set {
+      self.__render = newValue
+    }
+  }
+
+  var frame: StageTiming {
+    @inline(__always)
+    get {
+      return self.__frame
+    }
+    @inline(__always)
+    set {
+      self.__frame = newValue
+    }
+  }
+
+  var gpu: StageTiming {
+    @inline(__always)
+    get {
+      return self.__gpu
+    }
+    @inline(__always)
+    set {
+      self.__gpu = newValue
+    }
+  }
+}
@@ -0,0 +1,80 @@
+///
+/// StageTiming.swift
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2026 Marc Rousavy @ Margelo
+///
+
+import Foundation
+import NitroModules
+
+/**
+ * Represents an instance of `StageTiming`, backed by a C++ struct.
+ */
+public typealias StageTiming = margelo.nitro.nitrovto.StageTiming
+
+public extension StageTiming {
+  private typealias bridge = margelo.nitro.nitrovto.bridge.swift
+
+  /**
+   * Create a new instance of `StageTiming`.
+   */
+  init(p50: Double, p95: Double, p99: Double, max: Double, samples: Double) {
+    self.init(p50, p95, p99, max, samples)
+  }
+
+  var p50: Double {
+    @inline(__always)
+    get {
+      return self.__p50
+    }
+    @inline(__always)
+    set {
+      self.__p50 = newValue
+    }
+  }
+
+  var p95: Double {
+    @inline(__always)
+    get {
+      return self.__p95
+    }
+    @inline(__always)
+    set {
+      self.__p95 = newValue
+    }
+  }
+
+  var p99: Double {
+    @inline(__always)
+    get {
+      return self.__p99
+    }
+    @inline(__always)
+    set {
+      self.__p99 = newValue
+    }
+  }
+
+  var max: Double {
+    @inline(__always)
+    get {
+      return self.__max
+    }
+    @inline(__always)
+    set {
+      self.__max = newValue
+    }
+  }
+
+  var samples: Double {
+    @inline(__always)
+    get {
+      return self.__samples
+    }
+    @inline(__always)
+    set {
+      self.__samples = newValue
+    }
+  }
+}
@@ -20,16 +20,42 @@ namespace margelo::nitro::nitrovto {
       prototype.registerHybridSetter("isActive", &HybridNitroVtoViewSpec::setIsActive);
       prototype.registerHybridGetter("onModelLoaded", &HybridNitroVtoViewSpec::getOnModelLoaded);
       prototype.registerHybridSetter("onModelLoaded", &HybridNitroVtoViewSpec::setOnModelLoaded);
+      prototype.registerHybridGetter("onModelLoadProgress", &HybridNitroVtoViewSpec::getOnModelLoadProgress);
+      prototype.registerHybridSetter("onModelLoadProgress", &HybridNitroVtoViewSpec::setOnModelLoadProgress);
       prototype.registerHybridGetter("faceMeshOcclusion", &HybridNitroVtoViewSpec::getFaceMeshOcclusion);
       prototype.registerHybridSetter("faceMeshOcclusion", &HybridNitroVtoViewSpec::setFaceMeshOcclusion);
       prototype.registerHybridGetter("backPlaneOcclusion", &HybridNitroVtoViewSpec::getBackPlaneOcclusion);
       prototype.registerHybridSetter("backPlaneOcclusion", &HybridNitroVtoViewSpec::setBackPlaneOcclusion);
       prototype.registerHybridGetter("forwardOffset", &HybridNitroVtoViewSpec::getForwardOffset);
       prototype.registerHybridSetter("forwardOffset", &HybridNitroVtoViewSpec::setForwardOffset);
+      prototype.registerHybridGetter("maxFaces", &HybridNitroVtoViewSpec::getMaxFaces);
+      prototype.registerHybridSetter("maxFaces", &HybridNitroVtoViewSpec::setMaxFaces);
       prototype.registerHybridGetter("debug", &HybridNitroVtoViewSpec::getDebug);
       prototype.registerHybridSetter("debug", &HybridNitroVtoViewSpec::setDebug);
+      prototype.registerHybridGetter("adaptivePerformance", &HybridNitroVtoViewSpec::getAdaptivePerformance);
+      prototype.registerHybridSetter("adaptivePerformance", &HybridNitroVtoViewSpec::setAdaptivePerformance);
+      prototype.registerHybridGetter("onPerformanceChange", &HybridNitroVtoViewSpec::getOnPerformanceChange);
+      prototype.registerHybridSetter("onPerformanceChange", &HybridNitroVtoViewSpec::setOnPerformanceChange);
+      prototype.registerHybridGetter("onCaptureComplete", &HybridNitroVtoViewSpec::getOnCaptureComplete);
+      prototype.registerHybridSetter("onCaptureComplete", &HybridNitroVtoViewSpec::setOnCaptureComplete);
       prototype.registerHybridMethod("switchModel", &HybridNitroVtoViewSpec::switchModel);
       prototype.registerHybridMethod("resetSession", &HybridNitroVtoViewSpec::resetSession);
+      prototype.registerHybridMethod("prefetchModels", &HybridNitroVtoViewSpec::prefetchModels);
+      prototype.registerHybridMethod("setCompareModels", &HybridNitroVtoViewSpec::setCompareModels);
+      prototype.registerHybridMethod("setActiveModel", &HybridNitroVtoViewSpec::setActiveModel);
+      prototype.registerHybridMethod("setEnvironment", &HybridNitroVtoViewSpec::setEnvironment);
+      prototype.registerHybridMethod("warmUp", &HybridNitroVtoViewSpec::warmUp);
+      prototype.registerHybridMethod("getModelCacheStats", &HybridNitroVtoViewSpec::getModelCacheStats);
+      prototype.registerHybridMethod("getModelMemoryStats", &HybridNitroVtoViewSpec::getModelMemoryStats);
+      prototype.registerHybridMethod("getPerformanceStats", &HybridNitroVtoViewSpec::getPerformanceStats);
+      prototype.registerHybridMethod("getFacePoseBuffer", &HybridNitroVtoViewSpec::getFacePoseBuffer);
+      prototype.registerHybridMethod("startFaceRecording", &HybridNitroVtoViewSpec::startFaceRecording);
+      prototype.registerHybridMethod("stopFaceRecording", &HybridNitroVtoViewSpec::stopFaceRecording);
+      prototype.registerHybridMethod("capture", &HybridNitroVtoViewSpec::capture);
+      prototype.registerHybridMethod("startRecording", &HybridNitroVtoViewSpec::startRecording);
+      prototype.registerHybridMethod("stopRecording", &HybridNitroVtoViewSpec::stopRecording);
+      prototype.registerHybridMethod("clearModelCache", &HybridNitroVtoViewSpec::clearModelCache);
+      prototype.registerHybridMethod("setModelCacheLimit", &HybridNitroVtoViewSpec::setModelCacheLimit);
     });
   }
 
@@ -13,11 +13,21 @@
 #error NitroModules cannot be found! Are you sure you installed NitroModules properly?
 #endif
 
-
+// Forward declaration of `ModelCacheStats` to properly resolve imports.
+namespace margelo::nitro::nitrovto { struct ModelCacheStats; }
+// Forward declaration of `ModelMemoryStats` to properly resolve imports.
+namespace margelo::nitro::nitrovto { struct ModelMemoryStats; }
+// Forward declaration of `PerformanceStats` to properly resolve imports.
+namespace margelo::nitro::nitrovto { struct PerformanceStats; }
 
 #include <string>
 #include <functional>
 #include <optional>
+#include <vector>
+#include "ModelCacheStats.hpp"
+#include "ModelMemoryStats.hpp"
+#include "PerformanceStats.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
 
 namespace margelo::nitro::nitrovto {
 
@@ -52,19 +62,45 @@ namespace margelo::nitro::nitrovto {
       virtual void setIsActive(bool isActive) = 0;
       virtual std::optional<std::function<void(const std::string& /* modelUrl */)>> getOnModelLoaded() = 0;
       virtual void setOnModelLoaded(const std::optional<std::function<void(const std::string& /* modelUrl */)>>& onModelLoaded) = 0;
+      virtual std::optional<std::function<void(const std::string& /* modelUrl */, double /* progress */)>> getOnModelLoadProgress() = 0;
+      virtual void setOnModelLoadProgress(const std::optional<std::function<void(const std::string& /* modelUrl */, double /* progress */)>>& onModelLoadProgress) = 0;
       virtual std::optional<bool> getFaceMeshOcclusion() = 0;
       virtual void setFaceMeshOcclusion(std::optional<bool> faceMeshOcclusion) = 0;
       virtual std::optional<bool> getBackPlaneOcclusion() = 0;
       virtual void setBackPlaneOcclusion(std::optional<bool> backPlaneOcclusion) = 0;
       virtual std::optional<double> getForwardOffset() = 0;
       virtual void setForwardOffset(std::optional<double> forwardOffset) = 0;
+      virtual std::optional<double> getMaxFaces() = 0;
+      virtual void setMaxFaces(std::optional<double> maxFaces) = 0;
       virtual std::optional<bool> getDebug() = 0;
       virtual void setDebug(std::optional<bool> debug) = 0;
+      virtual std::optional<bool> getAdaptivePerformance() = 0;
+      virtual void setAdaptivePerformance(std::optional<bool> adaptivePerformance) = 0;
+      virtual std::optional<std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>> getOnPerformanceChange() = 0;
+      virtual void setOnPerformanceChange(const std::optional<std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>>& onPerformanceChange) = 0;
+      virtual std::optional<std::function<void(const std::string& /* filePath */, double /* durationSeconds */)>> getOnCaptureComplete() = 0;
+      virtual void setOnCaptureComplete(const std::optional<std::function<void(const std::string& /* filePath */, double /* durationSeconds */)>>& onCaptureComplete) = 0;
 
     public:
       // Methods
       virtual void switchModel(const std::string& modelUrl) = 0;
       virtual void resetSession() = 0;
+      virtual void prefetchModels(const std::vector<std::string>& modelUrls) = 0;
+      virtual void setCompareModels(const std::vector<std::string>& modelUrls) = 0;
+      virtual void setActiveModel(double index) = 0;
+      virtual void setEnvironment(const std::string& name) = 0;
+      virtual void warmUp() = 0;
+      virtual ModelCacheStats getModelCacheStats() = 0;
+      virtual ModelMemoryStats getModelMemoryStats() = 0;
+      virtual PerformanceStats getPerformanceStats() = 0;
+      virtual std::shared_ptr<ArrayBuffer> getFacePoseBuffer() = 0;
+      virtual void startFaceRecording(const std::string& filePath) = 0;
+      virtual void stopFaceRecording() = 0;
+      virtual void capture(const std::string& filePath) = 0;
+      virtual void startRecording(const std::string& filePath) = 0;
+      virtual void stopRecording() = 0;
+      virtual void clearModelCache() = 0;
+      virtual void setModelCacheLimit(double maxBytes) = 0;
 
     protected:
       // Hybrid Setup
@@ -0,0 +1,91 @@
+///
+/// ModelCacheStats.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2026 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+
+
+namespace margelo::nitro::nitrovto {
+
+  /**
+   * A struct which can be represented as a JavaScript object (ModelCacheStats).
+   */
+  struct ModelCacheStats {
+  public:
+    double fileCount     SWIFT_PRIVATE;
+    double totalBytes     SWIFT_PRIVATE;
+    double byteLimit     SWIFT_PRIVATE;
+    double hitCount     SWIFT_PRIVATE;
+    double missCount     SWIFT_PRIVATE;
+
+  public:
+    ModelCacheStats() = default;
+    explicit ModelCacheStats(double fileCount, double totalBytes, double byteLimit, double hitCount, double missCount): fileCount(fileCount), totalBytes(totalBytes), byteLimit(byteLimit), hitCount(hitCount), missCount(missCount) {}
+  };
+
+} // namespace margelo::nitro::nitrovto
+
+namespace margelo::nitro {
+
+  // C++ ModelCacheStats <> JS ModelCacheStats (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrovto::ModelCacheStats> final {
+    static inline margelo::nitro::nitrovto::ModelCacheStats fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrovto::ModelCacheStats(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "fileCount")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "totalBytes")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "byteLimit")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "hitCount")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "missCount"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrovto::ModelCacheStats& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "fileCount", JSIConverter<double>::toJSI(runtime, arg.fileCount));
+      obj.setProperty(runtime, "totalBytes", JSIConverter<double>::toJSI(runtime, arg.totalBytes));
+      obj.setProperty(runtime, "byteLimit", JSIConverter<double>::toJSI(runtime, arg.byteLimit));
+      obj.setProperty(runtime, "hitCount", JSIConverter<double>::toJSI(runtime, arg.hitCount));
+      obj.setProperty(runtime, "missCount", JSIConverter<double>::toJSI(runtime, arg.missCount));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "fileCount"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "totalBytes"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "byteLimit"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "hitCount"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "missCount"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,91 @@
+///
+/// ModelMemoryStats.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2026 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+
+
+namespace margelo::nitro::nitrovto {
+
+  /**
+   * A struct which can be represented as a JavaScript object (ModelMemoryStats).
+   */
+  struct ModelMemoryStats {
+  public:
+    double modelCount     SWIFT_PRIVATE;
+    double compareModelCount     SWIFT_PRIVATE;
+    double gpuBytes     SWIFT_PRIVATE;
+    double cpuBytes     SWIFT_PRIVATE;
+    double deviceTier     SWIFT_PRIVATE;
+
+  public:
+    ModelMemoryStats() = default;
+    explicit ModelMemoryStats(double modelCount, double compareModelCount, double gpuBytes, double cpuBytes, double deviceTier): modelCount(modelCount), compareModelCount(compareModelCount), gpuBytes(gpuBytes), cpuBytes(cpuBytes), deviceTier(deviceTier) {}
+  };
+
+} // namespace margelo::nitro::nitrovto
+
+namespace margelo::nitro {
+
+  // C++ ModelMemoryStats <> JS ModelMemoryStats (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrovto::ModelMemoryStats> final {
+    static inline margelo::nitro::nitrovto::ModelMemoryStats fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrovto::ModelMemoryStats(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "modelCount")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "compareModelCount")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "gpuBytes")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "cpuBytes")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "deviceTier"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrovto::ModelMemoryStats& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "modelCount", JSIConverter<double>::toJSI(runtime, arg.modelCount));
+      obj.setProperty(runtime, "compareModelCount", JSIConverter<double>::toJSI(runtime, arg.compareModelCount));
+      obj.setProperty(runtime, "gpuBytes", JSIConverter<double>::toJSI(runtime, arg.gpuBytes));
+      obj.setProperty(runtime, "cpuBytes", JSIConverter<double>::toJSI(runtime, arg.cpuBytes));
+      obj.setProperty(runtime, "deviceTier", JSIConverter<double>::toJSI(runtime, arg.deviceTier));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "modelCount"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "compareModelCount"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "gpuBytes"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "cpuBytes"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "deviceTier"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,112 @@
+///
+/// PerformanceStats.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2026 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `StageTiming` to properly resolve imports.
+namespace margelo::nitro::nitrovto { struct StageTiming; }
+
+#include "StageTiming.hpp"
+
+namespace margelo::nitro::nitrovto {
+
+  /**
+   * A struct which can be represented as a JavaScript object (PerformanceStats).
+   */
+  struct PerformanceStats {
+  public:
+    double frameCount     SWIFT_PRIVATE;
+    double droppedFrames     SWIFT_PRIVATE;
+    StageTiming session     SWIFT_PRIVATE;
+    StageTiming camera     SWIFT_PRIVATE;
+    StageTiming faceMesh     SWIFT_PRIVATE;
+    StageTiming glassesPose     SWIFT_PRIVATE;
+    StageTiming resources     SWIFT_PRIVATE;
+    StageTiming render     SWIFT_PRIVATE;
+    StageTiming frame     SWIFT_PRIVATE;
+    StageTiming gpu     SWIFT_PRIVATE;
+
+  public:
+    PerformanceStats() = default;
+    explicit PerformanceStats(double frameCount, double droppedFrames, StageTiming session, StageTiming camera, StageTiming faceMesh, StageTiming glassesPose, StageTiming resources, StageTiming render, StageTiming frame, StageTiming gpu): frameCount(frameCount), droppedFrames(droppedFrames), session(session), camera(camera), faceMesh(faceMesh), glassesPose(glassesPose), resources(resources), render(render), frame(frame), gpu(gpu) {}
+  };
+
+} // namespace margelo::nitro::nitrovto
+
+namespace margelo::nitro {
+
+  // C++ PerformanceStats <> JS PerformanceStats (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrovto::PerformanceStats> final {
+    static inline margelo::nitro::nitrovto::PerformanceStats fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrovto::PerformanceStats(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "frameCount")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "droppedFrames")),
+        JSIConverter<margelo::nitro::nitrovto::StageTiming>::fromJSI(runtime, obj.getProperty(runtime, "session")),
+        JSIConverter<margelo::nitro::nitrovto::StageTiming>::fromJSI(runtime, obj.getProperty(runtime, "camera")),
+        JSIConverter<margelo::nitro::nitrovto::StageTiming>::fromJSI(runtime, obj.getProperty(runtime, "faceMesh")),
+        JSIConverter<margelo::nitro::nitrovto::StageTiming>::fromJSI(runtime, obj.getProperty(runtime, "glassesPose")),
+        JSIConverter<margelo::nitro::nitrovto::StageTiming>::fromJSI(runtime, obj.getProperty(runtime, "resources")),
+        JSIConverter<margelo::nitro::nitrovto::StageTiming>::fromJSI(runtime, obj.getProperty(runtime, "render")),
+        JSIConverter<margelo::nitro::nitrovto::StageTiming>::fromJSI(runtime, obj.getProperty(runtime, "frame")),
+        JSIConverter<margelo::nitro::nitrovto::StageTiming>::fromJSI(runtime, obj.getProperty(runtime, "gpu"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrovto::PerformanceStats& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "frameCount", JSIConverter<double>::toJSI(runtime, arg.frameCount));
+      obj.setProperty(runtime, "droppedFrames", JSIConverter<double>::toJSI(runtime, arg.droppedFrames));
+      obj.setProperty(runtime, "session", JSIConverter<margelo::nitro::nitrovto::StageTiming>::toJSI(runtime, arg.session));
+      obj.setProperty(runtime, "camera", JSIConverter<margelo::nitro::nitrovto::StageTiming>::toJSI(runtime, arg.camera));
+      obj.setProperty(runtime, "faceMesh", JSIConverter<margelo::nitro::nitrovto::StageTiming>::toJSI(runtime, arg.faceMesh));
+      obj.setProperty(runtime, "glassesPose", JSIConverter<margelo::nitro::nitrovto::StageTiming>::toJSI(runtime, arg.glassesPose));
+      obj.setProperty(runtime, "resources", JSIConverter<margelo::nitro::nitrovto::StageTiming>::toJSI(runtime, arg.resources));
+      obj.setProperty(runtime, "render", JSIConverter<margelo::nitro::nitrovto::StageTiming>::toJSI(runtime, arg.render));
+      obj.setProperty(runtime, "frame", JSIConverter<margelo::nitro::nitrovto::StageTiming>::toJSI(runtime, arg.frame));
+      obj.setProperty(runtime, "gpu", JSIConverter<margelo::nitro::nitrovto::StageTiming>::toJSI(runtime, arg.gpu));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "frameCount"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "droppedFrames"))) return false;
+      if (!JSIConverter<margelo::nitro::nitrovto::StageTiming>::canConvert(runtime, obj.getProperty(runtime, "session"))) return false;
+      if (!JSIConverter<margelo::nitro::nitrovto::StageTiming>::canConvert(runtime, obj.getProperty(runtime, "camera"))) return false;
+      if (!JSIConverter<margelo::nitro::nitrovto::StageTiming>::canConvert(runtime, obj.getProperty(runtime, "faceMesh"))) return false;
+      if (!JSIConverter<margelo::nitro::nitrovto::StageTiming>::canConvert(runtime, obj.getProperty(runtime, "glassesPose"))) return false;
+      if (!JSIConverter<margelo::nitro::nitrovto::StageTiming>::canConvert(runtime, obj.getProperty(runtime, "resources"))) return false;
+      if (!JSIConverter<margelo::nitro::nitrovto::StageTiming>::canConvert(runtime, obj.getProperty(runtime, "render"))) return false;
+      if (!JSIConverter<margelo::nitro::nitrovto::StageTiming>::canConvert(runtime, obj.getProperty(runtime, "frame"))) return false;
+      if (!JSIConverter<margelo::nitro::nitrovto::StageTiming>::canConvert(runtime, obj.getProperty(runtime, "gpu"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,91 @@
+///
+/// StageTiming.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2026 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+
+
+namespace margelo::nitro::nitrovto {
+
+  /**
+   * A struct which can be represented as a JavaScript object (StageTiming).
+   */
+  struct StageTiming {
+  public:
+    double p50     SWIFT_PRIVATE;
+    double p95     SWIFT_PRIVATE;
+    double p99     SWIFT_PRIVATE;
+    double max     SWIFT_PRIVATE;
+    double samples     SWIFT_PRIVATE;
+
+  public:
+    StageTiming() = default;
+    explicit StageTiming(double p50, double p95, double p99, double max, double samples): p50(p50), p95(p95), p99(p99), max(max), samples(samples) {}
+  };
+
+} // namespace margelo::nitro::nitrovto
+
+namespace margelo::nitro {
+
+  // C++ StageTiming <> JS StageTiming (object)
+  template <>
+  struct JSIConverter<margelo::nitro::nitrovto::StageTiming> final {
+    static inline margelo::nitro::nitrovto::StageTiming fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::nitrovto::StageTiming(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "p50")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "p95")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "p99")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "max")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "samples"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::nitrovto::StageTiming& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "p50", JSIConverter<double>::toJSI(runtime, arg.p50));
+      obj.setProperty(runtime, "p95", JSIConverter<double>::toJSI(runtime, arg.p95));
+      obj.setProperty(runtime, "p99", JSIConverter<double>::toJSI(runtime, arg.p99));
+      obj.setProperty(runtime, "max", JSIConverter<double>::toJSI(runtime, arg.max));
+      obj.setProperty(runtime, "samples", JSIConverter<double>::toJSI(runtime, arg.samples));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "p50"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "p95"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "p99"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "max"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "samples"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -55,6 +55,16 @@ namespace margelo::nitro::nitrovto::views {
         throw std::runtime_error(std::string("NitroVtoView.onModelLoaded: ") + exc.what());
       }
     }()),
+    onModelLoadProgress([&]() -> CachedProp<std::optional<std::function<void(const std::string& /* modelUrl */, double /* progress */)>>> {
+      try {
+        const react::RawValue* rawValue = rawProps.at("onModelLoadProgress", nullptr, nullptr);
+        if (rawValue == nullptr) return sourceProps.onModelLoadProgress;
+        const auto& [runtime, value] = (std::pair<jsi::Runtime*, jsi::Value>)*rawValue;
+        return CachedProp<std::optional<std::function<void(const std::string& /* modelUrl */, double /* progress */)>>>::fromRawValue(*runtime, value.asObject(*runtime).getProperty(*runtime, "f"), sourceProps.onModelLoadProgress);
+      } catch (const std::exception& exc) {
+        throw std::runtime_error(std::string("NitroVtoView.onModelLoadProgress: ") + exc.what());
+      }
+    }()),
     faceMeshOcclusion([&]() -> CachedProp<std::optional<bool>> {
       try {
         const react::RawValue* rawValue = rawProps.at("faceMeshOcclusion", nullptr, nullptr);
@@ -85,6 +95,16 @@ namespace margelo::nitro::nitrovto::views {
         throw std::runtime_error(std::string("NitroVtoView.forwardOffset: ") + exc.what());
       }
     }()),
+    maxFaces([&]() -> CachedProp<std::optional<double>> {
+      try {
+        const react::RawValue* rawValue = rawProps.at("maxFaces", nullptr, nullptr);
+        if (rawValue == nullptr) return sourceProps.maxFaces;
+        const auto& [runtime, value] = (std::pair<jsi::Runtime*, jsi::Value>)*rawValue;
+        return CachedProp<std::optional<double>>::fromRawValue(*runtime, value, sourceProps.maxFaces);
+      } catch (const std::exception& exc) {
+        throw std::runtime_error(std::string("NitroVtoView.maxFaces: ") + exc.what());
+      }
+    }()),
     debug([&]() -> CachedProp<std::optional<bool>> {
       try {
         const react::RawValue* rawValue = rawProps.at("debug", nullptr, nullptr);
@@ -95,6 +115,36 @@ namespace margelo::nitro::nitrovto::views {
         throw std::runtime_error(std::string("NitroVtoView.debug: ") + exc.what());
       }
     }()),
+    adaptivePerformance([&]() -> CachedProp<std::optional<bool>> {
+      try {
+        const react::RawValue* rawValue = rawProps.at("adaptivePerformance", nullptr, nullptr);
+        if (rawValue == nullptr) return sourceProps.adaptivePerformance;
+        const auto& [runtime, value] = (std::pair<jsi::Runtime*, jsi::Value>)*rawValue;
+        return CachedProp<std::optional<bool>>::fromRawValue(*runtime, value, sourceProps.adaptivePerformance);
+      } catch (const std::exception& exc) {
+        throw std::runtime_error(std::string("NitroVtoView.adaptivePerformance: ") + exc.what());
+      }
+    }()),
+    onPerformanceChange([&]() -> CachedProp<std::optional<std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>>> {
+      try {
+        const react::RawValue* rawValue = rawProps.at("onPerformanceChange", nullptr, nullptr);
+        if (rawValue == nullptr) return sourceProps.onPerformanceChange;
+        const auto& [runtime, value] = (std::pair<jsi::Runtime*, jsi::Value>)*rawValue;
+        return CachedProp<std::optional<std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>>>::fromRawValue(*runtime, value.asObject(*runtime).getProperty(*runtime, "f"), sourceProps.onPerformanceChange);
+      } catch (const std::exception& exc) {
+        throw std::runtime_error(std::string("NitroVtoView.onPerformanceChange: ") + exc.what());
+      }
+    }()),
+    onCaptureComplete([&]() -> CachedProp<std::optional<std::function<void(const std::string& /* filePath */, double /* durationSeconds */)>>> {
+      try {
+        const react::RawValue* rawValue = rawProps.at("onCaptureComplete", nullptr, nullptr);
+        if (rawValue == nullptr) return sourceProps.onCaptureComplete;
+        const auto& [runtime, value] = (std::pair<jsi::Runtime*, jsi::Value>)*rawValue;
+        return CachedProp<std::optional<std::function<void(const std::string& /* filePath */, double /* durationSeconds */)>>>::fromRawValue(*runtime, value.asObject(*runtime).getProperty(*runtime, "f"), sourceProps.onCaptureComplete);
+      } catch (const std::exception& exc) {
+        throw std::runtime_error(std::string("NitroVtoView.onCaptureComplete: ") + exc.what());
+      }
+    }()),
     hybridRef([&]() -> CachedProp<std::optional<std::function<void(const std::shared_ptr<HybridNitroVtoViewSpec>& /* ref */)>>> {
       try {
         const react::RawValue* rawValue = rawProps.at("hybridRef", nullptr, nullptr);
@@ -111,10 +161,15 @@ namespace margelo::nitro::nitrovto::views {
     modelUrl(other.modelUrl),
     isActive(other.isActive),
     onModelLoaded(other.onModelLoaded),
+    onModelLoadProgress(other.onModelLoadProgress),
     faceMeshOcclusion(other.faceMeshOcclusion),
     backPlaneOcclusion(other.backPlaneOcclusion),
     forwardOffset(other.forwardOffset),
+    maxFaces(other.maxFaces),
     debug(other.debug),
+    adaptivePerformance(other.adaptivePerformance),
+    onPerformanceChange(other.onPerformanceChange),
+    onCaptureComplete(other.onCaptureComplete),
     hybridRef(other.hybridRef) { }
 
   bool HybridNitroVtoViewProps::filterObjectKeys(const std::string& propName) {
@@ -122,10 +177,15 @@ namespace margelo::nitro::nitrovto::views {
       case hashString("modelUrl"): return true;
       case hashString("isActive"): return true;
       case hashString("onModelLoaded"): return true;
+      case hashString("onModelLoadProgress"): return true;
       case hashString("faceMeshOcclusion"): return true;
       case hashString("backPlaneOcclusion"): return true;
       case hashString("forwardOffset"): return true;
+      case hashString("maxFaces"): return true;
       case hashString("debug"): return true;
+      case hashString("adaptivePerformance"): return true;
+      case hashString("onPerformanceChange"): return true;
+      case hashString("onCaptureComplete"): return true;
       case hashString("hybridRef"): return true;
       default: return false;
     }
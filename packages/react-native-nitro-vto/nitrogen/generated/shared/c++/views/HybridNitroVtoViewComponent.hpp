@@ -46,10 +46,15 @@ namespace margelo::nitro::nitrovto::views {
     CachedProp<std::string> modelUrl;
     CachedProp<bool> isActive;
     CachedProp<std::optional<std::function<void(const std::string& /* modelUrl */)>>> onModelLoaded;
+    CachedProp<std::optional<std::function<void(const std::string& /* modelUrl */, double /* progress */)>>> onModelLoadProgress;
     CachedProp<std::optional<bool>> faceMeshOcclusion;
     CachedProp<std::optional<bool>> backPlaneOcclusion;
     CachedProp<std::optional<double>> forwardOffset;
+    CachedProp<std::optional<double>> maxFaces;
     CachedProp<std::optional<bool>> debug;
+    CachedProp<std::optional<bool>> adaptivePerformance;
+    CachedProp<std::optional<std::function<void(double /* renderScale */, double /* frameRate */, const std::string& /* reason */)>>> onPerformanceChange;
+    CachedProp<std::optional<std::function<void(const std::string& /* filePath */, double /* durationSeconds */)>>> onCaptureComplete;
     CachedProp<std::optional<std::function<void(const std::shared_ptr<HybridNitroVtoViewSpec>& /* ref */)>>> hybridRef;
 
   private:
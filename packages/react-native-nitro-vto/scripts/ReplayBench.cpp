@@ -0,0 +1,323 @@
+// Replays a recorded face session (see cpp/FaceRecording.hpp) through the shared VTO core:
+// face mesh packing and back plane placement, the glasses pose solver and level of detail
+// selection. First checks the pose filter's prediction against synthetic constant motion.
+// Built and run by scripts/replay-bench.ts; not part of the app build.
+
+#include "FaceMesh.hpp"
+#include "FaceRecording.hpp"
+#include "GlassesPose.hpp"
+#include "ModelLod.hpp"
+#include "PoseFilter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Heap allocations made by the process; the replay loop reads it around each frame
+std::atomic<uint64_t> gAllocations{0};
+
+double now() {
+    using Clock = std::chrono::steady_clock;
+    return std::chrono::duration<double>(Clock::now().time_since_epoch()).count();
+}
+
+struct Options {
+    std::string recordingPath;
+    std::string modelPath;
+    int iterations = 10;
+    vto::DeviceTier tier = vto::DeviceTier::High;
+    float forwardOffset = 0.005f;
+    double prediction = 0.0;
+};
+
+const char* const kUsage =
+    "Usage: ReplayBench <recording> [--model <glb>] [--iterations <n>] [--tier low|mid|high]\n"
+    "                               [--forward-offset <meters>] [--prediction-ms <ms>]\n";
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--model" && hasValue) {
+            options.modelPath = argv[++i];
+        } else if (arg == "--iterations" && hasValue) {
+            options.iterations = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--tier" && hasValue) {
+            std::string tier = argv[++i];
+            if (tier == "low") options.tier = vto::DeviceTier::Low;
+            else if (tier == "mid") options.tier = vto::DeviceTier::Mid;
+            else if (tier == "high") options.tier = vto::DeviceTier::High;
+            else return false;
+        } else if (arg == "--forward-offset" && hasValue) {
+            options.forwardOffset = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--prediction-ms" && hasValue) {
+            options.prediction = std::atof(argv[++i]) * 1e-3;
+        } else if (arg.rfind("--", 0) != 0 && options.recordingPath.empty()) {
+            options.recordingPath = arg;
+        } else {
+            return false;
+        }
+    }
+    return !options.recordingPath.empty();
+}
+
+/// Number of levels of detail a GLB declares through _LOD<n> node and mesh names (1 without any)
+int glbLodLevelCount(const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return -1;
+
+    // 12 byte header, then the JSON chunk: uint32 length, uint32 type, UTF-8 text
+    uint32_t header[5] = {};
+    bool valid = std::fread(header, sizeof(uint32_t), 5, file) == 5 && header[0] == 0x46546C67 &&
+                 header[4] == 0x4E4F534A;
+    std::string json;
+    if (valid) {
+        json.resize(header[3]);
+        valid = std::fread(json.data(), 1, json.size(), file) == json.size();
+    }
+    std::fclose(file);
+    if (!valid) return -1;
+
+    int levels = 1;
+    const std::string key = "\"name\":\"";
+    for (size_t pos = json.find(key); pos != std::string::npos; pos = json.find(key, pos + 1)) {
+        size_t start = pos + key.size();
+        size_t end = json.find('"', start);
+        if (end == std::string::npos) break;
+        int level = vto::lodLevelFromName(json.substr(start, end - start).c_str());
+        levels = std::max(levels, level + 1);
+    }
+    return levels;
+}
+
+/// Nearest-rank percentile of sorted samples
+double percentile(const std::vector<double>& sorted, double fraction) {
+    size_t rank = static_cast<size_t>(fraction * sorted.size() + 0.5);
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+void printStage(const char* name, std::vector<double>& samples) {
+    if (samples.empty()) {
+        std::printf("  %-12s -\n", name);
+        return;
+    }
+    std::sort(samples.begin(), samples.end());
+    std::printf("  %-12s p50 %7.2f  p95 %7.2f  p99 %7.2f  max %7.2f us  (%zu frames)\n", name,
+                percentile(samples, 0.50) * 1e6, percentile(samples, 0.95) * 1e6, percentile(samples, 0.99) * 1e6,
+                samples.back() * 1e6, samples.size());
+}
+
+/// Frame count per power-of-two microsecond bucket
+void printHistogram(const std::vector<double>& samples) {
+    std::vector<size_t> buckets;
+    for (double seconds : samples) {
+        size_t bucket = 0;
+        for (double limit = 1e-6; seconds >= limit && bucket < 20; limit *= 2.0) bucket++;
+        if (buckets.size() <= bucket) buckets.resize(bucket + 1, 0);
+        buckets[bucket]++;
+    }
+    for (size_t bucket = 0; bucket < buckets.size(); bucket++) {
+        if (buckets[bucket] == 0) continue;
+        double upper = static_cast<double>(1u << bucket);
+        std::printf("  < %6.0f us  %6.2f%%\n", upper, 100.0 * buckets[bucket] / samples.size());
+    }
+}
+
+float distance(vto::Float3 a, vto::Float3 b) {
+    const float x = a.x - b.x, y = a.y - b.y, z = a.z - b.z;
+    return std::sqrt(x * x + y * y + z * z);
+}
+
+/**
+ * Constant linear and angular velocity at 30 Hz: once settled, the filter's velocities must match
+ * the motion and the pose predicted one frame ahead must land on the true pose.
+ */
+bool checkPrediction() {
+    const double frameTime = 1.0 / 30.0;
+    const double horizon = 0.033;
+    const vto::Float3 velocity = {0.2f, -0.1f, 0.05f};
+    const vto::Float3 angularVelocity = {0.3f, 1.0f, 0.0f};
+    auto truePose = [&](double t) {
+        const float s = static_cast<float>(t);
+        return vto::Pose{{velocity.x * s, velocity.y * s, velocity.z * s},
+                         vto::quatFromRotationVector({angularVelocity.x * s, angularVelocity.y * s,
+                                                      angularVelocity.z * s})};
+    };
+
+    vto::PoseFilterParams params;
+    vto::PoseFilterState state;
+    const int frames = 90;
+    for (int frame = 0; frame < frames; frame++) {
+        vto::updatePoseFilter(state, params, truePose(frame * frameTime), frame * frameTime);
+    }
+    const vto::Pose predicted = vto::predictPose(state, params, horizon);
+    const vto::Pose expected = truePose((frames - 1) * frameTime + horizon);
+
+    const float positionError = distance(predicted.position, expected.position);
+    const float rotationError = distance(
+        vto::quatToRotationVector(vto::quatMultiply(predicted.rotation, vto::quatConjugate(expected.rotation))),
+        {0.0f, 0.0f, 0.0f});
+    const float velocityError = distance(state.velocity, velocity);
+    const float angularVelocityError = distance(state.angularVelocity, angularVelocity);
+
+    // 0.1 mm, 1 mrad and 1% of the motion: far below what the eye sees, far above float noise
+    const bool passed = positionError < 1e-4f && rotationError < 1e-3f && velocityError < 2e-3f &&
+                        angularVelocityError < 1e-2f;
+    std::printf("Prediction check: %.3f mm, %.4f rad off at %.0f ms under constant motion, velocities off by "
+                "%.4f m/s, %.4f rad/s (%s)\n\n",
+                positionError * 1e3f, rotationError, horizon * 1e3, velocityError, angularVelocityError,
+                passed ? "ok" : "FAILED");
+    return passed;
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::fputs(kUsage, stderr);
+        return 1;
+    }
+
+    if (!checkPrediction()) return 1;
+
+    vto::FaceRecordingReader reader;
+    if (!reader.open(options.recordingPath)) {
+        std::fprintf(stderr, "Error: not a face recording: %s\n", options.recordingPath.c_str());
+        return 1;
+    }
+
+    int lodLevels = 1;
+    if (!options.modelPath.empty()) {
+        lodLevels = glbLodLevelCount(options.modelPath);
+        if (lodLevels < 0) {
+            std::fprintf(stderr, "Error: not a GLB file: %s\n", options.modelPath.c_str());
+            return 1;
+        }
+    }
+
+    // Load every frame up front, so file reads don't show up in the timings
+    std::vector<vto::RecordedFrame> frames;
+    for (vto::RecordedFrame frame; reader.next(frame);) {
+        frames.push_back(frame);
+    }
+    if (frames.empty()) {
+        std::fprintf(stderr, "Error: recording has no frames: %s\n", options.recordingPath.c_str());
+        return 1;
+    }
+
+    size_t maxVertices = 0;
+    size_t faceFrames = 0;
+    for (const vto::RecordedFrame& frame : frames) {
+        maxVertices = std::max(maxVertices, frame.vertexCount());
+        if (frame.hasFace) faceFrames++;
+    }
+    double duration = frames.back().camera.timestamp - frames.front().camera.timestamp;
+
+    std::printf("Recording: %s\n", options.recordingPath.c_str());
+    std::printf("  %zu frames over %.1f s, %zu with a face, %zu mesh vertices (%s)\n", frames.size(), duration,
+                faceFrames, maxVertices, reader.source() == vto::RecordingSource::ARCore ? "ARCore" : "ARKit");
+    std::printf("  %d levels of detail, %d iterations\n\n", lodLevels, options.iterations);
+
+    vto::GlassesPoseSolver poseSolver(vto::noseBridgeLandmarks(reader.source()));
+    poseSolver.setForwardOffset(options.forwardOffset);
+    vto::LodSelector lodSelector;
+    lodSelector.setDeviceTier(options.tier);
+    lodSelector.setLevelCount(lodLevels);
+
+    // Reserved up front: the replay loop itself must not allocate
+    size_t totalFrames = frames.size() * static_cast<size_t>(options.iterations);
+    std::vector<double> faceMeshTimes, glassesPoseTimes, frameTimes;
+    faceMeshTimes.reserve(totalFrames);
+    glassesPoseTimes.reserve(totalFrames);
+    frameTimes.reserve(totalFrames);
+    std::vector<float> packed(maxVertices * 3);
+    uint64_t steadyAllocations = 0;
+    uint64_t steadyFrames = 0;
+    // Order-dependent hash of the solved poses, to check two builds replay identically
+    uint64_t poseChecksum = 1469598103934665603ull;
+    bool faceTracked = false;
+
+    for (int iteration = 0; iteration < options.iterations; iteration++) {
+        poseSolver.reset();
+        lodSelector.reset();
+        faceTracked = false;
+
+        for (const vto::RecordedFrame& frame : frames) {
+            uint64_t allocationsBefore = gAllocations.load(std::memory_order_relaxed);
+            double frameStart = now();
+
+            if (frame.hasFace) {
+                faceTracked = true;
+                double stageStart = now();
+                vto::FaceMeshBounds bounds =
+                    vto::packFaceVertices(frame.vertices.data(), 3, frame.vertexCount(), packed.data());
+                vto::BackPlanePlacement placement = vto::placeBackPlanes(frame.faceTransform, bounds.min.z, true);
+                faceMeshTimes.push_back(now() - stageStart);
+
+                stageStart = now();
+                vto::Mat4 pose = poseSolver.update(frame.faceTransform, frame.vertices.data(), 3, frame.vertexCount(),
+                                                   frame.camera.timestamp, options.prediction);
+                int level = lodSelector.update(frame.faceTransform, frame.camera.transform);
+                glassesPoseTimes.push_back(now() - stageStart);
+
+                for (float value : pose.m) {
+                    uint32_t bits;
+                    std::memcpy(&bits, &value, sizeof(bits));
+                    poseChecksum = (poseChecksum ^ bits) * 1099511628211ull;
+                }
+                poseChecksum = (poseChecksum ^ static_cast<uint64_t>(level)) * 1099511628211ull;
+                poseChecksum = (poseChecksum ^ (placement.showLeft ? 1u : 0u) ^ (placement.showRight ? 2u : 0u)) *
+                               1099511628211ull;
+            } else if (faceTracked) {
+                // Face lost: same as the renderers, which reset the filters once
+                faceTracked = false;
+                poseSolver.reset();
+                lodSelector.reset();
+            }
+
+            frameTimes.push_back(now() - frameStart);
+            uint64_t allocations = gAllocations.load(std::memory_order_relaxed) - allocationsBefore;
+            // The first pass warms up lazily sized state; later passes must not allocate
+            if (iteration > 0) {
+                steadyAllocations += allocations;
+                steadyFrames++;
+            }
+        }
+    }
+
+    std::printf("Stage timings:\n");
+    printStage("faceMesh", faceMeshTimes);
+    printStage("glassesPose", glassesPoseTimes);
+    printStage("frame", frameTimes);
+    std::printf("\nFrame time distribution:\n");
+    printHistogram(frameTimes);
+    std::printf("\nAllocations: %.2f per frame after the first iteration\n",
+                steadyFrames > 0 ? static_cast<double>(steadyAllocations) / steadyFrames : 0.0);
+    std::printf("Pose checksum: %016llx\n", static_cast<unsigned long long>(poseChecksum));
+    return 0;
+}
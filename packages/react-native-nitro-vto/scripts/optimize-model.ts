@@ -0,0 +1,105 @@
+import { execSync } from "child_process";
+import { existsSync, mkdirSync, statSync } from "fs";
+import { resolve, basename, dirname, join } from "path";
+import dotenv from "dotenv";
+
+// Load .env file from package root
+dotenv.config({ path: resolve(__dirname, "../.env"), quiet: true });
+
+const MODELS_FOLDER = resolve(__dirname, "../../../misc/models");
+const OUTPUT_FOLDER_NAME = "optimized";
+
+// Glasses are viewed up close but small on screen: 1024px is plenty for any texture
+const MAX_TEXTURE_SIZE = 1024;
+
+const USAGE = `
+Usage: npx tsx scripts/optimize-model.ts <glb-file>
+
+Arguments:
+  glb-file   GLB to convert, relative to misc/models/ (or an absolute path)
+
+Writes <name>.glb to an "${OUTPUT_FOLDER_NAME}" folder next to the input, with:
+  - EXT_meshopt_compression geometry (quantized, meshopt-encoded)
+  - KHR_texture_basisu textures (KTX2: UASTC for normal maps, ETC1S otherwise)
+
+Requires GLTF_TRANSFORM_PATH in .env (gltf-transform CLI) and KTX-Software's
+toktx on PATH.
+
+Examples:
+  npx tsx scripts/optimize-model.ts 680048.glb
+`;
+
+const run = (command: string) => {
+  console.log(`Command: ${command}`);
+  execSync(command, { stdio: "inherit" });
+};
+
+const formatSize = (bytes: number) => `${(bytes / 1024).toFixed(0)} KB`;
+
+const main = () => {
+  const args = process.argv.slice(2);
+
+  if (args.length !== 1 || !args[0]) {
+    console.error(USAGE);
+    process.exit(1);
+  }
+
+  const inputPath = resolve(MODELS_FOLDER, args[0]);
+
+  if (!existsSync(inputPath)) {
+    console.error(`Error: Model file not found: ${inputPath}`);
+    process.exit(1);
+  }
+
+  if (!inputPath.endsWith(".glb")) {
+    console.error(`Error: File must have .glb extension: ${inputPath}`);
+    process.exit(1);
+  }
+
+  const gltfTransformPath = process.env.GLTF_TRANSFORM_PATH;
+
+  if (!gltfTransformPath) {
+    console.error("Error: GLTF_TRANSFORM_PATH not defined in .env file");
+    process.exit(1);
+  }
+
+  if (!existsSync(gltfTransformPath)) {
+    console.error(`Error: gltf-transform not found at ${gltfTransformPath}`);
+    process.exit(1);
+  }
+
+  const outputFolder = join(dirname(inputPath), OUTPUT_FOLDER_NAME);
+  mkdirSync(outputFolder, { recursive: true });
+  const outputPath = join(outputFolder, basename(inputPath));
+  const tool = `"${gltfTransformPath}"`;
+
+  console.log(`Optimizing ${basename(inputPath)}...`);
+
+  try {
+    // Geometry: dedup, prune, weld, then meshopt-encode. Simplification stays off: frame
+    // and hinge detail is what the user looks at. Geometry LODs are a separate step.
+    run(
+      `${tool} optimize "${inputPath}" "${outputPath}" --compress meshopt ` +
+        `--simplify false --texture-compress false --texture-size ${MAX_TEXTURE_SIZE}`
+    );
+
+    // Textures: UASTC keeps normal maps artifact-free, ETC1S is much smaller for color and ORM
+    run(
+      `${tool} uastc "${outputPath}" "${outputPath}" --slots "normalTexture" --level 2 --zstd 18`
+    );
+    run(
+      `${tool} etc1s "${outputPath}" "${outputPath}" --slots "!normalTexture" --quality 192`
+    );
+  } catch (error) {
+    console.error("Error: model optimization failed");
+    process.exit(1);
+  }
+
+  const inputSize = statSync(inputPath).size;
+  const outputSize = statSync(outputPath).size;
+  console.log(
+    `Output: ${outputPath} (${formatSize(inputSize)} -> ${formatSize(outputSize)})`
+  );
+};
+
+main();
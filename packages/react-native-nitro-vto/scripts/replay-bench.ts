@@ -0,0 +1,90 @@
+import { execSync } from "child_process";
+import { existsSync, mkdirSync } from "fs";
+import { tmpdir } from "os";
+import { resolve, join } from "path";
+
+const CORE_FOLDER = resolve(__dirname, "../cpp");
+const MODELS_FOLDER = resolve(__dirname, "../../../misc/models");
+const BENCH_SOURCE = resolve(__dirname, "ReplayBench.cpp");
+
+// Core sources the replayed pipeline runs through
+const CORE_SOURCES = [
+  "FaceMesh.cpp",
+  "FaceRecording.cpp",
+  "GlassesPose.cpp",
+  "ModelLod.cpp",
+  "PoseFilter.cpp",
+];
+
+const USAGE = `
+Usage: npx tsx scripts/replay-bench.ts <recording> [options]
+
+Arguments:
+  recording   Face session recorded with startFaceRecording() (.vtorec)
+
+Options:
+  --model <glb>               Model whose levels of detail to select, relative to misc/models/
+  --iterations <n>            Times to replay the recording (default 10)
+  --tier low|mid|high         Device tier for level of detail selection (default high)
+  --forward-offset <meters>   Glasses forward offset (default 0.005)
+  --prediction-ms <ms>        Pose extrapolation past each camera frame (default 0)
+
+Checks the pose filter's prediction against synthetic constant motion (failing the run if it
+drifts), then replays every frame through the shared C++ core (face mesh packing, back planes,
+glasses pose filtering, level of detail) and prints per-stage timings, the frame time
+distribution, steady-state allocations per frame and a checksum of the solved poses.
+Builds with $CXX (default c++).
+
+Examples:
+  npx tsx scripts/replay-bench.ts ~/Downloads/session.vtorec --model 680048.glb
+`;
+
+const main = () => {
+  const args = process.argv.slice(2);
+
+  if (args.length < 1 || !args[0] || args[0].startsWith("--")) {
+    console.error(USAGE);
+    process.exit(1);
+  }
+
+  const recordingPath = resolve(args[0]);
+
+  if (!existsSync(recordingPath)) {
+    console.error(`Error: Recording not found: ${recordingPath}`);
+    process.exit(1);
+  }
+
+  // Resolve --model like optimize-model.ts does, so the models in misc/models/ are easy to use
+  const benchArgs = args.slice(1).map((arg, index, all) =>
+    all[index - 1] === "--model" ? `"${resolve(MODELS_FOLDER, arg)}"` : arg
+  );
+
+  const buildFolder = join(tmpdir(), "nitro-vto-bench");
+  mkdirSync(buildFolder, { recursive: true });
+  const binary = join(buildFolder, "ReplayBench");
+  const compiler = process.env.CXX ?? "c++";
+  const sources = [BENCH_SOURCE, ...CORE_SOURCES.map((file) => join(CORE_FOLDER, file))]
+    .map((file) => `"${file}"`)
+    .join(" ");
+
+  try {
+    // Same optimization level as the app's release builds
+    execSync(
+      `${compiler} -std=c++20 -O2 -DNDEBUG -I"${CORE_FOLDER}" ${sources} -o "${binary}"`,
+      { stdio: "inherit" }
+    );
+  } catch (error) {
+    console.error("Error: failed to build the replay bench");
+    process.exit(1);
+  }
+
+  try {
+    execSync(`"${binary}" "${recordingPath}" ${benchArgs.join(" ")}`, {
+      stdio: "inherit",
+    });
+  } catch (error) {
+    process.exit(1);
+  }
+};
+
+main();
@@ -0,0 +1,185 @@
+/**
+ * Layout of the buffer returned by `getFacePoseBuffer()`, mirroring cpp/FacePoseStream.hpp.
+ * All offsets are in bytes; fields are in native byte order.
+ */
+export const FacePoseLayout = {
+  version: 1,
+  headerBytes: 32,
+  faceBytes: 96,
+  maxFaces: 3,
+  byteLength: 32 + 3 * 96,
+} as const;
+
+/**
+ * Tracking state written with every frame.
+ */
+export const FaceTrackingState = {
+  /** Rendering is paused or hasn't started yet */
+  NotRunning: 0,
+  /** Running, no face tracked */
+  Searching: 1,
+  Tracking: 2,
+} as const;
+
+export type FaceTrackingStateValue =
+  (typeof FaceTrackingState)[keyof typeof FaceTrackingState];
+
+/**
+ * One tracked face. Arrays are reused across reads.
+ */
+export interface FacePose {
+  /** Face transform in world space, column-major 4x4 (meters) */
+  transform: Float32Array;
+  /** Nose bridge (where the glasses rest) in world space, meters */
+  noseBridge: Float32Array;
+  /** Head yaw in radians, positive turning to the user's left */
+  yaw: number;
+  /** Nose bridge in view coordinates, [0, 1] from the top left corner of the view */
+  viewX: number;
+  viewY: number;
+  /** Nose bridge distance in front of the camera, meters */
+  depth: number;
+}
+
+/**
+ * Latest frame read from the buffer. `faces` always holds maxFaces entries, the first
+ * `faceCount` of which are valid.
+ */
+export interface FacePoseFrame {
+  /** Even sequence number of the frame; unchanged means no new frame since the last read */
+  sequence: number;
+  trackingState: FaceTrackingStateValue;
+  faceCount: number;
+  /** Camera frame timestamp in seconds */
+  timestamp: number;
+  faces: FacePose[];
+}
+
+// Header words (uint32)
+const SEQUENCE = 0;
+const VERSION = 1;
+const TRACKING_STATE = 2;
+const FACE_COUNT = 3;
+// Float64 index of the timestamp (byte 16)
+const TIMESTAMP = 2;
+
+const FACE_FLOATS = FacePoseLayout.faceBytes / 4;
+const NOSE_BRIDGE = 16;
+const YAW = 19;
+const VIEW_X = 20;
+const VIEW_Y = 21;
+const DEPTH = 22;
+
+// A frame is written in well under a microsecond: a few retries cover any overlap
+const MAX_ATTEMPTS = 4;
+
+function createFrame(): FacePoseFrame {
+  const faces: FacePose[] = [];
+  for (let i = 0; i < FacePoseLayout.maxFaces; i++) {
+    faces.push({
+      transform: new Float32Array(16),
+      noseBridge: new Float32Array(3),
+      yaw: 0,
+      viewX: 0,
+      viewY: 0,
+      depth: 0,
+    });
+  }
+  return {
+    sequence: 0,
+    trackingState: FaceTrackingState.NotRunning,
+    faceCount: 0,
+    timestamp: 0,
+    faces,
+  };
+}
+
+/**
+ * Polls the face pose buffer a view shares with JS, without allocating or crossing the bridge:
+ * the renderer overwrites the buffer every frame under a seqlock, and `read()` copies a
+ * consistent frame out of it.
+ *
+ * @example
+ * ```ts
+ * const reader = new FacePoseReader(vtoRef.current.getFacePoseBuffer())
+ * // e.g. in a requestAnimationFrame loop
+ * if (reader.read() && reader.frame.faceCount > 0) {
+ *   const face = reader.frame.faces[0]
+ *   indicator.setPosition(face.viewX * viewWidth, face.viewY * viewHeight)
+ * }
+ * ```
+ */
+export class FacePoseReader {
+  /** Filled by read(); the same object every time */
+  readonly frame: FacePoseFrame = createFrame();
+  // Faces being copied, swapped into frame once the copy is known to be consistent
+  private scratch: FacePose[] = createFrame().faces;
+
+  private readonly header: Uint32Array;
+  private readonly timestamp: Float64Array;
+  private readonly faceData: Float32Array;
+
+  constructor(buffer: ArrayBuffer) {
+    if (buffer.byteLength < FacePoseLayout.byteLength) {
+      throw new Error(
+        `Face pose buffer is ${buffer.byteLength} bytes, expected ${FacePoseLayout.byteLength}`
+      );
+    }
+    this.header = new Uint32Array(buffer, 0, FacePoseLayout.headerBytes / 4);
+    this.timestamp = new Float64Array(buffer, 0, FacePoseLayout.headerBytes / 8);
+    this.faceData = new Float32Array(
+      buffer,
+      FacePoseLayout.headerBytes,
+      FacePoseLayout.maxFaces * FACE_FLOATS
+    );
+  }
+
+  /**
+   * Copy the latest frame into `frame`.
+   * @returns false if no consistent frame could be read (the renderer was writing every time,
+   * or the buffer is from a different layout version); `frame` then keeps the previous frame.
+   * `frame.faces` alternates between two arrays: don't hold on to it across reads.
+   */
+  read(): boolean {
+    const header = this.header;
+    const frame = this.frame;
+    for (let attempt = 0; attempt < MAX_ATTEMPTS; attempt++) {
+      const sequence = header[SEQUENCE]!;
+      // Odd while the renderer writes
+      if (sequence & 1) continue;
+      // Nothing new, or nothing written yet (zero-filled: NotRunning)
+      if (sequence === frame.sequence) return true;
+      if (header[VERSION] !== FacePoseLayout.version) return false;
+
+      const trackingState = header[TRACKING_STATE]! as FaceTrackingStateValue;
+      const faceCount = Math.min(header[FACE_COUNT]!, FacePoseLayout.maxFaces);
+      const timestamp = this.timestamp[TIMESTAMP]!;
+      const data = this.faceData;
+      for (let i = 0; i < faceCount; i++) {
+        const face = this.scratch[i]!;
+        const base = i * FACE_FLOATS;
+        // Element copies: subarray() would allocate a view per call
+        for (let j = 0; j < 16; j++) face.transform[j] = data[base + j]!;
+        for (let j = 0; j < 3; j++) {
+          face.noseBridge[j] = data[base + NOSE_BRIDGE + j]!;
+        }
+        face.yaw = data[base + YAW]!;
+        face.viewX = data[base + VIEW_X]!;
+        face.viewY = data[base + VIEW_Y]!;
+        face.depth = data[base + DEPTH]!;
+      }
+
+      // Unchanged sequence: nothing was overwritten while copying
+      if (header[SEQUENCE] !== sequence) continue;
+      const faces = frame.faces;
+      frame.faces = this.scratch;
+      this.scratch = faces;
+      frame.sequence = sequence;
+      frame.trackingState = trackingState;
+      frame.faceCount = faceCount;
+      frame.timestamp = timestamp;
+      return true;
+    }
+    return false;
+  }
+}
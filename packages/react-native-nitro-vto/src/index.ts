@@ -2,11 +2,33 @@ import { getHostComponent } from "react-native-nitro-modules";
 import type {
   NitroVtoViewProps,
   NitroVtoViewMethods,
+  ModelCacheStats,
+  ModelMemoryStats,
+  PerformanceStats,
+  StageTiming,
 } from "./specs/NitroVtoView.nitro";
 import NitroVtoViewConfig from "../nitrogen/generated/shared/json/NitroVtoViewConfig.json";
 import { version } from "../package.json";
 // Re-export types
-export type { NitroVtoViewProps, NitroVtoViewMethods };
+export type {
+  NitroVtoViewProps,
+  NitroVtoViewMethods,
+  ModelCacheStats,
+  ModelMemoryStats,
+  PerformanceStats,
+  StageTiming,
+};
+
+export {
+  FacePoseLayout,
+  FacePoseReader,
+  FaceTrackingState,
+} from "./FacePoseReader";
+export type {
+  FacePose,
+  FacePoseFrame,
+  FaceTrackingStateValue,
+} from "./FacePoseReader";
 
 // Export the HybridRef type for use with hybridRef prop
 export type { HybridRef } from "react-native-nitro-modules";
@@ -4,6 +4,78 @@ import type {
   HybridViewMethods,
 } from "react-native-nitro-modules";
 
+/**
+ * Usage of the on-disk model cache shared by all views.
+ */
+export interface ModelCacheStats {
+  /** Number of cached models */
+  fileCount: number;
+  /** Bytes used by cached models */
+  totalBytes: number;
+  /** Byte budget; least recently used models are evicted beyond it */
+  byteLimit: number;
+  /** Model loads served from the cache since app start */
+  hitCount: number;
+  /** Model loads that had to download since app start */
+  missCount: number;
+}
+
+/**
+ * Memory taken by the glasses models a view keeps loaded (shown, pooled and compare models).
+ * GPU sizes are estimated from each GLB, since Filament doesn't report them.
+ */
+export interface ModelMemoryStats {
+  /** Number of loaded models */
+  modelCount: number;
+  /** Compare models (see setCompareModels) among them */
+  compareModelCount: number;
+  /** Estimated vertex, index and texture bytes on the GPU */
+  gpuBytes: number;
+  /** GLB source data held in memory until each model's textures finish decoding */
+  cpuBytes: number;
+  /** Device class used for level of detail: 0 = low, 1 = mid, 2 = high */
+  deviceTier: number;
+}
+
+/**
+ * Distribution of one frame stage over the last few seconds of rendered frames, in milliseconds.
+ */
+export interface StageTiming {
+  p50: number;
+  p95: number;
+  p99: number;
+  max: number;
+  /** Frames the percentiles were computed over (0 when the stage hasn't run or isn't measured) */
+  samples: number;
+}
+
+/**
+ * Per-stage frame times of one view, for field telemetry.
+ * Stages are also marked as signposts (iOS, Instruments) and trace sections (Android, Perfetto).
+ */
+export interface PerformanceStats {
+  /** Frames rendered since the view was created */
+  frameCount: number;
+  /** Frames Filament skipped because the GPU was behind */
+  droppedFrames: number;
+  /** Getting the camera frame: ARKit currentFrame / ARCore Session.update() */
+  session: StageTiming;
+  /** Camera projection, camera texture and light estimation */
+  camera: StageTiming;
+  /** Face occlusion mesh uploads (only while a face is tracked) */
+  faceMesh: StageTiming;
+  /** Glasses pose solve, smoothing and level of detail (only while a face is tracked) */
+  glassesPose: StageTiming;
+  /** Streaming in glasses resources */
+  resources: StageTiming;
+  /** Filament beginFrame, render and endFrame */
+  render: StageTiming;
+  /** The whole frame on the CPU */
+  frame: StageTiming;
+  /** GPU time of recently completed frames (iOS only; no samples on Android) */
+  gpu: StageTiming;
+}
+
 /**
  * Props for the NitroVtoView component.
  */
@@ -27,6 +99,14 @@ export interface NitroVtoViewProps extends HybridViewProps {
    */
   onModelLoaded?: (modelUrl: string) => void;
 
+  /**
+   * Callback invoked as model resources (mainly textures) are decoded.
+   * Geometry is visible as soon as loading starts; textures stream in over the following frames.
+   * @param modelUrl - The URL of the model being loaded
+   * @param progress - Decode progress in [0, 1]; onModelLoaded fires once it reaches 1
+   */
+  onModelLoadProgress?: (modelUrl: string, progress: number) => void;
+
   /**
    * Whether to enable face mesh occlusion.
    * When enabled, the face mesh writes to depth buffer to occlude glasses behind the face.
@@ -48,12 +128,48 @@ export interface NitroVtoViewProps extends HybridViewProps {
    */
   forwardOffset?: number;
 
+  /**
+   * Maximum number of faces to track and fit with glasses at once (e.g. group try-on).
+   * Clamped to what the device supports: iOS tracks up to 3 faces on A12 and later,
+   * ARCore Augmented Faces tracks a single face.
+   * Default: 1
+   */
+  maxFaces?: number;
+
   /**
    * Whether to enable debug visualization.
-   * When enabled, renders colored overlays for face mesh (red), left back plane (green), and right back plane (blue).
+   * When enabled, tints the occluder (face mesh and visible back planes) red and shows a HUD with
+   * the p50 / p95 time of each frame stage (see getPerformanceStats).
    * Default: false
    */
   debug?: boolean;
+
+  /**
+   * Whether to adapt rendering to the device's thermal state and frame times.
+   * When enabled, the glasses render resolution is lowered first and the frame rate second
+   * to hold the target frame time, and both are restored once the device has headroom again.
+   * Default: false
+   */
+  adaptivePerformance?: boolean;
+
+  /**
+   * Callback invoked when adaptive performance changes the render scale or frame rate.
+   * @param renderScale - Fraction of full rendering resolution, in (0, 1]
+   * @param frameRate - Target frames per second
+   * @param reason - What triggered the change: "thermal", "frameTime" or "recovered"
+   */
+  onPerformanceChange?: (
+    renderScale: number,
+    frameRate: number,
+    reason: string
+  ) => void;
+
+  /**
+   * Callback invoked once a capture() photo or a startRecording() video is written.
+   * @param filePath - Path given to capture or startRecording
+   * @param durationSeconds - Length of the video, 0 for a photo, or -1 if writing the file failed
+   */
+  onCaptureComplete?: (filePath: string, durationSeconds: number) => void;
 }
 
 /**
@@ -70,6 +186,119 @@ export interface NitroVtoViewMethods extends HybridViewMethods {
    * Reset the AR session and face tracking.
    */
   resetSession(): void;
+
+  /**
+   * Download and decode models ahead of time into a bounded pool of ready assets,
+   * so a later switchModel to one of them swaps instantly.
+   * Least recently used models are evicted once the pool exceeds its byte budget.
+   * @param modelUrls - URLs of the model files (GLB format)
+   */
+  prefetchModels(modelUrls: string[]): void;
+
+  /**
+   * Keep a set of models loaded side by side for comparison: they are downloaded and decoded
+   * ahead of time and never evicted, so setActiveModel switches between them by scene membership
+   * alone. Pass an empty array to release them back to the pool.
+   * @param modelUrls - URLs of the model files (GLB format), addressed by index in setActiveModel
+   */
+  setCompareModels(modelUrls: string[]): void;
+
+  /**
+   * Show one of the compare models. Glasses keep their pose across the switch.
+   * A model that hasn't finished loading is shown as soon as it lands.
+   * @param index - Index into the URLs given to setCompareModels
+   */
+  setActiveModel(index: number): void;
+
+  /**
+   * Light the glasses with one of the bundled environments: "studio" (the default),
+   * "brownPhotostudio" or "neonPhotostudio". The environment's reflections load off the render
+   * thread and are shared by every view using it; until they land, the glasses are lit by
+   * spherical harmonics alone. An unknown name keeps the current environment.
+   * @param name - Environment name
+   */
+  setEnvironment(name: string): void;
+
+  /**
+   * Start the shared Filament engine and compile the shader variants VTO uses ahead of time,
+   * so the first try-on frame doesn't stall on shader compilation.
+   * Call it before navigating to the try-on screen; the engine stays warm for 30 seconds
+   * after the last view unmounts.
+   */
+  warmUp(): void;
+
+  /**
+   * Get the size and hit rate of the on-disk model cache (shared by all views).
+   */
+  getModelCacheStats(): ModelCacheStats;
+
+  /**
+   * Get the estimated memory of the models this view keeps loaded, e.g. to cap the number of
+   * compare models per device tier.
+   */
+  getModelMemoryStats(): ModelMemoryStats;
+
+  /**
+   * Get this view's per-stage frame time percentiles over the last few seconds of rendering.
+   */
+  getPerformanceStats(): PerformanceStats;
+
+  /**
+   * Get the buffer this view's renderer overwrites every frame with the tracking state, the
+   * camera timestamp and, per tracked face, the head transform, the nose bridge anchor and its
+   * position in the view. It is shared memory: read it with FacePoseReader, as often as needed,
+   * without bridge calls or allocations. The same buffer is returned on every call.
+   * Layout: cpp/FacePoseStream.hpp (FacePoseLayout in JS).
+   */
+  getFacePoseBuffer(): ArrayBuffer;
+
+  /**
+   * Record the tracked face session to a file, to replay the VTO pipeline offline with
+   * `scripts/replay-bench.ts`. Each camera frame stores the camera intrinsics and transforms,
+   * the face transform and the face mesh (about 8 KB per frame on iOS, 3 KB on Android).
+   * Replaces a recording in progress.
+   * @param filePath - Absolute path of the file to write (created or overwritten)
+   */
+  startFaceRecording(filePath: string): void;
+
+  /**
+   * Stop recording the face session and close the file.
+   */
+  stopFaceRecording(): void;
+
+  /**
+   * Save a photo of what the view shows (camera, occlusion and glasses) on the next rendered frame.
+   * The frame is read back from the GPU asynchronously and encoded off the render thread, so
+   * capturing never holds up a display frame. onCaptureComplete reports when the file is written.
+   * @param filePath - Absolute path of the image to write: HEIC if it ends in `.heic` (iOS only),
+   * JPEG otherwise
+   */
+  capture(filePath: string): void;
+
+  /**
+   * Record what the view shows to an H.264 MP4 video until stopRecording, at up to 30 fps.
+   * Frames are encoded in the background; a frame the encoder can't take in time is dropped
+   * from the video, never from the display. Replaces a recording in progress.
+   * @param filePath - Absolute path of the video to write (created or overwritten)
+   */
+  startRecording(filePath: string): void;
+
+  /**
+   * Stop recording the video and finish the file; onCaptureComplete reports when it is written.
+   */
+  stopRecording(): void;
+
+  /**
+   * Delete every cached model. Models that are shown or pooled stay loaded.
+   */
+  clearModelCache(): void;
+
+  /**
+   * Set the on-disk model cache budget. Least recently used models are evicted beyond it.
+   * Default: 200 MB
+   * @param maxBytes - Budget in bytes
+   */
+  setModelCacheLimit(maxBytes: number): void;
 }
 
 /**